@@ -8,7 +8,7 @@ INCLUDEPATH += $$PWD/external
 QMAKE_CXXFLAGS += -Wall -Wextra -Wshadow -Wnon-virtual-dtor -pedantic -Weffc++
 
 # C++17
-CONFIG += c++17
+CONFIG += c++17 thread
 QMAKE_CXXFLAGS += -std=c++17
 
 DEFINES += RANDLIB_LIBRARY
@@ -29,6 +29,8 @@ SOURCES += \
     distributions/univariate/continuous/UniformRand.cpp \
     distributions/univariate/continuous/ParetoRand.cpp \
     distributions/univariate/continuous/ContinuousDistribution.cpp \
+    distributions/univariate/continuous/TransformedDensityRejection.cpp \
+    distributions/univariate/continuous/UniversalGenerator.cpp \
     distributions/univariate/continuous/TriangularRand.cpp \
     distributions/univariate/continuous/LogisticRand.cpp \
     distributions/univariate/discrete/DiscreteDistribution.cpp \
@@ -65,11 +67,13 @@ SOURCES += \
     distributions/univariate/discrete/BetaBinomialRand.cpp \
     distributions/bivariate/BivariateNormalRand.cpp \
     distributions/univariate/continuous/DegenerateRand.cpp \
+    distributions/univariate/continuous/EmpiricalRand.cpp \
     distributions/univariate/continuous/ExponentiallyModifiedGaussianRand.cpp \
     distributions/univariate/discrete/NegativeHyperGeometricRand.cpp \
     distributions/univariate/continuous/InverseGaussianRand.cpp \
     distributions/univariate/discrete/CategoricalRand.cpp \
     distributions/univariate/continuous/NoncentralChiSquaredRand.cpp \
+    distributions/univariate/continuous/NoncentralTRand.cpp \
     distributions/univariate/continuous/KolmogorovSmirnovRand.cpp \
     math/BetaMath.cpp \
     math/GammaMath.cpp \
@@ -83,7 +87,19 @@ SOURCES += \
     distributions/univariate/UnivariateDistribution.cpp \
     distributions/univariate/continuous/circular/WrappedExponentialRand.cpp \
     distributions/univariate/continuous/FisherFRand.cpp \
-    distributions/univariate/ExponentialFamily.cpp
+    distributions/univariate/ExponentialFamily.cpp \
+    distributions/univariate/CFInversion.cpp \
+    distributions/univariate/Bootstrap.cpp \
+    distributions/univariate/MixtureRand.cpp \
+    distributions/univariate/TruncatedRand.cpp \
+    distributions/univariate/ExponentialTilting.cpp \
+    distributions/multivariate/MultivariateDistribution.cpp \
+    distributions/multivariate/ContinuousMultivariateDistribution.cpp \
+    distributions/multivariate/DirichletRand.cpp \
+    distributions/multivariate/MultivariateNormalRand.cpp \
+    distributions/multivariate/DiscreteMultivariateDistribution.cpp \
+    distributions/multivariate/MultinomialRand.cpp \
+    math/ZetaMath.cpp
 
 HEADERS +=\
     distributions/ProbabilityDistribution.h \
@@ -101,6 +117,8 @@ HEADERS +=\
     distributions/univariate/continuous/UniformRand.h \
     distributions/univariate/continuous/ParetoRand.h \
     distributions/univariate/continuous/ContinuousDistribution.h \
+    distributions/univariate/continuous/TransformedDensityRejection.h \
+    distributions/univariate/continuous/UniversalGenerator.h \
     distributions/univariate/continuous/TriangularRand.h \
     distributions/univariate/continuous/LogisticRand.h \
     distributions/univariate/discrete/DiscreteDistribution.h \
@@ -138,6 +156,7 @@ HEADERS +=\
     distributions/univariate/discrete/BetaBinomialRand.h \
     distributions/bivariate/BivariateNormalRand.h \
     distributions/univariate/continuous/DegenerateRand.h \
+    distributions/univariate/continuous/EmpiricalRand.h \
     distributions/Distributions.h \
     RandLib.h \
     distributions/univariate/continuous/ExponentiallyModifiedGaussianRand.h \
@@ -145,6 +164,7 @@ HEADERS +=\
     distributions/univariate/continuous/InverseGaussianRand.h \
     distributions/univariate/discrete/CategoricalRand.h \
     distributions/univariate/continuous/NoncentralChiSquaredRand.h \
+    distributions/univariate/continuous/NoncentralTRand.h \
     distributions/univariate/continuous/KolmogorovSmirnovRand.h \
     math/BetaMath.h \
     math/GammaMath.h \
@@ -160,6 +180,18 @@ HEADERS +=\
     distributions/univariate/continuous/circular/WrappedExponentialRand.h \
     distributions/univariate/continuous/FisherFRand.h \
     distributions/univariate/ExponentialFamily.h \
+    distributions/univariate/CFInversion.h \
+    distributions/univariate/Bootstrap.h \
+    distributions/univariate/MixtureRand.h \
+    distributions/univariate/TruncatedRand.h \
+    distributions/univariate/ExponentialTilting.h \
+    distributions/multivariate/MultivariateDistribution.h \
+    distributions/multivariate/ContinuousMultivariateDistribution.h \
+    distributions/multivariate/DirichletRand.h \
+    distributions/multivariate/MultivariateNormalRand.h \
+    distributions/multivariate/DiscreteMultivariateDistribution.h \
+    distributions/multivariate/MultinomialRand.h \
+    math/ZetaMath.h \
     external/checks.hpp \
     external/floor.hpp \
     external/gcem_options.hpp \
@@ -6,6 +6,11 @@
 
 /// UNIVARIATE
 #include "univariate/UnivariateDistribution.h"
+#include "univariate/CFInversion.h"
+#include "univariate/Bootstrap.h"
+#include "univariate/MixtureRand.h"
+#include "univariate/TruncatedRand.h"
+#include "univariate/ExponentialTilting.h"
 
 /// CONTINUOUS
 #include "univariate/continuous/ContinuousDistribution.h"
@@ -13,6 +18,7 @@
 #include "univariate/continuous/BetaRand.h"
 #include "univariate/continuous/CauchyRand.h"
 #include "univariate/continuous/DegenerateRand.h"
+#include "univariate/continuous/EmpiricalRand.h"
 #include "univariate/continuous/ExponentialRand.h"
 #include "univariate/continuous/ExponentiallyModifiedGaussianRand.h"
 #include "univariate/continuous/FisherFRand.h"
@@ -31,6 +37,7 @@
 #include "univariate/continuous/MarchenkoPasturRand.h"
 #include "univariate/continuous/NakagamiRand.h"
 #include "univariate/continuous/NoncentralChiSquaredRand.h"
+#include "univariate/continuous/NoncentralTRand.h"
 #include "univariate/continuous/NormalRand.h"
 #include "univariate/continuous/ParetoRand.h"
 #include "univariate/continuous/PlanckRand.h"
@@ -76,4 +83,11 @@
 #include "bivariate/BivariateNormalRand.h"
 #include "bivariate/TrinomialRand.h"
 
+/// MULTIVARIATE
+#include "multivariate/ContinuousMultivariateDistribution.h"
+#include "multivariate/DirichletRand.h"
+#include "multivariate/MultivariateNormalRand.h"
+#include "multivariate/DiscreteMultivariateDistribution.h"
+#include "multivariate/MultinomialRand.h"
+
 #endif // RANDLIB_H
@@ -112,3 +112,13 @@ template class ProbabilityDistribution< Pair<long long int> >;
 template class ProbabilityDistribution< Pair<float> >;
 template class ProbabilityDistribution< Pair<double> >;
 template class ProbabilityDistribution< Pair<long double> >;
+
+/// Multivariate discrete
+template class ProbabilityDistribution< std::vector<int> >;
+template class ProbabilityDistribution< std::vector<long int> >;
+template class ProbabilityDistribution< std::vector<long long int> >;
+
+/// Multivariate continuous
+template class ProbabilityDistribution< std::vector<float> >;
+template class ProbabilityDistribution< std::vector<double> >;
+template class ProbabilityDistribution< std::vector<long double> >;
@@ -64,7 +64,7 @@ public:
      * @param x input vector
      * @param y output vector: y = P(X ≤ x)
      */
-    void CumulativeDistributionFunction(const std::vector<T> &x, std::vector<double> &y) const;
+    virtual void CumulativeDistributionFunction(const std::vector<T> &x, std::vector<double> &y) const;
 
     /**
      * @fn S
@@ -78,7 +78,7 @@ public:
      * @param x input vector
      * @param y output vector: y = P(X > x)
      */
-    void SurvivalFunction(const std::vector<T> &x, std::vector<double> &y) const;
+    virtual void SurvivalFunction(const std::vector<T> &x, std::vector<double> &y) const;
 
     /**
      * @fn Variate()
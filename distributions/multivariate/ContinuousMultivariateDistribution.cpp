@@ -0,0 +1,29 @@
+#include "ContinuousMultivariateDistribution.h"
+
+template < typename RealType >
+void ContinuousMultivariateDistribution<RealType>::ProbabilityDensityFunction(const std::vector<RealType> &points, std::vector<double> &y,
+                                                                              typename MultivariateDistribution<RealType>::MATRIX_LAYOUT layout) const
+{
+    this->LogProbabilityDensityFunction(points, y, layout);
+    for (double &var : y)
+        var = std::exp(var);
+}
+
+template < typename RealType >
+void ContinuousMultivariateDistribution<RealType>::LogProbabilityDensityFunction(const std::vector<RealType> &points, std::vector<double> &y,
+                                                                                 typename MultivariateDistribution<RealType>::MATRIX_LAYOUT layout) const
+{
+    size_t K = this->K;
+    size_t N = this->getSampleSize(points);
+    y.resize(N);
+    std::vector<RealType> point(K);
+    for (size_t i = 0; i != N; ++i) {
+        for (size_t k = 0; k != K; ++k)
+            point[k] = (layout == MultivariateDistribution<RealType>::ROW_MAJOR) ? points[i * K + k] : points[k * N + i];
+        y[i] = this->logf(point);
+    }
+}
+
+template class ContinuousMultivariateDistribution<float>;
+template class ContinuousMultivariateDistribution<double>;
+template class ContinuousMultivariateDistribution<long double>;
@@ -0,0 +1,44 @@
+#ifndef CONTINUOUS_MULTIVARIATE_DISTRIBUTION_H
+#define CONTINUOUS_MULTIVARIATE_DISTRIBUTION_H
+
+#include "MultivariateDistribution.h"
+
+/**
+ * @brief The ContinuousMultivariateDistribution class <BR>
+ * Abstract class for all continuous multivariate probability distributions
+ */
+template < typename RealType >
+class RANDLIBSHARED_EXPORT ContinuousMultivariateDistribution : public MultivariateDistribution<RealType>
+{
+    static_assert(std::is_floating_point_v<RealType>, "Continuous distribution supports only floating-point types");
+
+protected:
+    ContinuousMultivariateDistribution() {}
+    virtual ~ContinuousMultivariateDistribution() {}
+
+public:
+    virtual double f(const std::vector<RealType> &point) const = 0;
+    virtual double logf(const std::vector<RealType> &point) const = 0;
+
+    /**
+     * @fn ProbabilityDensityFunction
+     * fill vector y with f(x_i), where x_i are points stored in matrix buffer
+     * @param points buffer of size NK
+     * @param y output vector of size N
+     * @param layout storage order of the matrix
+     */
+    void ProbabilityDensityFunction(const std::vector<RealType> &points, std::vector<double> &y,
+                                    typename MultivariateDistribution<RealType>::MATRIX_LAYOUT layout = MultivariateDistribution<RealType>::ROW_MAJOR) const;
+
+    /**
+     * @fn LogProbabilityDensityFunction
+     * fill vector y with logf(x_i), where x_i are points stored in matrix buffer
+     * @param points buffer of size NK
+     * @param y output vector of size N
+     * @param layout storage order of the matrix
+     */
+    virtual void LogProbabilityDensityFunction(const std::vector<RealType> &points, std::vector<double> &y,
+                                               typename MultivariateDistribution<RealType>::MATRIX_LAYOUT layout = MultivariateDistribution<RealType>::ROW_MAJOR) const;
+};
+
+#endif // CONTINUOUS_MULTIVARIATE_DISTRIBUTION_H
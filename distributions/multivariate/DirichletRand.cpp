@@ -0,0 +1,182 @@
+#include "DirichletRand.h"
+#include "../univariate/continuous/UniformRand.h"
+
+template < typename RealType >
+DirichletRand<RealType>::DirichletRand(std::vector<double> &&concentrations)
+{
+    SetConcentrations(std::move(concentrations));
+}
+
+template < typename RealType >
+String DirichletRand<RealType>::Name() const
+{
+    String str = "Dirichlet(";
+    for (size_t k = 0; k != this->K - 1; ++k)
+        str += this->toStringWithPrecision(alpha[k]) + ", ";
+    return str + this->toStringWithPrecision(alpha[this->K - 1]) + ")";
+}
+
+template < typename RealType >
+void DirichletRand<RealType>::SetConcentrations(std::vector<double> &&concentrations)
+{
+    if (concentrations.size() < 2)
+        throw std::invalid_argument("Dirichlet distribution: number of concentration parameters should be at least 2");
+    for (double concentration : concentrations) {
+        if (concentration <= 0.0)
+            throw std::invalid_argument("Dirichlet distribution: concentration parameters should be positive, but one of them is equal to "
+                                        + std::to_string(concentration));
+    }
+    alpha = std::move(concentrations);
+    this->K = alpha.size();
+
+    alpha0 = 0.0;
+    logBetaFun = 0.0;
+    useLogSpace = false;
+    gammaShapes.resize(this->K);
+    for (size_t k = 0; k != this->K; ++k) {
+        alpha0 += alpha[k];
+        logBetaFun += std::lgammal(alpha[k]);
+        useLogSpace = useLogSpace || (alpha[k] < 1.0);
+        gammaShapes[k] = (alpha[k] < 1.0) ? alpha[k] + 1.0 : alpha[k];
+    }
+    logBetaFun -= std::lgammal(alpha0);
+}
+
+template < typename RealType >
+double DirichletRand<RealType>::f(const std::vector<RealType> &point) const
+{
+    return std::exp(logf(point));
+}
+
+template < typename RealType >
+double DirichletRand<RealType>::logf(const std::vector<RealType> &point) const
+{
+    if (point.size() != this->K)
+        throw std::invalid_argument("Dirichlet distribution: dimension of point should be equal to " + std::to_string(this->K));
+    double sum = 0.0, y = -logBetaFun;
+    for (size_t k = 0; k != this->K; ++k) {
+        RealType x = point[k];
+        if (x < 0.0 || x > 1.0)
+            return -INFINITY;
+        sum += x;
+        y += (alpha[k] - 1) * std::log(x);
+    }
+    return RandMath::areClose(sum, 1.0) ? y : -INFINITY;
+}
+
+template < typename RealType >
+double DirichletRand<RealType>::F(const std::vector<RealType> &point) const
+{
+    if (this->K != 2)
+        throw std::runtime_error("Dirichlet distribution: cumulative distribution function is available only for K = 2");
+    if (point.size() != 2)
+        throw std::invalid_argument("Dirichlet distribution: dimension of point should be equal to 2");
+    /// P(X_1 ≤ x_1, X_2 ≤ x_2) = P(1 - x_2 ≤ X_1 ≤ x_1)
+    double x1 = std::min<double>(point[0], 1.0);
+    double x2 = std::max<double>(1.0 - point[1], 0.0);
+    if (x1 <= x2)
+        return 0.0;
+    double F1 = (x1 >= 1.0) ? 1.0 : RandMath::ibeta(x1, alpha[0], alpha[1]);
+    double F2 = (x2 <= 0.0) ? 0.0 : RandMath::ibeta(x2, alpha[0], alpha[1]);
+    return F1 - F2;
+}
+
+template < typename RealType >
+void DirichletRand<RealType>::transformGammaVariates(RealType *data, size_t stride) const
+{
+    size_t K = this->K;
+    if (!useLogSpace) {
+        RealType sum = 0.0;
+        for (size_t k = 0; k != K; ++k)
+            sum += data[k * stride];
+        for (size_t k = 0; k != K; ++k)
+            data[k * stride] /= sum;
+        return;
+    }
+
+    /// log(Gamma(α)) = log(Gamma(α + 1)) + log(U) / α, then normalise in log-space,
+    /// so that tiny α don't lead to underflow and division by zero
+    RealType maxLog = -INFINITY;
+    for (size_t k = 0; k != K; ++k) {
+        RealType &var = data[k * stride];
+        var = std::log(var);
+        if (alpha[k] < 1.0)
+            var += std::log(UniformRand<RealType>::StandardVariate(this->localRandGenerator)) / alpha[k];
+        maxLog = std::max(maxLog, var);
+    }
+    RealType sum = 0.0;
+    for (size_t k = 0; k != K; ++k) {
+        RealType &var = data[k * stride];
+        var = std::exp(var - maxLog);
+        sum += var;
+    }
+    for (size_t k = 0; k != K; ++k)
+        data[k * stride] /= sum;
+}
+
+template < typename RealType >
+void DirichletRand<RealType>::Variate(std::vector<RealType> &outputData) const
+{
+    if (outputData.size() != this->K)
+        throw std::invalid_argument("Dirichlet distribution: size of output data should be equal to " + std::to_string(this->K));
+    GammaDistribution<RealType>::StandardSampleParams(gammaShapes, outputData, this->localRandGenerator);
+    transformGammaVariates(outputData.data(), 1);
+}
+
+template < typename RealType >
+void DirichletRand<RealType>::Sample(std::vector<RealType> &outputData, typename MultivariateDistribution<RealType>::MATRIX_LAYOUT layout) const
+{
+    size_t K = this->K;
+    size_t N = this->getSampleSize(outputData);
+    bool rowMajor = (layout == MultivariateDistribution<RealType>::ROW_MAJOR);
+
+    /// gamma variates of each component share the shape and are written directly into the output
+    for (size_t k = 0; k != K; ++k) {
+        if (rowMajor)
+            GammaDistribution<RealType>::StandardSampleStrided(gammaShapes[k], outputData.data() + k, N, K, this->localRandGenerator);
+        else
+            GammaDistribution<RealType>::StandardSampleStrided(gammaShapes[k], outputData.data() + k * N, N, 1, this->localRandGenerator);
+    }
+
+    for (size_t i = 0; i != N; ++i) {
+        if (rowMajor)
+            transformGammaVariates(outputData.data() + i * K, 1);
+        else
+            transformGammaVariates(outputData.data() + i, N);
+    }
+}
+
+template < typename RealType >
+std::vector<long double> DirichletRand<RealType>::Mean() const
+{
+    std::vector<long double> mean(this->K);
+    for (size_t k = 0; k != this->K; ++k)
+        mean[k] = alpha[k] / alpha0;
+    return mean;
+}
+
+template < typename RealType >
+long double DirichletRand<RealType>::Covariance(size_t i, size_t j) const
+{
+    if (i >= this->K || j >= this->K)
+        throw std::invalid_argument("Dirichlet distribution: index of component should be smaller than " + std::to_string(this->K));
+    long double alphai = alpha[i] / alpha0, alphaj = alpha[j] / alpha0;
+    long double cov = (i == j) ? alphai * (1 - alphai) : -alphai * alphaj;
+    return cov / (alpha0 + 1);
+}
+
+template < typename RealType >
+std::vector<RealType> DirichletRand<RealType>::Mode() const
+{
+    std::vector<RealType> mode(this->K);
+    for (size_t k = 0; k != this->K; ++k) {
+        if (alpha[k] <= 1.0)
+            throw std::runtime_error("Dirichlet distribution: mode is defined only if all concentration parameters are greater than 1");
+        mode[k] = (alpha[k] - 1) / (alpha0 - this->K);
+    }
+    return mode;
+}
+
+template class DirichletRand<float>;
+template class DirichletRand<double>;
+template class DirichletRand<long double>;
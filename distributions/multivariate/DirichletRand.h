@@ -0,0 +1,94 @@
+#ifndef DIRICHLETRAND_H
+#define DIRICHLETRAND_H
+
+#include "ContinuousMultivariateDistribution.h"
+#include "../univariate/continuous/GammaRand.h"
+
+/**
+ * @brief The DirichletRand class <BR>
+ * Dirichlet distribution
+ *
+ * f(x | α) = Π x_k^(α_k - 1) / B(α), where x lies on (K - 1)-dimensional simplex
+ *
+ * Notation: X ~ Dir(α_1, ..., α_K)
+ *
+ * Related distributions: <BR>
+ * If X ~ Dir(α_1, α_2), then X_1 ~ Beta(α_1, α_2) <BR>
+ * X = (Y_1, ..., Y_K) / (Y_1 + ... + Y_K), where Y_k ~ Gamma(α_k)
+ */
+template < typename RealType = double >
+class RANDLIBSHARED_EXPORT DirichletRand : public ContinuousMultivariateDistribution<RealType>
+{
+    std::vector<double> alpha{1.0, 1.0}; ///< concentration parameters α
+    double alpha0 = 2; ///< α_1 + ... + α_K
+    double logBetaFun = 0; ///< log(B(α))
+    /// shapes of gamma variates: α_k, or α_k + 1 for α_k < 1, since then
+    /// Gamma(α_k) variate is generated as Gamma(α_k + 1) * U^(1/α_k) in log-space
+    std::vector<double> gammaShapes{1.0, 1.0};
+    bool useLogSpace = false; ///< true if there are α_k < 1
+
+public:
+    explicit DirichletRand(std::vector<double> &&concentrations = {1.0, 1.0});
+
+    String Name() const override;
+    std::vector<RealType> MinValue() const override { return std::vector<RealType>(this->K, 0.0); }
+    std::vector<RealType> MaxValue() const override { return std::vector<RealType>(this->K, 1.0); }
+
+    void SetConcentrations(std::vector<double> &&concentrations);
+    inline const std::vector<double> & GetConcentrations() const { return alpha; }
+
+    double f(const std::vector<RealType> &point) const override;
+    /**
+     * @fn logf
+     * @param point
+     * @return log-density in one pass: Σ (α_k - 1) log(x_k) - log(B(α)), if point lies on simplex
+     */
+    double logf(const std::vector<RealType> &point) const override;
+    /**
+     * @fn F
+     * @param point
+     * @return P(X_1 ≤ x_1, X_2 ≤ x_2), available only for K = 2
+     */
+    double F(const std::vector<RealType> &point) const override;
+
+    using MultivariateDistribution<RealType>::Variate;
+    void Variate(std::vector<RealType> &outputData) const override;
+    using MultivariateDistribution<RealType>::Sample;
+    /**
+     * @fn Sample
+     * fill matrix buffer with random vectors: gamma variates are generated by components
+     * with the block sampler of common shape directly into the buffer and then normalised by rows
+     * @param outputData buffer of size NK, where N is the sample size
+     * @param layout storage order of the matrix
+     */
+    void Sample(std::vector<RealType> &outputData, typename MultivariateDistribution<RealType>::MATRIX_LAYOUT layout = MultivariateDistribution<RealType>::ROW_MAJOR) const override;
+
+    /**
+     * @fn Mean
+     * @return E[X] = α / α_0
+     */
+    std::vector<long double> Mean() const;
+    /**
+     * @fn Covariance
+     * @param i
+     * @param j
+     * @return Cov(X_i, X_j)
+     */
+    long double Covariance(size_t i, size_t j) const;
+    /**
+     * @fn Mode
+     * @return (α_k - 1) / (α_0 - K), defined only if all α_k > 1
+     */
+    std::vector<RealType> Mode() const;
+
+private:
+    /**
+     * @fn transformGammaVariates
+     * transform gamma variates of one random vector in place into Dirichlet variates
+     * @param data pointer on the first component
+     * @param stride distance between consecutive components
+     */
+    void transformGammaVariates(RealType *data, size_t stride) const;
+};
+
+#endif // DIRICHLETRAND_H
@@ -0,0 +1,29 @@
+#include "DiscreteMultivariateDistribution.h"
+
+template < typename IntType >
+void DiscreteMultivariateDistribution<IntType>::ProbabilityMassFunction(const std::vector<IntType> &points, std::vector<double> &y,
+                                                                        typename MultivariateDistribution<IntType>::MATRIX_LAYOUT layout) const
+{
+    LogProbabilityMassFunction(points, y, layout);
+    for (double &var : y)
+        var = std::exp(var);
+}
+
+template < typename IntType >
+void DiscreteMultivariateDistribution<IntType>::LogProbabilityMassFunction(const std::vector<IntType> &points, std::vector<double> &y,
+                                                                           typename MultivariateDistribution<IntType>::MATRIX_LAYOUT layout) const
+{
+    size_t K = this->K;
+    size_t N = this->getSampleSize(points);
+    y.resize(N);
+    std::vector<IntType> point(K);
+    for (size_t i = 0; i != N; ++i) {
+        for (size_t k = 0; k != K; ++k)
+            point[k] = (layout == MultivariateDistribution<IntType>::ROW_MAJOR) ? points[i * K + k] : points[k * N + i];
+        y[i] = this->logP(point);
+    }
+}
+
+template class DiscreteMultivariateDistribution<int>;
+template class DiscreteMultivariateDistribution<long int>;
+template class DiscreteMultivariateDistribution<long long int>;
@@ -0,0 +1,44 @@
+#ifndef DISCRETE_MULTIVARIATE_DISTRIBUTION_H
+#define DISCRETE_MULTIVARIATE_DISTRIBUTION_H
+
+#include "MultivariateDistribution.h"
+
+/**
+ * @brief The DiscreteMultivariateDistribution class <BR>
+ * Abstract class for all discrete multivariate probability distributions
+ */
+template < typename IntType >
+class RANDLIBSHARED_EXPORT DiscreteMultivariateDistribution : public MultivariateDistribution<IntType>
+{
+    static_assert(std::is_integral_v<IntType> && std::is_signed_v<IntType>, "Discrete distribution supports only signed integral types");
+
+protected:
+    DiscreteMultivariateDistribution() {}
+    virtual ~DiscreteMultivariateDistribution() {}
+
+public:
+    virtual double P(const std::vector<IntType> &point) const = 0;
+    virtual double logP(const std::vector<IntType> &point) const = 0;
+
+    /**
+     * @fn ProbabilityMassFunction
+     * fill vector y with P(x_i), where x_i are points stored in matrix buffer
+     * @param points buffer of size NK
+     * @param y output vector of size N
+     * @param layout storage order of the matrix
+     */
+    void ProbabilityMassFunction(const std::vector<IntType> &points, std::vector<double> &y,
+                                 typename MultivariateDistribution<IntType>::MATRIX_LAYOUT layout = MultivariateDistribution<IntType>::ROW_MAJOR) const;
+
+    /**
+     * @fn LogProbabilityMassFunction
+     * fill vector y with logP(x_i), where x_i are points stored in matrix buffer
+     * @param points buffer of size NK
+     * @param y output vector of size N
+     * @param layout storage order of the matrix
+     */
+    void LogProbabilityMassFunction(const std::vector<IntType> &points, std::vector<double> &y,
+                                    typename MultivariateDistribution<IntType>::MATRIX_LAYOUT layout = MultivariateDistribution<IntType>::ROW_MAJOR) const;
+};
+
+#endif // DISCRETE_MULTIVARIATE_DISTRIBUTION_H
@@ -0,0 +1,227 @@
+#include "MultinomialRand.h"
+#include "../univariate/continuous/UniformRand.h"
+#include "../univariate/discrete/BinomialRand.h"
+
+template < typename IntType >
+MultinomialRand<IntType>::MultinomialRand(IntType number, std::vector<double> &&probabilities)
+{
+    SetParameters(number, std::move(probabilities));
+}
+
+template < typename IntType >
+String MultinomialRand<IntType>::Name() const
+{
+    String str = "Multinomial(" + this->toStringWithPrecision(n);
+    for (double p : prob)
+        str += ", " + this->toStringWithPrecision(p);
+    return str + ")";
+}
+
+template < typename IntType >
+void MultinomialRand<IntType>::SetParameters(IntType number, std::vector<double> &&probabilities)
+{
+    if (number < 0)
+        throw std::invalid_argument("Multinomial distribution: number should be non-negative, but it's equal to " + std::to_string(number));
+    if (probabilities.size() == 0)
+        throw std::invalid_argument("Multinomial distribution: there should be at least one category");
+    double sum = 0.0;
+    for (double p : probabilities) {
+        if (p < 0.0)
+            throw std::invalid_argument("Multinomial distribution: probabilities should be non-negative, but one of them is equal to " + std::to_string(p));
+        sum += p;
+    }
+    if (!RandMath::areClose(sum, 1.0))
+        throw std::invalid_argument("Multinomial distribution: probability parameters should sum to 1");
+
+    n = number;
+    prob = std::move(probabilities);
+    size_t K = prob.size();
+    this->K = K;
+    lfactn = std::lgammal(n + 1);
+    logProb.resize(K);
+    for (size_t k = 0; k != K; ++k) {
+        prob[k] /= sum;
+        logProb[k] = std::log(prob[k]);
+    }
+
+    /// sort categories, so that the remaining number of trials vanishes as soon as possible
+    order.resize(K);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this] (size_t i, size_t j) { return prob[i] > prob[j]; });
+    conditionalProb.resize(K);
+    double remainingProb = 1.0;
+    for (size_t k = 0; k != K; ++k) {
+        double p = prob[order[k]];
+        conditionalProb[k] = (remainingProb > p) ? p / remainingProb : 1.0;
+        remainingProb -= p;
+    }
+    /// the last category with nonzero probability takes all the remaining trials
+    size_t lastPositive = K - 1;
+    while (lastPositive > 0 && prob[order[lastPositive]] == 0.0)
+        --lastPositive;
+    conditionalProb[lastPositive] = 1.0;
+
+    /// Vose's alias method
+    aliasProb.resize(K);
+    aliasIndex.resize(K);
+    std::vector<size_t> small, large;
+    for (size_t k = 0; k != K; ++k) {
+        aliasProb[k] = prob[k] * K;
+        aliasIndex[k] = k;
+        (aliasProb[k] < 1.0 ? small : large).push_back(k);
+    }
+    while (!small.empty() && !large.empty()) {
+        size_t s = small.back(), l = large.back();
+        small.pop_back();
+        aliasIndex[s] = l;
+        aliasProb[l] -= 1.0 - aliasProb[s];
+        if (aliasProb[l] < 1.0) {
+            large.pop_back();
+            small.push_back(l);
+        }
+    }
+    /// remaining cells are full up to rounding errors
+    for (size_t k : small)
+        aliasProb[k] = 1.0;
+    for (size_t k : large)
+        aliasProb[k] = 1.0;
+}
+
+template < typename IntType >
+double MultinomialRand<IntType>::P(const std::vector<IntType> &point) const
+{
+    return std::exp(logP(point));
+}
+
+template < typename IntType >
+double MultinomialRand<IntType>::logP(const std::vector<IntType> &point) const
+{
+    if (point.size() != this->K)
+        throw std::invalid_argument("Multinomial distribution: dimension of point should be equal to " + std::to_string(this->K));
+    IntType sum = 0;
+    double y = lfactn;
+    for (size_t k = 0; k != this->K; ++k) {
+        IntType x = point[k];
+        if (x < 0)
+            return -INFINITY;
+        sum += x;
+        if (x == 0)
+            continue;
+        if (prob[k] == 0.0)
+            return -INFINITY;
+        y += x * logProb[k] - std::lgammal(x + 1);
+    }
+    return (sum == n) ? y : -INFINITY;
+}
+
+template < typename IntType >
+double MultinomialRand<IntType>::F(const std::vector<IntType> &point) const
+{
+    if (this->K != 2)
+        throw std::runtime_error("Multinomial distribution: cumulative distribution function is available only for K = 2");
+    if (point.size() != 2)
+        throw std::invalid_argument("Multinomial distribution: dimension of point should be equal to 2");
+    /// P(X_1 ≤ x_1, X_2 ≤ x_2) = P(n - x_2 ≤ X_1 ≤ x_1)
+    IntType x1 = std::min(point[0], n), x2 = std::max<IntType>(n - point[1], 0);
+    if (x1 < x2)
+        return 0.0;
+    BinomialRand<IntType> X(n, prob[0]);
+    return X.F(x1) - ((x2 > 0) ? X.F(x2 - 1) : 0.0);
+}
+
+template < typename IntType >
+size_t MultinomialRand<IntType>::variateCategory() const
+{
+    double U = this->K * UniformRand<double>::StandardVariate(this->localRandGenerator);
+    size_t cell = std::min(static_cast<size_t>(U), this->K - 1);
+    return (U - cell < aliasProb[cell]) ? cell : aliasIndex[cell];
+}
+
+template < typename IntType >
+void MultinomialRand<IntType>::variateConditionalBinomial(IntType *data, size_t stride) const
+{
+    IntType remaining = n;
+    for (size_t k = 0; k != this->K && remaining > 0; ++k) {
+        IntType X = BinomialDistribution<IntType>::Variate(remaining, conditionalProb[k], this->localRandGenerator);
+        data[order[k] * stride] = X;
+        remaining -= X;
+    }
+}
+
+template < typename IntType >
+void MultinomialRand<IntType>::variateAlias(IntType *data, size_t stride) const
+{
+    for (IntType i = 0; i != n; ++i)
+        ++data[variateCategory() * stride];
+}
+
+template < typename IntType >
+void MultinomialRand<IntType>::Variate(std::vector<IntType> &outputData) const
+{
+    if (outputData.size() != this->K)
+        throw std::invalid_argument("Multinomial distribution: size of output data should be equal to " + std::to_string(this->K));
+    std::fill(outputData.begin(), outputData.end(), 0);
+    if (useAliasMethod())
+        variateAlias(outputData.data(), 1);
+    else
+        variateConditionalBinomial(outputData.data(), 1);
+}
+
+template < typename IntType >
+void MultinomialRand<IntType>::Sample(std::vector<IntType> &outputData, typename MultivariateDistribution<IntType>::MATRIX_LAYOUT layout) const
+{
+    size_t K = this->K;
+    size_t N = this->getSampleSize(outputData);
+    bool rowMajor = (layout == MultivariateDistribution<IntType>::ROW_MAJOR);
+    std::fill(outputData.begin(), outputData.end(), 0);
+
+    if (useAliasMethod()) {
+        for (size_t i = 0; i != N; ++i) {
+            if (rowMajor)
+                variateAlias(outputData.data() + i * K, 1);
+            else
+                variateAlias(outputData.data() + i, N);
+        }
+        return;
+    }
+
+    /// conditional binomials, category by category for all vectors,
+    /// keeping only vectors with remaining trials
+    std::vector<IntType> remaining(N, n);
+    std::vector<size_t> active(N);
+    std::iota(active.begin(), active.end(), 0);
+    for (size_t k = 0; k != K && !active.empty(); ++k) {
+        size_t category = order[k];
+        double p = conditionalProb[k];
+        size_t stillActive = 0;
+        for (size_t i : active) {
+            IntType X = BinomialDistribution<IntType>::Variate(remaining[i], p, this->localRandGenerator);
+            outputData[rowMajor ? i * K + category : category * N + i] = X;
+            remaining[i] -= X;
+            if (remaining[i] > 0)
+                active[stillActive++] = i;
+        }
+        active.resize(stillActive);
+    }
+}
+
+template < typename IntType >
+std::vector<long double> MultinomialRand<IntType>::Mean() const
+{
+    std::vector<long double> mean(this->K);
+    for (size_t k = 0; k != this->K; ++k)
+        mean[k] = n * prob[k];
+    return mean;
+}
+
+template < typename IntType >
+long double MultinomialRand<IntType>::Covariance(size_t i, size_t j) const
+{
+    if (i >= this->K || j >= this->K)
+        throw std::invalid_argument("Multinomial distribution: index of category should be smaller than " + std::to_string(this->K));
+    return (i == j) ? n * prob[i] * (1.0 - prob[i]) : -n * prob[i] * prob[j];
+}
+
+template class MultinomialRand<int>;
+template class MultinomialRand<long int>;
+template class MultinomialRand<long long int>;
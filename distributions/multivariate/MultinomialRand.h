@@ -0,0 +1,109 @@
+#ifndef MULTINOMIALRAND_H
+#define MULTINOMIALRAND_H
+
+#include "DiscreteMultivariateDistribution.h"
+
+/**
+ * @brief The MultinomialRand class <BR>
+ * Multinomial distribution
+ *
+ * P(X = x) = n! Π p_k^x_k / x_k!, where x_1 + ... + x_K = n
+ *
+ * Notation: X ~ Multin(n, p_1, ..., p_K)
+ *
+ * Related distributions: <BR>
+ * X_k ~ Bin(n, p_k) <BR>
+ * If X ~ Multin(1, p_1, ..., p_K), then index of nonzero component is distributed as Cat(p_1, ..., p_K)
+ */
+template < typename IntType = int >
+class RANDLIBSHARED_EXPORT MultinomialRand : public DiscreteMultivariateDistribution<IntType>
+{
+    IntType n = 1; ///< number of trials
+    std::vector<double> prob{0.5, 0.5}; ///< probabilities of categories
+    std::vector<double> logProb{-M_LN2, -M_LN2}; ///< logarithms of probabilities
+    double lfactn = 0; ///< log(n!)
+
+    /// constants for conditional binomial generator
+    std::vector<size_t> order{0, 1}; ///< categories sorted by decreasing probability
+    std::vector<double> conditionalProb{0.5, 1.0}; ///< p_k / (1 - sum of previous probabilities in the order)
+
+    /// constants for alias method
+    std::vector<double> aliasProb{1.0, 1.0}; ///< probability to stay in the cell
+    std::vector<size_t> aliasIndex{0, 1}; ///< alternative category of the cell
+
+public:
+    explicit MultinomialRand(IntType number = 1, std::vector<double> &&probabilities = {0.5, 0.5});
+
+    String Name() const override;
+    std::vector<IntType> MinValue() const override { return std::vector<IntType>(this->K, 0); }
+    std::vector<IntType> MaxValue() const override { return std::vector<IntType>(this->K, n); }
+
+    void SetParameters(IntType number, std::vector<double> &&probabilities);
+    inline IntType GetNumber() const { return n; }
+    inline const std::vector<double> & GetProbabilities() const { return prob; }
+
+    double P(const std::vector<IntType> &point) const override;
+    double logP(const std::vector<IntType> &point) const override;
+    /**
+     * @fn F
+     * @param point
+     * @return P(X_1 ≤ x_1, X_2 ≤ x_2), available only for K = 2
+     */
+    double F(const std::vector<IntType> &point) const override;
+
+private:
+    /**
+     * @fn useAliasMethod
+     * @return true if number of trials is small in comparison to the number of categories,
+     * so that it's faster to draw categories with alias method and count them
+     */
+    bool useAliasMethod() const { return static_cast<size_t>(n) < 16 * this->K; }
+    /**
+     * @fn variateCategory
+     * @return category, generated by alias method
+     */
+    size_t variateCategory() const;
+    /**
+     * @fn variateConditionalBinomial
+     * sequential conditional binomial method:
+     * X_k ~ Bin(n - X_1 - ... - X_{k-1}, p_k / (1 - p_1 - ... - p_{k-1}))
+     * @param data pointer on the first component
+     * @param stride distance between consecutive components
+     */
+    void variateConditionalBinomial(IntType *data, size_t stride) const;
+    /**
+     * @fn variateAlias
+     * count categories, generated by alias method
+     * @param data pointer on the first component
+     * @param stride distance between consecutive components
+     */
+    void variateAlias(IntType *data, size_t stride) const;
+
+public:
+    using MultivariateDistribution<IntType>::Variate;
+    void Variate(std::vector<IntType> &outputData) const override;
+    using MultivariateDistribution<IntType>::Sample;
+    /**
+     * @fn Sample
+     * fill matrix buffer with random vectors: in conditional binomial method
+     * each category is processed for all vectors at once
+     * @param outputData buffer of size NK, where N is the sample size
+     * @param layout storage order of the matrix
+     */
+    void Sample(std::vector<IntType> &outputData, typename MultivariateDistribution<IntType>::MATRIX_LAYOUT layout = MultivariateDistribution<IntType>::ROW_MAJOR) const override;
+
+    /**
+     * @fn Mean
+     * @return E[X] = np
+     */
+    std::vector<long double> Mean() const;
+    /**
+     * @fn Covariance
+     * @param i
+     * @param j
+     * @return Cov(X_i, X_j)
+     */
+    long double Covariance(size_t i, size_t j) const;
+};
+
+#endif // MULTINOMIALRAND_H
@@ -0,0 +1,51 @@
+#include "MultivariateDistribution.h"
+
+template < typename T >
+std::vector<T> MultivariateDistribution<T>::Variate() const
+{
+    std::vector<T> var(K);
+    this->Variate(var);
+    return var;
+}
+
+template < typename T >
+void MultivariateDistribution<T>::Sample(std::vector<std::vector<T>> &outputData) const
+{
+    for (std::vector<T> &var : outputData) {
+        var.resize(K);
+        this->Variate(var);
+    }
+}
+
+template < typename T >
+void MultivariateDistribution<T>::Sample(std::vector<T> &outputData, MATRIX_LAYOUT layout) const
+{
+    size_t N = getSampleSize(outputData);
+    std::vector<T> var(K);
+    for (size_t i = 0; i != N; ++i) {
+        this->Variate(var);
+        if (layout == ROW_MAJOR)
+            std::copy(var.begin(), var.end(), outputData.begin() + i * K);
+        else {
+            for (size_t k = 0; k != K; ++k)
+                outputData[k * N + i] = var[k];
+        }
+    }
+}
+
+template < typename T >
+size_t MultivariateDistribution<T>::getSampleSize(const std::vector<T> &outputData) const
+{
+    if (outputData.size() % K != 0)
+        throw std::invalid_argument(this->Name() + ": size of output data should be divisible by dimension "
+                                    + std::to_string(K) + ", but it's equal to " + std::to_string(outputData.size()));
+    return outputData.size() / K;
+}
+
+template class MultivariateDistribution<int>;
+template class MultivariateDistribution<long int>;
+template class MultivariateDistribution<long long int>;
+
+template class MultivariateDistribution<float>;
+template class MultivariateDistribution<double>;
+template class MultivariateDistribution<long double>;
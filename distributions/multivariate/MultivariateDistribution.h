@@ -0,0 +1,70 @@
+#ifndef MULTIVARIATEDISTRIBUTION_H
+#define MULTIVARIATEDISTRIBUTION_H
+
+#include "../ProbabilityDistribution.h"
+
+/**
+ * @brief The MultivariateDistribution class <BR>
+ * Abstract class for all multivariate probability distributions
+ * with values in K-dimensional space
+ *
+ * Variates are written into caller-provided buffers, so that
+ * no memory is allocated per variate
+ */
+template < typename T >
+class RANDLIBSHARED_EXPORT MultivariateDistribution : public ProbabilityDistribution< std::vector<T> >
+{
+protected:
+    size_t K = 1; ///< dimension
+
+    MultivariateDistribution() {}
+    virtual ~MultivariateDistribution() {}
+
+public:
+    enum MATRIX_LAYOUT {
+        ROW_MAJOR, ///< i-th variate is stored in elements [iK, (i + 1)K)
+        COLUMN_MAJOR ///< k-th component of i-th variate is stored in element kN + i, where N is the sample size
+    };
+
+    /**
+     * @fn Dimension
+     * @return K
+     */
+    inline size_t Dimension() const { return K; }
+
+    /**
+     * @fn Variate
+     * @return random vector (allocates memory, consider using Variate(outputData) instead)
+     */
+    std::vector<T> Variate() const override;
+
+    /**
+     * @fn Variate
+     * @param outputData buffer of size K to be filled with random vector
+     */
+    virtual void Variate(std::vector<T> &outputData) const = 0;
+
+    /**
+     * @fn Sample
+     * @param outputData vector of random vectors, each of them is resized to K
+     */
+    void Sample(std::vector<std::vector<T>> &outputData) const override;
+
+    /**
+     * @fn Sample
+     * fill matrix buffer with random vectors
+     * @param outputData buffer of size NK, where N is the sample size
+     * @param layout storage order of the matrix
+     */
+    virtual void Sample(std::vector<T> &outputData, MATRIX_LAYOUT layout = ROW_MAJOR) const;
+
+protected:
+    /**
+     * @fn getSampleSize
+     * @param outputData
+     * @return number of random vectors that can be stored in buffer
+     */
+    size_t getSampleSize(const std::vector<T> &outputData) const;
+};
+
+#endif // MULTIVARIATEDISTRIBUTION_H
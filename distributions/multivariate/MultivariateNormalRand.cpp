@@ -0,0 +1,304 @@
+#include "MultivariateNormalRand.h"
+#include "../univariate/continuous/NormalRand.h"
+#include "../bivariate/BivariateNormalRand.h"
+
+template < typename RealType >
+MultivariateNormalRand<RealType>::MultivariateNormalRand(std::vector<double> &&location, std::vector<double> &&covariance)
+{
+    SetParameters(std::move(location), std::move(covariance));
+}
+
+template < typename RealType >
+String MultivariateNormalRand<RealType>::Name() const
+{
+    return "Multivariate Normal(" + std::to_string(this->K) + "-dimensional)";
+}
+
+template < typename RealType >
+void MultivariateNormalRand<RealType>::SetParameters(std::vector<double> &&location, std::vector<double> &&covariance)
+{
+    size_t K = location.size();
+    if (K == 0)
+        throw std::invalid_argument("Multivariate-Normal distribution: dimension should be positive");
+    if (covariance.size() != K * K)
+        throw std::invalid_argument("Multivariate-Normal distribution: covariance matrix should have "
+                                    + std::to_string(K * K) + " elements, but it has " + std::to_string(covariance.size()));
+    for (size_t i = 0; i != K; ++i) {
+        if (covariance[i * K + i] < 0.0)
+            throw std::invalid_argument("Multivariate-Normal distribution: diagonal elements of covariance matrix should be non-negative");
+        for (size_t j = 0; j != i; ++j) {
+            double a = covariance[i * K + j], b = covariance[j * K + i];
+            if (!RandMath::areClose(a, b, 1e-10 * std::max(1.0, std::fabs(a))))
+                throw std::invalid_argument("Multivariate-Normal distribution: covariance matrix should be symmetric");
+        }
+    }
+
+    this->K = K;
+    mu = std::move(location);
+    Sigma = std::move(covariance);
+    L.assign(K * K, 0.0);
+    isSingular = !decomposeCholesky();
+    if (isSingular)
+        decomposeLDL();
+
+    LT.assign(K * K, 0.0);
+    for (size_t i = 0; i != K; ++i) {
+        for (size_t j = 0; j <= i; ++j)
+            LT[j * K + i] = L[i * K + j];
+    }
+}
+
+template < typename RealType >
+void MultivariateNormalRand<RealType>::SetLocation(std::vector<double> &&location)
+{
+    if (location.size() != this->K)
+        throw std::invalid_argument("Multivariate-Normal distribution: dimension of location should be equal to " + std::to_string(this->K));
+    mu = std::move(location);
+}
+
+template < typename RealType >
+bool MultivariateNormalRand<RealType>::decomposeCholesky()
+{
+    size_t K = this->K;
+    logDetSigma = 0.0;
+    for (size_t j = 0; j != K; ++j) {
+        const double *Lj = L.data() + j * K;
+        double diag = Sigma[j * K + j];
+        for (size_t k = 0; k != j; ++k)
+            diag -= Lj[k] * Lj[k];
+        if (diag <= 0.0)
+            return false;
+        double Ljj = std::sqrt(diag);
+        L[j * K + j] = Ljj;
+        logDetSigma += std::log(diag);
+        for (size_t i = j + 1; i != K; ++i) {
+            const double *Li = L.data() + i * K;
+            double sum = Sigma[i * K + j];
+            for (size_t k = 0; k != j; ++k)
+                sum -= Li[k] * Lj[k];
+            L[i * K + j] = sum / Ljj;
+        }
+    }
+    return true;
+}
+
+template < typename RealType >
+void MultivariateNormalRand<RealType>::decomposeLDL()
+{
+    size_t K = this->K;
+    double maxDiag = 0.0;
+    for (size_t i = 0; i != K; ++i)
+        maxDiag = std::max(maxDiag, Sigma[i * K + i]);
+    double tolerance = 1e-12 * K * maxDiag;
+
+    /// unit lower triangular matrix is stored in L, diagonal in D
+    std::vector<double> D(K, 0.0);
+    L.assign(K * K, 0.0);
+    logDetSigma = -INFINITY;
+    for (size_t j = 0; j != K; ++j) {
+        double *Lj = L.data() + j * K;
+        double d = Sigma[j * K + j];
+        for (size_t k = 0; k != j; ++k)
+            d -= Lj[k] * Lj[k] * D[k];
+        if (d < -tolerance)
+            throw std::invalid_argument("Multivariate-Normal distribution: covariance matrix should be positive semidefinite");
+        Lj[j] = 1.0;
+        if (d <= tolerance) {
+            /// zero pivot: the rest of the column should vanish as well
+            for (size_t i = j + 1; i != K; ++i) {
+                const double *Li = L.data() + i * K;
+                double sum = Sigma[i * K + j];
+                for (size_t k = 0; k != j; ++k)
+                    sum -= Li[k] * Lj[k] * D[k];
+                if (std::fabs(sum) > std::sqrt(tolerance * std::max(Sigma[i * K + i], tolerance)))
+                    throw std::invalid_argument("Multivariate-Normal distribution: covariance matrix should be positive semidefinite");
+            }
+            continue;
+        }
+        D[j] = d;
+        for (size_t i = j + 1; i != K; ++i) {
+            double *Li = L.data() + i * K;
+            double sum = Sigma[i * K + j];
+            for (size_t k = 0; k != j; ++k)
+                sum -= Li[k] * Lj[k] * D[k];
+            Li[j] = sum / d;
+        }
+    }
+
+    /// L := L√D, so that Σ = LL^T
+    std::vector<double> sqrtD(K);
+    for (size_t k = 0; k != K; ++k)
+        sqrtD[k] = std::sqrt(D[k]);
+    for (size_t i = 0; i != K; ++i) {
+        for (size_t j = 0; j <= i; ++j)
+            L[i * K + j] *= sqrtD[j];
+    }
+}
+
+template < typename RealType >
+double MultivariateNormalRand<RealType>::f(const std::vector<RealType> &point) const
+{
+    return std::exp(logf(point));
+}
+
+template < typename RealType >
+double MultivariateNormalRand<RealType>::logf(const std::vector<RealType> &point) const
+{
+    if (point.size() != this->K)
+        throw std::invalid_argument("Multivariate-Normal distribution: dimension of point should be equal to " + std::to_string(this->K));
+    std::vector<double> y;
+    LogProbabilityDensityFunction(point, y);
+    return y[0];
+}
+
+template < typename RealType >
+void MultivariateNormalRand<RealType>::LogProbabilityDensityFunction(const std::vector<RealType> &points, std::vector<double> &y,
+                                                                     typename MultivariateDistribution<RealType>::MATRIX_LAYOUT layout) const
+{
+    if (isSingular)
+        throw std::runtime_error("Multivariate-Normal distribution: density doesn't exist for singular covariance matrix");
+    size_t K = this->K;
+    size_t N = this->getSampleSize(points);
+    y.resize(N);
+    bool rowMajor = (layout == MultivariateDistribution<RealType>::ROW_MAJOR);
+    double logNormalizer = 0.5 * (K * (M_LN2 + M_LNPI) + logDetSigma);
+
+    /// forward substitution Lz = x - μ for a block of points at once,
+    /// z is stored component-wise, so that inner loops go over points
+    constexpr size_t MAX_BLOCK_SIZE = 64;
+    size_t BLOCK_SIZE = std::min(MAX_BLOCK_SIZE, N);
+    std::vector<double> Z(K * BLOCK_SIZE);
+    double squareNorm[MAX_BLOCK_SIZE];
+    for (size_t start = 0; start < N; start += BLOCK_SIZE) {
+        size_t R = std::min(BLOCK_SIZE, N - start);
+        for (size_t k = 0; k != K; ++k) {
+            double *Zk = Z.data() + k * BLOCK_SIZE;
+            for (size_t r = 0; r != R; ++r)
+                Zk[r] = (rowMajor ? points[(start + r) * K + k] : points[k * N + start + r]) - mu[k];
+        }
+        std::fill(squareNorm, squareNorm + R, 0.0);
+        for (size_t i = 0; i != K; ++i) {
+            double *Zi = Z.data() + i * BLOCK_SIZE;
+            const double *Li = L.data() + i * K;
+            size_t j = 0;
+            for (; j + 4 <= i; j += 4) {
+                const double *Zj0 = Z.data() + j * BLOCK_SIZE, *Zj1 = Zj0 + BLOCK_SIZE;
+                const double *Zj2 = Zj1 + BLOCK_SIZE, *Zj3 = Zj2 + BLOCK_SIZE;
+                double L0 = Li[j], L1 = Li[j + 1], L2 = Li[j + 2], L3 = Li[j + 3];
+                for (size_t r = 0; r != R; ++r)
+                    Zi[r] -= L0 * Zj0[r] + L1 * Zj1[r] + L2 * Zj2[r] + L3 * Zj3[r];
+            }
+            for (; j != i; ++j) {
+                const double *Zj = Z.data() + j * BLOCK_SIZE;
+                double Lij = Li[j];
+                for (size_t r = 0; r != R; ++r)
+                    Zi[r] -= Lij * Zj[r];
+            }
+            double LiiInv = 1.0 / Li[i];
+            for (size_t r = 0; r != R; ++r) {
+                Zi[r] *= LiiInv;
+                squareNorm[r] += Zi[r] * Zi[r];
+            }
+        }
+        for (size_t r = 0; r != R; ++r)
+            y[start + r] = -logNormalizer - 0.5 * squareNorm[r];
+    }
+}
+
+template < typename RealType >
+double MultivariateNormalRand<RealType>::F(const std::vector<RealType> &point) const
+{
+    if (point.size() != this->K)
+        throw std::invalid_argument("Multivariate-Normal distribution: dimension of point should be equal to " + std::to_string(this->K));
+    if (this->K == 1)
+        return NormalRand<RealType>(mu[0], Sigma[0]).F(point[0]);
+    if (this->K == 2) {
+        double sigma1 = std::sqrt(Sigma[0]), sigma2 = std::sqrt(Sigma[3]);
+        BivariateNormalRand<RealType> X(mu[0], mu[1], sigma1, sigma2, Sigma[1] / (sigma1 * sigma2));
+        return X.F(std::make_pair(point[0], point[1]));
+    }
+    throw std::runtime_error("Multivariate-Normal distribution: cumulative distribution function is available only for K ≤ 2");
+}
+
+template < typename RealType >
+void MultivariateNormalRand<RealType>::Variate(std::vector<RealType> &outputData) const
+{
+    size_t K = this->K;
+    if (outputData.size() != K)
+        throw std::invalid_argument("Multivariate-Normal distribution: size of output data should be equal to " + std::to_string(K));
+    /// x = μ + Lz, where each z_j affects only x_i for i ≥ j
+    std::copy(mu.begin(), mu.end(), outputData.begin());
+    for (size_t j = 0; j != K; ++j) {
+        RealType z = NormalRand<RealType>::StandardVariate(this->localRandGenerator);
+        const double *LTj = LT.data() + j * K;
+        for (size_t i = j; i != K; ++i)
+            outputData[i] += z * LTj[i];
+    }
+}
+
+template < typename RealType >
+void MultivariateNormalRand<RealType>::transformStandardNormals(const RealType *Z, RealType *X, size_t R) const
+{
+    /// x_r = μ + Σ_j z_rj (L^T)_j: rows of L^T are added to outputs (axpy),
+    /// each row of L^T is loaded once for four outputs at a time
+    size_t K = this->K;
+    for (size_t r = 0; r != R; ++r)
+        std::copy(mu.begin(), mu.end(), X + r * K);
+    size_t r = 0;
+    for (; r + 4 <= R; r += 4) {
+        RealType *X0 = X + r * K, *X1 = X0 + K, *X2 = X1 + K, *X3 = X2 + K;
+        const RealType *Z0 = Z + r * K, *Z1 = Z0 + K, *Z2 = Z1 + K, *Z3 = Z2 + K;
+        for (size_t j = 0; j != K; ++j) {
+            RealType z0 = Z0[j], z1 = Z1[j], z2 = Z2[j], z3 = Z3[j];
+            const double *LTj = LT.data() + j * K;
+            for (size_t i = j; i < K; ++i) {
+                RealType l = LTj[i];
+                X0[i] += z0 * l;
+                X1[i] += z1 * l;
+                X2[i] += z2 * l;
+                X3[i] += z3 * l;
+            }
+        }
+    }
+    for (; r != R; ++r) {
+        RealType *Xr = X + r * K;
+        const RealType *Zr = Z + r * K;
+        for (size_t j = 0; j != K; ++j) {
+            RealType z = Zr[j];
+            const double *LTj = LT.data() + j * K;
+            for (size_t i = j; i < K; ++i)
+                Xr[i] += z * LTj[i];
+        }
+    }
+}
+
+template < typename RealType >
+void MultivariateNormalRand<RealType>::Sample(std::vector<RealType> &outputData, typename MultivariateDistribution<RealType>::MATRIX_LAYOUT layout) const
+{
+    size_t K = this->K;
+    size_t N = this->getSampleSize(outputData);
+    bool rowMajor = (layout == MultivariateDistribution<RealType>::ROW_MAJOR);
+
+    constexpr size_t BLOCK_SIZE = 16;
+    std::vector<RealType> Z(BLOCK_SIZE * K), X;
+    if (!rowMajor)
+        X.resize(BLOCK_SIZE * K);
+    for (size_t start = 0; start < N; start += BLOCK_SIZE) {
+        size_t R = std::min(BLOCK_SIZE, N - start);
+        for (size_t j = 0; j != R * K; ++j)
+            Z[j] = NormalRand<RealType>::StandardVariate(this->localRandGenerator);
+        if (rowMajor) {
+            transformStandardNormals(Z.data(), outputData.data() + start * K, R);
+            continue;
+        }
+        transformStandardNormals(Z.data(), X.data(), R);
+        for (size_t r = 0; r != R; ++r) {
+            for (size_t k = 0; k != K; ++k)
+                outputData[k * N + start + r] = X[r * K + k];
+        }
+    }
+}
+
+template class MultivariateNormalRand<float>;
+template class MultivariateNormalRand<double>;
+template class MultivariateNormalRand<long double>;
@@ -0,0 +1,97 @@
+#ifndef MULTIVARIATENORMALRAND_H
+#define MULTIVARIATENORMALRAND_H
+
+#include "ContinuousMultivariateDistribution.h"
+
+/**
+ * @brief The MultivariateNormalRand class <BR>
+ * Multivariate Gaussian (normal) distribution
+ *
+ * f(x | μ, Σ) = exp(-(x - μ)^T Σ^(-1) (x - μ) / 2) / √((2π)^K |Σ|)
+ *
+ * Notation: X ~ N(μ, Σ)
+ *
+ * Covariance matrix is factorised once as Σ = LL^T (Cholesky decomposition)
+ * or, if it is only positive semidefinite, as Σ = LDL^T
+ */
+template < typename RealType = double >
+class RANDLIBSHARED_EXPORT MultivariateNormalRand : public ContinuousMultivariateDistribution<RealType>
+{
+    std::vector<double> mu{0.0}; ///< location μ
+    std::vector<double> Sigma{1.0}; ///< covariance matrix Σ (row-major)
+    std::vector<double> L{1.0}; ///< lower triangular factor, such that Σ = LL^T (row-major)
+    std::vector<double> LT{1.0}; ///< L^T, stored separately for sampling
+    double logDetSigma = 0; ///< log(|Σ|)
+    bool isSingular = false; ///< true if Σ is positive semidefinite, but not positive definite
+
+public:
+    MultivariateNormalRand(std::vector<double> &&location = {0.0}, std::vector<double> &&covariance = {1.0});
+
+    String Name() const override;
+    std::vector<RealType> MinValue() const override { return std::vector<RealType>(this->K, -INFINITY); }
+    std::vector<RealType> MaxValue() const override { return std::vector<RealType>(this->K, INFINITY); }
+
+    /**
+     * @fn SetParameters
+     * @param location μ
+     * @param covariance Σ, symmetric positive semidefinite matrix in row-major order
+     */
+    void SetParameters(std::vector<double> &&location, std::vector<double> &&covariance);
+    void SetLocation(std::vector<double> &&location);
+    inline const std::vector<double> & GetLocation() const { return mu; }
+    inline const std::vector<double> & GetCovariance() const { return Sigma; }
+    inline const std::vector<double> & GetCholeskyFactor() const { return L; }
+
+    double f(const std::vector<RealType> &point) const override;
+    double logf(const std::vector<RealType> &point) const override;
+    /**
+     * @fn LogProbabilityDensityFunction
+     * log-density of points evaluated in blocks through forward substitution Ly = x - μ
+     */
+    void LogProbabilityDensityFunction(const std::vector<RealType> &points, std::vector<double> &y,
+                                       typename MultivariateDistribution<RealType>::MATRIX_LAYOUT layout = MultivariateDistribution<RealType>::ROW_MAJOR) const override;
+    /**
+     * @fn F
+     * @param point
+     * @return P(X ≤ x), available only for K ≤ 2
+     */
+    double F(const std::vector<RealType> &point) const override;
+
+    using MultivariateDistribution<RealType>::Variate;
+    void Variate(std::vector<RealType> &outputData) const override;
+    using MultivariateDistribution<RealType>::Sample;
+    /**
+     * @fn Sample
+     * generate block of standard normal vectors and multiply it by L
+     * with cache-blocked kernel
+     * @param outputData buffer of size NK, where N is the sample size
+     * @param layout storage order of the matrix
+     */
+    void Sample(std::vector<RealType> &outputData, typename MultivariateDistribution<RealType>::MATRIX_LAYOUT layout = MultivariateDistribution<RealType>::ROW_MAJOR) const override;
+
+    inline const std::vector<double> & Mean() const { return mu; }
+    inline const std::vector<double> & Covariance() const { return Sigma; }
+    inline const std::vector<double> & Mode() const { return mu; }
+
+private:
+    /**
+     * @fn decomposeCholesky
+     * @return true if Σ is positive definite and L is successfully computed
+     */
+    bool decomposeCholesky();
+    /**
+     * @fn decomposeLDL
+     * compute Σ = LDL^T for positive semidefinite Σ and store L√D
+     */
+    void decomposeLDL();
+    /**
+     * @fn transformStandardNormals
+     * x_r = μ + Lz_r for R rows, stored contiguously
+     * @param Z standard normal vectors
+     * @param X output vectors
+     * @param R number of rows
+     */
+    void transformStandardNormals(const RealType *Z, RealType *X, size_t R) const;
+};
+
+#endif // MULTIVARIATENORMALRAND_H
@@ -0,0 +1,513 @@
+#include "Bootstrap.h"
+#include "continuous/NormalRand.h"
+#include "continuous/GammaRand.h"
+#include "continuous/BetaRand.h"
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+
+/**
+ * @fn streamSeed
+ * SplitMix64 hash, which decorrelates the streams of consecutive replicates
+ * @param seed
+ * @param replicate
+ * @return seed of the stream for the given replicate
+ */
+unsigned long streamSeed(unsigned long seed, size_t replicate)
+{
+    unsigned long long z = seed + (replicate + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+}
+
+template < typename RealType >
+void BootstrapEstimator<RealType>::Influence(std::vector<std::vector<double>> &influence) const
+{
+    /// jackknife: U_i = θ(.) - θ(i), where θ(i) is the estimate without the i-th element
+    size_t n = sampleSize, d = NumberOfParameters();
+    influence.assign(d, std::vector<double>(n));
+    std::vector<unsigned int> counts(n, 1);
+    std::vector<double> average(d, 0.0);
+    for (size_t i = 0; i != n; ++i) {
+        counts[i] = 0;
+        std::vector<double> theta = Estimate(counts);
+        counts[i] = 1;
+        for (size_t j = 0; j != d; ++j) {
+            influence[j][i] = theta[j];
+            average[j] += theta[j];
+        }
+    }
+    for (size_t j = 0; j != d; ++j) {
+        average[j] /= n;
+        for (double & u : influence[j])
+            u = average[j] - u;
+    }
+}
+
+template class BootstrapEstimator<float>;
+template class BootstrapEstimator<double>;
+template class BootstrapEstimator<long double>;
+
+template < typename RealType >
+SufficientStatisticEstimator<RealType>::SufficientStatisticEstimator(size_t statisticSize) :
+    statisticSize(statisticSize)
+{
+}
+
+template < typename RealType >
+void SufficientStatisticEstimator<RealType>::SetSample(const std::vector<RealType> &sample)
+{
+    prepare(sample);
+    this->sampleSize = sample.size();
+    table.resize(this->sampleSize * statisticSize);
+    double *row = table.data();
+    for (const RealType & x : sample) {
+        sufficientStatistic(x, row);
+        row += statisticSize;
+    }
+}
+
+template < typename RealType >
+std::vector<double> SufficientStatisticEstimator<RealType>::Estimate(const std::vector<unsigned int> &counts) const
+{
+    size_t n = this->sampleSize, k = statisticSize;
+    std::vector<double> statistic(k, 0.0);
+    double size = 0.0;
+    const double *row = table.data();
+    for (size_t i = 0; i != n; ++i, row += k) {
+        double count = counts[i];
+        size += count;
+        for (size_t j = 0; j != k; ++j)
+            statistic[j] += count * row[j];
+    }
+    for (double & t : statistic)
+        t /= size;
+    return estimate(statistic, size);
+}
+
+template < typename RealType >
+void SufficientStatisticEstimator<RealType>::Influence(std::vector<std::vector<double>> &influence) const
+{
+    size_t n = this->sampleSize, k = statisticSize, d = this->NumberOfParameters();
+    std::vector<double> mean(k, 0.0), deviation(k, 0.0);
+    const double *row = table.data();
+    for (size_t i = 0; i != n; ++i, row += k) {
+        for (size_t j = 0; j != k; ++j)
+            mean[j] += row[j];
+    }
+    for (double & t : mean)
+        t /= n;
+    row = table.data();
+    for (size_t i = 0; i != n; ++i, row += k) {
+        for (size_t j = 0; j != k; ++j)
+            deviation[j] += (row[j] - mean[j]) * (row[j] - mean[j]);
+    }
+
+    /// ∂θ/∂t_j by central differences with the step, small in comparison with the standard deviation of t_j
+    std::vector<std::vector<double>> gradient(k, std::vector<double>(d, 0.0));
+    for (size_t j = 0; j != k; ++j) {
+        double h = 1e-3 * std::sqrt(deviation[j] / n);
+        if (h == 0.0)
+            continue;
+        std::vector<double> statistic = mean;
+        statistic[j] = mean[j] + h;
+        std::vector<double> right = estimate(statistic, n);
+        statistic[j] = mean[j] - h;
+        std::vector<double> left = estimate(statistic, n);
+        for (size_t l = 0; l != d; ++l)
+            gradient[j][l] = 0.5 * (right[l] - left[l]) / h;
+    }
+
+    influence.assign(d, std::vector<double>(n, 0.0));
+    row = table.data();
+    for (size_t i = 0; i != n; ++i, row += k) {
+        for (size_t j = 0; j != k; ++j) {
+            double t = row[j] - mean[j];
+            for (size_t l = 0; l != d; ++l)
+                influence[l][i] += gradient[j][l] * t;
+        }
+    }
+}
+
+template class SufficientStatisticEstimator<float>;
+template class SufficientStatisticEstimator<double>;
+template class SufficientStatisticEstimator<long double>;
+
+template < typename RealType >
+void NormalBootstrapEstimator<RealType>::prepare(const std::vector<RealType> &sample)
+{
+    long double sum = 0.0;
+    for (const RealType & x : sample)
+        sum += x;
+    center = sum / sample.size();
+}
+
+template < typename RealType >
+void NormalBootstrapEstimator<RealType>::sufficientStatistic(const RealType &x, double *statistic) const
+{
+    double y = x - center;
+    statistic[0] = y;
+    statistic[1] = y * y;
+}
+
+template < typename RealType >
+std::vector<double> NormalBootstrapEstimator<RealType>::estimate(const std::vector<double> &statistic, double size) const
+{
+    double variance = statistic[1] - statistic[0] * statistic[0];
+    if (unbiased)
+        variance *= size / (size - 1);
+    return {center + statistic[0], variance};
+}
+
+template class NormalBootstrapEstimator<float>;
+template class NormalBootstrapEstimator<double>;
+template class NormalBootstrapEstimator<long double>;
+
+template < typename RealType >
+void GammaBootstrapEstimator<RealType>::prepare(const std::vector<RealType> &sample)
+{
+    for (const RealType & x : sample) {
+        if (!(x > 0))
+            throw std::invalid_argument("Gamma bootstrap: all elements should be positive");
+    }
+}
+
+template < typename RealType >
+void GammaBootstrapEstimator<RealType>::sufficientStatistic(const RealType &x, double *statistic) const
+{
+    statistic[0] = x;
+    statistic[1] = std::log(x);
+}
+
+template < typename RealType >
+std::vector<double> GammaBootstrapEstimator<RealType>::estimate(const std::vector<double> &statistic, double) const
+{
+    GammaRand<RealType> X;
+    X.Fit(statistic[0], statistic[1]);
+    return {X.GetShape(), X.GetRate()};
+}
+
+template class GammaBootstrapEstimator<float>;
+template class GammaBootstrapEstimator<double>;
+template class GammaBootstrapEstimator<long double>;
+
+template < typename RealType >
+BetaBootstrapEstimator<RealType>::BetaBootstrapEstimator(double minValue, double maxValue) :
+    SufficientStatisticEstimator<RealType>(4)
+{
+    if (!(minValue < maxValue))
+        throw std::invalid_argument("Beta bootstrap: minimal value should be smaller than maximal value, but they're equal to "
+                                    + std::to_string(minValue) + " and " + std::to_string(maxValue));
+    a = minValue;
+    b = maxValue;
+    bmaInv = 1.0 / (b - a);
+}
+
+template < typename RealType >
+void BetaBootstrapEstimator<RealType>::prepare(const std::vector<RealType> &sample)
+{
+    long double sum = 0.0;
+    for (const RealType & x : sample) {
+        if (!(x > a && x < b))
+            throw std::invalid_argument("Beta bootstrap: all elements should be inside of the interval ("
+                                        + std::to_string(a) + ", " + std::to_string(b) + ")");
+        sum += (x - a) * bmaInv;
+    }
+    center = sum / sample.size();
+}
+
+template < typename RealType >
+void BetaBootstrapEstimator<RealType>::sufficientStatistic(const RealType &x, double *statistic) const
+{
+    double z = (x - a) * bmaInv;
+    statistic[0] = std::log(z);
+    statistic[1] = std::log1p(-z);
+    statistic[2] = z - center;
+    statistic[3] = (z - center) * (z - center);
+}
+
+template < typename RealType >
+std::vector<double> BetaBootstrapEstimator<RealType>::estimate(const std::vector<double> &statistic, double) const
+{
+    double mean = a + (center + statistic[2]) * (b - a);
+    double variance = (statistic[3] - statistic[2] * statistic[2]) * (b - a) * (b - a);
+    BetaRand<RealType> X(1, 1, a, b);
+    X.FitShapes(statistic[0], statistic[1], mean, variance);
+    return {X.GetAlpha(), X.GetBeta()};
+}
+
+template class BetaBootstrapEstimator<float>;
+template class BetaBootstrapEstimator<double>;
+template class BetaBootstrapEstimator<long double>;
+
+template < typename RealType >
+LaplaceBootstrapEstimator<RealType>::LaplaceBootstrapEstimator(double asymmetry)
+{
+    if (asymmetry <= 0.0)
+        throw std::invalid_argument("Laplace bootstrap: asymmetry should be positive, but it's equal to "
+                                    + std::to_string(asymmetry));
+    kappa = asymmetry;
+}
+
+template < typename RealType >
+double LaplaceBootstrapEstimator<RealType>::deviation(const RealType &x, double shift) const
+{
+    return (x > shift) ? kappa * (x - shift) : (shift - x) / kappa;
+}
+
+template < typename RealType >
+void LaplaceBootstrapEstimator<RealType>::SetSample(const std::vector<RealType> &sample)
+{
+    orderStatistic = sample;
+    std::sort(orderStatistic.begin(), orderStatistic.end());
+    this->sampleSize = sample.size();
+}
+
+template < typename RealType >
+std::vector<double> LaplaceBootstrapEstimator<RealType>::Estimate(const std::vector<unsigned int> &counts) const
+{
+    size_t n = this->sampleSize;
+    double size = 0.0;
+    for (size_t i = 0; i != n; ++i)
+        size += counts[i];
+
+    /// shift is the root of #{x < m} = κ^2 #{x > m},
+    /// if the whole interval between two order statistics solves it, its middle is taken
+    double level = size * kappa * kappa / (1.0 + kappa * kappa);
+    double cumulative = 0.0;
+    size_t j = 0;
+    while (j + 1 < n && cumulative + counts[j] < level)
+        cumulative += counts[j++];
+    cumulative += counts[j];
+    double shift = orderStatistic[j];
+    if (cumulative == level) {
+        size_t next = j + 1;
+        while (next < n && counts[next] == 0)
+            ++next;
+        if (next < n)
+            shift = 0.5 * (shift + orderStatistic[next]);
+    }
+
+    double scale = 0.0;
+    for (size_t i = 0; i != n; ++i)
+        scale += counts[i] * deviation(orderStatistic[i], shift);
+    scale /= size;
+    return {shift, scale};
+}
+
+template < typename RealType >
+void LaplaceBootstrapEstimator<RealType>::Influence(std::vector<std::vector<double>> &influence) const
+{
+    /// influence of the quantile of level p is proportional to p - 1{x ≤ m},
+    /// scale doesn't depend on the shift in the first order, since ∂E[dev(X, m)]/∂m = 0 at the quantile
+    size_t n = this->sampleSize;
+    std::vector<double> theta = Estimate(std::vector<unsigned int>(n, 1));
+    double p = kappa * kappa / (1.0 + kappa * kappa);
+    influence.assign(2, std::vector<double>(n));
+    for (size_t i = 0; i != n; ++i) {
+        const RealType & x = orderStatistic[i];
+        influence[0][i] = (x <= theta[0]) ? p - 1.0 : p;
+        influence[1][i] = deviation(x, theta[0]) - theta[1];
+    }
+}
+
+template class LaplaceBootstrapEstimator<float>;
+template class LaplaceBootstrapEstimator<double>;
+template class LaplaceBootstrapEstimator<long double>;
+
+template < typename RealType >
+Bootstrap<RealType>::Bootstrap(const std::vector<RealType> &sample, BootstrapEstimator<RealType> &estimator) :
+    estimator(estimator)
+{
+    if (sample.size() < 2)
+        throw std::invalid_argument("Bootstrap: there should be at least 2 elements in the sample");
+    if (sample.size() > 0xFFFFFFFFULL)
+        throw std::invalid_argument("Bootstrap: there should be less than 2^32 elements in the sample");
+    estimator.SetSample(sample);
+    estimate = estimator.Estimate(std::vector<unsigned int>(sample.size(), 1));
+    seed = RandGenerator().Variate();
+}
+
+template < typename RealType >
+void Bootstrap<RealType>::SetNumberOfThreads(size_t threads)
+{
+    numberOfThreads = threads;
+}
+
+template < typename RealType >
+void Bootstrap<RealType>::Run(size_t numberOfReplicates)
+{
+    if (numberOfReplicates == 0)
+        throw std::invalid_argument("Bootstrap: number of replicates should be positive");
+    size_t n = estimator.GetSampleSize(), d = estimator.NumberOfParameters();
+    replicates.assign(d, std::vector<double>(numberOfReplicates));
+    acceleration.clear();
+
+    std::atomic<size_t> nextReplicate(0);
+    std::exception_ptr error = nullptr;
+    std::mutex errorMutex;
+    auto worker = [&] ()
+    {
+        /// PCG streams differ both in state and in increment, unlike the default generator,
+        /// which changes only one of its components on reseeding
+        BasicRandGenerator<PCGRandEngine> generator;
+        std::vector<unsigned int> counts(n);
+        try {
+            for (size_t r = nextReplicate++; r < numberOfReplicates; r = nextReplicate++) {
+                generator.Reseed(streamSeed(seed, r));
+                std::fill(counts.begin(), counts.end(), 0);
+                /// multiply-shift maps 32-bit variate to the index
+                for (size_t i = 0; i != n; ++i)
+                    ++counts[(generator.Variate() * n) >> 32];
+                std::vector<double> theta = estimator.Estimate(counts);
+                for (size_t j = 0; j != d; ++j)
+                    replicates[j][r] = theta[j];
+            }
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (error == nullptr)
+                error = std::current_exception();
+            nextReplicate = numberOfReplicates;
+        }
+    };
+
+    size_t threads = (numberOfThreads == 0) ? std::thread::hardware_concurrency() : numberOfThreads;
+    threads = std::max<size_t>(1, std::min(threads, numberOfReplicates));
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (size_t t = 1; t < threads; ++t)
+        pool.emplace_back(worker);
+    worker();
+    for (std::thread & thread : pool)
+        thread.join();
+    if (error != nullptr) {
+        replicates.clear();
+        std::rethrow_exception(error);
+    }
+
+    for (std::vector<double> & parameterReplicates : replicates)
+        std::sort(parameterReplicates.begin(), parameterReplicates.end());
+}
+
+template < typename RealType >
+void Bootstrap<RealType>::checkParameter(size_t parameter, double significanceLevel) const
+{
+    if (replicates.empty())
+        throw std::runtime_error("Bootstrap: replicates should be generated first");
+    if (parameter >= replicates.size())
+        throw std::invalid_argument("Bootstrap: index of parameter should be smaller than " + std::to_string(replicates.size()));
+    if (significanceLevel <= 0 || significanceLevel > 1)
+        throw std::invalid_argument("Bootstrap: significance level should be in interval (0, 1], but it's equal to "
+                                    + std::to_string(significanceLevel));
+}
+
+template < typename RealType >
+const std::vector<double> &Bootstrap<RealType>::GetReplicates(size_t parameter) const
+{
+    checkParameter(parameter);
+    return replicates[parameter];
+}
+
+template < typename RealType >
+double Bootstrap<RealType>::StandardError(size_t parameter) const
+{
+    checkParameter(parameter);
+    const std::vector<double> &theta = replicates[parameter];
+    size_t size = theta.size();
+    if (size < 2)
+        return 0.0;
+    long double mean = 0.0, variance = 0.0;
+    for (double x : theta)
+        mean += x;
+    mean /= size;
+    for (double x : theta)
+        variance += (x - mean) * (x - mean);
+    return std::sqrt(variance / (size - 1));
+}
+
+template < typename RealType >
+double Bootstrap<RealType>::Bias(size_t parameter) const
+{
+    checkParameter(parameter);
+    long double mean = 0.0;
+    for (double x : replicates[parameter])
+        mean += x;
+    return mean / replicates[parameter].size() - estimate[parameter];
+}
+
+template < typename RealType >
+double Bootstrap<RealType>::replicateQuantile(size_t parameter, double p) const
+{
+    const std::vector<double> &theta = replicates[parameter];
+    double position = std::min(std::max(p, 0.0), 1.0) * (theta.size() - 1);
+    size_t index = std::min(static_cast<size_t>(position), theta.size() - 1);
+    if (index + 1 == theta.size())
+        return theta.back();
+    double h = position - index;
+    return theta[index] + h * (theta[index + 1] - theta[index]);
+}
+
+template < typename RealType >
+DoublePair Bootstrap<RealType>::PercentileInterval(size_t parameter, double significanceLevel) const
+{
+    checkParameter(parameter, significanceLevel);
+    double halfAlpha = 0.5 * significanceLevel;
+    return std::make_pair(replicateQuantile(parameter, halfAlpha), replicateQuantile(parameter, 1.0 - halfAlpha));
+}
+
+template < typename RealType >
+void Bootstrap<RealType>::calculateAcceleration() const
+{
+    std::vector<std::vector<double>> influence;
+    estimator.Influence(influence);
+    acceleration.resize(influence.size());
+    for (size_t j = 0; j != influence.size(); ++j) {
+        long double sumSq = 0.0, sumCube = 0.0;
+        for (double u : influence[j]) {
+            sumSq += u * u;
+            sumCube += u * u * u;
+        }
+        acceleration[j] = (sumSq > 0) ? sumCube / (6 * sumSq * std::sqrt(sumSq)) : 0.0;
+    }
+}
+
+template < typename RealType >
+DoublePair Bootstrap<RealType>::BCaInterval(size_t parameter, double significanceLevel) const
+{
+    checkParameter(parameter, significanceLevel);
+    if (acceleration.empty())
+        calculateAcceleration();
+    double a = acceleration[parameter];
+
+    /// bias correction z0 = Φ^(-1)(P(θ* < θ)), ties are counted by half
+    const std::vector<double> &theta = replicates[parameter];
+    double size = theta.size();
+    auto range = std::equal_range(theta.begin(), theta.end(), estimate[parameter]);
+    double below = (range.first - theta.begin()) + 0.5 * (range.second - range.first);
+    double proportion = std::min(std::max(below / size, 0.5 / size), 1.0 - 0.5 / size);
+    NormalRand<double> NormalRV(0, 1);
+    double z0 = NormalRV.Quantile(proportion);
+
+    double halfAlpha = 0.5 * significanceLevel;
+    auto adjustedLevel = [&] (double p)
+    {
+        double z = z0 + NormalRV.Quantile(p);
+        double denominator = 1.0 - a * z;
+        if (denominator <= 0)
+            return (z > 0) ? 1.0 : 0.0;
+        return NormalRV.F(z0 + z / denominator);
+    };
+    return std::make_pair(replicateQuantile(parameter, adjustedLevel(halfAlpha)),
+                          replicateQuantile(parameter, adjustedLevel(1.0 - halfAlpha)));
+}
+
+template class Bootstrap<float>;
+template class Bootstrap<double>;
+template class Bootstrap<long double>;
@@ -0,0 +1,307 @@
+#ifndef BOOTSTRAP_H
+#define BOOTSTRAP_H
+
+#include "UnivariateDistribution.h"
+
+/**
+ * @brief The BootstrapEstimator class <BR>
+ * Abstract estimator, which can be evaluated on a resample without materializing it
+ *
+ * Resample is described by the counts c_i - number of copies of the i-th element,
+ * so that Σ c_i is the size of the resample (multinomial weights).
+ * Elements are indexed in the internal order of the estimator, which is irrelevant for resampling.
+ * Const methods are called concurrently from several threads.
+ */
+template < typename RealType = double >
+class RANDLIBSHARED_EXPORT BootstrapEstimator
+{
+protected:
+    size_t sampleSize = 0; ///< size of the sample, given to SetSample
+
+public:
+    BootstrapEstimator() {}
+    virtual ~BootstrapEstimator() {}
+
+    /**
+     * @fn NumberOfParameters
+     * @return number of estimated parameters
+     */
+    virtual size_t NumberOfParameters() const = 0;
+
+    /**
+     * @fn SetSample
+     * precompute everything, which doesn't depend on the resample
+     * @param sample
+     */
+    virtual void SetSample(const std::vector<RealType> &sample) = 0;
+    inline size_t GetSampleSize() const { return sampleSize; }
+
+    /**
+     * @fn Estimate
+     * @param counts number of copies of each element in the resample
+     * @return estimated parameters
+     */
+    virtual std::vector<double> Estimate(const std::vector<unsigned int> &counts) const = 0;
+
+    /**
+     * @fn Influence
+     * empirical influence of each element on each parameter, up to a positive factor,
+     * which is used for acceleration of BCa interval.
+     * By default it's calculated by the jackknife, which costs n estimations of O(n) each
+     * @param influence matrix with NumberOfParameters() rows and n columns
+     */
+    virtual void Influence(std::vector<std::vector<double>> &influence) const;
+};
+
+
+/**
+ * @brief The SufficientStatisticEstimator class <BR>
+ * Abstract estimator, which is a function of the average of sufficient statistic θ = g(Σ c_i t(x_i) / Σ c_i)
+ *
+ * Values t(x_i) are tabulated once, so that each replicate costs O(nk) without transcendental functions,
+ * and influence of x_i is ∇g · (t(x_i) - t̄), where gradient is calculated by central differences.
+ */
+template < typename RealType = double >
+class RANDLIBSHARED_EXPORT SufficientStatisticEstimator : public BootstrapEstimator<RealType>
+{
+    size_t statisticSize = 1; ///< k - dimension of sufficient statistic
+    std::vector<double> table{}; ///< t(x_i), row by row
+
+protected:
+    explicit SufficientStatisticEstimator(size_t statisticSize);
+
+    /**
+     * @fn prepare
+     * check the sample and calculate the values, which are needed for sufficientStatistic
+     * @param sample
+     */
+    virtual void prepare(const std::vector<RealType> &sample) = 0;
+
+    /**
+     * @fn sufficientStatistic
+     * @param x
+     * @param statistic array of size k, where t(x) should be written
+     */
+    virtual void sufficientStatistic(const RealType &x, double *statistic) const = 0;
+
+    /**
+     * @fn estimate
+     * @param statistic average of sufficient statistic over the resample
+     * @param size size of the resample
+     * @return estimated parameters
+     */
+    virtual std::vector<double> estimate(const std::vector<double> &statistic, double size) const = 0;
+
+public:
+    void SetSample(const std::vector<RealType> &sample) override;
+    std::vector<double> Estimate(const std::vector<unsigned int> &counts) const override;
+    void Influence(std::vector<std::vector<double>> &influence) const override;
+};
+
+
+/**
+ * @brief The NormalBootstrapEstimator class <BR>
+ * Location and variance, estimated as in NormalRand::Fit
+ */
+template < typename RealType = double >
+class RANDLIBSHARED_EXPORT NormalBootstrapEstimator : public SufficientStatisticEstimator<RealType>
+{
+    bool unbiased = false; ///< true if variance should be unbiased
+    double center = 0; ///< sample mean, subtracted from the values to avoid cancellation
+
+public:
+    explicit NormalBootstrapEstimator(bool unbiased = false) :
+        SufficientStatisticEstimator<RealType>(2), unbiased(unbiased) {}
+    size_t NumberOfParameters() const override { return 2; }
+
+protected:
+    void prepare(const std::vector<RealType> &sample) override;
+    void sufficientStatistic(const RealType &x, double *statistic) const override;
+    std::vector<double> estimate(const std::vector<double> &statistic, double size) const override;
+};
+
+
+/**
+ * @brief The GammaBootstrapEstimator class <BR>
+ * Shape and rate, estimated via maximum likelihood as in GammaRand::Fit
+ */
+template < typename RealType = double >
+class RANDLIBSHARED_EXPORT GammaBootstrapEstimator : public SufficientStatisticEstimator<RealType>
+{
+public:
+    GammaBootstrapEstimator() : SufficientStatisticEstimator<RealType>(2) {}
+    size_t NumberOfParameters() const override { return 2; }
+
+protected:
+    void prepare(const std::vector<RealType> &sample) override;
+    void sufficientStatistic(const RealType &x, double *statistic) const override;
+    std::vector<double> estimate(const std::vector<double> &statistic, double size) const override;
+};
+
+
+/**
+ * @brief The BetaBootstrapEstimator class <BR>
+ * Shapes α and β on the given support, estimated via maximum likelihood as in BetaRand::FitShapes
+ */
+template < typename RealType = double >
+class RANDLIBSHARED_EXPORT BetaBootstrapEstimator : public SufficientStatisticEstimator<RealType>
+{
+    double a = 0; ///< min bound
+    double b = 1; ///< max bound
+    double bmaInv = 1; ///< 1 / (b - a)
+    double center = 0; ///< normalized sample mean, subtracted from the values to avoid cancellation
+
+public:
+    BetaBootstrapEstimator(double minValue = 0, double maxValue = 1);
+    size_t NumberOfParameters() const override { return 2; }
+
+protected:
+    void prepare(const std::vector<RealType> &sample) override;
+    void sufficientStatistic(const RealType &x, double *statistic) const override;
+    std::vector<double> estimate(const std::vector<double> &statistic, double size) const override;
+};
+
+
+/**
+ * @brief The LaplaceBootstrapEstimator class <BR>
+ * Shift and scale of (asymmetric) Laplace distribution with known asymmetry,
+ * estimated as in FitShiftAndScale
+ *
+ * Shift is the weighted quantile of level κ^2 / (1 + κ^2), found in one pass over the sorted sample,
+ * and scale is the weighted average of asymmetric absolute deviations from it.
+ */
+template < typename RealType = double >
+class RANDLIBSHARED_EXPORT LaplaceBootstrapEstimator : public BootstrapEstimator<RealType>
+{
+    double kappa = 1; ///< asymmetry
+    std::vector<RealType> orderStatistic{}; ///< sorted sample
+
+    /**
+     * @fn deviation
+     * @param x
+     * @param shift
+     * @return κ(x - m) for x > m and (m - x) / κ otherwise
+     */
+    double deviation(const RealType &x, double shift) const;
+
+public:
+    explicit LaplaceBootstrapEstimator(double asymmetry = 1);
+    size_t NumberOfParameters() const override { return 2; }
+    void SetSample(const std::vector<RealType> &sample) override;
+    std::vector<double> Estimate(const std::vector<unsigned int> &counts) const override;
+    void Influence(std::vector<std::vector<double>> &influence) const override;
+};
+
+
+/**
+ * @brief The Bootstrap class <BR>
+ * Non-parametric bootstrap of the estimator with percentile and BCa confidence intervals
+ *
+ * Replicates are distributed over the threads dynamically. Each replicate draws n uniform indices
+ * from its own stream, which is seeded by the hash of the seed and the number of the replicate,
+ * hence the result depends only on the seed and not on the number of threads.
+ * Only the counts of the indices are stored, resampled vectors are never materialized.
+ */
+template < typename RealType = double >
+class RANDLIBSHARED_EXPORT Bootstrap
+{
+    BootstrapEstimator<RealType> &estimator; ///< estimator, which owns the prepared sample
+    size_t numberOfThreads = 0; ///< 0 if all hardware threads should be used
+    unsigned long seed = 0; ///< seed of all the streams
+    std::vector<double> estimate{}; ///< estimate on the original sample
+    std::vector<std::vector<double>> replicates{}; ///< sorted replicates of each parameter
+    mutable std::vector<double> acceleration{}; ///< acceleration of BCa interval for each parameter
+
+public:
+    /**
+     * @fn Bootstrap
+     * @param sample at least two elements
+     * @param estimator it's prepared for the sample and should outlive the bootstrap
+     */
+    Bootstrap(const std::vector<RealType> &sample, BootstrapEstimator<RealType> &estimator);
+
+    /**
+     * @fn SetNumberOfThreads
+     * @param numberOfThreads if it's equal to 0, all hardware threads are used
+     */
+    void SetNumberOfThreads(size_t numberOfThreads);
+    inline size_t GetNumberOfThreads() const { return numberOfThreads; }
+    inline void SetSeed(unsigned long newSeed) { seed = newSeed; }
+    inline unsigned long GetSeed() const { return seed; }
+
+    /**
+     * @fn Run
+     * generate replicates of the estimator, replacing the previous ones
+     * @param numberOfReplicates
+     */
+    void Run(size_t numberOfReplicates);
+
+    /**
+     * @fn GetEstimate
+     * @return estimated parameters on the original sample
+     */
+    inline const std::vector<double> &GetEstimate() const { return estimate; }
+
+    /**
+     * @fn GetReplicates
+     * @param parameter index of the parameter
+     * @return sorted replicates of the parameter
+     */
+    const std::vector<double> &GetReplicates(size_t parameter) const;
+
+    /**
+     * @fn StandardError
+     * @param parameter index of the parameter
+     * @return standard deviation of the replicates
+     */
+    double StandardError(size_t parameter) const;
+
+    /**
+     * @fn Bias
+     * @param parameter index of the parameter
+     * @return difference between the average of the replicates and the estimate
+     */
+    double Bias(size_t parameter) const;
+
+    /**
+     * @fn PercentileInterval
+     * @param parameter index of the parameter
+     * @param significanceLevel α
+     * @return quantiles of the replicates of levels α/2 and 1 - α/2
+     */
+    DoublePair PercentileInterval(size_t parameter, double significanceLevel) const;
+
+    /**
+     * @fn BCaInterval
+     * bias-corrected and accelerated interval, the levels of the quantiles are adjusted
+     * by the median bias of the replicates and by the skewness of the empirical influence
+     * @param parameter index of the parameter
+     * @param significanceLevel α
+     * @return BCa confidence interval
+     */
+    DoublePair BCaInterval(size_t parameter, double significanceLevel) const;
+
+private:
+    /**
+     * @fn checkParameter
+     * @param parameter
+     * @param significanceLevel
+     */
+    void checkParameter(size_t parameter, double significanceLevel = 0.5) const;
+
+    /**
+     * @fn replicateQuantile
+     * @param parameter
+     * @param p
+     * @return linearly interpolated quantile of the sorted replicates
+     */
+    double replicateQuantile(size_t parameter, double p) const;
+
+    /**
+     * @fn calculateAcceleration
+     * a = Σ U_i^3 / (6 (Σ U_i^2)^(3/2)) for the empirical influence U
+     */
+    void calculateAcceleration() const;
+};
+
+#endif // BOOTSTRAP_H
@@ -0,0 +1,308 @@
+#include "CFInversion.h"
+#include "continuous/ContinuousDistribution.h"
+
+namespace
+{
+
+/**
+ * @fn checkSummands
+ * @param summands
+ * @param epsilon
+ */
+template < typename RealType >
+void checkSummands(const std::vector<const UnivariateDistribution<RealType> *> &summands, double epsilon)
+{
+    if (epsilon <= 0.0)
+        throw std::invalid_argument("Characteristic function inversion: accuracy should be positive, but it's equal to "
+                                    + std::to_string(epsilon));
+    bool hasContinuousSummand = false;
+    for (const UnivariateDistribution<RealType> *summand : summands) {
+        if (summand == nullptr)
+            throw std::invalid_argument("Characteristic function inversion: distribution should not be null");
+        if (dynamic_cast<const ContinuousDistribution<RealType> *>(summand) != nullptr)
+            hasContinuousSummand = true;
+    }
+    if (!hasContinuousSummand)
+        throw std::invalid_argument("Characteristic function inversion: at least one distribution should be continuous");
+}
+
+}
+
+template < typename RealType >
+CFInversion<RealType>::CFInversion(const UnivariateDistribution<RealType> &distribution, double epsilon) :
+    CFInversion(std::vector<const UnivariateDistribution<RealType> *>{&distribution}, epsilon)
+{
+}
+
+template < typename RealType >
+CFInversion<RealType>::CFInversion(const std::vector<const UnivariateDistribution<RealType> *> &summands, double epsilon)
+{
+    checkSummands(summands, epsilon);
+    setRange(summands, epsilon);
+    tabulate(summands, epsilon);
+}
+
+template < typename RealType >
+CFInversion<RealType>::CFInversion(const std::vector<const UnivariateDistribution<RealType> *> &summands, double minValue, double maxValue, double epsilon)
+{
+    checkSummands(summands, epsilon);
+    if (!(minValue < maxValue) || !std::isfinite(minValue) || !std::isfinite(maxValue))
+        throw std::invalid_argument("Characteristic function inversion: interval should be finite and non-empty, but it's equal to ["
+                                    + std::to_string(minValue) + ", " + std::to_string(maxValue) + "]");
+    a = minValue;
+    b = maxValue;
+    rangeError = 0.0;
+    tabulate(summands, epsilon);
+}
+
+template < typename RealType >
+void CFInversion<RealType>::setRange(const std::vector<const UnivariateDistribution<RealType> *> &summands, double epsilon)
+{
+    /// P(ΣX_i < Σa_i) ≤ ΣP(X_i < a_i), the same for the right tail
+    double delta = 0.25 * epsilon / summands.size();
+    a = b = rangeError = 0.0;
+    for (const UnivariateDistribution<RealType> *summand : summands) {
+        if (summand->isLeftBounded()) {
+            a += summand->MinValue();
+        }
+        else {
+            a += summand->Quantile(delta);
+            rangeError += delta;
+        }
+        if (summand->isRightBounded()) {
+            b += summand->MaxValue();
+        }
+        else {
+            b += summand->Quantile1m(delta);
+            rangeError += delta;
+        }
+    }
+    if (!(a < b) || !std::isfinite(a) || !std::isfinite(b))
+        throw std::runtime_error("Characteristic function inversion: failed to find finite interval for the given accuracy");
+}
+
+template < typename RealType >
+void CFInversion<RealType>::tabulate(const std::vector<const UnivariateDistribution<RealType> *> &summands, double epsilon)
+{
+    static constexpr int MIN_TERMS = 64;
+    static constexpr int MAX_TERMS = 1 << 19;
+    static constexpr size_t MAX_GRID_SIZE = 1 << 20;
+    static constexpr double MAX_ERROR_RATIO = 1e3;
+    double omega = M_PI / (b - a), coef = 2.0 / (b - a);
+
+    /// A_k with doubling of the number of terms, the last half of them estimates the error of cdf
+    std::vector<double> coefs(1, coef);
+    numberOfTerms = MIN_TERMS;
+    while (true) {
+        coefs.reserve(numberOfTerms);
+        double tail = 0.0;
+        for (int k = coefs.size(); k != numberOfTerms; ++k) {
+            double u = k * omega, angle = u * a;
+            std::complex<double> phi(std::cos(angle), -std::sin(angle));
+            for (const UnivariateDistribution<RealType> *summand : summands)
+                phi *= summand->CF(u);
+            double A = coef * phi.real();
+            coefs.push_back(A);
+            tail += std::fabs(A) / u;
+        }
+        seriesError = tail;
+        if (tail <= 0.5 * epsilon || numberOfTerms == MAX_TERMS)
+            break;
+        numberOfTerms *= 2;
+    }
+
+    /// Refine the grid until cubic interpolation of cdf is accurate enough,
+    /// its error is bounded by h^4 max|F^(4)| / 384, which is estimated by the fourth differences
+    size_t gridSize = 2 * numberOfTerms;
+    while (true) {
+        sumSeries(coefs, gridSize);
+        double maxDifference = 0.0;
+        for (size_t j = 4; j < cdfTable.size(); ++j) {
+            double difference = cdfTable[j] - 4 * cdfTable[j - 1] + 6 * cdfTable[j - 2] - 4 * cdfTable[j - 3] + cdfTable[j - 4];
+            maxDifference = std::max(maxDifference, std::fabs(difference));
+        }
+        interpolationError = maxDifference / 384;
+        if (interpolationError <= 0.5 * epsilon || gridSize == MAX_GRID_SIZE)
+            break;
+        double ratio = interpolationError / (0.5 * epsilon);
+        int power = std::max(1, static_cast<int>(std::ceil(0.25 * std::log2(ratio))));
+        gridSize = std::min(gridSize << power, MAX_GRID_SIZE);
+    }
+
+    /// series converge too slowly for heavy tails or singular density, the table would be useless
+    double errorRatio = ErrorEstimate() / epsilon;
+    if (!(errorRatio <= MAX_ERROR_RATIO))
+        throw std::runtime_error("Characteristic function inversion: estimated error is "
+                                 + std::to_string(errorRatio) + " times larger than required accuracy");
+    buildGuideTable();
+}
+
+template < typename RealType >
+void CFInversion<RealType>::sumSeries(const std::vector<double> &coefs, size_t gridSize)
+{
+    /// Σ A_k cos(u_k(x_j - a)) and Σ A_k / u_k sin(u_k(x_j - a)),
+    /// both real sequences are packed into one transform
+    double omega = M_PI / (b - a);
+    size_t fftSize = 2 * gridSize;
+    std::vector<std::complex<double>> z(fftSize);
+    z[0] = 0.5 * coefs[0];
+    for (size_t k = 1; k != coefs.size(); ++k)
+        z[k] = std::complex<double>(coefs[k], coefs[k] / (k * omega));
+    RandMath::fft(z, true);
+
+    step = (b - a) / gridSize;
+    pdfTable.resize(gridSize + 1);
+    cdfTable.resize(gridSize + 1);
+    for (size_t j = 0; j <= gridSize; ++j) {
+        std::complex<double> g = z[j], gConj = std::conj(z[(fftSize - j) % fftSize]);
+        pdfTable[j] = 0.5 * (g.real() + gConj.real());
+        double sineSum = 0.5 * (gConj.real() - g.real());
+        cdfTable[j] = 0.5 * coefs[0] * j * step + sineSum;
+    }
+    cdfTable.front() = 0.0;
+    cdfTable.back() = 1.0;
+}
+
+template < typename RealType >
+void CFInversion<RealType>::buildGuideTable()
+{
+    size_t numberOfCells = cdfTable.size() - 1;
+    guideTable.resize(numberOfCells);
+    size_t j = 0;
+    for (size_t i = 0; i != numberOfCells; ++i) {
+        double p = static_cast<double>(i) / numberOfCells;
+        while (j + 1 < numberOfCells && cdfTable[j + 1] <= p)
+            ++j;
+        guideTable[i] = j;
+    }
+}
+
+template < typename RealType >
+bool CFInversion<RealType>::locate(double x, size_t &index, double &h) const
+{
+    if (!(x >= a && x <= b))
+        return false;
+    double t = (x - a) / step;
+    index = std::min(static_cast<size_t>(t), pdfTable.size() - 2);
+    h = t - index;
+    return true;
+}
+
+template < typename RealType >
+double CFInversion<RealType>::slope(size_t index) const
+{
+    size_t last = pdfTable.size() - 1;
+    if (index == 0)
+        return pdfTable[1] - pdfTable[0];
+    if (index == last)
+        return pdfTable[last] - pdfTable[last - 1];
+    if (index == 1 || index == last - 1)
+        return 0.5 * (pdfTable[index + 1] - pdfTable[index - 1]);
+    double slope = 8 * (pdfTable[index + 1] - pdfTable[index - 1]) - pdfTable[index + 2] + pdfTable[index - 2];
+    return slope / 12;
+}
+
+template < typename RealType >
+double CFInversion<RealType>::f(const RealType &x) const
+{
+    size_t j = 0;
+    double h = 0;
+    if (!locate(x, j, h))
+        return 0.0;
+    /// cubic Hermite interpolation with slopes given by finite differences
+    double y0 = pdfTable[j], y1 = pdfTable[j + 1];
+    double m0 = slope(j), m1 = slope(j + 1);
+    double h1 = 1.0 - h;
+    double y = h1 * h1 * ((1.0 + 2.0 * h) * y0 + h * m0) + h * h * ((3.0 - 2.0 * h) * y1 - h1 * m1);
+    return std::max(y, 0.0);
+}
+
+template < typename RealType >
+double CFInversion<RealType>::F(const RealType &x) const
+{
+    size_t j = 0;
+    double h = 0;
+    if (!locate(x, j, h))
+        return (x < a) ? 0.0 : 1.0;
+    /// cubic Hermite interpolation with slopes given by density
+    double y0 = cdfTable[j], y1 = cdfTable[j + 1];
+    double m0 = step * pdfTable[j], m1 = step * pdfTable[j + 1];
+    double h1 = 1.0 - h;
+    double y = h1 * h1 * ((1.0 + 2.0 * h) * y0 + h * m0) + h * h * ((3.0 - 2.0 * h) * y1 - h1 * m1);
+    return std::min(std::max(y, 0.0), 1.0);
+}
+
+template < typename RealType >
+double CFInversion<RealType>::S(const RealType &x) const
+{
+    return 1.0 - F(x);
+}
+
+template < typename RealType >
+RealType CFInversion<RealType>::Quantile(double p) const
+{
+    if (p < 0.0 || p > 1.0)
+        throw std::invalid_argument("Probability p in quantile function should be in interval [0, 1]");
+    size_t numberOfCells = cdfTable.size() - 1;
+    size_t j = guideTable[std::min(static_cast<size_t>(p * numberOfCells), numberOfCells - 1)];
+    while (j + 1 < numberOfCells && cdfTable[j + 1] <= p)
+        ++j;
+
+    /// invert cubic Hermite interpolation of cdf in the cell
+    double y0 = cdfTable[j], y1 = cdfTable[j + 1];
+    double m0 = step * pdfTable[j], m1 = step * pdfTable[j + 1];
+    if (y1 <= y0)
+        return a + j * step;
+    double hMin = 0.0, hMax = 1.0;
+    double h = std::min(std::max((p - y0) / (y1 - y0), 0.0), 1.0);
+    for (int i = 0; i != 8; ++i) {
+        double h1 = 1.0 - h;
+        double y = h1 * h1 * ((1.0 + 2.0 * h) * y0 + h * m0) + h * h * ((3.0 - 2.0 * h) * y1 - h1 * m1) - p;
+        if (y < 0)
+            hMin = h;
+        else
+            hMax = h;
+        double dy = 6 * h * h1 * (y1 - y0) + h1 * (1.0 - 3.0 * h) * m0 + h * (3.0 * h - 2.0) * m1;
+        double hNew = (dy > 0) ? h - y / dy : 0.5 * (hMin + hMax);
+        if (hNew <= hMin || hNew >= hMax)
+            hNew = 0.5 * (hMin + hMax);
+        if (std::fabs(hNew - h) < 1e-10)
+            return a + (j + hNew) * step;
+        h = hNew;
+    }
+    return a + (j + h) * step;
+}
+
+template < typename RealType >
+void CFInversion<RealType>::ProbabilityDensityFunction(const std::vector<RealType> &x, std::vector<double> &y) const
+{
+    size_t size = x.size();
+    if (size > y.size())
+        return;
+    for (size_t i = 0; i != size; ++i)
+        y[i] = f(x[i]);
+}
+
+template < typename RealType >
+void CFInversion<RealType>::CumulativeDistributionFunction(const std::vector<RealType> &x, std::vector<double> &y) const
+{
+    size_t size = x.size();
+    if (size > y.size())
+        return;
+    for (size_t i = 0; i != size; ++i)
+        y[i] = F(x[i]);
+}
+
+template < typename RealType >
+void CFInversion<RealType>::SurvivalFunction(const std::vector<RealType> &x, std::vector<double> &y) const
+{
+    size_t size = x.size();
+    if (size > y.size())
+        return;
+    for (size_t i = 0; i != size; ++i)
+        y[i] = S(x[i]);
+}
+
+template class CFInversion<float>;
+template class CFInversion<double>;
+template class CFInversion<long double>;
@@ -0,0 +1,153 @@
+#ifndef CFINVERSION_H
+#define CFINVERSION_H
+
+#include "UnivariateDistribution.h"
+
+/**
+ * @brief The CFInversion class <BR>
+ * Tabulated density and cdf recovered from characteristic function
+ *
+ * Density is expanded into the cosine series (COS method) on the interval [a, b]:
+ * f(x) ≈ A_0 / 2 + Σ A_k cos(u_k (x - a)), where u_k = kπ / (b - a) and
+ * A_k = 2 / (b - a) Re[φ(u_k) exp(-i u_k a)].
+ * Cdf is obtained by termwise integration, so that F(a) = 0 and F(b) = 1 exactly.
+ * Both series are summed on the uniform grid by one fast Fourier transform,
+ * values between the nodes are interpolated, the grid is refined until the interpolation is accurate enough.
+ *
+ * For the sum of independent random variables φ(t) = Π φ_i(t), which gives the law of the sum
+ * without convolution integrals.
+ *
+ * Interval [a, b] is chosen by the quantiles of the summands, so that the probability to fall outside
+ * is not greater than ε / 2. Number of terms is doubled until the terms of the cdf series become
+ * smaller than ε / 2, or until the maximal size is reached. In the last case ErrorEstimate() can be larger than ε,
+ * and the constructor throws if it exceeds ε by more than three orders of magnitude (e.g. for heavy tails).
+ */
+template < typename RealType = double >
+class RANDLIBSHARED_EXPORT CFInversion
+{
+    double a = 0; ///< left bound of the interval
+    double b = 1; ///< right bound of the interval
+    double step = 1; ///< step of the grid
+    double seriesError = 0; ///< estimated error of truncated cdf series
+    double interpolationError = 0; ///< estimated error of interpolation between the nodes
+    double rangeError = 0; ///< upper bound of probability outside of [a, b]
+    int numberOfTerms = 0; ///< number of terms in the cosine series
+    std::vector<double> pdfTable{}; ///< f(a + j * step)
+    std::vector<double> cdfTable{}; ///< F(a + j * step)
+    std::vector<size_t> guideTable{}; ///< index of the cell, containing probability i / (number of cells)
+
+public:
+    /**
+     * @fn CFInversion
+     * @param distribution
+     * @param epsilon required accuracy of cdf
+     */
+    explicit CFInversion(const UnivariateDistribution<RealType> &distribution, double epsilon = 1e-10);
+
+    /**
+     * @fn CFInversion
+     * recover the law of the sum of independent random variables
+     * @param summands distributions of the summands, at least one of them should be continuous
+     * @param epsilon required accuracy of cdf
+     */
+    explicit CFInversion(const std::vector<const UnivariateDistribution<RealType> *> &summands, double epsilon = 1e-10);
+
+    /**
+     * @fn CFInversion
+     * recover the law of the sum on the given interval,
+     * probability outside of it is not included in the error estimate
+     * @param summands
+     * @param minValue a
+     * @param maxValue b
+     * @param epsilon required accuracy of cdf
+     */
+    CFInversion(const std::vector<const UnivariateDistribution<RealType> *> &summands, double minValue, double maxValue, double epsilon = 1e-10);
+
+    inline double MinValue() const { return a; }
+    inline double MaxValue() const { return b; }
+    inline double Step() const { return step; }
+    inline int NumberOfTerms() const { return numberOfTerms; }
+
+    /**
+     * @fn ErrorEstimate
+     * @return estimate of the absolute error of cdf
+     */
+    inline double ErrorEstimate() const { return seriesError + interpolationError + rangeError; }
+
+    /**
+     * @fn PdfTable
+     * @return values of density on the grid a + j * Step()
+     */
+    inline const std::vector<double> &PdfTable() const { return pdfTable; }
+
+    /**
+     * @fn CdfTable
+     * @return values of cdf on the grid a + j * Step()
+     */
+    inline const std::vector<double> &CdfTable() const { return cdfTable; }
+
+    double f(const RealType &x) const;
+    double F(const RealType &x) const;
+    double S(const RealType &x) const;
+    void ProbabilityDensityFunction(const std::vector<RealType> &x, std::vector<double> &y) const;
+    void CumulativeDistributionFunction(const std::vector<RealType> &x, std::vector<double> &y) const;
+    void SurvivalFunction(const std::vector<RealType> &x, std::vector<double> &y) const;
+
+    /**
+     * @fn Quantile
+     * the cell is found by the guide table in O(1) expected time,
+     * then interpolated cdf is inverted by safeguarded Newton's method
+     * @param p
+     * @return such x that F(x) = p
+     */
+    RealType Quantile(double p) const;
+
+private:
+    /**
+     * @fn setRange
+     * choose [a, b] by quantiles of the summands with the union bound
+     * @param summands
+     * @param epsilon
+     */
+    void setRange(const std::vector<const UnivariateDistribution<RealType> *> &summands, double epsilon);
+
+    /**
+     * @fn tabulate
+     * calculate coefficients of the series and sum them up on the grid
+     * @param summands
+     * @param epsilon
+     */
+    void tabulate(const std::vector<const UnivariateDistribution<RealType> *> &summands, double epsilon);
+
+    /**
+     * @fn sumSeries
+     * fill the tables by the series on the uniform grid
+     * @param coefs A_k
+     * @param gridSize number of cells
+     */
+    void sumSeries(const std::vector<double> &coefs, size_t gridSize);
+
+    /**
+     * @fn buildGuideTable
+     * find the cell for each of the probabilities i / (number of cells)
+     */
+    void buildGuideTable();
+
+    /**
+     * @fn locate
+     * @param x
+     * @param index of the node on the left of x
+     * @param h relative position of x in the cell
+     * @return false if x is outside of [a, b]
+     */
+    bool locate(double x, size_t &index, double &h) const;
+
+    /**
+     * @fn slope
+     * @param index
+     * @return step * f'(a + index * step), estimated by central differences of the fourth order
+     */
+    double slope(size_t index) const;
+};
+
+#endif // CFINVERSION_H
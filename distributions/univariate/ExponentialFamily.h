@@ -13,7 +13,9 @@ public:
     virtual P SufficientStatistic(T x) const = 0;
     virtual P SourceParameters() const = 0;
     virtual P SourceToNatural(P sourceParameters) const = 0;
+    virtual P NaturalToSource(P theta) const = 0;
     virtual P NaturalParameters() const;
+    virtual void SetSourceParameters(P sourceParameters) = 0;
 
     virtual double LogNormalizer(P theta) const = 0;
     virtual P LogNormalizerGradient(P theta) const = 0;
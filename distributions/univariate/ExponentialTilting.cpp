@@ -0,0 +1,301 @@
+#include "ExponentialTilting.h"
+
+/// default directions of tilting, such that d·t(x) is monotone in x
+template < class Distribution >
+static double defaultTiltDirection(const Distribution &)
+{
+    return 1.0;
+}
+
+template < typename RealType >
+static DoublePair defaultTiltDirection(const NormalRand<RealType> &)
+{
+    return {1.0, 0.0};
+}
+
+template < typename RealType >
+static DoublePair defaultTiltDirection(const GammaRand<RealType> &)
+{
+    return {0.0, 1.0};
+}
+
+template < typename RealType >
+static DoublePair defaultTiltDirection(const BetaRand<RealType> &)
+{
+    return {1.0, -1.0};
+}
+
+static double tiltStep(double direction, double eta)
+{
+    return eta * direction;
+}
+
+static DoublePair tiltStep(const DoublePair &direction, double eta)
+{
+    return {eta * direction.first, eta * direction.second};
+}
+
+template < class Distribution >
+ExponentialTilting<Distribution>::ExponentialTilting(const Distribution &distribution)
+    : ExponentialTilting(distribution, defaultTiltDirection(distribution))
+{
+}
+
+template < class Distribution >
+ExponentialTilting<Distribution>::ExponentialTilting(const Distribution &distribution, P tiltDirection)
+    : target(distribution), proposal(distribution), direction(tiltDirection)
+{
+    if (direction * direction == 0.0)
+        throw std::invalid_argument("Exponential tilting: direction should be non-zero");
+    theta = target.NaturalParameters();
+    logNormalizer = target.LogNormalizer(theta);
+}
+
+template < class Distribution >
+void ExponentialTilting<Distribution>::SetTilt(double eta)
+{
+    P thetaTilted = theta + tiltStep(direction, eta);
+    double logNormalizerTilted = target.LogNormalizer(thetaTilted);
+    if (!std::isfinite(logNormalizerTilted))
+        throw std::invalid_argument("Exponential tilting: tilt " + std::to_string(eta) + " leads out of natural parameter space");
+    proposal.SetSourceParameters(target.NaturalToSource(thetaTilted));
+    tilt = eta;
+    logNormalizerShift = logNormalizerTilted - logNormalizer;
+}
+
+template < class Distribution >
+void ExponentialTilting<Distribution>::SetThreshold(T threshold)
+{
+    double statistic = direction * target.SufficientStatistic(threshold);
+    SetTilt(solveTilt(statistic));
+}
+
+template < class Distribution >
+double ExponentialTilting<Distribution>::solveTilt(double statistic) const
+{
+    if (!std::isfinite(statistic))
+        throw std::invalid_argument("Exponential tilting: statistic should be finite");
+    /// gap between mean of d·t(X) under tilted distribution and the statistic,
+    /// which increases in η, as its derivative is variance of d·t(X);
+    /// NaN is returned if η leads out of natural parameter space
+    Distribution trial = target;
+    auto gap = [this, &trial, statistic] (double eta) -> double {
+        P thetaTilted = theta + tiltStep(direction, eta);
+        try {
+            trial.SetSourceParameters(target.NaturalToSource(thetaTilted));
+        } catch (std::invalid_argument &) {
+            return NAN;
+        }
+        if (!std::isfinite(target.LogNormalizer(thetaTilted)))
+            return NAN;
+        double g = direction * target.LogNormalizerGradient(thetaTilted) - statistic;
+        return std::isfinite(g) ? g : NAN;
+    };
+
+    double gapLower = gap(0);
+    if (gapLower == 0.0)
+        return 0.0;
+    /// bracket the root, doubling the step while the gap keeps its sign
+    /// and halving it when the natural parameter space is left
+    double sign = (gapLower < 0) ? 1.0 : -1.0;
+    double lower = 0, upper = 0, step = 1.0;
+    bool isBracketed = false;
+    static constexpr int MAX_ITER = 4096;
+    for (int iter = 0; iter < MAX_ITER && !isBracketed; ++iter) {
+        double eta = lower + sign * step;
+        double g = gap(eta);
+        if (std::isnan(g)) {
+            step *= 0.5;
+            if (step <= MIN_POSITIVE * (1.0 + std::fabs(lower)))
+                break;
+        }
+        else if (sign * g < 0) {
+            lower = eta;
+            step *= 2;
+            if (!std::isfinite(lower + sign * step))
+                break;
+        }
+        else {
+            upper = eta;
+            isBracketed = true;
+        }
+    }
+    if (!isBracketed)
+        throw std::invalid_argument("Exponential tilting: statistic " + std::to_string(statistic) + " can't be reached by the family");
+
+    /// bisection
+    for (int iter = 0; iter < MAX_ITER; ++iter) {
+        double eta = 0.5 * (lower + upper);
+        if (eta == lower || eta == upper)
+            break;
+        double g = gap(eta);
+        if (g == 0.0)
+            return eta;
+        if (sign * g < 0)
+            lower = eta;
+        else
+            upper = eta;
+    }
+    return 0.5 * (lower + upper);
+}
+
+template < class Distribution >
+double ExponentialTilting<Distribution>::LogWeight(const T &x) const
+{
+    double statistic = direction * target.SufficientStatistic(x);
+    return logNormalizerShift - tilt * statistic;
+}
+
+template < class Distribution >
+void ExponentialTilting<Distribution>::Sample(std::vector<T> &outputData, std::vector<double> &weights) const
+{
+    proposal.Sample(outputData);
+    size_t size = outputData.size();
+    weights.resize(size);
+    if (size == 0)
+        return;
+    double maxLogWeight = -INFINITY;
+    for (size_t i = 0; i != size; ++i) {
+        weights[i] = LogWeight(outputData[i]);
+        maxLogWeight = std::max(maxLogWeight, weights[i]);
+    }
+    long double sum = 0.0;
+    for (double &weight : weights) {
+        weight = std::exp(weight - maxLogWeight);
+        sum += weight;
+    }
+    for (double &weight : weights)
+        weight /= sum;
+}
+
+template < class Distribution >
+ImportanceSamplingEstimate ExponentialTilting<Distribution>::summarize(const std::vector<double> &logWeights, const std::vector<double> &values)
+{
+    size_t size = logWeights.size();
+    double maxLogWeight = *std::max_element(logWeights.begin(), logWeights.end());
+    /// all sums are scaled by exp(-max log(w_i)) in order to avoid overflow and underflow
+    long double weightSum = 0, weightSqSum = 0, sum = 0, sqSum = 0;
+    for (size_t i = 0; i != size; ++i) {
+        long double weight = std::exp(logWeights[i] - maxLogWeight);
+        long double y = weight * values[i];
+        weightSum += weight;
+        weightSqSum += weight * weight;
+        sum += y;
+        sqSum += y * y;
+    }
+    ImportanceSamplingEstimate estimate;
+    long double mean = sum / size;
+    long double variance = (sqSum - sum * mean) / (size - 1);
+    long double meanDeviation = std::sqrt(std::max(variance, 0.0l) / size);
+    double scale = std::exp(maxLogWeight);
+    estimate.value = scale * mean;
+    estimate.logValue = maxLogWeight + std::log(mean);
+    estimate.standardError = scale * meanDeviation;
+    estimate.relativeError = meanDeviation / mean;
+    estimate.selfNormalizedValue = sum / weightSum;
+    estimate.meanWeight = scale * weightSum / size;
+    estimate.effectiveSampleSize = weightSum * weightSum / weightSqSum;
+    estimate.maxWeightShare = 1.0 / weightSum;
+    return estimate;
+}
+
+template < class Distribution >
+ImportanceSamplingEstimate ExponentialTilting<Distribution>::Estimate(const std::function<double (T)> &funPtr, size_t sampleSize) const
+{
+    if (sampleSize < 2)
+        throw std::invalid_argument("Exponential tilting: sample size should be at least 2");
+    std::vector<T> sample(sampleSize);
+    proposal.Sample(sample);
+    std::vector<double> logWeights(sampleSize), values(sampleSize);
+    for (size_t i = 0; i != sampleSize; ++i) {
+        logWeights[i] = LogWeight(sample[i]);
+        values[i] = funPtr(sample[i]);
+    }
+    return summarize(logWeights, values);
+}
+
+template < class Distribution >
+ImportanceSamplingEstimate ExponentialTilting<Distribution>::TailProbability(T threshold, size_t sampleSize, bool isRightTail) const
+{
+    if (isRightTail)
+        return Estimate([threshold] (T x) { return (x >= threshold) ? 1.0 : 0.0; }, sampleSize);
+    return Estimate([threshold] (T x) { return (x <= threshold) ? 1.0 : 0.0; }, sampleSize);
+}
+
+template < class Distribution >
+size_t ExponentialTilting<Distribution>::CrossEntropy(const std::function<double (T)> &score, double level, size_t sampleSize, double rarity, size_t maxIterations)
+{
+    if (rarity <= 0 || rarity >= 1)
+        throw std::invalid_argument("Exponential tilting: rarity should be in (0, 1), but it's equal to " + std::to_string(rarity));
+    size_t eliteSize = std::ceil(rarity * sampleSize);
+    if (eliteSize < 2 || eliteSize >= sampleSize)
+        throw std::invalid_argument("Exponential tilting: sample size is too small for given rarity");
+    std::vector<T> sample(sampleSize);
+    std::vector<double> scores(sampleSize), sortedScores(sampleSize);
+    for (size_t iter = 1; iter <= maxIterations; ++iter) {
+        proposal.Sample(sample);
+        for (size_t i = 0; i != sampleSize; ++i)
+            scores[i] = score(sample[i]);
+        /// current level is (1 - ρ)-quantile of scores, but not above the target one
+        sortedScores = scores;
+        auto quantileIt = sortedScores.begin() + (sampleSize - eliteSize);
+        std::nth_element(sortedScores.begin(), quantileIt, sortedScores.end());
+        double currentLevel = std::min(*quantileIt, level);
+
+        /// weighted mean of d·t(x) over the elite
+        double maxLogWeight = -INFINITY;
+        std::vector<double> logWeights, statistics;
+        logWeights.reserve(eliteSize);
+        statistics.reserve(eliteSize);
+        for (size_t i = 0; i != sampleSize; ++i) {
+            if (scores[i] >= currentLevel) {
+                logWeights.push_back(LogWeight(sample[i]));
+                statistics.push_back(direction * target.SufficientStatistic(sample[i]));
+                maxLogWeight = std::max(maxLogWeight, logWeights.back());
+            }
+        }
+        long double weightSum = 0, statisticSum = 0;
+        for (size_t i = 0; i != logWeights.size(); ++i) {
+            long double weight = std::exp(logWeights[i] - maxLogWeight);
+            weightSum += weight;
+            statisticSum += weight * statistics[i];
+        }
+        if (!std::isfinite(maxLogWeight) || weightSum == 0)
+            throw std::runtime_error("Exponential tilting: elite sample has zero weight");
+        SetTilt(solveTilt(statisticSum / weightSum));
+        if (currentLevel >= level)
+            return iter;
+    }
+    return maxIterations;
+}
+
+template < class Distribution >
+void ExponentialTilting<Distribution>::Reseed(unsigned long seed) const
+{
+    proposal.Reseed(seed);
+}
+
+
+template class ExponentialTilting<NormalRand<float>>;
+template class ExponentialTilting<NormalRand<double>>;
+template class ExponentialTilting<NormalRand<long double>>;
+
+template class ExponentialTilting<ExponentialRand<float>>;
+template class ExponentialTilting<ExponentialRand<double>>;
+template class ExponentialTilting<ExponentialRand<long double>>;
+
+template class ExponentialTilting<GammaRand<float>>;
+template class ExponentialTilting<GammaRand<double>>;
+template class ExponentialTilting<GammaRand<long double>>;
+
+template class ExponentialTilting<BetaRand<float>>;
+template class ExponentialTilting<BetaRand<double>>;
+template class ExponentialTilting<BetaRand<long double>>;
+
+template class ExponentialTilting<PoissonRand<int>>;
+template class ExponentialTilting<PoissonRand<long int>>;
+template class ExponentialTilting<PoissonRand<long long int>>;
+
+template class ExponentialTilting<BinomialRand<int>>;
+template class ExponentialTilting<BinomialRand<long int>>;
+template class ExponentialTilting<BinomialRand<long long int>>;
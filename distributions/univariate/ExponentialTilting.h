@@ -0,0 +1,142 @@
+#ifndef EXPONENTIALTILTING_H
+#define EXPONENTIALTILTING_H
+
+#include "continuous/NormalRand.h"
+#include "continuous/ExponentialRand.h"
+#include "continuous/GammaRand.h"
+#include "continuous/BetaRand.h"
+#include "discrete/PoissonRand.h"
+#include "discrete/BinomialRand.h"
+
+#include <functional>
+
+/**
+ * @brief The ImportanceSamplingEstimate struct <BR>
+ * Estimate of E[h(X)] by importance sampling together with diagnostics of the weights
+ */
+struct RANDLIBSHARED_EXPORT ImportanceSamplingEstimate
+{
+    double value = 0; ///< (1/n) Σ w_i h(x_i), unbiased as both normalizers are known
+    double logValue = -INFINITY; ///< log(value) for non-negative h, which doesn't underflow for rare events
+    double standardError = 0; ///< standard deviation of value
+    double relativeError = 0; ///< standardError / value
+    double selfNormalizedValue = 0; ///< Σ w_i h(x_i) / Σ w_i
+    double meanWeight = 0; ///< (1/n) Σ w_i, which should be close to 1
+    double effectiveSampleSize = 0; ///< (Σ w_i)^2 / Σ w_i^2
+    double maxWeightShare = 0; ///< max(w_i) / Σ w_i
+};
+
+/**
+ * @brief The ExponentialTilting class <BR>
+ * Importance sampling for the exponential family with proposal from the same family
+ *
+ * q(x) = p(x) exp(η d·t(x) - A(θ + η d) + A(θ)),
+ * where θ are natural parameters of target p, t(x) is sufficient statistic, d is direction of tilting and η is tilt.
+ * Weight w(x) = p(x) / q(x) depends only on t(x), therefore no density is evaluated during sampling.
+ * By default d·t(x) is monotone in x: d = 1 for one-parameter families,
+ * (1, 0) for normal, (0, 1) for gamma and (1, -1) for beta distribution
+ */
+template < class Distribution >
+class RANDLIBSHARED_EXPORT ExponentialTilting
+{
+    typedef decltype(std::declval<Distribution>().Variate()) T;
+    typedef decltype(std::declval<Distribution>().NaturalParameters()) P;
+
+    Distribution target; ///< p
+    Distribution proposal; ///< q
+    P theta{}; ///< natural parameters of p
+    P direction{}; ///< d
+    double logNormalizer = 0; ///< A(θ)
+    double tilt = 0; ///< η
+    double logNormalizerShift = 0; ///< A(θ + η d) - A(θ)
+
+public:
+    explicit ExponentialTilting(const Distribution &distribution);
+    ExponentialTilting(const Distribution &distribution, P tiltDirection);
+
+    /**
+     * @fn SetTilt
+     * set proposal with natural parameters θ + η d
+     * @param eta η
+     */
+    void SetTilt(double eta);
+    /**
+     * @fn SetThreshold
+     * set tilt, which solves ∇A(θ + η d)·d = d·t(threshold),
+     * i.e. the proposal is centered at the threshold in terms of statistic d·t(x)
+     * @param threshold
+     */
+    void SetThreshold(T threshold);
+
+    inline double GetTilt() const { return tilt; }
+    inline P GetDirection() const { return direction; }
+    inline const Distribution &GetTarget() const { return target; }
+    inline const Distribution &GetProposal() const { return proposal; }
+
+    /**
+     * @fn LogWeight
+     * @param x
+     * @return log(p(x) / q(x)) = -η d·t(x) + A(θ + η d) - A(θ)
+     */
+    double LogWeight(const T &x) const;
+
+    /**
+     * @fn Sample
+     * fill outputData with variates from proposal and weights with their self-normalised importance weights
+     * @param outputData
+     * @param weights
+     */
+    void Sample(std::vector<T> &outputData, std::vector<double> &weights) const;
+
+    /**
+     * @fn Estimate
+     * @param funPtr h
+     * @param sampleSize n
+     * @return estimate of E[h(X)] for X ~ p
+     */
+    ImportanceSamplingEstimate Estimate(const std::function<double (T)> &funPtr, size_t sampleSize) const;
+
+    /**
+     * @fn TailProbability
+     * @param threshold
+     * @param sampleSize n
+     * @param isRightTail
+     * @return estimate of P(X ≥ threshold) if isRightTail is true and of P(X ≤ threshold) otherwise
+     */
+    ImportanceSamplingEstimate TailProbability(T threshold, size_t sampleSize, bool isRightTail = true) const;
+
+    /**
+     * @fn CrossEntropy
+     * adapt tilt for event {score(X) ≥ level} by multilevel cross-entropy method:
+     * on each iteration level is raised to (1 - ρ)-quantile of scores and the tilt is set to
+     * weighted maximum-likelihood estimator of the elite, which matches ∇A(θ + η d)·d to weighted mean of d·t(x).
+     * Score should be monotone in d·t(x) for the tilted family to approach zero-variance proposal
+     * @param score
+     * @param level
+     * @param sampleSize number of variates per iteration
+     * @param rarity ρ
+     * @param maxIterations
+     * @return number of iterations
+     */
+    size_t CrossEntropy(const std::function<double (T)> &score, double level, size_t sampleSize, double rarity = 0.1, size_t maxIterations = 100);
+
+    void Reseed(unsigned long seed) const;
+
+private:
+    /**
+     * @fn solveTilt
+     * @param statistic
+     * @return such η that ∇A(θ + η d)·d = statistic
+     */
+    double solveTilt(double statistic) const;
+
+    /**
+     * @fn summarize
+     * @param logWeights log(w_i)
+     * @param values h(x_i)
+     * @return estimate of E[h(X)] and diagnostics
+     */
+    static ImportanceSamplingEstimate summarize(const std::vector<double> &logWeights, const std::vector<double> &values);
+};
+
+#endif // EXPONENTIALTILTING_H
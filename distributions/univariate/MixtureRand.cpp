@@ -0,0 +1,533 @@
+#include "MixtureRand.h"
+#include "continuous/UniformRand.h"
+#include "discrete/BinomialRand.h"
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+template < typename RealType >
+void MixtureDensity<RealType, true>::ProbabilityDensityFunction(const std::vector<RealType> &x, std::vector<double> &y) const
+{
+    mixtureLogDensityFunction(x, y);
+    for (size_t i = 0; i != x.size(); ++i)
+        y[i] = std::exp(y[i]);
+}
+
+template < typename IntType >
+void MixtureDensity<IntType, false>::ProbabilityMassFunction(const std::vector<IntType> &x, std::vector<double> &y) const
+{
+    mixtureLogDensityFunction(x, y);
+    for (size_t i = 0; i != x.size(); ++i)
+        y[i] = std::exp(y[i]);
+}
+
+template class MixtureDensity<float>;
+template class MixtureDensity<double>;
+template class MixtureDensity<long double>;
+
+template class MixtureDensity<int>;
+template class MixtureDensity<long int>;
+template class MixtureDensity<long long int>;
+
+template < typename T >
+String MixtureDistribution<T>::Name() const
+{
+    String name = "Mixture(";
+    for (size_t k = 0; k != weights.size(); ++k) {
+        if (k != 0)
+            name += ", ";
+        name += this->toStringWithPrecision(weights[k]) + " * " + component(k).Name();
+    }
+    return name + ")";
+}
+
+template < typename T >
+SUPPORT_TYPE MixtureDistribution<T>::SupportType() const
+{
+    bool leftBounded = true, rightBounded = true;
+    for (size_t k = 0; k != weights.size(); ++k) {
+        leftBounded = leftBounded && component(k).isLeftBounded();
+        rightBounded = rightBounded && component(k).isRightBounded();
+    }
+    if (leftBounded)
+        return rightBounded ? FINITE_T : RIGHTSEMIFINITE_T;
+    return rightBounded ? LEFTSEMIFINITE_T : INFINITE_T;
+}
+
+template < typename T >
+T MixtureDistribution<T>::MinValue() const
+{
+    T minValue = component(0).MinValue();
+    for (size_t k = 1; k < weights.size(); ++k)
+        minValue = std::min(minValue, component(k).MinValue());
+    return minValue;
+}
+
+template < typename T >
+T MixtureDistribution<T>::MaxValue() const
+{
+    T maxValue = component(0).MaxValue();
+    for (size_t k = 1; k < weights.size(); ++k)
+        maxValue = std::max(maxValue, component(k).MaxValue());
+    return maxValue;
+}
+
+template < typename T >
+void MixtureDistribution<T>::setWeights(std::vector<double> &&newWeights, size_t numberOfComponents)
+{
+    if (newWeights.size() != numberOfComponents)
+        throw std::invalid_argument("Mixture distribution: number of weights should be equal to the number of components "
+                                    + std::to_string(numberOfComponents) + ", but it's equal to " + std::to_string(newWeights.size()));
+    double sum = 0.0;
+    for (double weight : newWeights) {
+        if (weight < 0.0 || !std::isfinite(weight))
+            throw std::invalid_argument("Mixture distribution: weights should be non-negative and finite");
+        sum += weight;
+    }
+    if (sum <= 0.0)
+        throw std::invalid_argument("Mixture distribution: sum of weights should be positive");
+
+    weights = std::move(newWeights);
+    size_t K = weights.size();
+    logWeights.resize(K);
+    for (size_t k = 0; k != K; ++k) {
+        weights[k] /= sum;
+        logWeights[k] = std::log(weights[k]);
+    }
+
+    /// Vose's construction of alias table
+    aliasProbability.resize(K);
+    alias.resize(K);
+    std::vector<size_t> small, large;
+    for (size_t k = 0; k != K; ++k) {
+        aliasProbability[k] = weights[k] * K;
+        alias[k] = k;
+        (aliasProbability[k] < 1.0 ? small : large).push_back(k);
+    }
+    while (!small.empty() && !large.empty()) {
+        size_t less = small.back(), more = large.back();
+        small.pop_back();
+        alias[less] = more;
+        aliasProbability[more] -= 1.0 - aliasProbability[less];
+        if (aliasProbability[more] < 1.0) {
+            large.pop_back();
+            small.push_back(more);
+        }
+    }
+    /// the rest are equal to 1 up to rounding errors
+    for (size_t k : small)
+        aliasProbability[k] = 1.0;
+    for (size_t k : large)
+        aliasProbability[k] = 1.0;
+}
+
+template < typename T >
+void MixtureDistribution<T>::SetWeights(std::vector<double> &&newWeights)
+{
+    setWeights(std::move(newWeights), weights.size());
+}
+
+template < typename T >
+void MixtureDistribution<T>::BuildCaches() const
+{
+    for (size_t k = 0; k != weights.size(); ++k)
+        component(k).BuildCaches();
+    MixtureDensity<T>::BuildCaches();
+}
+
+template < typename T >
+size_t MixtureDistribution<T>::workerCount(size_t size) const
+{
+    size_t threads = (numberOfThreads == 0) ? std::thread::hardware_concurrency() : numberOfThreads;
+    size_t numberOfBlocks = (size + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    return std::max<size_t>(1, std::min(threads, numberOfBlocks));
+}
+
+template < typename T >
+void MixtureDistribution<T>::runInBlocks(size_t size, size_t workers, const std::function<void (size_t, size_t, size_t)> &task) const
+{
+    if (workers <= 1) {
+        for (size_t begin = 0; begin < size; begin += BLOCK_SIZE)
+            task(begin, std::min(begin + BLOCK_SIZE, size), 0);
+        return;
+    }
+
+    /// some components build their tables on demand in const methods, which is not thread-safe
+    for (size_t k = 0; k != weights.size(); ++k) {
+        if (weights[k] > 0.0)
+            component(k).BuildCaches();
+    }
+    std::atomic<size_t> nextBlock(0);
+    std::exception_ptr error = nullptr;
+    std::mutex errorMutex;
+    auto worker = [&] (size_t thread)
+    {
+        try {
+            for (size_t begin = BLOCK_SIZE * nextBlock++; begin < size; begin = BLOCK_SIZE * nextBlock++)
+                task(begin, std::min(begin + BLOCK_SIZE, size), thread);
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (error == nullptr)
+                error = std::current_exception();
+            nextBlock = size;
+        }
+    };
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (size_t thread = 1; thread < workers; ++thread)
+        pool.emplace_back(worker, thread);
+    worker(0);
+    for (std::thread & thread : pool)
+        thread.join();
+    if (error != nullptr)
+        std::rethrow_exception(error);
+}
+
+template < typename T >
+void MixtureDistribution<T>::weightedLogDensities(const std::vector<T> &x, std::vector<std::vector<double>> &logDensities, std::vector<double> &maximum) const
+{
+    size_t size = x.size(), K = weights.size();
+    logDensities.resize(K);
+    maximum.assign(size, -INFINITY);
+    for (size_t k = 0; k != K; ++k) {
+        std::vector<double> &logDensity = logDensities[k];
+        logDensity.resize(size);
+        if (weights[k] == 0.0) {
+            std::fill(logDensity.begin(), logDensity.end(), -INFINITY);
+            continue;
+        }
+        this->componentLogDensityFunction(component(k), x, logDensity);
+        double logWeight = logWeights[k];
+        for (size_t i = 0; i != size; ++i) {
+            logDensity[i] += logWeight;
+            maximum[i] = std::max(maximum[i], logDensity[i]);
+        }
+    }
+}
+
+template < typename T >
+double MixtureDistribution<T>::mixtureLogDensity(const T &x) const
+{
+    double maxValue = -INFINITY;
+    std::vector<double> values(weights.size(), -INFINITY);
+    for (size_t k = 0; k != weights.size(); ++k) {
+        if (weights[k] == 0.0)
+            continue;
+        values[k] = this->componentLogDensity(component(k), x) + logWeights[k];
+        maxValue = std::max(maxValue, values[k]);
+    }
+    if (!std::isfinite(maxValue))
+        return maxValue;
+    double sum = 0.0;
+    for (double value : values)
+        sum += std::exp(value - maxValue);
+    return maxValue + std::log(sum);
+}
+
+template < typename T >
+void MixtureDistribution<T>::mixtureLogDensityFunction(const std::vector<T> &x, std::vector<double> &y) const
+{
+    size_t size = x.size();
+    if (size > y.size())
+        return;
+    /// log-sum-exp in two passes: maximum over the components, then the sum of exponents relative to it
+    size_t workers = workerCount(size);
+    std::vector<std::vector<T>> blocks(workers);
+    std::vector<std::vector<std::vector<double>>> buffers(workers);
+    std::vector<std::vector<double>> maxima(workers), sums(workers);
+    runInBlocks(size, workers, [&] (size_t begin, size_t end, size_t thread)
+    {
+        std::vector<T> &block = blocks[thread];
+        std::vector<std::vector<double>> &logDensities = buffers[thread];
+        std::vector<double> &maximum = maxima[thread], &sum = sums[thread];
+        size_t blockSize = end - begin;
+        block.assign(x.begin() + begin, x.begin() + end);
+        weightedLogDensities(block, logDensities, maximum);
+        sum.assign(blockSize, 0.0);
+        for (const std::vector<double> &logDensity : logDensities) {
+            for (size_t i = 0; i != blockSize; ++i)
+                sum[i] += std::exp(logDensity[i] - maximum[i]);
+        }
+        for (size_t i = 0; i != blockSize; ++i)
+            y[begin + i] = std::isfinite(maximum[i]) ? maximum[i] + std::log(sum[i]) : maximum[i];
+    });
+}
+
+template < typename T >
+double MixtureDistribution<T>::expectation(const std::vector<T> &sample, double center, bool logarithm, std::vector<ComponentStatistic> &statistics) const
+{
+    size_t size = sample.size(), K = weights.size();
+    size_t workers = workerCount(size);
+    std::vector<std::vector<ComponentStatistic>> threadStatistics(workers, std::vector<ComponentStatistic>(K));
+    std::vector<long double> threadLogLikelihood(workers, 0.0);
+    std::vector<std::vector<T>> blocks(workers);
+    std::vector<std::vector<std::vector<double>>> buffers(workers);
+    std::vector<std::vector<double>> maxima(workers), sums(workers);
+
+    runInBlocks(size, workers, [&] (size_t begin, size_t end, size_t thread)
+    {
+        std::vector<T> &block = blocks[thread];
+        std::vector<std::vector<double>> &logDensities = buffers[thread];
+        std::vector<double> &maximum = maxima[thread], &sum = sums[thread];
+        size_t blockSize = end - begin;
+        block.assign(sample.begin() + begin, sample.begin() + end);
+        weightedLogDensities(block, logDensities, maximum);
+        sum.assign(blockSize, 0.0);
+        for (size_t k = 0; k != K; ++k) {
+            std::vector<double> &logDensity = logDensities[k];
+            for (size_t i = 0; i != blockSize; ++i) {
+                logDensity[i] = std::isfinite(maximum[i]) ? std::exp(logDensity[i] - maximum[i]) : 1.0;
+                sum[i] += logDensity[i];
+            }
+        }
+
+        /// responsibilities r_ik = w_k f_k(x_i) / f(x_i) and their weighted sums
+        long double logLikelihood = 0.0;
+        for (size_t i = 0; i != blockSize; ++i) {
+            logLikelihood += maximum[i] + std::log(sum[i]);
+            sum[i] = 1.0 / sum[i];
+        }
+        threadLogLikelihood[thread] += logLikelihood;
+        for (size_t k = 0; k != K; ++k) {
+            const std::vector<double> &responsibility = logDensities[k];
+            double weight = 0.0, sumX = 0.0, sumSq = 0.0, sumLog = 0.0;
+            for (size_t i = 0; i != blockSize; ++i) {
+                double r = responsibility[i] * sum[i];
+                double y = block[i] - center;
+                weight += r;
+                sumX += r * y;
+                sumSq += r * y * y;
+            }
+            if (logarithm) {
+                for (size_t i = 0; i != blockSize; ++i)
+                    sumLog += responsibility[i] * sum[i] * std::log(block[i]);
+            }
+            ComponentStatistic &statistic = threadStatistics[thread][k];
+            statistic.weight += weight;
+            statistic.sum += sumX;
+            statistic.squareSum += sumSq;
+            statistic.logSum += sumLog;
+        }
+    });
+
+    statistics.assign(K, ComponentStatistic());
+    long double logLikelihood = 0.0;
+    for (size_t thread = 0; thread != workers; ++thread) {
+        logLikelihood += threadLogLikelihood[thread];
+        for (size_t k = 0; k != K; ++k) {
+            const ComponentStatistic &statistic = threadStatistics[thread][k];
+            statistics[k].weight += statistic.weight;
+            statistics[k].sum += statistic.sum;
+            statistics[k].squareSum += statistic.squareSum;
+            statistics[k].logSum += statistic.logSum;
+        }
+    }
+    return logLikelihood;
+}
+
+template < typename T >
+double MixtureDistribution<T>::F(const T & x) const
+{
+    double y = 0.0;
+    for (size_t k = 0; k != weights.size(); ++k)
+        y += weights[k] * component(k).F(x);
+    return std::min(y, 1.0);
+}
+
+template < typename T >
+double MixtureDistribution<T>::S(const T & x) const
+{
+    double y = 0.0;
+    for (size_t k = 0; k != weights.size(); ++k)
+        y += weights[k] * component(k).S(x);
+    return std::min(y, 1.0);
+}
+
+template < typename T >
+void MixtureDistribution<T>::cdfFunction(const std::vector<T> &x, std::vector<double> &y, bool isRightTail) const
+{
+    size_t size = x.size();
+    if (size > y.size())
+        return;
+    std::fill(y.begin(), y.begin() + size, 0.0);
+    std::vector<double> buffer(size);
+    for (size_t k = 0; k != weights.size(); ++k) {
+        if (isRightTail)
+            component(k).SurvivalFunction(x, buffer);
+        else
+            component(k).CumulativeDistributionFunction(x, buffer);
+        for (size_t i = 0; i != size; ++i)
+            y[i] += weights[k] * buffer[i];
+    }
+    for (size_t i = 0; i != size; ++i)
+        y[i] = std::min(y[i], 1.0);
+}
+
+template < typename T >
+void MixtureDistribution<T>::CumulativeDistributionFunction(const std::vector<T> &x, std::vector<double> &y) const
+{
+    cdfFunction(x, y, false);
+}
+
+template < typename T >
+void MixtureDistribution<T>::SurvivalFunction(const std::vector<T> &x, std::vector<double> &y) const
+{
+    cdfFunction(x, y, true);
+}
+
+template < typename T >
+size_t MixtureDistribution<T>::ComponentIndex() const
+{
+    size_t K = weights.size();
+    double u = K * UniformRand<double>::StandardVariateHalfClosed(this->localRandGenerator);
+    size_t cell = std::min(static_cast<size_t>(u), K - 1);
+    return (u - cell < aliasProbability[cell]) ? cell : alias[cell];
+}
+
+template < typename T >
+T MixtureDistribution<T>::Variate() const
+{
+    return component(ComponentIndex()).Variate();
+}
+
+template < typename T >
+void MixtureDistribution<T>::Sample(std::vector<T> &outputData) const
+{
+    /// numbers of variates of each component by the chain of binomial variates
+    size_t size = outputData.size(), K = weights.size();
+    size_t remaining = size, offset = 0;
+    double restWeight = 1.0;
+    std::vector<T> buffer;
+    for (size_t k = 0; k != K && remaining != 0; ++k) {
+        size_t count = remaining;
+        if (k + 1 != K) {
+            double probability = weights[k] / restWeight;
+            if (probability <= 0.0)
+                count = 0;
+            else if (probability < 1.0)
+                count = BinomialRand<long long int>::Variate(remaining, probability, this->localRandGenerator);
+            restWeight -= weights[k];
+        }
+        if (count == 0)
+            continue;
+        buffer.resize(count);
+        component(k).Sample(buffer);
+        std::copy(buffer.begin(), buffer.end(), outputData.begin() + offset);
+        offset += count;
+        remaining -= count;
+    }
+
+    if (!shuffled)
+        return;
+    /// Fisher-Yates shuffle
+    for (size_t i = size; i > 1; --i) {
+        size_t j = std::min(static_cast<size_t>(i * UniformRand<double>::StandardVariateHalfClosed(this->localRandGenerator)), i - 1);
+        std::swap(outputData[i - 1], outputData[j]);
+    }
+}
+
+template < typename T >
+void MixtureDistribution<T>::Reseed(unsigned long seed) const
+{
+    this->localRandGenerator.Reseed(seed);
+    for (size_t k = 0; k != weights.size(); ++k)
+        component(k).Reseed(seed + k + 1);
+}
+
+template < typename T >
+long double MixtureDistribution<T>::Mean() const
+{
+    long double mean = 0.0;
+    for (size_t k = 0; k != weights.size(); ++k)
+        mean += weights[k] * component(k).Mean();
+    return mean;
+}
+
+template < typename T >
+std::array<long double, 3> MixtureDistribution<T>::centralMoments() const
+{
+    long double mean = Mean();
+    std::array<long double, 3> moments = {0, 0, 0};
+    for (size_t k = 0; k != weights.size(); ++k) {
+        const Component &distribution = component(k);
+        long double variance = distribution.Variance(), sigma = std::sqrt(variance);
+        long double d = distribution.Mean() - mean, dSq = d * d;
+        long double thirdMoment = (variance > 0) ? distribution.Skewness() * sigma * variance : 0.0;
+        long double fourthMoment = (variance > 0) ? distribution.Kurtosis() * variance * variance : 0.0;
+        moments[0] += weights[k] * (variance + dSq);
+        moments[1] += weights[k] * (thirdMoment + 3 * variance * d + dSq * d);
+        moments[2] += weights[k] * (fourthMoment + 4 * thirdMoment * d + 6 * variance * dSq + dSq * dSq);
+    }
+    return moments;
+}
+
+template < typename T >
+long double MixtureDistribution<T>::Variance() const
+{
+    return centralMoments()[0];
+}
+
+template < typename T >
+long double MixtureDistribution<T>::Skewness() const
+{
+    std::array<long double, 3> moments = centralMoments();
+    return moments[1] / (moments[0] * std::sqrt(moments[0]));
+}
+
+template < typename T >
+long double MixtureDistribution<T>::ExcessKurtosis() const
+{
+    std::array<long double, 3> moments = centralMoments();
+    return moments[2] / (moments[0] * moments[0]) - 3.0;
+}
+
+template < typename T >
+T MixtureDistribution<T>::Mode() const
+{
+    T mode = component(0).Mode();
+    double maxLogDensity = mixtureLogDensity(mode);
+    for (size_t k = 1; k < weights.size(); ++k) {
+        T x = component(k).Mode();
+        double logDensity = mixtureLogDensity(x);
+        if (logDensity > maxLogDensity) {
+            maxLogDensity = logDensity;
+            mode = x;
+        }
+    }
+    return mode;
+}
+
+template < typename T >
+double MixtureDistribution<T>::LikelihoodFunction(const std::vector<T> &sample) const
+{
+    return std::exp(LogLikelihoodFunction(sample));
+}
+
+template < typename T >
+double MixtureDistribution<T>::LogLikelihoodFunction(const std::vector<T> &sample) const
+{
+    std::vector<double> y(sample.size());
+    mixtureLogDensityFunction(sample, y);
+    long double logLikelihood = 0.0;
+    for (double logDensity : y)
+        logLikelihood += logDensity;
+    return logLikelihood;
+}
+
+template < typename T >
+std::complex<double> MixtureDistribution<T>::CFImpl(double t) const
+{
+    std::complex<double> y = 0.0;
+    for (size_t k = 0; k != weights.size(); ++k)
+        y += weights[k] * component(k).CF(t);
+    return y;
+}
+
+template class MixtureDistribution<float>;
+template class MixtureDistribution<double>;
+template class MixtureDistribution<long double>;
+
+template class MixtureDistribution<int>;
+template class MixtureDistribution<long int>;
+template class MixtureDistribution<long long int>;
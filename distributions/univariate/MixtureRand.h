@@ -0,0 +1,477 @@
+#ifndef MIXTURERAND_H
+#define MIXTURERAND_H
+
+#include "continuous/NormalRand.h"
+#include "continuous/GammaRand.h"
+#include "discrete/PoissonRand.h"
+#include <array>
+#include <tuple>
+
+/**
+ * @brief The MixtureDensity class <BR>
+ * Abstract parent class, which connects density of mixture to the continuous or discrete hierarchy
+ */
+template < typename T, bool isContinuous = std::is_floating_point_v<T> >
+class RANDLIBSHARED_EXPORT MixtureDensity;
+
+template < typename RealType >
+class RANDLIBSHARED_EXPORT MixtureDensity<RealType, true> : public ContinuousDistribution<RealType>
+{
+public:
+    typedef ContinuousDistribution<RealType> Component;
+
+protected:
+    MixtureDensity() {}
+    virtual ~MixtureDensity() {}
+
+    static double componentLogDensity(const Component &component, const RealType &x) { return component.logf(x); }
+    static void componentLogDensityFunction(const Component &component, const std::vector<RealType> &x, std::vector<double> &y)
+    {
+        component.LogProbabilityDensityFunction(x, y);
+    }
+
+    /**
+     * @fn mixtureLogDensity
+     * @param x
+     * @return logarithm of density of the mixture
+     */
+    virtual double mixtureLogDensity(const RealType &x) const = 0;
+
+    /**
+     * @fn mixtureLogDensityFunction
+     * fill vector y with logarithm of density of the mixture
+     * @param x
+     * @param y
+     */
+    virtual void mixtureLogDensityFunction(const std::vector<RealType> &x, std::vector<double> &y) const = 0;
+
+public:
+    double f(const RealType & x) const override { return std::exp(mixtureLogDensity(x)); }
+    double logf(const RealType & x) const override { return mixtureLogDensity(x); }
+    void ProbabilityDensityFunction(const std::vector<RealType> &x, std::vector<double> &y) const override;
+    void LogProbabilityDensityFunction(const std::vector<RealType> &x, std::vector<double> &y) const override { mixtureLogDensityFunction(x, y); }
+};
+
+template < typename IntType >
+class RANDLIBSHARED_EXPORT MixtureDensity<IntType, false> : public DiscreteDistribution<IntType>
+{
+public:
+    typedef DiscreteDistribution<IntType> Component;
+
+protected:
+    MixtureDensity() {}
+    virtual ~MixtureDensity() {}
+
+    static double componentLogDensity(const Component &component, const IntType &k) { return component.logP(k); }
+    static void componentLogDensityFunction(const Component &component, const std::vector<IntType> &x, std::vector<double> &y)
+    {
+        component.LogProbabilityMassFunction(x, y);
+    }
+
+    /**
+     * @fn mixtureLogDensity
+     * @param k
+     * @return logarithm of probability of the mixture to get k
+     */
+    virtual double mixtureLogDensity(const IntType &k) const = 0;
+
+    /**
+     * @fn mixtureLogDensityFunction
+     * fill vector y with logarithm of probability mass function of the mixture
+     * @param x
+     * @param y
+     */
+    virtual void mixtureLogDensityFunction(const std::vector<IntType> &x, std::vector<double> &y) const = 0;
+
+public:
+    double P(const IntType & k) const override { return std::exp(mixtureLogDensity(k)); }
+    double logP(const IntType & k) const override { return mixtureLogDensity(k); }
+    void ProbabilityMassFunction(const std::vector<IntType> &x, std::vector<double> &y) const override;
+    void LogProbabilityMassFunction(const std::vector<IntType> &x, std::vector<double> &y) const override { mixtureLogDensityFunction(x, y); }
+};
+
+
+/**
+ * @brief The MixtureDistribution class <BR>
+ * Abstract parent class for finite mixtures
+ *
+ * f(x) = Σ w_k f_k(x), where Σ w_k = 1
+ *
+ * Component of a single variate is chosen by Walker's alias table in O(1).
+ * Sample draws the numbers of variates of each component multinomially, by the chain of binomial variates,
+ * fills contiguous slices by batched Sample of the components and shuffles the result if it's required.
+ * Vector functions are evaluated by blocks: one batched call of each component per block
+ * and two-pass log-sum-exp, blocks are distributed over the threads.
+ */
+template < typename T >
+class RANDLIBSHARED_EXPORT MixtureDistribution : public MixtureDensity<T>
+{
+public:
+    typedef typename MixtureDensity<T>::Component Component;
+
+private:
+    std::vector<double> weights{1.0}; ///< w_k
+    std::vector<double> logWeights{0.0}; ///< log(w_k)
+    std::vector<double> aliasProbability{1.0}; ///< probability to keep the cell in alias method
+    std::vector<size_t> alias{0}; ///< alternative component of the cell
+    bool shuffled = true; ///< true if Sample should shuffle the variates of different components
+    size_t numberOfThreads = 1; ///< number of threads for vector functions and fitting, 0 for all hardware threads
+
+protected:
+    static constexpr size_t BLOCK_SIZE = 1024; ///< number of elements, which are processed by one batched call
+
+    /**
+     * @brief The ComponentStatistic struct
+     * sums over the sample, weighted by responsibilities of the component
+     */
+    struct ComponentStatistic {
+        long double weight = 0; ///< Σ r_i
+        long double sum = 0; ///< Σ r_i (x_i - c)
+        long double squareSum = 0; ///< Σ r_i (x_i - c)^2
+        long double logSum = 0; ///< Σ r_i log(x_i)
+    };
+
+    MixtureDistribution() {}
+    virtual ~MixtureDistribution() {}
+
+    /**
+     * @fn component
+     * @param index
+     * @return index-th component
+     */
+    virtual const Component &component(size_t index) const = 0;
+
+    /**
+     * @fn setWeights
+     * normalize weights and build the alias table
+     * @param newWeights nonnegative values with positive sum
+     * @param numberOfComponents
+     */
+    void setWeights(std::vector<double> &&newWeights, size_t numberOfComponents);
+
+    /**
+     * @fn workerCount
+     * @param size number of elements
+     * @return number of threads, which will process the elements
+     */
+    size_t workerCount(size_t size) const;
+
+    /**
+     * @fn runInBlocks
+     * distribute blocks of elements over the threads,
+     * caches of the components are built beforehand, so that they are not built concurrently
+     * @param size number of elements
+     * @param workers number of threads, returned by workerCount
+     * @param task function of the first and the last element of the block and the index of the thread
+     */
+    void runInBlocks(size_t size, size_t workers, const std::function<void (size_t, size_t, size_t)> &task) const;
+
+    /**
+     * @fn expectation
+     * E-step of EM algorithm: responsibilities r_ik ∝ w_k f_k(x_i) from batched log-densities
+     * and their weighted sums, responsibilities themselves are not stored
+     * @param sample
+     * @param center c
+     * @param logarithm true if Σ r_i log(x_i) is needed
+     * @param statistics sums for each component
+     * @return log-likelihood of the sample
+     */
+    double expectation(const std::vector<T> &sample, double center, bool logarithm, std::vector<ComponentStatistic> &statistics) const;
+
+public:
+    String Name() const override;
+    SUPPORT_TYPE SupportType() const override;
+    T MinValue() const override;
+    T MaxValue() const override;
+
+    inline size_t NumberOfComponents() const { return weights.size(); }
+    inline const std::vector<double> &GetWeights() const { return weights; }
+
+    /**
+     * @fn SetWeights
+     * @param newWeights nonnegative values with positive sum, they are normalized
+     */
+    void SetWeights(std::vector<double> &&newWeights);
+
+    /**
+     * @fn SetShuffle
+     * @param shuffle false if the variates of Sample can be grouped by components,
+     * which is faster if the order doesn't matter
+     */
+    inline void SetShuffle(bool shuffle) { shuffled = shuffle; }
+    inline bool IsShuffled() const { return shuffled; }
+
+    /**
+     * @fn SetNumberOfThreads
+     * components are shared by the threads, their tables are built by BuildCaches before the parallel run
+     * @param threads number of threads for vector functions and fitting, 0 for all hardware threads
+     */
+    inline void SetNumberOfThreads(size_t threads) { numberOfThreads = threads; }
+    inline size_t GetNumberOfThreads() const { return numberOfThreads; }
+
+    /**
+     * @fn BuildCaches
+     * build the caches of all components and of the mixture itself
+     */
+    void BuildCaches() const override;
+
+    double F(const T & x) const override;
+    double S(const T & x) const override;
+    void CumulativeDistributionFunction(const std::vector<T> &x, std::vector<double> &y) const override;
+    void SurvivalFunction(const std::vector<T> &x, std::vector<double> &y) const override;
+
+    /**
+     * @fn ComponentIndex
+     * @return random index of component, chosen by alias method
+     */
+    size_t ComponentIndex() const;
+
+    T Variate() const override;
+    void Sample(std::vector<T> &outputData) const override;
+    void Reseed(unsigned long seed) const override;
+
+    long double Mean() const override;
+    long double Variance() const override;
+    long double Skewness() const override;
+    long double ExcessKurtosis() const override;
+
+    /**
+     * @fn Mode
+     * @return mode of the component, where density of the mixture is the largest,
+     * which is exact for well-separated components
+     */
+    T Mode() const override;
+
+    double LikelihoodFunction(const std::vector<T> &sample) const override;
+    double LogLikelihoodFunction(const std::vector<T> &sample) const override;
+
+private:
+    /**
+     * @fn centralMoments
+     * @return second, third and fourth central moments of the mixture
+     */
+    std::array<long double, 3> centralMoments() const;
+
+    /**
+     * @fn weightedLogDensities
+     * @param x block of elements
+     * @param logDensities log(w_k f_k(x_i)) for each component k, by one batched call of each component
+     * @param maximum max_k log(w_k f_k(x_i))
+     */
+    void weightedLogDensities(const std::vector<T> &x, std::vector<std::vector<double>> &logDensities, std::vector<double> &maximum) const;
+
+    /**
+     * @fn cdfFunction
+     * @param x
+     * @param y F(x) or S(x)
+     * @param isRightTail
+     */
+    void cdfFunction(const std::vector<T> &x, std::vector<double> &y, bool isRightTail) const;
+
+protected:
+    double mixtureLogDensity(const T &x) const override;
+    void mixtureLogDensityFunction(const std::vector<T> &x, std::vector<double> &y) const override;
+    std::complex<double> CFImpl(double t) const override;
+};
+
+
+/**
+ * @brief The MixtureRand class <BR>
+ * Finite mixture of distributions of different types
+ *
+ * f(x) = Σ w_k f_k(x)
+ *
+ * Notation: X ~ Mixture(w_1, F_1, ..., w_K, F_K)
+ *
+ * Components are stored by value, all of them should have the same type of variates.
+ * MixtureRand<Distribution> with one type is the mixture of any number of components of this type.
+ */
+template < class... Components >
+class RANDLIBSHARED_EXPORT MixtureRand : public MixtureDistribution<decltype(std::declval<std::tuple_element_t<0, std::tuple<Components...>>>().Variate())>
+{
+    typedef decltype(std::declval<std::tuple_element_t<0, std::tuple<Components...>>>().Variate()) T;
+    typedef typename MixtureDistribution<T>::Component Component;
+    static constexpr size_t K = sizeof...(Components);
+    static_assert((std::is_base_of_v<Component, Components> && ...), "All components should have the same type of variates");
+
+    std::tuple<Components...> components;
+
+public:
+    explicit MixtureRand(const Components &... distributions) : components(distributions...)
+    {
+        this->setWeights(std::vector<double>(K, 1.0), K);
+    }
+
+    MixtureRand(std::vector<double> &&weights, const Components &... distributions) : components(distributions...)
+    {
+        this->setWeights(std::move(weights), K);
+    }
+
+    template < size_t index >
+    inline auto &GetComponent() { return std::get<index>(components); }
+    template < size_t index >
+    inline const auto &GetComponent() const { return std::get<index>(components); }
+
+protected:
+    const Component &component(size_t index) const override
+    {
+        std::array<const Component *, K> pointers = std::apply([] (const Components &... distributions)
+        {
+            return std::array<const Component *, K>{&distributions...};
+        }, components);
+        return *pointers[index];
+    }
+};
+
+
+/**
+ * @brief The MixtureRand<Distribution> class <BR>
+ * Finite mixture of K distributions of the same type
+ *
+ * Mixtures of Normal, Gamma and Poisson distributions can be fitted by EM algorithm.
+ */
+template < class Distribution >
+class RANDLIBSHARED_EXPORT MixtureRand<Distribution> : public MixtureDistribution<decltype(std::declval<Distribution>().Variate())>
+{
+    typedef decltype(std::declval<Distribution>().Variate()) T;
+    typedef typename MixtureDistribution<T>::Component Component;
+    typedef typename MixtureDistribution<T>::ComponentStatistic ComponentStatistic;
+    static_assert(std::is_base_of_v<Component, Distribution>, "Component should be a univariate distribution");
+
+    std::vector<Distribution> components{};
+
+public:
+    explicit MixtureRand(std::vector<Distribution> &&distributions) : components(std::move(distributions))
+    {
+        checkComponents();
+        this->setWeights(std::vector<double>(components.size(), 1.0), components.size());
+    }
+
+    MixtureRand(std::vector<Distribution> &&distributions, std::vector<double> &&weights) : components(std::move(distributions))
+    {
+        checkComponents();
+        this->setWeights(std::move(weights), components.size());
+    }
+
+    inline Distribution &GetComponent(size_t index) { return components.at(index); }
+    inline const Distribution &GetComponent(size_t index) const { return components.at(index); }
+
+    /**
+     * @fn Fit
+     * set weights and parameters of the components, estimated by EM algorithm.
+     * Initial values are taken from K blocks of the sorted sample.
+     * E-step is distributed over GetNumberOfThreads() threads
+     * @param sample
+     * @param maxIterations
+     * @param tolerance relative change of log-likelihood, at which iterations stop
+     */
+    void Fit(const std::vector<T> &sample, int maxIterations = 1000, double tolerance = 1e-9)
+    {
+        static_assert(std::is_same_v<Distribution, NormalRand<T>> || std::is_same_v<Distribution, GammaRand<T>> || std::is_same_v<Distribution, PoissonRand<T>>,
+                      "EM algorithm is implemented only for mixtures of Normal, Gamma and Poisson distributions");
+        constexpr bool logarithm = std::is_same_v<Distribution, GammaRand<T>>;
+        size_t K = components.size(), n = sample.size();
+        if (n < 2 * K)
+            throw std::invalid_argument(this->fitErrorDescription(this->TOO_FEW_ELEMENTS, "There should be at least " + std::to_string(2 * K) + " elements"));
+        if constexpr (logarithm) {
+            if (!this->allElementsArePositive(sample))
+                throw std::invalid_argument(this->fitErrorDescription(this->WRONG_SAMPLE, this->POSITIVITY_VIOLATION));
+        }
+        else if constexpr (std::is_same_v<Distribution, PoissonRand<T>>) {
+            if (!this->allElementsAreNonNegative(sample))
+                throw std::invalid_argument(this->fitErrorDescription(this->WRONG_SAMPLE, this->NON_NEGATIVITY_VIOLATION));
+        }
+
+        /// initial values from the blocks of the order statistic
+        long double center = 0;
+        for (const T & x : sample)
+            center += x;
+        center /= n;
+        std::vector<T> orderStatistic = sample;
+        std::sort(orderStatistic.begin(), orderStatistic.end());
+        std::vector<ComponentStatistic> statistics(K);
+        for (size_t k = 0; k != K; ++k) {
+            for (size_t i = k * n / K; i != (k + 1) * n / K; ++i) {
+                long double x = orderStatistic[i], y = x - center;
+                statistics[k].weight += 1;
+                statistics[k].sum += y;
+                statistics[k].squareSum += y * y;
+                if constexpr (logarithm)
+                    statistics[k].logSum += std::log(x);
+            }
+        }
+        orderStatistic.clear();
+        maximization(statistics, center);
+
+        double logLikelihood = -INFINITY;
+        for (int iteration = 0; iteration != maxIterations; ++iteration) {
+            double newLogLikelihood = this->expectation(sample, center, logarithm, statistics);
+            maximization(statistics, center);
+            bool converged = std::fabs(newLogLikelihood - logLikelihood) <= tolerance * std::fabs(newLogLikelihood);
+            logLikelihood = newLogLikelihood;
+            if (converged)
+                break;
+        }
+    }
+
+protected:
+    const Component &component(size_t index) const override { return components[index]; }
+
+private:
+    void checkComponents() const
+    {
+        if (components.empty())
+            throw std::invalid_argument("Mixture distribution: there should be at least one component");
+    }
+
+    /**
+     * @fn maximization
+     * M-step of EM algorithm: weighted maximum-likelihood estimators of the components
+     * and new weights, components without responsibility keep their parameters
+     * @param statistics
+     * @param center
+     */
+    void maximization(const std::vector<ComponentStatistic> &statistics, double center)
+    {
+        size_t K = components.size();
+        std::vector<double> newWeights(K);
+        for (size_t k = 0; k != K; ++k) {
+            const ComponentStatistic &statistic = statistics[k];
+            newWeights[k] = statistic.weight;
+            if (statistic.weight > 0)
+                maximize(components[k], statistic, center);
+        }
+        this->setWeights(std::move(newWeights), K);
+    }
+
+    /// degenerate components are kept away from zero variance, so that the likelihood stays bounded
+    static constexpr double MIN_RELATIVE_SPREAD = 1e-12;
+
+    template < typename RealType >
+    static void maximize(NormalRand<RealType> &distribution, const ComponentStatistic &statistic, double center)
+    {
+        long double mean = statistic.sum / statistic.weight;
+        long double variance = statistic.squareSum / statistic.weight - mean * mean;
+        long double location = center + mean;
+        long double minVariance = MIN_RELATIVE_SPREAD * (1 + location * location);
+        distribution.SetLocation(location);
+        distribution.SetVariance(std::max(variance, minVariance));
+    }
+
+    template < typename RealType >
+    static void maximize(GammaRand<RealType> &distribution, const ComponentStatistic &statistic, double center)
+    {
+        long double mean = center + statistic.sum / statistic.weight;
+        long double logMean = statistic.logSum / statistic.weight;
+        distribution.Fit(mean, std::min(logMean, std::log(mean) - MIN_RELATIVE_SPREAD));
+    }
+
+    template < typename IntType >
+    static void maximize(PoissonRand<IntType> &distribution, const ComponentStatistic &statistic, double center)
+    {
+        long double mean = center + statistic.sum / statistic.weight;
+        distribution.SetRate(std::max<long double>(mean, MIN_RELATIVE_SPREAD));
+    }
+};
+
+#endif // MIXTURERAND_H
@@ -0,0 +1,866 @@
+#include "TruncatedRand.h"
+#include "continuous/UniformRand.h"
+
+template < typename T >
+String TruncatedDistribution<T>::Name() const
+{
+    return "Truncated(" + component().Name() + ", " + this->toStringWithPrecision(a) + ", " + this->toStringWithPrecision(b) + ")";
+}
+
+template < typename T >
+SUPPORT_TYPE TruncatedDistribution<T>::SupportType() const
+{
+    const Component &original = component();
+    bool leftBounded = original.isLeftBounded() || a > original.MinValue();
+    bool rightBounded = original.isRightBounded() || b < original.MaxValue();
+    if (leftBounded)
+        return rightBounded ? FINITE_T : RIGHTSEMIFINITE_T;
+    return rightBounded ? LEFTSEMIFINITE_T : INFINITE_T;
+}
+
+template < typename T >
+double TruncatedDistribution<T>::logLowerF() const
+{
+    if (a <= component().MinValue())
+        return -INFINITY;
+    if constexpr (std::is_floating_point_v<T>)
+        return componentLogF(a);
+    else
+        return componentLogF(a - 1);
+}
+
+template < typename T >
+double TruncatedDistribution<T>::logLowerS() const
+{
+    if (a <= component().MinValue())
+        return 0.0;
+    if constexpr (std::is_floating_point_v<T>)
+        return componentLogS(a);
+    else
+        return componentLogS(a - 1);
+}
+
+template < typename T >
+void TruncatedDistribution<T>::setTruncation(T lowerBound, T upperBound)
+{
+    if (!(lowerBound <= upperBound) || (std::is_floating_point_v<T> && lowerBound == upperBound))
+        throw std::invalid_argument("Truncated distribution: lower bound should be less than upper bound");
+    const Component &original = component();
+    T oldA = a, oldB = b;
+    a = std::max(lowerBound, original.MinValue());
+    b = std::min(upperBound, original.MaxValue());
+
+    /// the tail, which doesn't contain the median, keeps relative accuracy
+    double lowerS = logLowerS();
+    bool rightTail = lowerS < -M_LN2;
+    double lowerTail, upperTail, newLogMass;
+    if (rightTail) {
+        lowerTail = lowerS;
+        upperTail = (b >= original.MaxValue()) ? -INFINITY : componentLogS(b);
+        newLogMass = lowerTail + RandMath::log1mexp(upperTail - lowerTail);
+    }
+    else {
+        lowerTail = logLowerF();
+        upperTail = (b >= original.MaxValue()) ? 0.0 : componentLogF(b);
+        newLogMass = upperTail + RandMath::log1mexp(lowerTail - upperTail);
+    }
+    if (!(a <= b) || !(newLogMass > -INFINITY)) {
+        a = oldA;
+        b = oldB;
+        throw std::invalid_argument("Truncated distribution: probability of the interval should be positive");
+    }
+    isRightTail = rightTail;
+    logLowerTail = lowerTail;
+    logUpperTail = upperTail;
+    logMass = std::min(newLogMass, 0.0);
+}
+
+template < typename T >
+void TruncatedDistribution<T>::SetTruncation(T lowerBound, T upperBound)
+{
+    setTruncation(lowerBound, upperBound);
+    prepareSampler();
+}
+
+template < typename T >
+double TruncatedDistribution<T>::truncatedLogDensity(const T &x) const
+{
+    if (x < a || x > b)
+        return -INFINITY;
+    return this->componentLogDensity(component(), x) - logMass;
+}
+
+template < typename T >
+double TruncatedDistribution<T>::F(const T & x) const
+{
+    if (x < a)
+        return 0.0;
+    if (x >= b)
+        return 1.0;
+    double y = 0.0;
+    if (isRightTail) {
+        /// (S_0(a-) - S_0(x)) / (S_0(a-) - S_0(b))
+        double logS = componentLogS(x);
+        y = std::exp(logLowerTail - logMass) * -std::expm1(logS - logLowerTail);
+    }
+    else {
+        /// (F_0(x) - F_0(a-)) / (F_0(b) - F_0(a-))
+        double logF = componentLogF(x);
+        if (logF == -INFINITY)
+            return 0.0;
+        y = std::exp(logF - logMass) * -std::expm1(logLowerTail - logF);
+    }
+    return std::min(std::max(y, 0.0), 1.0);
+}
+
+template < typename T >
+double TruncatedDistribution<T>::S(const T & x) const
+{
+    if (x < a)
+        return 1.0;
+    if (x >= b)
+        return 0.0;
+    double y = 0.0;
+    if (isRightTail) {
+        /// (S_0(x) - S_0(b)) / (S_0(a-) - S_0(b))
+        double logS = componentLogS(x);
+        if (logS == -INFINITY)
+            return 0.0;
+        y = std::exp(logS - logMass) * -std::expm1(logUpperTail - logS);
+    }
+    else {
+        /// (F_0(b) - F_0(x)) / (F_0(b) - F_0(a-))
+        double logF = componentLogF(x);
+        y = std::exp(logUpperTail - logMass) * -std::expm1(logF - logUpperTail);
+    }
+    return std::min(std::max(y, 0.0), 1.0);
+}
+
+template < typename T >
+double TruncatedDistribution<T>::componentLogTail(double p, double q) const
+{
+    if (isRightTail) {
+        /// S_0(x) = S_0(a-) - p M = S_0(b) + q M
+        if (p < q)
+            return logLowerTail + std::log1p(-p * std::exp(logMass - logLowerTail));
+        double logAddon = std::log(q) + logMass;
+        double maximum = std::max(logUpperTail, logAddon), minimum = std::min(logUpperTail, logAddon);
+        return (minimum == -INFINITY) ? maximum : maximum + std::log1p(std::exp(minimum - maximum));
+    }
+    /// F_0(x) = F_0(b) - q M = F_0(a-) + p M
+    if (q < p)
+        return logUpperTail + std::log1p(-q * std::exp(logMass - logUpperTail));
+    double logAddon = std::log(p) + logMass;
+    double maximum = std::max(logLowerTail, logAddon), minimum = std::min(logLowerTail, logAddon);
+    return (minimum == -INFINITY) ? maximum : maximum + std::log1p(std::exp(minimum - maximum));
+}
+
+template < typename T >
+bool TruncatedDistribution<T>::quantileFromTails(double p, double q, T &quantile) const
+{
+    double tail = std::exp(componentLogTail(p, q));
+    if (tail < std::numeric_limits<double>::min())
+        return false;
+    const Component &original = component();
+    T x = isRightTail ? original.Quantile1m(std::min(tail, 1.0)) : original.Quantile(std::min(tail, 1.0));
+    quantile = std::min(std::max(x, a), b);
+    return true;
+}
+
+template < typename T >
+T TruncatedDistribution<T>::quantileImpl(double p, T initValue) const
+{
+    T x = 0;
+    if (quantileFromTails(p, 1.0 - p, x))
+        return x;
+    /// tail of the original distribution underflows, solve F(x) = p for the truncated one
+    return TruncatedDensity<T>::quantileImpl(p, initValue);
+}
+
+template < typename T >
+T TruncatedDistribution<T>::quantileImpl(double p) const
+{
+    T x = 0;
+    return quantileFromTails(p, 1.0 - p, x) ? x : TruncatedDensity<T>::quantileImpl(p, Mode());
+}
+
+template < typename T >
+T TruncatedDistribution<T>::quantileImpl1m(double p, T initValue) const
+{
+    T x = 0;
+    if (quantileFromTails(1.0 - p, p, x))
+        return x;
+    return TruncatedDensity<T>::quantileImpl1m(p, initValue);
+}
+
+template < typename T >
+T TruncatedDistribution<T>::quantileImpl1m(double p) const
+{
+    T x = 0;
+    return quantileFromTails(1.0 - p, p, x) ? x : TruncatedDensity<T>::quantileImpl1m(p, Mode());
+}
+
+template < typename T >
+T TruncatedDistribution<T>::Variate() const
+{
+    double u = UniformRand<double>::StandardVariate(this->localRandGenerator);
+    T x = 0;
+    return quantileFromTails(u, 1.0 - u, x) ? x : TruncatedDensity<T>::quantileImpl(u, Mode());
+}
+
+template < typename T >
+LongDoublePair TruncatedDistribution<T>::discreteMoments() const
+{
+    /// probabilities relative to the mode, so that the sums don't underflow in the tails
+    static constexpr double EPSILON = 1e-20;
+    const Component &original = component();
+    T mode = Mode();
+    double logPeak = this->componentLogDensity(original, mode);
+    long double weight = 0, sum = 0, squareSum = 0;
+    auto addon = [&] (T k)
+    {
+        double w = std::exp(this->componentLogDensity(original, k) - logPeak);
+        long double d = static_cast<long double>(k) - mode;
+        weight += w;
+        sum += w * d;
+        squareSum += w * d * d;
+        return w;
+    };
+    addon(mode);
+    for (T k = mode; k < b;) {
+        if (addon(++k) < EPSILON * weight)
+            break;
+    }
+    for (T k = mode; k > a;) {
+        if (addon(--k) < EPSILON * weight)
+            break;
+    }
+    long double mean = sum / weight;
+    return std::make_pair(mode + mean, std::max(squareSum / weight - mean * mean, 0.0l));
+}
+
+template < typename T >
+bool TruncatedDistribution<T>::tailDiverges(int power, bool isRight, double scale) const
+{
+    /// x^n P(|X| > x) is compared at two distant points beyond the bound of the other side
+    static constexpr double NEAR_DISTANCE = 1e4;
+    static constexpr double FAR_DISTANCE = 1e8;
+    double bound = isRight ? a : b;
+    double base = (std::isfinite(bound) ? std::fabs(bound) : 0.0) + scale;
+    auto logTerm = [this, power, isRight] (double x)
+    {
+        return power * std::log(x) + (isRight ? componentLogS(x) : componentLogF(-x));
+    };
+    double nearTerm = logTerm(NEAR_DISTANCE * base), farTerm = logTerm(FAR_DISTANCE * base);
+    return farTerm > -INFINITY && farTerm >= nearTerm - 2 * M_LN10;
+}
+
+template < typename T >
+long double TruncatedDistribution<T>::standardizedExpectation(const std::function<double (double)> &funPtr, double center, double scale) const
+{
+    /// each side of the center is mapped on [0, 1] by y = t / (1 - t), where 1 - t decays as (1 - u)^8,
+    /// so that heavy tails and singularities of the density at the bounds are flattened
+    static constexpr double EPSILON = 1e-11;
+    static constexpr int MAX_DEPTH = 16;
+    long double sum = 0.0;
+    for (bool isRight : {false, true}) {
+        double yMax = isRight ? (b - center) / scale : (center - a) / scale;
+        if (!(yMax > 0.0))
+            continue;
+        double tMax = std::isfinite(yMax) ? yMax / (1.0 + yMax) : 1.0;
+        double tComplement = std::isfinite(yMax) ? 1.0 / (1.0 + yMax) : 0.0;
+        sum += RandMath::integral([this, funPtr, center, scale, isRight, yMax, tMax, tComplement] (double u)
+        {
+            double v = 1.0 - u, v2 = v * v, v4 = v2 * v2, v7 = v4 * v2 * v;
+            double denominator = tComplement + tMax * v7 * v;
+            if (v7 == 0.0 || denominator == 0.0)
+                return 0.0;
+            double y = tMax * (1.0 - v7 * v) / denominator;
+            double value = funPtr(isRight ? y : -y);
+            if (value == 0.0)
+                return 0.0;
+            /// near a finite bound the point is measured from it to keep the distance accurate
+            T x = isRight ? center + scale * y : center - scale * y;
+            if (y > 0.5 * yMax) {
+                double distance = scale * tMax * v7 * v / (tComplement * denominator);
+                x = isRight ? b - distance : a + distance;
+            }
+            double density = std::exp(truncatedLogDensity(x));
+            if (!std::isfinite(density))
+                return 0.0;
+            return value * scale * density * 8 * tMax * v7 / (denominator * denominator);
+        },
+        0.0, 1.0, EPSILON, MAX_DEPTH);
+    }
+    return sum;
+}
+
+template < typename T >
+LongDoublePair TruncatedDistribution<T>::continuousMoments(bool isVarianceNeeded) const
+{
+    const Component &original = component();
+    double median = this->Quantile(0.5);
+    double scale = 0.5 * (this->Quantile(0.75) - this->Quantile(0.25));
+    if (!(scale > 0.0))
+        scale = std::isfinite(b - a) ? b - a : 1.0;
+
+    /// moments of the original distribution show, which tails can be heavy
+    bool isLeftOpen = !std::isfinite(a), isRightOpen = !std::isfinite(b);
+    if (isLeftOpen || isRightOpen) {
+        long double originalMean = original.Mean();
+        if (!std::isfinite(originalMean)) {
+            bool isLeftDivergent = isLeftOpen && tailDiverges(1, false, scale);
+            bool isRightDivergent = isRightOpen && tailDiverges(1, true, scale);
+            if (isLeftDivergent || isRightDivergent) {
+                double mean = isLeftDivergent ? (isRightDivergent ? NAN : -INFINITY) : INFINITY;
+                return std::make_pair(mean, INFINITY);
+            }
+        }
+        if (isVarianceNeeded && !std::isfinite(original.Variance())) {
+            if ((isLeftOpen && tailDiverges(2, false, scale)) || (isRightOpen && tailDiverges(2, true, scale)))
+                return std::make_pair(median + scale * standardizedExpectation([] (double y) { return y; }, median, scale), INFINITY);
+        }
+    }
+
+    long double shift = standardizedExpectation([] (double y) { return y; }, median, scale);
+    if (!isVarianceNeeded)
+        return std::make_pair(median + scale * shift, NAN);
+    long double variance = standardizedExpectation([shift] (double y) { return (y - shift) * (y - shift); }, median, scale);
+    return std::make_pair(median + scale * shift, scale * scale * variance);
+}
+
+template < typename T >
+long double TruncatedDistribution<T>::Mean() const
+{
+    if constexpr (std::is_floating_point_v<T>)
+        return continuousMoments(false).first;
+    else
+        return discreteMoments().first;
+}
+
+template < typename T >
+long double TruncatedDistribution<T>::Variance() const
+{
+    if constexpr (std::is_floating_point_v<T>)
+        return continuousMoments(true).second;
+    else
+        return discreteMoments().second;
+}
+
+template < typename T >
+T TruncatedDistribution<T>::Mode() const
+{
+    T mode = component().Mode();
+    return std::min(std::max(mode, a), b);
+}
+
+template class TruncatedDensity<float>;
+template class TruncatedDensity<double>;
+template class TruncatedDensity<long double>;
+
+template class TruncatedDensity<int>;
+template class TruncatedDensity<long int>;
+template class TruncatedDensity<long long int>;
+
+template class TruncatedDistribution<float>;
+template class TruncatedDistribution<double>;
+template class TruncatedDistribution<long double>;
+
+template class TruncatedDistribution<int>;
+template class TruncatedDistribution<long int>;
+template class TruncatedDistribution<long long int>;
+
+template < typename RealType >
+TruncatedRand<NormalRand<RealType>>::TruncatedRand(const NormalRand<RealType> &original, RealType lowerBound, RealType upperBound) :
+    TruncatedWrapper<NormalRand<RealType>>(original)
+{
+    this->SetTruncation(lowerBound, upperBound);
+}
+
+template < typename RealType >
+double TruncatedRand<NormalRand<RealType>>::standardLogS(double z)
+{
+    double y = M_SQRT1_2 * z;
+    if (y < 0.0)
+        return std::log1p(-0.5 * std::erfc(-y));
+    if (y < 10.0)
+        return std::log(0.5 * std::erfc(y));
+    /// erfc(y) = xexpxsqerfc(y) / (y exp(y^2))
+    return std::log(0.5 * RandMath::xexpxsqerfc(y) / y) - y * y;
+}
+
+template < typename RealType >
+double TruncatedRand<NormalRand<RealType>>::componentLogF(const RealType &x) const
+{
+    const NormalRand<RealType> &original = this->distribution;
+    return standardLogS((original.GetLocation() - x) / original.GetScale());
+}
+
+template < typename RealType >
+double TruncatedRand<NormalRand<RealType>>::componentLogS(const RealType &x) const
+{
+    const NormalRand<RealType> &original = this->distribution;
+    return standardLogS((x - original.GetLocation()) / original.GetScale());
+}
+
+template < typename RealType >
+void TruncatedRand<NormalRand<RealType>>::prepareSampler()
+{
+    const NormalRand<RealType> &original = this->distribution;
+    double mu = original.GetLocation(), sigma = original.GetScale();
+    double lower = (this->GetLowerBound() - mu) / sigma, upper = (this->GetUpperBound() - mu) / sigma;
+    isReflected = (upper <= 0.0);
+    alpha = isReflected ? -upper : lower;
+    beta = isReflected ? -lower : upper;
+    uniformShift = (alpha > 0.0) ? alpha * alpha : 0.0;
+    if (alpha < 0.0) {
+        /// interval contains the location
+        samplerId = (beta - alpha < M_SQRT2PI) ? UNIFORM_REJECTION : NORMAL_REJECTION;
+        return;
+    }
+    /// acceptance of the half-normal proposal is 2 P(α < |Z| < β)
+    if (this->GetMass() >= 0.35) {
+        samplerId = HALF_NORMAL_REJECTION;
+        return;
+    }
+    double root = std::sqrt(alpha * alpha + 4.0);
+    double uniformBound = alpha + 2 * std::sqrt(M_E) / (alpha + root) * std::exp(0.25 * alpha * (alpha - root));
+    if (beta <= uniformBound) {
+        samplerId = UNIFORM_REJECTION;
+        return;
+    }
+    samplerId = EXPONENTIAL_REJECTION;
+    rate = 0.5 * (alpha + root);
+    exponentialMass = -std::expm1(-rate * (beta - alpha));
+}
+
+template < typename RealType >
+RealType TruncatedRand<NormalRand<RealType>>::Variate() const
+{
+    double z = 0;
+    switch (samplerId) {
+    case NORMAL_REJECTION:
+        do {
+            z = NormalRand<double>::StandardVariate(this->localRandGenerator);
+        } while (z < alpha || z > beta);
+        break;
+    case HALF_NORMAL_REJECTION:
+        do {
+            z = std::fabs(NormalRand<double>::StandardVariate(this->localRandGenerator));
+        } while (z < alpha || z > beta);
+        break;
+    case UNIFORM_REJECTION:
+        do {
+            z = alpha + (beta - alpha) * UniformRand<double>::StandardVariate(this->localRandGenerator);
+        } while (ExponentialRand<double>::StandardVariate(this->localRandGenerator) < 0.5 * (z * z - uniformShift));
+        break;
+    case EXPONENTIAL_REJECTION:
+    default:
+        do {
+            if (exponentialMass == 1.0)
+                z = alpha + ExponentialRand<double>::StandardVariate(this->localRandGenerator) / rate;
+            else
+                z = alpha - std::log1p(-exponentialMass * UniformRand<double>::StandardVariate(this->localRandGenerator)) / rate;
+        } while (z > beta || ExponentialRand<double>::StandardVariate(this->localRandGenerator) < 0.5 * (z - rate) * (z - rate));
+        break;
+    }
+    const NormalRand<RealType> &original = this->distribution;
+    return original.GetLocation() + original.GetScale() * (isReflected ? -z : z);
+}
+
+template < typename RealType >
+void TruncatedRand<NormalRand<RealType>>::standardTailMoments(double z, double &excess, double &variance)
+{
+    static constexpr double CONTINUED_FRACTION_BOUND = 3.0;
+    static constexpr int CONTINUED_FRACTION_DEPTH = 80;
+    if (z < CONTINUED_FRACTION_BOUND) {
+        /// inverse Mills ratio m = φ(z) / S(z), excess = m - z and variance = 1 - m (m - z)
+        double hazard = 1.0 / (std::sqrt(M_PI_2) * std::exp(0.5 * z * z) * std::erfc(M_SQRT1_2 * z));
+        excess = hazard - z;
+        variance = 1.0 - hazard * excess;
+        return;
+    }
+    /// m = z + 1 / T_1, where T_j = z + (j + 1) / T_{j + 1},
+    /// then excess = 1 / T_1 and variance = (T_2 (z - 3 / T_3) + 4) / (T_1 T_2)^2
+    double t1 = z, t2 = z, t3 = z;
+    for (int j = CONTINUED_FRACTION_DEPTH; j > 0; --j) {
+        t3 = t2;
+        t2 = t1;
+        t1 = z + (j + 1) / t2;
+    }
+    excess = 1.0 / t1;
+    double denominator = t1 * t2;
+    variance = (t2 * (z - 3.0 / t3) + 4.0) / (denominator * denominator);
+}
+
+template < typename RealType >
+LongDoublePair TruncatedRand<NormalRand<RealType>>::standardMoments() const
+{
+    static constexpr double NARROW_BOUND = 1.0;
+    static constexpr int MAX_TERMS = 60;
+    double halfWidth = 0.5 * (beta - alpha), center = 0.5 * (alpha + beta);
+    if (halfWidth * (std::fabs(center) + halfWidth) < NARROW_BOUND) {
+        /// exp(-z^2 / 2) ∝ exp(-ct - t^2 / 2) = Σ b_n (t / h)^n for t = z - c, where b_n = He_n(-c) h^n / n!,
+        /// the moments of t are averaged over [-h, h] termwise
+        long double b0 = 1.0l, b1 = -center * halfWidth;
+        long double m0 = 1.0l, m1 = b1 / 3.0l, m2 = 1.0l / 3.0l;
+        for (int n = 2; n <= MAX_TERMS; ++n) {
+            long double bn = (-center * halfWidth * b1 - halfWidth * halfWidth * b0) / n;
+            if (n & 1)
+                m1 += bn / (n + 2);
+            else {
+                m0 += bn / (n + 1);
+                m2 += bn / (n + 3);
+            }
+            b0 = b1;
+            b1 = bn;
+            if (std::fabs(b0) + std::fabs(b1) < 1e-20l)
+                break;
+        }
+        long double shift = halfWidth * m1 / m0;
+        long double variance = halfWidth * halfWidth * m2 / m0 - shift * shift;
+        return std::make_pair(center + shift, std::max(variance, 0.0l));
+    }
+
+    if (alpha < 0.0) {
+        /// interval contains the location: mean (φ(α) - φ(β)) / M and variance 1 + (α φ(α) - β φ(β)) / M - mean^2
+        double logNormalizer = 0.5 * std::log(2 * M_PI) + this->GetLogMass();
+        double phiLower = 0.0, phiUpper = 0.0, lowerTerm = 0.0, upperTerm = 0.0;
+        if (std::isfinite(alpha)) {
+            phiLower = std::exp(-0.5 * alpha * alpha - logNormalizer);
+            lowerTerm = alpha * phiLower;
+        }
+        if (std::isfinite(beta)) {
+            phiUpper = std::exp(-0.5 * beta * beta - logNormalizer);
+            upperTerm = beta * phiUpper;
+        }
+        long double mean = phiLower - phiUpper;
+        long double variance = 1.0l + lowerTerm - upperTerm - mean * mean;
+        return std::make_pair(mean, std::max(variance, 0.0l));
+    }
+
+    /// distribution on [α, ∞) is the mixture of the ones on [α, β] and [β, ∞) with weights 1 - ρ and ρ = S(β) / S(α),
+    /// moments are measured from α
+    double lowerExcess = 0, lowerVariance = 0;
+    standardTailMoments(alpha, lowerExcess, lowerVariance);
+    if (!std::isfinite(beta))
+        return std::make_pair(alpha + lowerExcess, lowerVariance);
+    double upperExcess = 0, upperVariance = 0;
+    standardTailMoments(beta, upperExcess, upperVariance);
+    /// log(S(β) / S(α)) = (α^2 - β^2) / 2 + log(m(α) / m(β)) for inverse Mills ratio m
+    double logRatio = -0.5 * (beta - alpha) * (alpha + beta) + std::log((alpha + lowerExcess) / (beta + upperExcess));
+    double ratio = std::exp(logRatio), complement = -std::expm1(logRatio);
+    double upperShift = beta - alpha + upperExcess;
+    long double mean = (lowerExcess - ratio * upperShift) / complement;
+    long double secondMoment = lowerVariance + lowerExcess * lowerExcess;
+    secondMoment -= ratio * (upperVariance + upperShift * upperShift);
+    secondMoment /= complement;
+    return std::make_pair(alpha + mean, std::max(secondMoment - mean * mean, 0.0l));
+}
+
+template < typename RealType >
+long double TruncatedRand<NormalRand<RealType>>::Mean() const
+{
+    const NormalRand<RealType> &original = this->distribution;
+    long double mean = standardMoments().first;
+    return original.GetLocation() + original.GetScale() * (isReflected ? -mean : mean);
+}
+
+template < typename RealType >
+long double TruncatedRand<NormalRand<RealType>>::Variance() const
+{
+    double sigma = this->distribution.GetScale();
+    return sigma * sigma * standardMoments().second;
+}
+
+template class TruncatedRand<NormalRand<float>>;
+template class TruncatedRand<NormalRand<double>>;
+template class TruncatedRand<NormalRand<long double>>;
+
+template < typename RealType, class Distribution >
+TruncatedGammaDistribution<RealType, Distribution>::TruncatedGammaDistribution(const Distribution &original, RealType lowerBound, RealType upperBound) :
+    TruncatedWrapper<Distribution>(original)
+{
+    this->SetTruncation(lowerBound, upperBound);
+}
+
+template < typename RealType, class Distribution >
+double TruncatedGammaDistribution<RealType, Distribution>::componentLogF(const RealType &x) const
+{
+    return this->distribution.logF(x);
+}
+
+template < typename RealType, class Distribution >
+double TruncatedGammaDistribution<RealType, Distribution>::componentLogS(const RealType &x) const
+{
+    return this->distribution.logS(x);
+}
+
+template < typename RealType, class Distribution >
+void TruncatedGammaDistribution<RealType, Distribution>::prepareSampler()
+{
+    const Distribution &original = this->distribution;
+    double shape = original.GetShape(), beta = original.GetRate();
+    double a = this->GetLowerBound(), b = this->GetUpperBound(), width = b - a;
+    shapem1 = shape - 1.0;
+    if (shape != 1.0 && this->GetMass() >= 0.25) {
+        samplerId = GAMMA_REJECTION;
+        return;
+    }
+
+    if (shape >= 1.0) {
+        double mode = shapem1 / beta;
+        samplerId = EXPONENTIAL_REJECTION;
+        if (a >= mode) {
+            touchPoint = a;
+            isAscending = true;
+            rate = (a > 0.0) ? beta - shapem1 / a : beta;
+        }
+        else if (b <= mode) {
+            touchPoint = b;
+            isAscending = false;
+            rate = shapem1 / b - beta;
+        }
+        else {
+            touchPoint = mode;
+            samplerId = UNIFORM_REJECTION;
+        }
+        /// if tangent is almost flat, constant envelope f(c) is as good
+        if (samplerId == EXPONENTIAL_REJECTION && rate * width < 1e-3)
+            samplerId = UNIFORM_REJECTION;
+        if (samplerId == UNIFORM_REJECTION)
+            rate = 0.0;
+        exponentialMass = -std::expm1(-rate * width);
+        return;
+    }
+
+    if (beta * a >= 1.0) {
+        /// x^(k - 1) decreases, hence f(x) / f(a) <= exp(-β(x - a))
+        samplerId = EXPONENTIAL_REJECTION;
+        touchPoint = a;
+        isAscending = true;
+        rate = beta;
+        exponentialMass = -std::expm1(-rate * width);
+    }
+    else if (beta * b <= 1.0) {
+        /// exp(-βx) varies less than e times on the interval
+        samplerId = POWER_REJECTION;
+        powerRatio = std::pow(a / b, shape);
+    }
+    else
+        samplerId = INVERSION;
+}
+
+template < typename RealType, class Distribution >
+double TruncatedGammaDistribution<RealType, Distribution>::logRatio(double x) const
+{
+    double beta = this->distribution.GetRate(), y = x - touchPoint;
+    double value = -beta * y + rate * std::fabs(y);
+    if (shapem1 != 0.0)
+        value += shapem1 * std::log1p(y / touchPoint);
+    return value;
+}
+
+template < typename RealType, class Distribution >
+RealType TruncatedGammaDistribution<RealType, Distribution>::Variate() const
+{
+    double a = this->GetLowerBound(), b = this->GetUpperBound();
+    switch (samplerId) {
+    case GAMMA_REJECTION: {
+        const Distribution &original = this->distribution;
+        double x = 0;
+        do {
+            x = GammaDistribution<RealType>::Variate(original.GetShape(), original.GetRate(), this->localRandGenerator);
+        } while (x < a || x > b);
+        return x;
+    }
+    case EXPONENTIAL_REJECTION:
+        do {
+            double y = (exponentialMass == 1.0) ? ExponentialRand<double>::StandardVariate(this->localRandGenerator) / rate
+                                                : -std::log1p(-exponentialMass * UniformRand<double>::StandardVariate(this->localRandGenerator)) / rate;
+            double x = isAscending ? touchPoint + y : touchPoint - y;
+            if (x < a || x > b)
+                continue;
+            if (shapem1 == 0.0 || ExponentialRand<double>::StandardVariate(this->localRandGenerator) >= -logRatio(x))
+                return x;
+        } while (true);
+    case UNIFORM_REJECTION:
+        do {
+            double x = a + (b - a) * UniformRand<double>::StandardVariate(this->localRandGenerator);
+            if (ExponentialRand<double>::StandardVariate(this->localRandGenerator) >= -logRatio(x))
+                return x;
+        } while (true);
+    case POWER_REJECTION: {
+        /// proposal with density proportional to x^(k - 1) on [a, b], density ratio is exp(-β(x - a))
+        double shape = shapem1 + 1.0, beta = this->distribution.GetRate();
+        double x = 0;
+        do {
+            double u = UniformRand<double>::StandardVariate(this->localRandGenerator);
+            x = b * std::pow(powerRatio + u * (1.0 - powerRatio), 1.0 / shape);
+        } while (ExponentialRand<double>::StandardVariate(this->localRandGenerator) < beta * (x - a));
+        return std::min(std::max(x, a), b);
+    }
+    case INVERSION:
+    default:
+        return TruncatedDistribution<RealType>::Variate();
+    }
+}
+
+template class TruncatedGammaDistribution<float, GammaRand<float>>;
+template class TruncatedGammaDistribution<double, GammaRand<double>>;
+template class TruncatedGammaDistribution<long double, GammaRand<long double>>;
+
+template class TruncatedGammaDistribution<float, ExponentialRand<float>>;
+template class TruncatedGammaDistribution<double, ExponentialRand<double>>;
+template class TruncatedGammaDistribution<long double, ExponentialRand<long double>>;
+
+template < typename RealType >
+TruncatedRand<GammaRand<RealType>>::TruncatedRand(const GammaRand<RealType> &original, RealType lowerBound, RealType upperBound) :
+    TruncatedGammaDistribution<RealType, GammaRand<RealType>>(original, lowerBound, upperBound)
+{
+}
+
+template class TruncatedRand<GammaRand<float>>;
+template class TruncatedRand<GammaRand<double>>;
+template class TruncatedRand<GammaRand<long double>>;
+
+template < typename RealType >
+TruncatedRand<ExponentialRand<RealType>>::TruncatedRand(const ExponentialRand<RealType> &original, RealType lowerBound, RealType upperBound) :
+    TruncatedGammaDistribution<RealType, ExponentialRand<RealType>>(original, lowerBound, upperBound)
+{
+}
+
+template < typename RealType >
+long double TruncatedRand<ExponentialRand<RealType>>::Mean() const
+{
+    /// a + 1 / β - w / (exp(βw) - 1) for w = b - a
+    double a = this->GetLowerBound(), w = this->GetUpperBound() - a;
+    double beta = this->distribution.GetRate(), t = beta * w;
+    if (t < 1e-2)
+        return a + w * (0.5 - t / 12.0 + t * t * t / 720.0);
+    if (!std::isfinite(t))
+        return a + 1.0 / beta;
+    return a + 1.0 / beta - w / std::expm1(t);
+}
+
+template < typename RealType >
+long double TruncatedRand<ExponentialRand<RealType>>::Variance() const
+{
+    /// 1 / β^2 - w^2 exp(βw) / (exp(βw) - 1)^2
+    double w = this->GetUpperBound() - this->GetLowerBound();
+    double beta = this->distribution.GetRate(), t = beta * w;
+    if (t < 1e-2)
+        return w * w * (1.0 / 12.0 - t * t / 720.0);
+    if (!std::isfinite(t))
+        return 1.0 / (beta * beta);
+    double denominator = -std::expm1(-t);
+    return 1.0 / (beta * beta) - w * w * std::exp(-t) / (denominator * denominator);
+}
+
+template class TruncatedRand<ExponentialRand<float>>;
+template class TruncatedRand<ExponentialRand<double>>;
+template class TruncatedRand<ExponentialRand<long double>>;
+
+template < typename IntType >
+TruncatedRand<PoissonRand<IntType>>::TruncatedRand(const PoissonRand<IntType> &original, IntType lowerBound, IntType upperBound) :
+    TruncatedWrapper<PoissonRand<IntType>>(original)
+{
+    this->SetTruncation(lowerBound, upperBound);
+}
+
+template < typename IntType >
+double TruncatedRand<PoissonRand<IntType>>::componentLogF(const IntType &k) const
+{
+    return (k >= 0) ? RandMath::lqgamma(k + 1, this->distribution.GetRate()) : -INFINITY;
+}
+
+template < typename IntType >
+double TruncatedRand<PoissonRand<IntType>>::componentLogS(const IntType &k) const
+{
+    return (k >= 0) ? RandMath::lpgamma(k + 1, this->distribution.GetRate()) : 0.0;
+}
+
+template < typename IntType >
+void TruncatedRand<PoissonRand<IntType>>::prepareSampler()
+{
+    static constexpr double EPSILON = 1e-17;
+    table.clear();
+    if (this->GetMass() >= 0.25) {
+        samplerId = REJECTION;
+        return;
+    }
+
+    /// probabilities decrease along the table from the bound, which is closest to the mode,
+    /// or first increase and then decrease if the mode is inside of the interval
+    double lambda = this->distribution.GetRate();
+    IntType a = this->GetLowerBound(), b = this->GetUpperBound();
+    IntType mode = std::floor(lambda);
+    isTableAscending = (mode < b);
+    tableStart = isTableAscending ? a : b;
+    table.push_back(1.0);
+    double probability = 1.0, total = 1.0;
+    bool isComplete = false;
+    IntType k = tableStart;
+    while (table.size() < MAX_TABLE_SIZE) {
+        if (isTableAscending) {
+            if (k == b) {
+                isComplete = true;
+                break;
+            }
+            ++k;
+            probability *= lambda / k;
+        }
+        else {
+            if (k == a) {
+                isComplete = true;
+                break;
+            }
+            probability *= k / lambda;
+            --k;
+        }
+        total += probability;
+        table.push_back(total);
+        bool isDecreasing = isTableAscending ? (k > mode) : (k <= mode);
+        if (isDecreasing && probability < EPSILON * total) {
+            isComplete = true;
+            break;
+        }
+    }
+    if (!isComplete || !std::isfinite(total)) {
+        table.clear();
+        samplerId = INVERSION;
+        return;
+    }
+    samplerId = TABLE;
+}
+
+template < typename IntType >
+IntType TruncatedRand<PoissonRand<IntType>>::Variate() const
+{
+    if (samplerId == REJECTION) {
+        IntType a = this->GetLowerBound(), b = this->GetUpperBound();
+        IntType k = 0;
+        do {
+            k = this->distribution.Variate();
+        } while (k < a || k > b);
+        return k;
+    }
+    if (samplerId == TABLE) {
+        double u = table.back() * UniformRand<double>::StandardVariate(this->localRandGenerator);
+        size_t index = std::upper_bound(table.begin(), table.end(), u) - table.begin();
+        IntType shift = std::min(index, table.size() - 1);
+        return isTableAscending ? tableStart + shift : tableStart - shift;
+    }
+    return TruncatedDistribution<IntType>::Variate();
+}
+
+template < typename IntType >
+void TruncatedRand<PoissonRand<IntType>>::Reseed(unsigned long seed) const
+{
+    TruncatedDistribution<IntType>::Reseed(seed);
+    this->distribution.Reseed(seed);
+}
+
+template class TruncatedRand<PoissonRand<int>>;
+template class TruncatedRand<PoissonRand<long int>>;
+template class TruncatedRand<PoissonRand<long long int>>;
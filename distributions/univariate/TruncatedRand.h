@@ -0,0 +1,497 @@
+#ifndef TRUNCATEDRAND_H
+#define TRUNCATEDRAND_H
+
+#include "continuous/NormalRand.h"
+#include "continuous/ExponentialRand.h"
+#include "continuous/GammaRand.h"
+#include "discrete/PoissonRand.h"
+
+/**
+ * @brief The TruncatedDensity class <BR>
+ * Abstract parent class, which connects density of truncated distribution to the continuous or discrete hierarchy
+ */
+template < typename T, bool isContinuous = std::is_floating_point_v<T> >
+class RANDLIBSHARED_EXPORT TruncatedDensity;
+
+template < typename RealType >
+class RANDLIBSHARED_EXPORT TruncatedDensity<RealType, true> : public ContinuousDistribution<RealType>
+{
+public:
+    typedef ContinuousDistribution<RealType> Component;
+
+protected:
+    TruncatedDensity() {}
+    virtual ~TruncatedDensity() {}
+
+    static double componentLogDensity(const Component &component, const RealType &x) { return component.logf(x); }
+
+    /**
+     * @fn truncatedLogDensity
+     * @param x
+     * @return logarithm of density of the truncated distribution
+     */
+    virtual double truncatedLogDensity(const RealType &x) const = 0;
+
+public:
+    double f(const RealType & x) const override { return std::exp(truncatedLogDensity(x)); }
+    double logf(const RealType & x) const override { return truncatedLogDensity(x); }
+};
+
+template < typename IntType >
+class RANDLIBSHARED_EXPORT TruncatedDensity<IntType, false> : public DiscreteDistribution<IntType>
+{
+public:
+    typedef DiscreteDistribution<IntType> Component;
+
+protected:
+    TruncatedDensity() {}
+    virtual ~TruncatedDensity() {}
+
+    static double componentLogDensity(const Component &component, const IntType &k) { return component.logP(k); }
+
+    /**
+     * @fn truncatedLogDensity
+     * @param k
+     * @return logarithm of probability of the truncated distribution to get k
+     */
+    virtual double truncatedLogDensity(const IntType &k) const = 0;
+
+public:
+    double P(const IntType & k) const override { return std::exp(truncatedLogDensity(k)); }
+    double logP(const IntType & k) const override { return truncatedLogDensity(k); }
+};
+
+
+/**
+ * @brief The TruncatedDistribution class <BR>
+ * Abstract parent class for distributions, truncated to the interval [a, b]
+ *
+ * f(x) = f_0(x) / (F_0(b) - F_0(a)) for a <= x <= b
+ *
+ * Probability of the interval and all distribution functions are calculated in log-space
+ * through the tail, which contains the interval, so that the deep tails keep their relative accuracy.
+ * Variates are generated by inversion: uniform variate is mapped into the probabilities of the tail
+ * between the bounds and passed to Quantile or Quantile1m of the original distribution.
+ * Children can replace it by exact samplers, which don't depend on the accuracy of quantile.
+ */
+template < typename T >
+class RANDLIBSHARED_EXPORT TruncatedDistribution : public TruncatedDensity<T>
+{
+public:
+    typedef typename TruncatedDensity<T>::Component Component;
+
+private:
+    T a = 0; ///< lower bound
+    T b = 1; ///< upper bound
+    bool isRightTail = false; ///< true if probabilities are calculated through survival function
+    double logLowerTail = -INFINITY; ///< log(F_0(a-)) or log(S_0(a-))
+    double logUpperTail = 0; ///< log(F_0(b)) or log(S_0(b))
+    double logMass = 0; ///< log(F_0(b) - F_0(a-))
+
+protected:
+    TruncatedDistribution() {}
+    virtual ~TruncatedDistribution() {}
+
+    /**
+     * @fn component
+     * @return original distribution
+     */
+    virtual const Component &component() const = 0;
+
+    /**
+     * @fn componentLogF
+     * @param x
+     * @return logarithm of cdf of the original distribution,
+     * children should override it if it's known beyond the range of double
+     */
+    virtual double componentLogF(const T &x) const { return std::log(component().F(x)); }
+
+    /**
+     * @fn componentLogS
+     * @param x
+     * @return logarithm of survival function of the original distribution
+     */
+    virtual double componentLogS(const T &x) const { return std::log(component().S(x)); }
+
+    /**
+     * @fn setTruncation
+     * calculate probability of the interval, which is intersected with the support of the original distribution
+     * @param lowerBound a
+     * @param upperBound b
+     */
+    void setTruncation(T lowerBound, T upperBound);
+
+    /**
+     * @fn prepareSampler
+     * recalculate constants of the sampler after change of the bounds or the original distribution
+     */
+    virtual void prepareSampler() {}
+
+    double truncatedLogDensity(const T &x) const override;
+
+public:
+    String Name() const override;
+    SUPPORT_TYPE SupportType() const override;
+    T MinValue() const override { return a; }
+    T MaxValue() const override { return b; }
+
+    /**
+     * @fn SetTruncation
+     * @param lowerBound a
+     * @param upperBound b, interval should have positive probability
+     */
+    void SetTruncation(T lowerBound, T upperBound);
+    inline T GetLowerBound() const { return a; }
+    inline T GetUpperBound() const { return b; }
+
+    /**
+     * @fn GetMass
+     * @return probability of the interval for the original distribution
+     */
+    inline double GetMass() const { return std::exp(logMass); }
+
+    /**
+     * @fn GetLogMass
+     * @return logarithm of probability of the interval, which is finite even if the probability underflows
+     */
+    inline double GetLogMass() const { return logMass; }
+
+    double F(const T & x) const override;
+    double S(const T & x) const override;
+    T Variate() const override;
+
+    long double Mean() const override;
+    long double Variance() const override;
+
+    /**
+     * @fn Mode
+     * @return mode of the original distribution, clamped to the interval, which is exact for unimodal distributions
+     */
+    T Mode() const override;
+
+private:
+    /**
+     * @fn logLowerF
+     * @return log(F_0(a-)): probability of the values less than a
+     */
+    double logLowerF() const;
+
+    /**
+     * @fn logLowerS
+     * @return log(S_0(a-)): probability of the values not less than a
+     */
+    double logLowerS() const;
+
+    /**
+     * @fn componentLogTail
+     * @param p probability of the truncated distribution to be less than x
+     * @param q probability of the truncated distribution to be greater than x, equal to 1 - p
+     * @return logarithm of probability of the same tail of the original distribution as the mass,
+     * which is measured from the closest bound
+     */
+    double componentLogTail(double p, double q) const;
+
+    /**
+     * @fn quantileFromTails
+     * @param p
+     * @param q 1 - p
+     * @param quantile quantile of the original distribution for the same tail
+     * @return false if the tail of the original distribution underflows,
+     * then the root of the truncated cdf should be found instead
+     */
+    bool quantileFromTails(double p, double q, T &quantile) const;
+
+    /**
+     * @fn tailDiverges
+     * @param power n
+     * @param isRight
+     * @param scale spread of the truncated distribution
+     * @return true if x^n P(|X| > x) doesn't vanish in the given tail of the original distribution,
+     * i.e. the moment of order n diverges there
+     */
+    bool tailDiverges(int power, bool isRight, double scale) const;
+
+    /**
+     * @fn standardizedExpectation
+     * @param funPtr function g
+     * @param center c
+     * @param scale s
+     * @return E[g((X - c) / s)], each side of c is mapped onto [0, 1) by y = t / (1 - t),
+     * so that the tolerance of integration is relative to the spread of the distribution
+     */
+    long double standardizedExpectation(const std::function<double (double)> &funPtr, double center, double scale) const;
+
+    /**
+     * @fn continuousMoments
+     * @param isVarianceNeeded
+     * @return mean and variance, integrated in the coordinates standardized by the median and quartiles,
+     * infinite or NaN if the moment of the original distribution diverges on the unbounded side
+     */
+    LongDoublePair continuousMoments(bool isVarianceNeeded) const;
+
+    /**
+     * @fn discreteMoments
+     * @return mean and variance, summed from the mode of the truncated distribution
+     * till the probabilities become negligible
+     */
+    LongDoublePair discreteMoments() const;
+
+protected:
+    T quantileImpl(double p, T initValue) const override;
+    T quantileImpl(double p) const override;
+    T quantileImpl1m(double p, T initValue) const override;
+    T quantileImpl1m(double p) const override;
+};
+
+
+/**
+ * @brief The TruncatedWrapper class <BR>
+ * Common part of TruncatedRand, which stores the original distribution
+ */
+template < class Distribution >
+class RANDLIBSHARED_EXPORT TruncatedWrapper : public TruncatedDistribution<decltype(std::declval<Distribution>().Variate())>
+{
+    typedef decltype(std::declval<Distribution>().Variate()) T;
+    typedef typename TruncatedDistribution<T>::Component Component;
+    static_assert(std::is_base_of_v<Component, Distribution>, "Original distribution should be a univariate distribution");
+
+protected:
+    Distribution distribution;
+
+    /// bounds are set by the final class, so that its functions of the original distribution are used
+    explicit TruncatedWrapper(const Distribution &original) : distribution(original) {}
+
+public:
+    inline const Distribution &GetDistribution() const { return distribution; }
+
+    /**
+     * @fn SetDistribution
+     * @param original distribution, which should give positive probability to the current interval
+     */
+    void SetDistribution(const Distribution &original)
+    {
+        distribution = original;
+        this->setTruncation(this->GetLowerBound(), this->GetUpperBound());
+        this->prepareSampler();
+    }
+
+protected:
+    const Component &component() const override { return distribution; }
+};
+
+
+/**
+ * @brief The TruncatedRand class <BR>
+ * Distribution, truncated to the interval [a, b]
+ *
+ * f(x) = f_0(x) / (F_0(b) - F_0(a)) for a <= x <= b
+ *
+ * Notation: X ~ Truncated(F_0, a, b)
+ *
+ * Bounds are inclusive, infinite bounds are allowed for continuous distributions.
+ * Normal, exponential, gamma and Poisson distributions have exact samplers,
+ * any other distribution is sampled by inversion.
+ */
+template < class Distribution >
+class RANDLIBSHARED_EXPORT TruncatedRand : public TruncatedWrapper<Distribution>
+{
+    typedef decltype(std::declval<Distribution>().Variate()) T;
+
+public:
+    TruncatedRand(const Distribution &original, T lowerBound, T upperBound) : TruncatedWrapper<Distribution>(original)
+    {
+        this->SetTruncation(lowerBound, upperBound);
+    }
+};
+
+
+/**
+ * @brief The TruncatedRand<NormalRand> class <BR>
+ * Normal distribution, truncated to [a, b]
+ *
+ * Variates are generated by Robert's algorithm for standardized bounds:
+ * rejection from normal or half-normal distribution if the interval is likely,
+ * from uniform distribution if the interval is short and from translated exponential distribution
+ * with optimal rate otherwise, so that acceptance doesn't vanish in the tails.
+ */
+template < typename RealType >
+class RANDLIBSHARED_EXPORT TruncatedRand<NormalRand<RealType>> : public TruncatedWrapper<NormalRand<RealType>>
+{
+    enum SAMPLER_ID {
+        NORMAL_REJECTION,
+        HALF_NORMAL_REJECTION,
+        UNIFORM_REJECTION,
+        EXPONENTIAL_REJECTION
+    };
+
+    SAMPLER_ID samplerId = NORMAL_REJECTION;
+    double alpha = 0; ///< standardized lower bound, after reflection if the interval is on the left
+    double beta = 1; ///< standardized upper bound
+    bool isReflected = false; ///< true if the interval is reflected around the location
+    double rate = 1; ///< rate of exponential proposal
+    double exponentialMass = 1; ///< probability of exponential proposal to be less than β - α
+    double uniformShift = 0; ///< α^2 if α > 0 and 0 otherwise, logarithm of density ratio is (shift - z^2) / 2
+
+public:
+    TruncatedRand(const NormalRand<RealType> &original, RealType lowerBound, RealType upperBound);
+
+    RealType Variate() const override;
+    long double Mean() const override;
+    long double Variance() const override;
+
+protected:
+    double componentLogF(const RealType &x) const override;
+    double componentLogS(const RealType &x) const override;
+    void prepareSampler() override;
+
+private:
+    /**
+     * @fn standardLogS
+     * @param z
+     * @return logarithm of survival function of standard normal distribution,
+     * calculated through scaled complementary error function in the right tail
+     */
+    static double standardLogS(double z);
+
+    /**
+     * @fn standardTailMoments
+     * @param z
+     * @param excess E[Z - z | Z > z] for standard normal Z
+     * @param variance Var(Z | Z > z),
+     * calculated through continued fraction of Mills ratio in the right tail to avoid cancellation
+     */
+    static void standardTailMoments(double z, double &excess, double &variance);
+
+    /**
+     * @fn standardMoments
+     * @return mean and variance of standard normal distribution, truncated to [α, β]:
+     * Taylor series in the width for narrow intervals, difference of the tails beyond α and β
+     * for intervals on one side of the location, and closed form otherwise
+     */
+    LongDoublePair standardMoments() const;
+};
+
+
+/**
+ * @brief The TruncatedGammaDistribution class <BR>
+ * Abstract parent class for gamma distributions, truncated to [a, b]
+ *
+ * Likely intervals are sampled by rejection from the original distribution.
+ * Otherwise, for k >= 1 density is log-concave, so that it's bounded by the exponential tangent
+ * at the bound, closest to the mode, or by the constant if the mode is inside of the interval.
+ * Exponential distribution is sampled this way without rejection.
+ * For k < 1 right tail is bounded by the exponential density with rate β,
+ * the interval near zero by power density x^(k - 1), and the rest is sampled by inversion.
+ */
+template < typename RealType, class Distribution >
+class RANDLIBSHARED_EXPORT TruncatedGammaDistribution : public TruncatedWrapper<Distribution>
+{
+    enum SAMPLER_ID {
+        INVERSION,
+        GAMMA_REJECTION,
+        EXPONENTIAL_REJECTION,
+        UNIFORM_REJECTION,
+        POWER_REJECTION
+    };
+
+    SAMPLER_ID samplerId = INVERSION;
+    double shapem1 = 0; ///< k - 1
+    double touchPoint = 0; ///< c - point, where the envelope touches the density
+    bool isAscending = true; ///< true if exponential proposal goes to the right from c
+    double rate = 1; ///< rate of exponential proposal, which is equal to |β - (k - 1) / c|
+    double exponentialMass = 1; ///< probability of exponential proposal to be less than b - a
+    double powerRatio = 0; ///< (a / b)^k
+
+    /**
+     * @fn logRatio
+     * @param x
+     * @return log(f(x) / f(c)) + rate * |x - c|
+     */
+    double logRatio(double x) const;
+
+protected:
+    TruncatedGammaDistribution(const Distribution &original, RealType lowerBound, RealType upperBound);
+
+public:
+    RealType Variate() const override;
+
+protected:
+    double componentLogF(const RealType &x) const override;
+    double componentLogS(const RealType &x) const override;
+    void prepareSampler() override;
+};
+
+
+/**
+ * @brief The TruncatedRand<GammaRand> class <BR>
+ * Gamma distribution, truncated to [a, b]
+ */
+template < typename RealType >
+class RANDLIBSHARED_EXPORT TruncatedRand<GammaRand<RealType>> : public TruncatedGammaDistribution<RealType, GammaRand<RealType>>
+{
+public:
+    TruncatedRand(const GammaRand<RealType> &original, RealType lowerBound, RealType upperBound);
+};
+
+
+/**
+ * @brief The TruncatedRand<ExponentialRand> class <BR>
+ * Exponential distribution, truncated to [a, b]
+ *
+ * X - a has exponential distribution, truncated to [0, b - a], because of memorylessness.
+ */
+template < typename RealType >
+class RANDLIBSHARED_EXPORT TruncatedRand<ExponentialRand<RealType>> : public TruncatedGammaDistribution<RealType, ExponentialRand<RealType>>
+{
+public:
+    TruncatedRand(const ExponentialRand<RealType> &original, RealType lowerBound, RealType upperBound);
+
+    long double Mean() const override;
+    long double Variance() const override;
+};
+
+
+/**
+ * @brief The TruncatedRand<PoissonRand> class <BR>
+ * Poisson distribution, truncated to {a, ..., b}
+ *
+ * Likely intervals are sampled by rejection, unlikely ones by binary search in the table
+ * of cumulative probabilities, which are built by recursion P(k + 1) = P(k) λ / (k + 1)
+ * from the bound closest to the mode, so that the tails don't suffer from underflow.
+ * Intervals, which need too large table, are sampled by inversion.
+ */
+template < typename IntType >
+class RANDLIBSHARED_EXPORT TruncatedRand<PoissonRand<IntType>> : public TruncatedWrapper<PoissonRand<IntType>>
+{
+    enum SAMPLER_ID {
+        INVERSION,
+        REJECTION,
+        TABLE
+    };
+
+    static constexpr size_t MAX_TABLE_SIZE = 1 << 16;
+
+    SAMPLER_ID samplerId = INVERSION;
+    IntType tableStart = 0; ///< value of the first element of the table
+    bool isTableAscending = true; ///< true if the values increase along the table
+    std::vector<double> table{}; ///< cumulative probabilities, relative to the probability of the first element
+
+public:
+    TruncatedRand(const PoissonRand<IntType> &original, IntType lowerBound, IntType upperBound);
+
+    IntType Variate() const override;
+
+    /**
+     * @fn Reseed
+     * reseed also the original distribution, which generates variates of likely intervals
+     * @param seed
+     */
+    void Reseed(unsigned long seed) const override;
+
+protected:
+    double componentLogF(const IntType &k) const override;
+    double componentLogS(const IntType &k) const override;
+    void prepareSampler() override;
+};
+
+#endif // TRUNCATEDRAND_H
@@ -53,10 +53,56 @@ T UnivariateDistribution<T>::Quantile1m(double p) const
     return (x > maxVal) ? maxVal : x;
 }
 
+template< typename T >
+thread_local typename UnivariateDistribution<T>::QuantileSweep *UnivariateDistribution<T>::currentSweep = nullptr;
+
+template< typename T >
+bool UnivariateDistribution<T>::getPreviousQuantile(T &x, double &p) const
+{
+    if (currentSweep == nullptr || currentSweep->owner != this || !currentSweep->hasPrevious)
+        return false;
+    x = currentSweep->previousQuantile;
+    p = currentSweep->previousProbability;
+    return true;
+}
+
+template< typename T >
+void UnivariateDistribution<T>::setPreviousQuantile(const T &x, double p) const
+{
+    if (currentSweep != nullptr && currentSweep->owner == this) {
+        currentSweep->previousQuantile = x;
+        currentSweep->previousProbability = p;
+        currentSweep->hasPrevious = true;
+    }
+}
+
+template< typename T >
+void UnivariateDistribution<T>::quantileSweepImpl(const std::vector<double> &p, std::vector<T> &y, bool isComplement) const
+{
+    int size = std::min(p.size(), y.size());
+    QuantileSweep sweep = {this, false, 0, 0};
+    QuantileSweep *outerSweep = currentSweep;
+    currentSweep = &sweep;
+    try {
+        for (int i = 0; i != size; ++i)
+            y[i] = isComplement ? this->Quantile1m(p[i]) : this->Quantile(p[i]);
+    }
+    catch (...) {
+        currentSweep = outerSweep;
+        throw;
+    }
+    currentSweep = outerSweep;
+}
+
 template< typename T >
 void UnivariateDistribution<T>::QuantileFunction(const std::vector<double> &p, std::vector<T> &y)
 {
     int size = std::min(p.size(), y.size());
+    if (size > 1 && (std::is_sorted(p.begin(), p.begin() + size) ||
+                     std::is_sorted(p.begin(), p.begin() + size, std::greater<>()))) {
+        quantileSweepImpl(p, y, false);
+        return;
+    }
     for (int i = 0; i != size; ++i)
         y[i] = this->Quantile(p[i]);
 }
@@ -65,6 +111,11 @@ template< typename T >
 void UnivariateDistribution<T>::QuantileFunction1m(const std::vector<double> &p, std::vector<T> &y)
 {
     int size = std::min(p.size(), y.size());
+    if (size > 1 && (std::is_sorted(p.begin(), p.begin() + size) ||
+                     std::is_sorted(p.begin(), p.begin() + size, std::greater<>()))) {
+        quantileSweepImpl(p, y, true);
+        return;
+    }
     for (int i = 0; i != size; ++i)
         y[i] = this->Quantile1m(p[i]);
 }
@@ -84,15 +135,14 @@ std::complex<double> UnivariateDistribution<T>::CFImpl(double t) const
     if (leftBound == rightBound)
         return std::complex<double>(std::cos(t * leftBound), std::sin(t * leftBound));
 
-    double re = this->ExpectedValue([this, t] (double x)
+    std::vector<long double> reim = this->ExpectedValues({[t] (T x)
     {
         return std::cos(t * x);
-    }, leftBound, rightBound);
-
-    double im = this->ExpectedValue([this, t] (double x)
+    }, [t] (T x)
     {
         return std::sin(t * x);
-    }, leftBound, rightBound);
+    }}, leftBound, rightBound);
+    double re = reim[0], im = reim[1];
 
     return std::complex<double>(re, im);
 }
@@ -120,40 +170,60 @@ T UnivariateDistribution<T>::Median() const
 }
 
 template< typename T >
-long double UnivariateDistribution<T>::Skewness() const
+std::vector<long double> UnivariateDistribution<T>::ExpectedValues(const std::vector<std::function<double (T)>> &funPtrs, T minPoint, T maxPoint) const
 {
-    long double var = this->Variance();
-    if (!std::isfinite(var))
-        return NAN;
-    long double mu = this->Mean(); /// var is finite, so is mu
-
-    long double sum = this->ExpectedValue([this, mu] (double x)
-    {
-        double xmmu = x - mu;
-        double skewness = xmmu * xmmu * xmmu;
-        return skewness;
-    }, this->MinValue(), this->MaxValue());
+    std::vector<long double> values(funPtrs.size());
+    for (size_t i = 0; i != funPtrs.size(); ++i)
+        values[i] = this->ExpectedValue(funPtrs[i], minPoint, maxPoint);
+    return values;
+}
 
-    return sum / std::pow(var, 1.5);
+template< typename T >
+void UnivariateDistribution<T>::invalidateMoments()
+{
+    hasCachedMoments = false;
 }
 
 template< typename T >
-long double UnivariateDistribution<T>::ExcessKurtosis() const
+bool UnivariateDistribution<T>::calculateMoments() const
 {
     long double var = this->Variance();
     if (!std::isfinite(var))
-        return NAN;
+        return false;
     long double mu = this->Mean(); /// var is finite, so is mu
+    /// mean and variance are explicit, so they are used as a key in case if some setter doesn't invalidate the cache
+    if (hasCachedMoments && cachedMean == mu && cachedVariance == var)
+        return true;
 
-    long double sum = this->ExpectedValue([this, mu] (double x)
+    std::vector<long double> moments = this->ExpectedValues({[mu] (T x)
     {
         double xmmu = x - mu;
-        double kurtosisSqrt = xmmu * xmmu;
-        double kurtosis = kurtosisSqrt * kurtosisSqrt;
-        return kurtosis;
-    }, this->MinValue(), this->MaxValue());
+        return xmmu * xmmu * xmmu;
+    }, [mu] (T x)
+    {
+        double xmmuSq = x - mu;
+        xmmuSq *= xmmuSq;
+        return xmmuSq * xmmuSq;
+    }}, this->MinValue(), this->MaxValue());
+
+    cachedMean = mu;
+    cachedVariance = var;
+    cachedSkewness = moments[0] / std::pow(var, 1.5);
+    cachedExcessKurtosis = moments[1] / (var * var) - 3;
+    hasCachedMoments = true;
+    return true;
+}
 
-    return sum / (var * var) - 3;
+template< typename T >
+long double UnivariateDistribution<T>::Skewness() const
+{
+    return calculateMoments() ? cachedSkewness : NAN;
+}
+
+template< typename T >
+long double UnivariateDistribution<T>::ExcessKurtosis() const
+{
+    return calculateMoments() ? cachedExcessKurtosis : NAN;
 }
 
 template< typename T >
@@ -234,6 +304,21 @@ bool UnivariateDistribution<T>::allElementsArePositive(const std::vector<T> &sam
     return true;
 }
 
+template< typename T >
+std::vector<size_t> UnivariateDistribution<T>::groupIndicesByRegime(const std::vector<int> &regimeIds, int numberOfRegimes, std::vector<size_t> &indices)
+{
+    std::vector<size_t> offsets(numberOfRegimes + 1, 0);
+    for (int id : regimeIds)
+        ++offsets[id + 1];
+    for (int i = 0; i != numberOfRegimes; ++i)
+        offsets[i + 1] += offsets[i];
+    indices.resize(regimeIds.size());
+    std::vector<size_t> position(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i != regimeIds.size(); ++i)
+        indices[position[regimeIds[i]]++] = i;
+    return offsets;
+}
+
 template< typename T >
 long double UnivariateDistribution<T>::GetSampleSum(const std::vector<T> &sample)
 {
@@ -52,6 +52,13 @@ public:
      */
     virtual long double Variance() const = 0;
 
+    /**
+     * @fn BuildCaches
+     * build the tables, which are otherwise calculated on demand by const methods (density, cdf, quantile),
+     * so that these methods can be called concurrently afterwards, until parameters are changed
+     */
+    virtual void BuildCaches() const {}
+
 private:
     /**
      * @fn quantileImpl
@@ -71,7 +78,46 @@ private:
     virtual T quantileImpl1m(double p, T initValue) const = 0;
     virtual T quantileImpl1m(double p) const = 0;
 
+    /**
+     * @brief The QuantileSweep struct
+     * state of the monotone sweep, which lives on the stack of quantileSweepImpl
+     */
+    struct QuantileSweep
+    {
+        const UnivariateDistribution<T> *owner; ///< distribution, which calculates quantiles in the sweep
+        bool hasPrevious; ///< true if previous root is stored
+        T previousQuantile; ///< previous root
+        double previousProbability; ///< probability of the previous root
+    };
+    /// sweep of the current thread, so that concurrent calls on the same object don't share the state
+    static thread_local QuantileSweep *currentSweep;
+
 protected:
+    /**
+     * @fn getPreviousQuantile
+     * @param x previous root of quantile function
+     * @param p probability of the previous root
+     * @return true if quantiles are calculated in a monotone sweep and previous root is known
+     */
+    bool getPreviousQuantile(T &x, double &p) const;
+
+    /**
+     * @fn setPreviousQuantile
+     * store the root as a seed for the next one, if quantiles are calculated in a monotone sweep
+     * @param x
+     * @param p probability of x
+     */
+    void setPreviousQuantile(const T &x, double p) const;
+
+    /**
+     * @fn quantileSweepImpl
+     * fill y with quantileImpl(p) or quantileImpl1m(p), seeding each root from the previous one
+     * @param p monotone sequence of probabilities
+     * @param y
+     * @param isComplement true if quantileImpl1m should be used
+     */
+    virtual void quantileSweepImpl(const std::vector<double> &p, std::vector<T> &y, bool isComplement) const;
+
     /**
      * @fn CFimpl
      * @param t
@@ -87,6 +133,38 @@ protected:
      * @return E[g(x)]
      */
     virtual long double ExpectedValue(const std::function<double (T)> &funPtr, T minPoint, T maxPoint) const = 0;
+
+    /**
+     * @fn ExpectedValues
+     * @param funPtrs functions g_i(x) with finite support which expected values should be returned
+     * @param minPoint min{x | g_i(x) ≠ 0}
+     * @param maxPoint max{x | g_i(x) ≠ 0}
+     * @return E[g_i(x)] for each of the functions,
+     * implementations evaluate distribution at the same nodes for all of them
+     */
+    virtual std::vector<long double> ExpectedValues(const std::vector<std::function<double (T)>> &funPtrs, T minPoint, T maxPoint) const;
+
+    /**
+     * @fn invalidateMoments
+     * drop cached skewness and kurtosis, should be called by setters of distributions,
+     * which rely on numerical calculation of these moments
+     */
+    void invalidateMoments();
+
+private:
+    mutable bool hasCachedMoments = false; ///< true if skewness and excess kurtosis are calculated numerically and stored
+    mutable long double cachedMean = 0; ///< mean, for which the moments are stored
+    mutable long double cachedVariance = 0; ///< variance, for which the moments are stored
+    mutable long double cachedSkewness = 0; ///< stored skewness
+    mutable long double cachedExcessKurtosis = 0; ///< stored excess kurtosis
+
+    /**
+     * @fn calculateMoments
+     * calculate third and fourth central moments in one pass and store skewness and excess kurtosis
+     * @return false if variance is not finite
+     */
+    bool calculateMoments() const;
+
 public:
     /**
      * @fn Quantile
@@ -106,7 +184,8 @@ public:
      * @fn QuantileFunction
      * @param p
      * @param y
-     * @return fills vector y with Quantile(p)
+     * @return fills vector y with Quantile(p),
+     * if p is sorted, each root is seeded from the previous one
      */
     void QuantileFunction(const std::vector<double> &p, std::vector<T> &y);
 
@@ -114,7 +193,8 @@ public:
      * @fn QuantileFunction1m
      * @param p
      * @param y
-     * @return fills vector y with Quantile1m(p)
+     * @return fills vector y with Quantile1m(p),
+     * if p is sorted, each root is seeded from the previous one
      */
     void QuantileFunction1m(const std::vector<double> &p, std::vector<T> &y);
 
@@ -244,6 +324,17 @@ protected:
      */
     static bool allElementsArePositive(const std::vector<T> &sample);
 
+    /**
+     * @fn groupIndicesByRegime
+     * stable counting sort of indices 0, ..., n-1 by the regime (generator id) of each element,
+     * so that elements, which share the same variate generator, can be processed together
+     * @param regimeIds id of regime for each element, should be in [0, numberOfRegimes)
+     * @param numberOfRegimes
+     * @param indices output permutation, where indices of each regime are contiguous
+     * @return offsets of the regimes in indices (numberOfRegimes + 1 values)
+     */
+    static std::vector<size_t> groupIndicesByRegime(const std::vector<int> &regimeIds, int numberOfRegimes, std::vector<size_t> &indices);
+
 public:
     /**
      * @fn GetSampleSum
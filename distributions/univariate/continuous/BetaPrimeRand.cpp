@@ -59,7 +59,12 @@ double BetaPrimeRand<RealType>::F(const RealType & x) const
 template < typename RealType >
 double BetaPrimeRand<RealType>::S(const RealType &x) const
 {
-    return (x > 0) ? B.S(x / (1.0 + x)) : 1;
+    if (x <= 1)
+        return (x > 0) ? B.S(x / (1.0 + x)) : 1;
+    /// S(x) = P(Y < 1 / (1 + x)), where Y = 1 / (1 + X) ~ B(β, α),
+    /// so that the right tail doesn't vanish when x / (1 + x) is rounded to 1
+    double log1pX = std::log1p(x);
+    return RandMath::ibeta(1.0 / (1.0 + x), beta, alpha, GetLogBetaFunction(), -log1pX, std::log(x) - log1pX);
 }
 
 template < typename RealType >
@@ -150,14 +155,21 @@ template < typename RealType >
 RealType BetaPrimeRand<RealType>::quantileImpl(double p) const
 {
     double x = B.Quantile(p);
-    return x / (1.0 - x);
+    if (x <= 0.5)
+        return x / (1.0 - x);
+    /// X = (1 - Y) / Y, where Y = 1 / (1 + X) ~ B(β, α) is small in the right tail
+    double y = RandMath::ibetacinv(p, beta, alpha, GetLogBetaFunction());
+    return (1.0 - y) / y;
 }
 
 template < typename RealType >
 RealType BetaPrimeRand<RealType>::quantileImpl1m(double p) const
 {
     double x = B.Quantile1m(p);
-    return x / (1.0 - x);
+    if (x <= 0.5)
+        return x / (1.0 - x);
+    double y = RandMath::ibetainv(p, beta, alpha, GetLogBetaFunction());
+    return (1.0 - y) / y;
 }
 
 template < typename RealType >
@@ -167,17 +179,16 @@ std::complex<double> BetaPrimeRand<RealType>::CFImpl(double t) const
     if (alpha >= 1)
         return UnivariateDistribution<RealType>::CFImpl(t);
 
-    double re = this->ExpectedValue([this, t] (double x)
+    std::vector<long double> reim = this->ExpectedValues({[t] (double x)
     {
         if (x == 0.0)
             return 0.0;
         return std::cos(t * x) - 1.0;
-    }, 0.0, INFINITY) + 1.0;
-
-    double im = this->ExpectedValue([this, t] (double x)
+    }, [t] (double x)
     {
         return std::sin(t * x);
-    }, 0.0, INFINITY);
+    }}, 0.0, INFINITY);
+    double re = reim[0] + 1.0, im = reim[1];
     return std::complex<double>(re, im);
 }
 
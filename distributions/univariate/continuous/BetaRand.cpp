@@ -11,27 +11,34 @@ BetaDistribution<RealType>::BetaDistribution(double shape1, double shape2, doubl
 }
 
 template < typename RealType >
-void BetaDistribution<RealType>::setCoefficientsForGenerator()
+typename BetaDistribution<RealType>::genCoef_t BetaDistribution<RealType>::getCoefficientsForGenerator(GENERATOR_ID id, double shape1, double shape2)
 {
-    GENERATOR_ID id = getIdOfUsedGenerator();
+    genCoef_t coef = {0, 0, 0};
     if (id == REJECTION_NORMAL) {
-        double alpham1 = alpha - 1;
-        genCoef.s = alpham1 * std::log1pl(0.5 / alpham1) - 0.5;
-        genCoef.t = 1.0 / std::sqrt(8 * alpha - 4);
+        double shape1m1 = shape1 - 1;
+        coef.s = shape1m1 * std::log1pl(0.5 / shape1m1) - 0.5;
+        coef.t = 1.0 / std::sqrt(8 * shape1 - 4);
     }
     else if (id == CHENG) {
-        genCoef.s = alpha + beta;
-        genCoef.t = std::min(alpha, beta);
-        if (genCoef.t > 1)
-            genCoef.t = std::sqrt((2 * alpha * beta - genCoef.s) / (genCoef.s - 2));
-        genCoef.u = alpha + genCoef.t;
+        coef.s = shape1 + shape2;
+        coef.t = std::min(shape1, shape2);
+        if (coef.t > 1)
+            coef.t = std::sqrt((2 * shape1 * shape2 - coef.s) / (coef.s - 2));
+        coef.u = shape1 + coef.t;
     }
     else if (id == ATKINSON_WHITTAKER) {
-        genCoef.t = std::sqrt(alpha * (1 - alpha));
-        genCoef.t /= (genCoef.t + std::sqrt(beta * (1 - beta)));
-        genCoef.s = beta * genCoef.t;
-        genCoef.s /= (genCoef.s + alpha * (1 - genCoef.t));
+        coef.t = std::sqrt(shape1 * (1 - shape1));
+        coef.t /= (coef.t + std::sqrt(shape2 * (1 - shape2)));
+        coef.s = shape2 * coef.t;
+        coef.s /= (coef.s + shape1 * (1 - coef.t));
     }
+    return coef;
+}
+
+template < typename RealType >
+void BetaDistribution<RealType>::setCoefficientsForGenerator()
+{
+    genCoef = getCoefficientsForGenerator(getIdOfUsedGenerator(alpha, beta), alpha, beta);
 }
 
 #if HAVE_MATH_SPECIAL_FUNCTIONS
@@ -44,8 +51,9 @@ void BetaDistribution<RealType>::SetShapes(double shape1, double shape2)
     GammaRV2.SetParameters(shape2, 1);
     alpha = GammaRV1.GetShape();
     beta = GammaRV2.GetShape();
-    betaFun = std::betal(alpha, beta);
-    logBetaFun = std::log(betaFun);
+    /// beta function underflows for large shapes, so its logarithm is calculated separately
+    logBetaFun = RandMath::logBeta(alpha, beta);
+    betaFun = std::exp(logBetaFun);
     setCoefficientsForGenerator();
 }
 #else
@@ -141,118 +149,158 @@ double BetaDistribution<RealType>::S(const RealType &x) const
 }
 
 template < typename RealType >
-RealType BetaDistribution<RealType>::variateArcsine() const
+void BetaDistribution<RealType>::CumulativeDistributionFunction(const std::vector<RealType> &x, std::vector<double> &y) const
+{
+    /// Workaround known case
+    if (alpha == beta && beta == 0.5)
+        return ContinuousDistribution<RealType>::CumulativeDistributionFunction(x, y);
+    size_t size = x.size();
+    if (size > y.size())
+        return;
+    /// Standardize
+    std::vector<double> xSt(size);
+    for (size_t i = 0; i != size; ++i) {
+        if (x[i] <= a)
+            xSt[i] = 0.0;
+        else
+            xSt[i] = (x[i] >= b) ? 1.0 : (x[i] - a) * bmaInv;
+    }
+    RandMath::ibeta(xSt, y, alpha, beta, logBetaFun);
+}
+
+template < typename RealType >
+void BetaDistribution<RealType>::SurvivalFunction(const std::vector<RealType> &x, std::vector<double> &y) const
+{
+    /// Workaround known case
+    if (alpha == beta && beta == 0.5)
+        return ContinuousDistribution<RealType>::SurvivalFunction(x, y);
+    size_t size = x.size();
+    if (size > y.size())
+        return;
+    /// Standardize
+    std::vector<double> xSt(size);
+    for (size_t i = 0; i != size; ++i) {
+        if (x[i] <= a)
+            xSt[i] = 0.0;
+        else
+            xSt[i] = (x[i] >= b) ? 1.0 : (x[i] - a) / bma;
+    }
+    RandMath::ibetac(xSt, y, alpha, beta, logBetaFun);
+}
+
+template < typename RealType >
+RealType BetaDistribution<RealType>::variateArcsine(RandGenerator &randGenerator)
 {
-    RealType U = 2 * UniformRand<RealType>::StandardVariate(this->localRandGenerator) - 1;
+    RealType U = 2 * UniformRand<RealType>::StandardVariate(randGenerator) - 1;
     RealType X = std::sin(M_PI * U);
     return X * X;
 }
 
 template < typename RealType >
-RealType BetaDistribution<RealType>::variateRejectionUniform() const
+RealType BetaDistribution<RealType>::variateRejectionUniform(RandGenerator &randGenerator)
 {
     size_t iter = 0;
     do {
-        RealType U = UniformRand<RealType>::StandardVariate(this->localRandGenerator);
-        RealType V = UniformRand<RealType>::StandardVariate(this->localRandGenerator);
+        RealType U = UniformRand<RealType>::StandardVariate(randGenerator);
+        RealType V = UniformRand<RealType>::StandardVariate(randGenerator);
         if (0.25 * V * V <= U - U * U)
             return U;
-    } while (++iter <= this->MAX_ITER_REJECTION);
+    } while (++iter <= ProbabilityDistribution<RealType>::MAX_ITER_REJECTION);
     throw std::runtime_error("Beta distribution: sampling failed");
 }
 
 template < typename RealType >
-RealType BetaDistribution<RealType>::variateRejectionUniformExtended() const
+RealType BetaDistribution<RealType>::variateRejectionUniformExtended(double shape, RandGenerator &randGenerator)
 {
     size_t iter = 0;
     static constexpr double M_LN4 = M_LN2 + M_LN2;
     do {
-        RealType U = UniformRand<RealType>::StandardVariate(this->localRandGenerator);
-        RealType W = ExponentialRand<RealType>::StandardVariate(this->localRandGenerator);
+        RealType U = UniformRand<RealType>::StandardVariate(randGenerator);
+        RealType W = ExponentialRand<RealType>::StandardVariate(randGenerator);
         RealType edge = M_LN4 + std::log(U - U * U);
-        if (W >= (1.0 - alpha) * edge)
+        if (W >= (1.0 - shape) * edge)
             return U;
-    } while (++iter <= this->MAX_ITER_REJECTION);
+    } while (++iter <= ProbabilityDistribution<RealType>::MAX_ITER_REJECTION);
     throw std::runtime_error("Beta distribution: sampling failed");
 }
 
 template < typename RealType >
-RealType BetaDistribution<RealType>::variateRejectionNormal() const
+RealType BetaDistribution<RealType>::variateRejectionNormal(double shape, const genCoef_t &coef, RandGenerator &randGenerator)
 {
     size_t iter = 0;
     RealType N = 0, Z = 0;
-    RealType alpham1 = alpha - 1;
-    RealType alpha2m1 = alpha + alpham1;
+    RealType shapem1 = shape - 1;
+    RealType shape2m1 = shape + shapem1;
     do {
         do {
-            N = NormalRand<RealType>::StandardVariate(this->localRandGenerator);
+            N = NormalRand<RealType>::StandardVariate(randGenerator);
             Z = N * N;
-        } while (Z >= alpha2m1);
+        } while (Z >= shape2m1);
 
-        RealType W = ExponentialRand<RealType>::StandardVariate(this->localRandGenerator) + genCoef.s;
-        RealType aux = 0.5 - alpham1 / (alpha2m1 - Z);
+        RealType W = ExponentialRand<RealType>::StandardVariate(randGenerator) + coef.s;
+        RealType aux = 0.5 - shapem1 / (shape2m1 - Z);
         aux *= Z;
         if (W + aux >= 0)
-            return 0.5 + N * genCoef.t;
-        aux = std::log1pl(-Z / alpha2m1);
-        aux *= alpham1;
+            return 0.5 + N * coef.t;
+        aux = std::log1pl(-Z / shape2m1);
+        aux *= shapem1;
         aux += W + 0.5 * Z;
         if (aux >= 0)
-            return 0.5 + N * genCoef.t;
-    } while (++iter <= this->MAX_ITER_REJECTION);
+            return 0.5 + N * coef.t;
+    } while (++iter <= ProbabilityDistribution<RealType>::MAX_ITER_REJECTION);
     throw std::runtime_error("Beta distribution: sampling failed");
 }
 
 template < typename RealType >
-RealType BetaDistribution<RealType>::variateJohnk() const
+RealType BetaDistribution<RealType>::variateJohnk(double shape1, double shape2, RandGenerator &randGenerator)
 {
     RealType X = 0, Z = 0;
     RealType W = 0, V = 0;
     do {
-        W = ExponentialRand<RealType>::StandardVariate(this->localRandGenerator) / alpha;
-        V = ExponentialRand<RealType>::StandardVariate(this->localRandGenerator) / beta;
+        W = ExponentialRand<RealType>::StandardVariate(randGenerator) / shape1;
+        V = ExponentialRand<RealType>::StandardVariate(randGenerator) / shape2;
         X = std::exp(-W);
         Z = X + std::exp(-V);
     } while (Z > 1);
-    return (Z > 0) ? (X / Z) : (W < V);;
+    return (Z > 0) ? (X / Z) : (W < V);
 }
 
 template < typename RealType >
-RealType BetaDistribution<RealType>::variateCheng() const
+RealType BetaDistribution<RealType>::variateCheng(double shape1, double shape2, const genCoef_t &coef, RandGenerator &randGenerator)
 {
     RealType R, T, Y;
     do {
-        RealType U = UniformRand<RealType>::StandardVariate(this->localRandGenerator);
-        RealType V = UniformRand<RealType>::StandardVariate(this->localRandGenerator);
-        RealType X = std::log(U / (1 - U)) / genCoef.t;
-        Y = alpha * std::exp(X);
-        R = 1.0 / (beta + Y);
+        RealType U = UniformRand<RealType>::StandardVariate(randGenerator);
+        RealType V = UniformRand<RealType>::StandardVariate(randGenerator);
+        RealType X = std::log(U / (1 - U)) / coef.t;
+        Y = shape1 * std::exp(X);
+        R = 1.0 / (shape2 + Y);
         T = 4 * U * U * V;
         T = std::log(T);
-        T -= genCoef.u * X;
-        T -= genCoef.s * std::log(genCoef.s * R);
+        T -= coef.u * X;
+        T -= coef.s * std::log(coef.s * R);
     } while (T > 0);
     return Y * R;
 }
 
 template < typename RealType >
-RealType BetaDistribution<RealType>::variateAtkinsonWhittaker() const
+RealType BetaDistribution<RealType>::variateAtkinsonWhittaker(double shape1, double shape2, const genCoef_t &coef, RandGenerator &randGenerator)
 {
     size_t iter = 0;
     do {
-        RealType U = UniformRand<RealType>::StandardVariate(this->localRandGenerator);
-        RealType W = ExponentialRand<RealType>::StandardVariate(this->localRandGenerator);
-        if (U <= genCoef.s) {
-            RealType X = genCoef.t * std::pow(U / genCoef.s, 1.0 / alpha);
-            if (W >= (1.0 - beta) * std::log((1.0 - X) / (1.0 - genCoef.t)))
+        RealType U = UniformRand<RealType>::StandardVariate(randGenerator);
+        RealType W = ExponentialRand<RealType>::StandardVariate(randGenerator);
+        if (U <= coef.s) {
+            RealType X = coef.t * std::pow(U / coef.s, 1.0 / shape1);
+            if (W >= (1.0 - shape2) * std::log((1.0 - X) / (1.0 - coef.t)))
                 return X;
         }
         else {
-            RealType X = 1.0 - (1.0 - genCoef.t) * std::pow((1.0 - U) / (1.0 - genCoef.s), 1.0 / beta);
-            if (W >= (1.0 - alpha) * std::log(X / genCoef.t))
+            RealType X = 1.0 - (1.0 - coef.t) * std::pow((1.0 - U) / (1.0 - coef.s), 1.0 / shape2);
+            if (W >= (1.0 - shape1) * std::log(X / coef.t))
                 return X;
         }
-    } while (++iter <= this->MAX_ITER_REJECTION);
+    } while (++iter <= ProbabilityDistribution<RealType>::MAX_ITER_REJECTION);
     throw std::runtime_error("Beta distribution: sampling failed");
 }
 
@@ -268,32 +316,32 @@ template < typename RealType >
 RealType BetaDistribution<RealType>::Variate() const
 {
     double var = 0;
-    GENERATOR_ID id = getIdOfUsedGenerator();
+    GENERATOR_ID id = getIdOfUsedGenerator(alpha, beta);
 
     switch (id) {
     case UNIFORM:
         var = UniformRand<RealType>::StandardVariate(this->localRandGenerator);
         break;
     case ARCSINE:
-        var = variateArcsine();
+        var = variateArcsine(this->localRandGenerator);
         break;
     case CHENG:
-        var = variateCheng();
+        var = variateCheng(alpha, beta, genCoef, this->localRandGenerator);
         break;
     case REJECTION_UNIFORM:
-        var = variateRejectionUniform();
+        var = variateRejectionUniform(this->localRandGenerator);
         break;
     case REJECTION_UNIFORM_EXTENDED:
-        var = variateRejectionUniformExtended();
+        var = variateRejectionUniformExtended(alpha, this->localRandGenerator);
         break;
     case REJECTION_NORMAL:
-        var = variateRejectionNormal();
+        var = variateRejectionNormal(alpha, genCoef, this->localRandGenerator);
         break;
     case JOHNK:
-        var = variateJohnk();
+        var = variateJohnk(alpha, beta, this->localRandGenerator);
         break;
     case ATKINSON_WHITTAKER:
-        var = variateAtkinsonWhittaker();
+        var = variateAtkinsonWhittaker(alpha, beta, genCoef, this->localRandGenerator);
         break;
     case GAMMA_RATIO:
     default:
@@ -307,7 +355,7 @@ RealType BetaDistribution<RealType>::Variate() const
 template < typename RealType >
 void BetaDistribution<RealType>::Sample(std::vector<RealType> &outputData) const
 {
-    GENERATOR_ID id = getIdOfUsedGenerator();
+    GENERATOR_ID id = getIdOfUsedGenerator(alpha, beta);
 
     switch (id) {
     case UNIFORM: {
@@ -317,37 +365,37 @@ void BetaDistribution<RealType>::Sample(std::vector<RealType> &outputData) const
         break;
     case ARCSINE: {
         for (RealType &var : outputData)
-            var = variateArcsine();
+            var = variateArcsine(this->localRandGenerator);
         }
         break;
     case CHENG: {
         for (RealType &var : outputData)
-            var = variateCheng();
+            var = variateCheng(alpha, beta, genCoef, this->localRandGenerator);
         }
         break;
     case REJECTION_UNIFORM: {
         for (RealType &var : outputData)
-            var = variateRejectionUniform();
+            var = variateRejectionUniform(this->localRandGenerator);
         }
         break;
     case REJECTION_UNIFORM_EXTENDED: {
         for (RealType &var : outputData)
-            var = variateRejectionUniformExtended();
+            var = variateRejectionUniformExtended(alpha, this->localRandGenerator);
         }
         break;
     case REJECTION_NORMAL: {
         for (RealType &var : outputData)
-            var = variateRejectionNormal();
+            var = variateRejectionNormal(alpha, genCoef, this->localRandGenerator);
         }
         break;
     case JOHNK: {
         for (RealType &var : outputData)
-            var = variateJohnk();
+            var = variateJohnk(alpha, beta, this->localRandGenerator);
         }
         break;
     case ATKINSON_WHITTAKER: {
         for (RealType &var : outputData)
-            var = variateAtkinsonWhittaker();
+            var = variateAtkinsonWhittaker(alpha, beta, genCoef, this->localRandGenerator);
         }
         break;
     case GAMMA_RATIO:
@@ -364,6 +412,70 @@ void BetaDistribution<RealType>::Sample(std::vector<RealType> &outputData) const
         var = a + bma * var;
 }
 
+template < typename RealType >
+void BetaDistribution<RealType>::SampleParams(const std::vector<double> &shapes1, const std::vector<double> &shapes2, std::vector<RealType> &outputData, RandGenerator &randGenerator)
+{
+    size_t size = outputData.size();
+    if (shapes1.size() != size || shapes2.size() != size)
+        throw std::invalid_argument("Beta distribution: number of shapes should be equal to the size of output data");
+
+    std::vector<int> regimeIds(size);
+    for (size_t i = 0; i != size; ++i) {
+        if (shapes1[i] <= 0 || shapes2[i] <= 0)
+            throw std::invalid_argument("Beta distribution: shapes should be positive, but they're equal to "
+                                        + std::to_string(shapes1[i]) + " and " + std::to_string(shapes2[i]));
+        regimeIds[i] = getIdOfUsedGenerator(shapes1[i], shapes2[i]);
+    }
+    std::vector<size_t> indices;
+    std::vector<size_t> offsets = UnivariateDistribution<RealType>::groupIndicesByRegime(regimeIds, GAMMA_RATIO + 1, indices);
+
+    for (size_t j = offsets[UNIFORM]; j != offsets[UNIFORM + 1]; ++j)
+        outputData[indices[j]] = UniformRand<RealType>::StandardVariate(randGenerator);
+    for (size_t j = offsets[ARCSINE]; j != offsets[ARCSINE + 1]; ++j)
+        outputData[indices[j]] = variateArcsine(randGenerator);
+    for (size_t j = offsets[CHENG]; j != offsets[CHENG + 1]; ++j) {
+        size_t i = indices[j];
+        genCoef_t coef = getCoefficientsForGenerator(CHENG, shapes1[i], shapes2[i]);
+        outputData[i] = variateCheng(shapes1[i], shapes2[i], coef, randGenerator);
+    }
+    for (size_t j = offsets[REJECTION_UNIFORM]; j != offsets[REJECTION_UNIFORM + 1]; ++j)
+        outputData[indices[j]] = variateRejectionUniform(randGenerator);
+    for (size_t j = offsets[REJECTION_UNIFORM_EXTENDED]; j != offsets[REJECTION_UNIFORM_EXTENDED + 1]; ++j) {
+        size_t i = indices[j];
+        outputData[i] = variateRejectionUniformExtended(shapes1[i], randGenerator);
+    }
+    for (size_t j = offsets[REJECTION_NORMAL]; j != offsets[REJECTION_NORMAL + 1]; ++j) {
+        size_t i = indices[j];
+        genCoef_t coef = getCoefficientsForGenerator(REJECTION_NORMAL, shapes1[i], shapes2[i]);
+        outputData[i] = variateRejectionNormal(shapes1[i], coef, randGenerator);
+    }
+    for (size_t j = offsets[JOHNK]; j != offsets[JOHNK + 1]; ++j) {
+        size_t i = indices[j];
+        outputData[i] = variateJohnk(shapes1[i], shapes2[i], randGenerator);
+    }
+    for (size_t j = offsets[ATKINSON_WHITTAKER]; j != offsets[ATKINSON_WHITTAKER + 1]; ++j) {
+        size_t i = indices[j];
+        genCoef_t coef = getCoefficientsForGenerator(ATKINSON_WHITTAKER, shapes1[i], shapes2[i]);
+        outputData[i] = variateAtkinsonWhittaker(shapes1[i], shapes2[i], coef, randGenerator);
+    }
+
+    /// Gamma ratio: Y / (Y + Z), where gamma variates of the whole group are sampled at once
+    size_t gammaRatioSize = offsets[GAMMA_RATIO + 1] - offsets[GAMMA_RATIO];
+    if (gammaRatioSize > 0) {
+        std::vector<double> groupShapes1(gammaRatioSize), groupShapes2(gammaRatioSize);
+        for (size_t j = 0; j != gammaRatioSize; ++j) {
+            size_t i = indices[offsets[GAMMA_RATIO] + j];
+            groupShapes1[j] = shapes1[i];
+            groupShapes2[j] = shapes2[i];
+        }
+        std::vector<RealType> Y(gammaRatioSize), Z(gammaRatioSize);
+        GammaDistribution<RealType>::StandardSampleParams(groupShapes1, Y, randGenerator);
+        GammaDistribution<RealType>::StandardSampleParams(groupShapes2, Z, randGenerator);
+        for (size_t j = 0; j != gammaRatioSize; ++j)
+            outputData[indices[offsets[GAMMA_RATIO] + j]] = Y[j] / (Y[j] + Z[j]);
+    }
+}
+
 template < typename RealType >
 void BetaDistribution<RealType>::Reseed(unsigned long seed) const
 {
@@ -409,14 +521,7 @@ RealType BetaDistribution<RealType>::Median() const
         return a - bma * std::expm1l(-M_LN2 / beta);
     if (beta == 1.0)
         return a + bma * std::exp(-M_LN2 / alpha);
-    if (alpha >= 1.0 && beta >= 1.0) {
-        double initValue = 3 * alpha - 1.0;
-        initValue /= 3 * (alpha + beta) - 2.0;
-        initValue *= bma;
-        initValue += a;
-        return ContinuousDistribution<RealType>::quantileImpl(0.5, initValue);
-    }
-    return ContinuousDistribution<RealType>::quantileImpl(0.5);
+    return a + bma * RandMath::ibetainv(0.5, alpha, beta, logBetaFun);
 }
 
 template < typename RealType >
@@ -481,7 +586,13 @@ RealType BetaDistribution<RealType>::quantileImpl(double p) const
         return a - bma * std::expm1l(std::log1pl(-p) / beta);
     if (beta == 1.0)
         return a + bma * std::pow(p, 1.0 / alpha);
-    return ContinuousDistribution<RealType>::quantileImpl(p);
+    RealType root = 0;
+    if (this->quantileSweepGuess(p, root, false))
+        root = ContinuousDistribution<RealType>::quantileImpl(p, root);
+    else
+        root = a + bma * RandMath::ibetainv(p, alpha, beta, logBetaFun);
+    this->setPreviousQuantile(root, p);
+    return root;
 }
 
 template < typename RealType >
@@ -500,7 +611,13 @@ RealType BetaDistribution<RealType>::quantileImpl1m(double p) const
         return a - bma * std::expm1l(std::log(p) / beta);
     if (beta == 1.0)
         return a + bma * std::exp(std::log1pl(-p) / alpha);
-    return ContinuousDistribution<RealType>::quantileImpl1m(p);
+    RealType root = 0;
+    if (this->quantileSweepGuess(p, root, true))
+        root = ContinuousDistribution<RealType>::quantileImpl1m(p, root);
+    else
+        root = a + bma * RandMath::ibetacinv(p, alpha, beta, logBetaFun);
+    this->setPreviousQuantile(root, p);
+    return root;
 }
 
 template < typename RealType >
@@ -583,6 +700,18 @@ DoublePair BetaRand<RealType>::SourceToNatural(DoublePair sourceParameters) cons
     return {sourceParameters.first - 1, sourceParameters.second - 1};
 }
 
+template < typename RealType >
+DoublePair BetaRand<RealType>::NaturalToSource(DoublePair theta) const
+{
+    return {theta.first + 1, theta.second + 1};
+}
+
+template < typename RealType >
+void BetaRand<RealType>::SetSourceParameters(DoublePair sourceParameters)
+{
+    this->SetShapes(sourceParameters.first, sourceParameters.second);
+}
+
 template < typename RealType >
 double BetaRand<RealType>::LogNormalizer(DoublePair theta) const
 {
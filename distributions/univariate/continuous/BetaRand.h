@@ -67,27 +67,38 @@ private:
 
     /**
      * @fn getIdOfUsedGenerator
+     * @param shape1 α
+     * @param shape2 β
      * @return id of used variate generator according to the shapes
      */
-    GENERATOR_ID getIdOfUsedGenerator() const {
-        if (alpha < 1 && beta < 1 && alpha + beta > 1)
+    static GENERATOR_ID getIdOfUsedGenerator(double shape1, double shape2) {
+        if (shape1 < 1 && shape2 < 1 && shape1 + shape2 > 1)
             return ATKINSON_WHITTAKER;
 
-        if (RandMath::areClose(alpha, beta)) {
-            if (RandMath::areClose(alpha, 1.0))
+        if (RandMath::areClose(shape1, shape2)) {
+            if (RandMath::areClose(shape1, 1.0))
                 return UNIFORM;
-            else if (RandMath::areClose(alpha, 0.5))
+            else if (RandMath::areClose(shape1, 0.5))
                 return ARCSINE;
-            else if (RandMath::areClose(alpha, 1.5))
+            else if (RandMath::areClose(shape1, 1.5))
                 return REJECTION_UNIFORM;
-            else if (alpha > 1)
-                return (alpha < 2) ? REJECTION_UNIFORM_EXTENDED : REJECTION_NORMAL;
+            else if (shape1 > 1)
+                return (shape1 < 2) ? REJECTION_UNIFORM_EXTENDED : REJECTION_NORMAL;
         }
-        if (std::min(alpha, beta) > 0.5 && std::max(alpha, beta) > 1)
+        if (std::min(shape1, shape2) > 0.5 && std::max(shape1, shape2) > 1)
             return CHENG;
-        return (alpha + beta < 2) ? JOHNK : GAMMA_RATIO;
+        return (shape1 + shape2 < 2) ? JOHNK : GAMMA_RATIO;
     }
 
+    /**
+     * @fn getCoefficientsForGenerator
+     * @param id id of used variate generator
+     * @param shape1 α
+     * @param shape2 β
+     * @return constants for faster sampling
+     */
+    static genCoef_t getCoefficientsForGenerator(GENERATOR_ID id, double shape1, double shape2);
+
     /**
      * @fn setCoefficientsForGenerator
      */
@@ -134,6 +145,8 @@ public:
     double logf(const RealType & x) const override;
     double F(const RealType & x) const override;
     double S(const RealType & x) const override;
+    void CumulativeDistributionFunction(const std::vector<RealType> &x, std::vector<double> &y) const override;
+    void SurvivalFunction(const std::vector<RealType> &x, std::vector<double> &y) const override;
 
 private:
     /**
@@ -141,49 +154,60 @@ private:
      * Symmetric beta generator via rejection from the uniform density
      * @return beta variate for α = β = 1.5
      */
-    RealType variateRejectionUniform() const;
+    static RealType variateRejectionUniform(RandGenerator &randGenerator);
 
     /**
-     * @fn variateRejectionUniform
+     * @fn variateRejectionUniformExtended
      * Symmetric beta generator via rejection from the uniform density
+     * @param shape α = β
      * @return beta variate for 1 < α = β < 2 and α != 1.5
      */
-    RealType variateRejectionUniformExtended() const;
+    static RealType variateRejectionUniformExtended(double shape, RandGenerator &randGenerator);
 
     /**
      * @fn variateArcsine
      * Arcsine beta generator
      * @return beta variate for α = β = 0.5
      */
-    RealType variateArcsine() const;
+    static RealType variateArcsine(RandGenerator &randGenerator);
 
     /**
      * @fn variateRejectionNormal
      * Symmetric beta generator via rejection from the normal density
+     * @param shape α = β
+     * @param coef constants for the generator
      * @return beta variate for equal shape parameters > 2
      */
-    RealType variateRejectionNormal() const;
+    static RealType variateRejectionNormal(double shape, const genCoef_t &coef, RandGenerator &randGenerator);
 
     /**
      * @fn variateJohnk
      * Johnk's beta generator
+     * @param shape1 α
+     * @param shape2 β
      * @return beta variate for small shape parameters < 1
      */
-    RealType variateJohnk() const;
+    static RealType variateJohnk(double shape1, double shape2, RandGenerator &randGenerator);
 
     /**
      * @fn variateCheng
      * Cheng's beta generator
+     * @param shape1 α
+     * @param shape2 β
+     * @param coef constants for the generator
      * @return beta variate for max(α, β) > 1 and min(α, β) > 0.5
      */
-    RealType variateCheng() const;
+    static RealType variateCheng(double shape1, double shape2, const genCoef_t &coef, RandGenerator &randGenerator);
 
     /**
      * @fn variateAtkinsonWhittaker
      * Atkinson-Whittaker beta generator
+     * @param shape1 α
+     * @param shape2 β
+     * @param coef constants for the generator
      * @return beta variate for max(α, β) < 1 and α + β > 1
      */
-    RealType variateAtkinsonWhittaker() const;
+    static RealType variateAtkinsonWhittaker(double shape1, double shape2, const genCoef_t &coef, RandGenerator &randGenerator);
 
     /**
      * @fn variateGammaRatio
@@ -197,6 +221,17 @@ public:
     void Sample(std::vector<RealType> &outputData) const override;
     void Reseed(unsigned long seed) const override;
 
+    /**
+     * @fn SampleParams
+     * fill outputData with standard beta variates (on [0, 1]), such that i-th variate has shapes α_i and β_i;
+     * elements are grouped by the generator used for their shapes and each group is sampled in one pass
+     * @param shapes1 α_i
+     * @param shapes2 β_i
+     * @param outputData
+     */
+    static void SampleParams(const std::vector<double> &shapes1, const std::vector<double> &shapes2, std::vector<RealType> &outputData,
+                             RandGenerator &randGenerator = ProbabilityDistribution<RealType>::staticRandGenerator);
+
     long double Mean() const override;
     /**
      * @fn GeometricMean
@@ -247,6 +282,8 @@ public:
     DoublePair SufficientStatistic(RealType x) const override;
     DoublePair SourceParameters() const override;
     DoublePair SourceToNatural(DoublePair sourceParameters) const override;
+    DoublePair NaturalToSource(DoublePair theta) const override;
+    void SetSourceParameters(DoublePair sourceParameters) override;
     double LogNormalizer(DoublePair theta) const override;
     DoublePair LogNormalizerGradient(DoublePair theta) const override;
     double CarrierMeasure(RealType) const override;
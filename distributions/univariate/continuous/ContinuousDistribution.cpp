@@ -15,6 +15,169 @@ void ContinuousDistribution<RealType>::LogProbabilityDensityFunction(const std::
         y[i] = this->logf(x[i]);
 }
 
+template< typename RealType >
+RealType ContinuousDistribution<RealType>::quantileBracketed(const std::function<DoubleTriplet (RealType)> &funPtr, RealType initValue) const
+{
+    RealType minVal = this->MinValue(), maxVal = this->MaxValue();
+    RealType root = std::min(std::max(initValue, minVal), maxVal);
+    if (!RandMath::findRootNewtonBracketed<RealType>(funPtr, minVal, maxVal, root))
+        throw std::runtime_error("Continuous distribution: failure in numeric procedure");
+    return root;
+}
+
+template< typename RealType >
+bool ContinuousDistribution<RealType>::quantileSweepGuess(double p, RealType &guess, bool isComplement) const
+{
+    RealType x0 = 0;
+    double p0 = 0;
+    if (!this->getPreviousQuantile(x0, p0))
+        return false;
+    /// Heun's step for equation dx/dp = 1 / f(x)
+    guess = x0;
+    double dp = isComplement ? p0 - p : p - p0;
+    double f0 = this->f(x0);
+    if (dp == 0.0 || !(f0 > 0.0) || !std::isfinite(f0))
+        return true;
+    RealType x1 = x0 + dp / f0;
+    if (!std::isfinite(x1))
+        return true;
+    double f1 = this->f(x1);
+    guess = (f1 > 0.0 && std::isfinite(f1)) ? x0 + 0.5 * (x1 - x0) * (1.0 + f0 / f1) : x1;
+    return true;
+}
+
+template< typename RealType >
+bool ContinuousDistribution<RealType>::isQuantileGridValid() const
+{
+    if (gridQuantiles.empty())
+        return false;
+    /// parameters are considered unchanged if the density at the nodes is the same
+    size_t middle = gridQuantiles.size() / 2;
+    return this->f(gridQuantiles[middle]) == gridPdf[middle] && this->f(gridQuantiles[0]) == gridPdf[0];
+}
+
+template< typename RealType >
+void ContinuousDistribution<RealType>::buildQuantileGrid() const
+{
+    /// nodes correspond to normal quantiles ±0.5k
+    static constexpr int GRID_HALF_SIZE = 7;
+    RealType minVal = this->MinValue(), maxVal = this->MaxValue();
+    std::vector<RealType> nodes;
+    double mean = this->Mean(), variance = this->Variance();
+    if (std::isfinite(mean) && std::isfinite(variance) && variance > 0) {
+        /// Cornish-Fisher expansion
+        double sigma = std::sqrt(variance);
+        double skewness = this->Skewness(), exKurtosis = this->ExcessKurtosis();
+        if (!std::isfinite(skewness))
+            skewness = 0.0;
+        if (!std::isfinite(exKurtosis))
+            exKurtosis = 0.0;
+        for (int k = -GRID_HALF_SIZE; k <= GRID_HALF_SIZE; ++k) {
+            double z = 0.5 * k, z2 = z * z;
+            double w = z + (z2 - 1) * skewness / 6.0;
+            w += z * (z2 - 3) * exKurtosis / 24.0;
+            w -= z * (2 * z2 - 5) * skewness * skewness / 36.0;
+            nodes.push_back(mean + sigma * w);
+        }
+    }
+    else {
+        /// heavy tails: nodes are spread geometrically around the center with scale taken from density
+        RealType center = std::isfinite(mean) ? mean : 0.0;
+        if (this->isLeftBounded() && this->isRightBounded())
+            center = 0.5 * (minVal + maxVal);
+        else if (this->isLeftBounded())
+            center = std::max<RealType>(center, minVal + 1.0);
+        else if (this->isRightBounded())
+            center = std::min<RealType>(center, maxVal - 1.0);
+        double fCenter = this->f(center);
+        double scale = (fCenter > 0.0 && std::isfinite(fCenter)) ? 0.25 / fCenter : 1.0;
+        nodes.push_back(center);
+        for (int k = 0; k != GRID_HALF_SIZE; ++k) {
+            nodes.push_back(center - scale);
+            nodes.push_back(center + scale);
+            scale *= 2;
+        }
+    }
+    std::sort(nodes.begin(), nodes.end());
+
+    gridQuantiles.clear();
+    gridCdf.clear();
+    gridCcdf.clear();
+    gridPdf.clear();
+    for (RealType x : nodes) {
+        if (!(x > minVal && x < maxVal))
+            continue;
+        double cdf = this->F(x), ccdf = this->S(x), pdf = this->f(x);
+        /// nodes should have distinct probabilities and non-zero density
+        if (!(cdf > 0.0 && ccdf > 0.0 && pdf > 0.0 && std::isfinite(pdf)))
+            continue;
+        if (!gridCdf.empty() && cdf <= gridCdf.back())
+            continue;
+        gridQuantiles.push_back(x);
+        gridCdf.push_back(cdf);
+        gridCcdf.push_back(ccdf);
+        gridPdf.push_back(pdf);
+    }
+}
+
+template< typename RealType >
+RealType ContinuousDistribution<RealType>::quantileTailGuess(double p, RealType x, double px, double fx, bool isRightTail) const
+{
+    if (isRightTail ? this->isRightBounded() : this->isLeftBounded()) {
+        /// power asymptotics near the boundary: P(tail) ~ px * ((y - bound) / (x - bound))^k
+        RealType bound = isRightTail ? this->MaxValue() : this->MinValue();
+        double distance = std::fabs(x - bound);
+        double k = fx * distance / px;
+        if (k > 0.0 && std::isfinite(k)) {
+            double y = distance * std::exp(std::log(p / px) / k);
+            return isRightTail ? bound - y : bound + y;
+        }
+    }
+    /// exponential asymptotics: P(tail) ~ px * exp(-|y - x| * fx / px)
+    double y = std::log(p / px) * px / fx;
+    return isRightTail ? x - y : x + y;
+}
+
+template< typename RealType >
+RealType ContinuousDistribution<RealType>::quantileInitialValue(double p, bool isComplement) const
+{
+    if (!isQuantileGridValid())
+        buildQuantileGrid();
+    RealType minVal = this->MinValue(), maxVal = this->MaxValue();
+    if (gridQuantiles.empty()) {
+        /// no information about the distribution
+        if (std::isfinite(minVal))
+            return std::isfinite(maxVal) ? 0.5 * (minVal + maxVal) : minVal + 1.0;
+        return std::isfinite(maxVal) ? maxVal - 1.0 : 0.0;
+    }
+    double pLeft = isComplement ? 1.0 - p : p;
+    double pRight = isComplement ? p : 1.0 - p;
+    size_t last = gridQuantiles.size() - 1;
+    RealType guess = 0;
+    if (pLeft <= gridCdf[0] || (last == 0 && pLeft < 0.5))
+        guess = quantileTailGuess(pLeft, gridQuantiles[0], gridCdf[0], gridPdf[0], false);
+    else if (pRight <= gridCcdf[last] || last == 0)
+        guess = quantileTailGuess(pRight, gridQuantiles[last], gridCcdf[last], gridPdf[last], true);
+    else {
+        /// cubic Hermite interpolation of inverse function, dx/dp = 1 / f(x)
+        size_t j = std::upper_bound(gridCdf.begin(), gridCdf.end(), pLeft) - gridCdf.begin();
+        j = std::min(std::max<size_t>(j, 1), last) - 1;
+        double h = isComplement ? gridCcdf[j] - gridCcdf[j + 1] : gridCdf[j + 1] - gridCdf[j];
+        double t = isComplement ? (gridCcdf[j] - p) / h : (p - gridCdf[j]) / h;
+        t = std::min(std::max(t, 0.0), 1.0);
+        RealType x0 = gridQuantiles[j], x1 = gridQuantiles[j + 1];
+        double t2 = t * t, t3 = t2 * t;
+        guess = (2 * t3 - 3 * t2 + 1) * x0 + (-2 * t3 + 3 * t2) * x1;
+        guess += (t3 - 2 * t2 + t) * h / gridPdf[j] + (t3 - t2) * h / gridPdf[j + 1];
+        /// linear interpolation if Hermite's one is not monotone
+        if (!(guess >= x0 && guess <= x1))
+            guess = x0 + t * (x1 - x0);
+    }
+    if (!std::isfinite(guess))
+        return (pLeft < 0.5) ? gridQuantiles[0] : gridQuantiles[last];
+    return std::min(std::max(guess, minVal), maxVal);
+}
+
 template< typename RealType >
 RealType ContinuousDistribution<RealType>::quantileImpl(double p, RealType initValue) const
 {
@@ -22,48 +185,32 @@ RealType ContinuousDistribution<RealType>::quantileImpl(double p, RealType initV
     if (p < SMALL_P) {
         /// for small p we use logarithmic scale
         double logP = std::log(p);
-        if (!RandMath::findRootNewtonFirstOrder<RealType>([this, logP] (const RealType & x)
+        return quantileBracketed([this, logP] (const RealType & x)
         {
             double logCdf = std::log(this->F(x)), logPdf = this->logf(x);
             double first = logCdf - logP;
             double second = std::exp(logPdf - logCdf);
-            return DoublePair(first, second);
-        }, initValue))
-            throw std::runtime_error("Continuous distribution: failure in numeric procedure");
-        return initValue;
+            return DoubleTriplet(first, second, 0.0);
+        }, initValue);
     }
 
-    if (this->SupportType() == FINITE_T) {
-        if (!RandMath::findRootNewtonFirstOrder<RealType>([this, p] (const RealType & x)
-        {
-            return this->F(x) - p;
-        }, this->MinValue(), this->MaxValue(), initValue))
-            throw std::runtime_error("Continuous distribution: failure in numeric procedure");
-        return initValue;
-    }
-
-    if (!RandMath::findRootNewtonFirstOrder<RealType>([this, p] (const RealType & x)
+    return quantileBracketed([this, p] (const RealType & x)
     {
         double first = this->F(x) - p;
         double second = this->f(x);
-        return DoublePair(first, second);
-    }, initValue))
-        throw std::runtime_error("Continuous distribution: failure in numeric procedure");
-    return initValue;
+        return DoubleTriplet(first, second, 0.0);
+    }, initValue);
 }
 
 template< typename RealType >
 RealType ContinuousDistribution<RealType>::quantileImpl(double p) const
 {
-    /// We use quantile from sample as an initial guess
-    static constexpr int SAMPLE_SIZE = 128;
-    static std::vector<RealType> sample(SAMPLE_SIZE);
-    this->Sample(sample);
-    int index = p * SAMPLE_SIZE;
-    if (index == 0.0)
-        return this->quantileImpl(p, *std::min_element(sample.begin(), sample.end()));
-    std::nth_element(sample.begin(), sample.begin() + index, sample.end());
-    return this->quantileImpl(p, sample[index]);
+    RealType root = 0;
+    if (!quantileSweepGuess(p, root, false))
+        root = quantileInitialValue(p, false);
+    root = this->quantileImpl(p, root);
+    this->setPreviousQuantile(root, p);
+    return root;
 }
 
 template< typename RealType >
@@ -73,48 +220,32 @@ RealType ContinuousDistribution<RealType>::quantileImpl1m(double p, RealType ini
     if (p < SMALL_P) {
         /// for small p we use logarithmic scale
         double logP = std::log(p);
-        if (!RandMath::findRootNewtonFirstOrder<RealType>([this, logP] (const RealType & x)
+        return quantileBracketed([this, logP] (const RealType & x)
         {
             double logCcdf = std::log(this->S(x)), logPdf = this->logf(x);
             double first = logP - logCcdf;
             double second = std::exp(logPdf - logCcdf);
-            return DoublePair(first, second);
-        }, initValue))
-            throw std::runtime_error("Continuous distribution: failure in numeric procedure");
-        return initValue;
+            return DoubleTriplet(first, second, 0.0);
+        }, initValue);
     }
 
-    if (this->SupportType() == FINITE_T) {
-        if (!RandMath::findRootNewtonFirstOrder<RealType>([this, p] (const RealType & x)
-        {
-            return this->S(x) - p;
-        }, this->MinValue(), this->MaxValue(), initValue))
-            throw std::runtime_error("Continuous distribution: failure in numeric procedure");
-        return initValue;
-    }
-
-    if (!RandMath::findRootNewtonFirstOrder<RealType>([this, p] (const RealType & x)
+    return quantileBracketed([this, p] (const RealType & x)
     {
         double first = p - this->S(x);
         double second = this->f(x);
-        return DoublePair(first, second);
-    }, initValue))
-        throw std::runtime_error("Continuous distribution: failure in numeric procedure");
-    return initValue;
+        return DoubleTriplet(first, second, 0.0);
+    }, initValue);
 }
 
 template< typename RealType >
 RealType ContinuousDistribution<RealType>::quantileImpl1m(double p) const
 {
-    /// We use quantile from sample as an initial guess
-    static constexpr int SAMPLE_SIZE = 128;
-    static std::vector<RealType> sample(SAMPLE_SIZE);
-    this->Sample(sample);
-    int index = p * SAMPLE_SIZE;
-    if (index == 0.0)
-        return this->quantileImpl1m(p, *std::max_element(sample.begin(), sample.end()));
-    std::nth_element(sample.begin(), sample.begin() + index, sample.end(), std::greater<>());
-    return this->quantileImpl1m(p, sample[index]);
+    RealType root = 0;
+    if (!quantileSweepGuess(p, root, true))
+        root = quantileInitialValue(p, true);
+    root = this->quantileImpl1m(p, root);
+    this->setPreviousQuantile(root, p);
+    return root;
 }
 
 template< typename RealType >
@@ -131,6 +262,38 @@ RealType ContinuousDistribution<RealType>::Mode() const
     return root;
 }
 
+template< typename RealType >
+RealType ContinuousDistribution<RealType>::Variate() const
+{
+    if (!universalGenerator.IsBuilt())
+        universalGenerator.Setup(*this);
+    return universalGenerator.Variate(*this, this->localRandGenerator);
+}
+
+template< typename RealType >
+void ContinuousDistribution<RealType>::Sample(std::vector<RealType> &outputData) const
+{
+    /// density at the probes is used as a key in case if some setter doesn't invalidate the generator
+    if (universalGenerator.IsBuilt() && !universalGenerator.IsBuiltFor(*this))
+        universalGenerator.Invalidate();
+    UnivariateDistribution<RealType>::Sample(outputData);
+}
+
+template< typename RealType >
+typename UniversalGenerator<RealType>::GENERATOR_ID ContinuousDistribution<RealType>::GetIdOfUniversalGenerator() const
+{
+    if (!universalGenerator.IsBuiltFor(*this))
+        universalGenerator.Setup(*this);
+    return universalGenerator.GetIdOfUsedGenerator();
+}
+
+template< typename RealType >
+void ContinuousDistribution<RealType>::BuildCaches() const
+{
+    if (!isQuantileGridValid())
+        buildQuantileGrid();
+}
+
 template< typename RealType >
 long double ContinuousDistribution<RealType>::ExpectedValue(const std::function<double (RealType)> &funPtr, RealType minPoint, RealType maxPoint) const
 {
@@ -208,6 +371,76 @@ long double ContinuousDistribution<RealType>::ExpectedValue(const std::function<
     }, -1.0, 1.0);
 }
 
+template< typename RealType >
+std::vector<long double> ContinuousDistribution<RealType>::ExpectedValues(const std::vector<std::function<double (RealType)>> &funPtrs, RealType minPoint, RealType maxPoint) const
+{
+    /// the same changes of variable as in ExpectedValue,
+    /// but density is calculated once per node for all of the functions
+    size_t size = funPtrs.size();
+    std::vector<long double> values(size, 0.0);
+    RealType lowerBoundary = minPoint, upperBoundary = maxPoint;
+    if (size == 0 || lowerBoundary >= upperBoundary)
+        return values;
+
+    bool isLeftBoundFinite = std::isfinite(lowerBoundary), isRightBoundFinite = std::isfinite(upperBoundary);
+    double a = -1.0, b = 1.0;
+    /// t(x) and dt/dx
+    std::function<double (double, double &)> change;
+    if (isLeftBoundFinite && isRightBoundFinite) {
+        a = lowerBoundary;
+        b = upperBoundary;
+        change = [] (double x, double &jacobian) {
+            jacobian = 1.0;
+            return x;
+        };
+    }
+    else if (isLeftBoundFinite) {
+        a = 0.0;
+        change = [lowerBoundary] (double x, double &jacobian) {
+            double denom = 1.0 - x;
+            jacobian = 1.0 / (denom * denom);
+            return lowerBoundary + x / denom;
+        };
+    }
+    else if (isRightBoundFinite) {
+        a = 0.0;
+        change = [upperBoundary] (double x, double &jacobian) {
+            jacobian = 1.0 / (x * x);
+            return upperBoundary - (1.0 - x) / x;
+        };
+    }
+    else {
+        change = [] (double x, double &jacobian) {
+            double x2 = x * x;
+            double denom = 1.0 - x2;
+            jacobian = (1.0 + x2) / (denom * denom);
+            return x / denom;
+        };
+    }
+
+    std::vector<double> integrals = RandMath::integral([this, &funPtrs, &change, size] (double x, std::vector<double> &y)
+    {
+        std::fill(y.begin(), y.end(), 0.0);
+        double jacobian = 1.0;
+        double t = change(x, jacobian);
+        /// endpoints of the transformed interval correspond to infinity
+        if (!std::isfinite(t) || !std::isfinite(jacobian))
+            return;
+        bool isZero = true;
+        for (size_t i = 0; i != size; ++i) {
+            y[i] = funPtrs[i](t);
+            isZero = isZero && (y[i] == 0.0);
+        }
+        if (isZero)
+            return;
+        double weight = this->f(t) * jacobian;
+        for (double & var : y)
+            var *= weight;
+    }, a, b, size);
+    std::copy(integrals.begin(), integrals.end(), values.begin());
+    return values;
+}
+
 template< typename RealType >
 double ContinuousDistribution<RealType>::Hazard(const RealType &x) const
 {
@@ -3,6 +3,7 @@
 
 #include "../UnivariateDistribution.h"
 #include "../ExponentialFamily.h"
+#include "UniversalGenerator.h"
 
 /**
  * @brief The ContinuousDistribution class <BR>
@@ -13,6 +14,12 @@ class RANDLIBSHARED_EXPORT ContinuousDistribution : virtual public UnivariateDis
 {
     static_assert(std::is_floating_point_v<RealType>, "Continuous distribution supports only floating-point types");
 
+    mutable std::vector<RealType> gridQuantiles{}; ///< nodes of the coarse grid for initial guesses of quantile
+    mutable std::vector<double> gridCdf{}; ///< F at the nodes
+    mutable std::vector<double> gridCcdf{}; ///< S at the nodes
+    mutable std::vector<double> gridPdf{}; ///< f at the nodes
+    mutable UniversalGenerator<RealType> universalGenerator{}; ///< default generator
+
 protected:
     ContinuousDistribution() {}
     virtual ~ContinuousDistribution() {}
@@ -32,13 +39,21 @@ public:
      */
     virtual double logf(const RealType & x) const = 0;
 
+    /**
+     * @fn logfDerivative
+     * @param x
+     * @return derivative of logarithm of probability density function
+     * or NaN if it's unknown and should be evaluated numerically
+     */
+    virtual double logfDerivative(const RealType &) const { return NAN; }
+
     /**
      * @fn ProbabilityDensityFunction
      * fill vector y with f(x)
      * @param x
      * @param y
      */
-    void ProbabilityDensityFunction(const std::vector<RealType> &x, std::vector<double> &y) const;
+    virtual void ProbabilityDensityFunction(const std::vector<RealType> &x, std::vector<double> &y) const;
 
     /**
      * @fn LogProbabilityDensityFunction
@@ -46,16 +61,109 @@ public:
      * @param x
      * @param y
      */
-    void LogProbabilityDensityFunction(const std::vector<RealType> &x, std::vector<double> &y) const;
+    virtual void LogProbabilityDensityFunction(const std::vector<RealType> &x, std::vector<double> &y) const;
 
     RealType Mode() const override;
 
+    /**
+     * @fn Variate
+     * default generator: transformed density rejection if density is log-concave,
+     * ratio-of-uniforms or numerical inversion otherwise.
+     * The setup is done once and kept until invalidateGenerator is called
+     * @return random variate
+     */
+    RealType Variate() const override;
+
+    /**
+     * @fn Sample
+     * fill vector with variates, the setup of default generator
+     * is checked against current parameters once per call
+     * @param outputData
+     */
+    void Sample(std::vector<RealType> &outputData) const override;
+
+    /**
+     * @fn GetIdOfUniversalGenerator
+     * @return method of the default generator for current parameters
+     */
+    typename UniversalGenerator<RealType>::GENERATOR_ID GetIdOfUniversalGenerator() const;
+
+    /**
+     * @fn BuildCaches
+     * build the coarse grid for initial guesses of quantile.
+     * Default generator is set up by Variate only, which changes the random generator of the object
+     * and therefore shouldn't be called concurrently anyway
+     */
+    void BuildCaches() const override;
+
 protected:
+    /**
+     * @fn invalidateGenerator
+     * drop the setup of default generator, should be called by setters of distributions,
+     * which rely on it
+     */
+    inline void invalidateGenerator() { universalGenerator.Invalidate(); }
+
+    /**
+     * @fn quantileBracketed
+     * safeguarded Newton's procedure for quantile function within the support
+     * @param funPtr nondecreasing mapping x |-> (g(x), g'(x), g''(x)), g''(x) should be 0 if unknown
+     * @param initValue initial value of x
+     * @return such x that g(x) = 0
+     */
+    RealType quantileBracketed(const std::function<DoubleTriplet (RealType)> &funPtr, RealType initValue) const;
+
+    /**
+     * @fn quantileSweepGuess
+     * @param p
+     * @param guess Heun's step for equation dx/dp = 1 / f(x) from the previous root in a monotone sweep
+     * @param isComplement true if p is a probability of the right tail
+     * @return true if the previous root is known
+     */
+    bool quantileSweepGuess(double p, RealType &guess, bool isComplement) const;
+
+private:
+    /**
+     * @fn isQuantileGridValid
+     * @return true if the grid is built for current parameters,
+     * which is checked by the density at the nodes
+     */
+    bool isQuantileGridValid() const;
+
+    /**
+     * @fn buildQuantileGrid
+     * evaluate F, S and f at the nodes, taken from Cornish-Fisher expansion
+     * if the variance is finite, or spread geometrically around the center otherwise
+     */
+    void buildQuantileGrid() const;
+
+    /**
+     * @fn quantileTailGuess
+     * @param p probability of the tail
+     * @param x node of the grid, closest to the tail
+     * @param px probability of the tail beyond x
+     * @param fx density at x
+     * @param isRightTail
+     * @return initial guess from power asymptotics near finite boundary or exponential asymptotics otherwise
+     */
+    RealType quantileTailGuess(double p, RealType x, double px, double fx, bool isRightTail) const;
+
+protected:
+    /**
+     * @fn quantileInitialValue
+     * @param p
+     * @param isComplement true if p is a probability of the right tail
+     * @return deterministic initial guess for quantile:
+     * Hermite interpolation on the cached coarse grid in the bulk and tail asymptotics beyond it
+     */
+    RealType quantileInitialValue(double p, bool isComplement) const;
+
     RealType quantileImpl(double p, RealType initValue) const override;
     RealType quantileImpl(double p) const override;
     RealType quantileImpl1m(double p, RealType initValue) const override;
     RealType quantileImpl1m(double p) const override;
     long double ExpectedValue(const std::function<double (RealType)> &funPtr, RealType minPoint, RealType maxPoint) const override;
+    std::vector<long double> ExpectedValues(const std::vector<std::function<double (RealType)>> &funPtrs, RealType minPoint, RealType maxPoint) const override;
 
 public:
     double Hazard(const RealType &x) const override;
@@ -0,0 +1,325 @@
+#include "EmpiricalRand.h"
+#include "UniformRand.h"
+
+template < typename RealType >
+EmpiricalRand<RealType>::EmpiricalRand(std::vector<RealType> &&sample)
+{
+    SetSample(std::move(sample));
+}
+
+template < typename RealType >
+String EmpiricalRand<RealType>::Name() const
+{
+    return "Empirical(" + this->toStringWithPrecision(GetSize()) + ")";
+}
+
+template < typename RealType >
+void EmpiricalRand<RealType>::SetSample(std::vector<RealType> &&sample)
+{
+    for (const RealType &var : sample) {
+        if (!std::isfinite(var))
+            throw std::invalid_argument("Empirical distribution: all elements of the sample should be finite");
+    }
+    std::sort(sample.begin(), sample.end());
+    if (sample.size() < 2 || sample.front() == sample.back())
+        throw std::invalid_argument("Empirical distribution: sample should contain at least two distinct values");
+    orderStatistic = std::move(sample);
+    calculateMoments();
+    kdeTable.clear();
+}
+
+template < typename RealType >
+void EmpiricalRand<RealType>::SetBandwidth(double bandwidth)
+{
+    if (bandwidth < 0.0)
+        throw std::invalid_argument("Empirical distribution: bandwidth should be non-negative, but it's equal to "
+                                    + std::to_string(bandwidth));
+    this->bandwidth = bandwidth;
+    kdeTable.clear();
+}
+
+template < typename RealType >
+double EmpiricalRand<RealType>::GetBandwidth() const
+{
+    if (bandwidth > 0.0)
+        return bandwidth;
+    /// Silverman's rule of thumb 0.9 min(σ, IQR / 1.34) n^(-1/5)
+    double iqr = quantileImpl(0.75) - quantileImpl(0.25);
+    double spread = (iqr > 0.0) ? std::min(sampleStd, iqr / 1.34) : sampleStd;
+    return 0.9 * spread * std::pow(GetSize(), -0.2);
+}
+
+template < typename RealType >
+void EmpiricalRand<RealType>::calculateMoments()
+{
+    size_t n = orderStatistic.size();
+    long double sum = 0.0, sampleSum = 0.0;
+    for (size_t i = 0; i != n - 1; ++i)
+        sum += orderStatistic[i] + orderStatistic[i + 1];
+    for (const RealType &var : orderStatistic)
+        sampleSum += var;
+    mean = 0.5 * sum / (n - 1);
+    long double sampleMean = sampleSum / n;
+
+    /// E[(X - μ)^k] for U(a, b) is equal to Σ_{j=0}^k (a - μ)^j (b - μ)^(k-j) / (k + 1)
+    long double moment2 = 0.0, moment3 = 0.0, moment4 = 0.0, sampleMoment2 = 0.0;
+    RealType minGap = INFINITY;
+    mode = orderStatistic.front();
+    for (size_t i = 0; i != n - 1; ++i) {
+        long double a = orderStatistic[i] - mean, b = orderStatistic[i + 1] - mean;
+        long double a2 = a * a, b2 = b * b, ab = a * b;
+        moment2 += (a2 + ab + b2) / 3;
+        moment3 += (a2 * a + a2 * b + a * b2 + b2 * b) / 4;
+        moment4 += (a2 * a2 + a2 * ab + a2 * b2 + ab * b2 + b2 * b2) / 5;
+        RealType gap = orderStatistic[i + 1] - orderStatistic[i];
+        if (gap < minGap) {
+            minGap = gap;
+            mode = orderStatistic[i] + 0.5 * gap;
+        }
+        long double centered = orderStatistic[i] - sampleMean;
+        sampleMoment2 += centered * centered;
+    }
+    long double centered = orderStatistic.back() - sampleMean;
+    sampleMoment2 += centered * centered;
+
+    variance = moment2 / (n - 1);
+    skewness = moment3 / (n - 1) / std::pow(variance, 1.5l);
+    excessKurtosis = moment4 / (n - 1) / (variance * variance) - 3.0l;
+    sampleStd = std::sqrt(sampleMoment2 / (n - 1));
+}
+
+template < typename RealType >
+long long EmpiricalRand<RealType>::locate(const RealType &x, long long hint) const
+{
+    long long size = orderStatistic.size();
+    if (hint < 0 || hint >= size || orderStatistic[hint] > x)
+        return std::upper_bound(orderStatistic.begin(), orderStatistic.end(), x) - orderStatistic.begin() - 1;
+    /// galloping search from the hint
+    long long lower = hint, step = 1;
+    while (lower + step < size && orderStatistic[lower + step] <= x) {
+        lower += step;
+        step <<= 1;
+    }
+    auto last = orderStatistic.begin() + std::min(lower + step, size);
+    return std::upper_bound(orderStatistic.begin() + lower, last, x) - orderStatistic.begin() - 1;
+}
+
+template < typename RealType >
+double EmpiricalRand<RealType>::cdfAtIndex(const RealType &x, long long i, bool isRightTail) const
+{
+    long long last = orderStatistic.size() - 1;
+    if (i < 0)
+        return isRightTail ? 1.0 : 0.0;
+    if (i >= last)
+        return isRightTail ? 0.0 : 1.0;
+    double t = (x - orderStatistic[i]) / (orderStatistic[i + 1] - orderStatistic[i]);
+    return isRightTail ? (last - i - t) / last : (i + t) / last;
+}
+
+template < typename RealType >
+double EmpiricalRand<RealType>::f(const RealType & x) const
+{
+    long long i = locate(x, -1), last = orderStatistic.size() - 1;
+    if (i < 0 || x > orderStatistic.back())
+        return 0.0;
+    if (i == last)
+        i = std::lower_bound(orderStatistic.begin(), orderStatistic.end(), x) - orderStatistic.begin() - 1;
+    return 1.0 / (last * (orderStatistic[i + 1] - orderStatistic[i]));
+}
+
+template < typename RealType >
+double EmpiricalRand<RealType>::logf(const RealType & x) const
+{
+    return std::log(f(x));
+}
+
+template < typename RealType >
+double EmpiricalRand<RealType>::F(const RealType & x) const
+{
+    return cdfAtIndex(x, locate(x, -1), false);
+}
+
+template < typename RealType >
+double EmpiricalRand<RealType>::S(const RealType & x) const
+{
+    return cdfAtIndex(x, locate(x, -1), true);
+}
+
+template < typename RealType >
+void EmpiricalRand<RealType>::cdfFunction(const std::vector<RealType> &x, std::vector<double> &y, bool isRightTail) const
+{
+    size_t size = x.size();
+    if (size > y.size())
+        return;
+    long long i = -1;
+    for (size_t j = 0; j != size; ++j) {
+        i = locate(x[j], i);
+        y[j] = cdfAtIndex(x[j], i, isRightTail);
+    }
+}
+
+template < typename RealType >
+void EmpiricalRand<RealType>::CumulativeDistributionFunction(const std::vector<RealType> &x, std::vector<double> &y) const
+{
+    cdfFunction(x, y, false);
+}
+
+template < typename RealType >
+void EmpiricalRand<RealType>::SurvivalFunction(const std::vector<RealType> &x, std::vector<double> &y) const
+{
+    cdfFunction(x, y, true);
+}
+
+template < typename RealType >
+RealType EmpiricalRand<RealType>::Variate() const
+{
+    return quantileImpl(UniformRand<RealType>::StandardVariate(this->localRandGenerator));
+}
+
+template < typename RealType >
+void EmpiricalRand<RealType>::Resample(std::vector<RealType> &outputData) const
+{
+    size_t n = orderStatistic.size();
+    for (RealType &var : outputData) {
+        size_t index = UniformRand<RealType>::StandardVariate(this->localRandGenerator) * n;
+        var = orderStatistic[std::min(index, n - 1)];
+    }
+}
+
+template < typename RealType >
+void EmpiricalRand<RealType>::buildKernelDensity() const
+{
+    static constexpr size_t MAX_GRID_SIZE = 1 << 20;
+    static constexpr double KERNEL_WIDTH = 6.0; ///< kernel is truncated at 6 bandwidths
+    double h = GetBandwidth();
+    double start = orderStatistic.front() - KERNEL_WIDTH * h;
+    double length = orderStatistic.back() - orderStatistic.front() + 2 * KERNEL_WIDTH * h;
+    double step = h / 16;
+    size_t gridSize = std::ceil(length / step) + 1;
+    if (gridSize > MAX_GRID_SIZE) {
+        gridSize = MAX_GRID_SIZE;
+        step = length / (gridSize - 1);
+    }
+    size_t kernelSize = std::ceil(KERNEL_WIDTH * h / step);
+    size_t fftSize = 1;
+    while (fftSize < gridSize + kernelSize)
+        fftSize <<= 1;
+
+    /// linear binning, each observation is split between two nearest nodes
+    std::vector<std::complex<double>> counts(fftSize), kernel(fftSize);
+    for (const RealType &var : orderStatistic) {
+        double t = (var - start) / step;
+        size_t j = std::min(static_cast<size_t>(t), gridSize - 2);
+        double w = t - j;
+        counts[j] += 1.0 - w;
+        counts[j + 1] += w;
+    }
+
+    /// Gaussian kernel on the same grid, wrapped around for circular convolution
+    double coef = M_1_SQRT2PI / (GetSize() * h);
+    for (size_t k = 0; k <= kernelSize; ++k) {
+        double z = k * step / h;
+        double value = coef * std::exp(-0.5 * z * z);
+        kernel[k] = value;
+        if (k > 0)
+            kernel[fftSize - k] = value;
+    }
+
+    RandMath::fft(counts);
+    RandMath::fft(kernel);
+    for (size_t k = 0; k != fftSize; ++k)
+        counts[k] *= kernel[k];
+    RandMath::fft(counts, true);
+
+    kdeTable.resize(gridSize);
+    for (size_t j = 0; j != gridSize; ++j)
+        kdeTable[j] = std::max(counts[j].real() / fftSize, 0.0);
+    kdeStart = start;
+    kdeStep = step;
+}
+
+template < typename RealType >
+double EmpiricalRand<RealType>::KernelDensity(const RealType &x) const
+{
+    if (kdeTable.empty())
+        buildKernelDensity();
+    double t = (x - kdeStart) / kdeStep;
+    size_t last = kdeTable.size() - 1;
+    if (!(t >= 0.0 && t <= last))
+        return 0.0;
+    /// cubic interpolation through four nearest nodes
+    size_t j = std::min(static_cast<size_t>(t), last - 1);
+    double h = t - j;
+    double y0 = (j == 0) ? 0.0 : kdeTable[j - 1], y1 = kdeTable[j];
+    double y2 = kdeTable[j + 1], y3 = (j + 2 > last) ? 0.0 : kdeTable[j + 2];
+    double y = y1 + 0.5 * h * (y2 - y0 + h * (2 * y0 - 5 * y1 + 4 * y2 - y3 + h * (3 * (y1 - y2) + y3 - y0)));
+    return std::max(y, 0.0);
+}
+
+template < typename RealType >
+void EmpiricalRand<RealType>::KernelDensityFunction(const std::vector<RealType> &x, std::vector<double> &y) const
+{
+    size_t size = x.size();
+    if (size > y.size())
+        return;
+    for (size_t i = 0; i != size; ++i)
+        y[i] = KernelDensity(x[i]);
+}
+
+template < typename RealType >
+void EmpiricalRand<RealType>::BuildCaches() const
+{
+    if (kdeTable.empty())
+        buildKernelDensity();
+    ContinuousDistribution<RealType>::BuildCaches();
+}
+
+template < typename RealType >
+RealType EmpiricalRand<RealType>::Median() const
+{
+    return quantileImpl(0.5);
+}
+
+template < typename RealType >
+RealType EmpiricalRand<RealType>::quantileImpl(double p) const
+{
+    size_t last = orderStatistic.size() - 1;
+    double t = p * last;
+    size_t i = std::min(static_cast<size_t>(t), last - 1);
+    double h = t - i;
+    return orderStatistic[i] + h * (orderStatistic[i + 1] - orderStatistic[i]);
+}
+
+template < typename RealType >
+RealType EmpiricalRand<RealType>::quantileImpl1m(double p) const
+{
+    size_t last = orderStatistic.size() - 1;
+    double t = p * last;
+    size_t i = std::min(static_cast<size_t>(t), last - 1);
+    double h = t - i;
+    return orderStatistic[last - i] - h * (orderStatistic[last - i] - orderStatistic[last - i - 1]);
+}
+
+template < typename RealType >
+std::complex<double> EmpiricalRand<RealType>::CFImpl(double t) const
+{
+    /// φ(t) = Σ (exp(itb) - exp(ita)) / (it(b - a)) / (n - 1), atoms contribute exp(ita)
+    size_t n = orderStatistic.size();
+    std::complex<double> sum = 0.0;
+    double cosA = std::cos(t * orderStatistic[0]), sinA = std::sin(t * orderStatistic[0]);
+    for (size_t i = 0; i != n - 1; ++i) {
+        double a = orderStatistic[i], b = orderStatistic[i + 1];
+        double cosB = std::cos(t * b), sinB = std::sin(t * b);
+        if (b == a)
+            sum += std::complex<double>(cosA, sinA);
+        else
+            sum += std::complex<double>(sinB - sinA, cosA - cosB) / (t * (b - a));
+        cosA = cosB;
+        sinA = sinB;
+    }
+    return sum / static_cast<double>(n - 1);
+}
+
+template class EmpiricalRand<float>;
+template class EmpiricalRand<double>;
+template class EmpiricalRand<long double>;
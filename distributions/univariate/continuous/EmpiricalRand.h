@@ -0,0 +1,174 @@
+#ifndef EMPIRICALRAND_H
+#define EMPIRICALRAND_H
+
+#include "ContinuousDistribution.h"
+
+/**
+ * @brief The EmpiricalRand class <BR>
+ * Empirical distribution of a sample
+ *
+ * F(x) = (i + (x - x_(i)) / (x_(i+1) - x_(i))) / (n - 1) for x_(i) ≤ x < x_(i+1),
+ * where x_(0) ≤ ... ≤ x_(n-1) is the order statistic,
+ * i.e. the empirical cdf is interpolated linearly between the order statistics,
+ * which gives the same quantiles as the common definition x_(p(n-1)) with linear interpolation.
+ * Tied observations form atoms of the distribution.
+ *
+ * Notation: X ~ Emp(x_1, ..., x_n)
+ *
+ * Related distributions: <BR>
+ * X is a mixture of n - 1 uniform distributions U(x_(i), x_(i+1)) with equal weights
+ */
+template < typename RealType = double >
+class RANDLIBSHARED_EXPORT EmpiricalRand : public ContinuousDistribution<RealType>
+{
+    std::vector<RealType> orderStatistic{}; ///< sorted sample
+    long double mean = 0; ///< E[X]
+    long double variance = 0; ///< Var(X)
+    long double skewness = 0; ///< skewness of X
+    long double excessKurtosis = 0; ///< excess kurtosis of X
+    RealType mode = 0; ///< middle of the shortest interval between order statistics
+    double sampleStd = 0; ///< standard deviation of the sample, used for bandwidth
+
+    double bandwidth = 0; ///< bandwidth of Gaussian kernel, 0 if Silverman's rule of thumb should be used
+    mutable std::vector<double> kdeTable{}; ///< kernel density estimate on the grid
+    mutable double kdeStart = 0; ///< first node of the grid
+    mutable double kdeStep = 0; ///< step of the grid
+
+public:
+    /**
+     * @fn EmpiricalRand
+     * @param sample at least two distinct values, moved into the distribution
+     */
+    explicit EmpiricalRand(std::vector<RealType> &&sample);
+
+    String Name() const override;
+    SUPPORT_TYPE SupportType() const override { return FINITE_T; }
+    RealType MinValue() const override { return orderStatistic.front(); }
+    RealType MaxValue() const override { return orderStatistic.back(); }
+
+    /**
+     * @fn SetSample
+     * take ownership of the sample and sort it
+     * @param sample at least two distinct values
+     */
+    void SetSample(std::vector<RealType> &&sample);
+    inline const std::vector<RealType> &GetOrderStatistic() const { return orderStatistic; }
+    inline size_t GetSize() const { return orderStatistic.size(); }
+
+    /**
+     * @fn SetBandwidth
+     * @param bandwidth of Gaussian kernel for KernelDensity,
+     * if it's equal to 0, Silverman's rule of thumb is used
+     */
+    void SetBandwidth(double bandwidth);
+    /**
+     * @fn GetBandwidth
+     * @return bandwidth, which is used by KernelDensity
+     */
+    double GetBandwidth() const;
+
+private:
+    /**
+     * @fn locate
+     * @param x
+     * @param hint index, from which the search starts, for monotone sequences of arguments
+     * @return the last index i, such that x_(i) ≤ x, or -1 if x < x_(0)
+     */
+    long long locate(const RealType &x, long long hint) const;
+
+    /**
+     * @fn cdfAtIndex
+     * @param x
+     * @param i the last index, such that x_(i) ≤ x
+     * @param isRightTail
+     * @return F(x) or S(x)
+     */
+    double cdfAtIndex(const RealType &x, long long i, bool isRightTail) const;
+
+    /**
+     * @fn cdfFunction
+     * fill y with F(x) or S(x), searching from the previous index if x is sorted
+     * @param x
+     * @param y
+     * @param isRightTail
+     */
+    void cdfFunction(const std::vector<RealType> &x, std::vector<double> &y, bool isRightTail) const;
+
+    /**
+     * @fn calculateMoments
+     * central moments of the mixture of uniform distributions and the mode
+     */
+    void calculateMoments();
+
+    /**
+     * @fn buildKernelDensity
+     * linear binning of the sample on the grid with step h / 16
+     * and convolution with Gaussian kernel by fast Fourier transform,
+     * which costs O(n + m log m) instead of O(nm) for m nodes
+     */
+    void buildKernelDensity() const;
+
+public:
+    double f(const RealType & x) const override;
+    double logf(const RealType & x) const override;
+    double F(const RealType & x) const override;
+    double S(const RealType & x) const override;
+    void CumulativeDistributionFunction(const std::vector<RealType> &x, std::vector<double> &y) const override;
+    void SurvivalFunction(const std::vector<RealType> &x, std::vector<double> &y) const override;
+
+    /**
+     * @fn Variate
+     * uniform index and position between two order statistics, O(1)
+     * @return random variable
+     */
+    RealType Variate() const override;
+
+    /**
+     * @fn Resample
+     * fill outputData with elements of the sample, drawn with replacement (bootstrap)
+     * @param outputData
+     */
+    void Resample(std::vector<RealType> &outputData) const;
+
+    /**
+     * @fn KernelDensity
+     * @param x
+     * @return Gaussian kernel density estimate, interpolated from the grid
+     */
+    double KernelDensity(const RealType &x) const;
+
+    /**
+     * @fn KernelDensityFunction
+     * fill vector y with KernelDensity(x)
+     * @param x
+     * @param y
+     */
+    void KernelDensityFunction(const std::vector<RealType> &x, std::vector<double> &y) const;
+
+    /**
+     * @fn BuildCaches
+     * build the grid of kernel density estimate and the grid for quantiles
+     */
+    void BuildCaches() const override;
+
+    long double Mean() const override { return mean; }
+    long double Variance() const override { return variance; }
+    RealType Median() const override;
+    RealType Mode() const override { return mode; }
+    long double Skewness() const override { return skewness; }
+    long double ExcessKurtosis() const override { return excessKurtosis; }
+
+private:
+    RealType quantileImpl(double p) const override;
+    RealType quantileImpl1m(double p) const override;
+
+    /**
+     * @fn CFImpl
+     * sum of characteristic functions of n - 1 uniform distributions, O(n)
+     * @param t
+     * @return characteristic function
+     */
+    std::complex<double> CFImpl(double t) const override;
+};
+
+#endif // EMPIRICALRAND_H
@@ -26,6 +26,18 @@ double ExponentialRand<RealType>::SourceToNatural(double rate) const
     return -rate;
 }
 
+template < typename RealType >
+double ExponentialRand<RealType>::NaturalToSource(double theta) const
+{
+    return -theta;
+}
+
+template < typename RealType >
+void ExponentialRand<RealType>::SetSourceParameters(double rate)
+{
+    this->SetRate(rate);
+}
+
 template < typename RealType >
 double ExponentialRand<RealType>::LogNormalizer(double thetaP) const
 {
@@ -62,6 +62,8 @@ public:
     double SufficientStatistic(RealType x) const override;
     double SourceParameters() const override;
     double SourceToNatural(double rate) const override;
+    double NaturalToSource(double theta) const override;
+    void SetSourceParameters(double rate) override;
     double LogNormalizer(double theta) const override;
     double LogNormalizerGradient(double theta) const override;
     double CarrierMeasure(RealType) const override;
@@ -72,6 +72,14 @@ double GammaDistribution<RealType>::logf(const RealType & x) const
     return y;
 }
 
+template < typename RealType >
+void GammaDistribution<RealType>::LogProbabilityDensityFunction(const std::vector<RealType> &x, std::vector<double> &y) const
+{
+    double alpham1 = this->alpha - 1.0, rate = this->beta;
+    for (size_t i = 0; i != x.size(); ++i)
+        y[i] = (x[i] > 0) ? alpham1 * std::log(x[i]) - x[i] * rate + pdfCoef : logf(x[i]);
+}
+
 template < typename RealType >
 double GammaDistribution<RealType>::F(const RealType & x) const
 {
@@ -96,6 +104,30 @@ double GammaDistribution<RealType>::logS(const RealType &x) const
     return (x > 0.0) ? RandMath::lqgamma(this->alpha, x * this->beta, logAlpha, lgammaAlpha) : 0.0;
 }
 
+template < typename RealType >
+void GammaDistribution<RealType>::CumulativeDistributionFunction(const std::vector<RealType> &x, std::vector<double> &y) const
+{
+    size_t size = x.size();
+    if (size > y.size())
+        return;
+    std::vector<double> xSt(size);
+    for (size_t i = 0; i != size; ++i)
+        xSt[i] = (x[i] > 0.0) ? x[i] * this->beta : 0.0;
+    RandMath::pgamma(this->alpha, xSt, y, logAlpha, lgammaAlpha);
+}
+
+template < typename RealType >
+void GammaDistribution<RealType>::SurvivalFunction(const std::vector<RealType> &x, std::vector<double> &y) const
+{
+    size_t size = x.size();
+    if (size > y.size())
+        return;
+    std::vector<double> xSt(size);
+    for (size_t i = 0; i != size; ++i)
+        xSt[i] = (x[i] > 0.0) ? x[i] * this->beta : 0.0;
+    RandMath::qgamma(this->alpha, xSt, y, logAlpha, lgammaAlpha);
+}
+
 template < typename RealType >
 RealType GammaDistribution<RealType>::variateThroughExponentialSum(int shape, RandGenerator& randGenerator)
 {
@@ -184,6 +216,8 @@ RealType GammaDistribution<RealType>::variateMarsagliaTsang(double shape, RandGe
     /// Marsaglia and Tsang’s Method (shape > 1/3)
     RealType d = shape - 1.0 / 3;
     RealType c = 3 * std::sqrt(d);
+    /// squeeze 1 - 0.0331 x^4 lies below the acceptance function only for α >= 1
+    bool useSqueeze = (shape >= 1.0);
     size_t iter = 0;
     do {
         RealType N;
@@ -194,13 +228,159 @@ RealType GammaDistribution<RealType>::variateMarsagliaTsang(double shape, RandGe
         v = v * v * v;
         N *= N;
         RealType U = UniformRand<RealType>::StandardVariate(randGenerator);
-        if (U < 1.0 - 0.331 * N * N || std::log(U) < 0.5 * N + d * (1.0 - v + std::log(v))) {
+        if ((useSqueeze && U < 1.0 - 0.0331 * N * N) || std::log(U) < 0.5 * N + d * (1.0 - v + std::log(v))) {
             return d * v;
         }
     } while (++iter <= ProbabilityDistribution<RealType>::MAX_ITER_REJECTION);
     throw std::runtime_error("Gamma distribution: sampling failed");
 }
 
+template < typename RealType >
+void GammaDistribution<RealType>::sampleBest(const std::vector<double> &shapes, std::vector<RealType> &outputData, RandGenerator &randGenerator)
+{
+    /// Algorithm RGS (Best, 1983), processed by blocks small enough to stay in cache
+    constexpr size_t BLOCK_SIZE = 256;
+    size_t size = outputData.size();
+    bool commonShape = (shapes.size() == 1);
+    double alpha[BLOCK_SIZE], t[BLOCK_SIZE], b[BLOCK_SIZE];
+    RealType V[BLOCK_SIZE], W[BLOCK_SIZE], X[BLOCK_SIZE];
+    size_t pending[BLOCK_SIZE];
+    bool accepted[BLOCK_SIZE];
+
+    for (size_t start = 0; start < size; start += BLOCK_SIZE) {
+        size_t m = std::min(BLOCK_SIZE, size - start);
+        for (size_t j = 0; j != m; ++j) {
+            alpha[j] = commonShape ? shapes[0] : shapes[start + j];
+            if (commonShape && j > 0) {
+                t[j] = t[0];
+                b[j] = b[0];
+                continue;
+            }
+            t[j] = 0.07 + 0.75 * std::exp(0.5 * std::log1p(-alpha[j]));
+            b[j] = 1.0 + std::exp(-t[j]) * alpha[j] / t[j];
+        }
+        for (size_t j = 0; j != m; ++j)
+            pending[j] = j;
+
+        size_t iter = 0;
+        while (m > 0) {
+            if (++iter > ProbabilityDistribution<RealType>::MAX_ITER_REJECTION)
+                throw std::runtime_error("Gamma distribution: sampling failed");
+            for (size_t j = 0; j != m; ++j)
+                V[j] = UniformRand<RealType>::StandardVariate(randGenerator);
+            for (size_t j = 0; j != m; ++j)
+                W[j] = UniformRand<RealType>::StandardVariate(randGenerator);
+
+            /// candidates and squeeze tests
+            for (size_t j = 0; j != m; ++j) {
+                size_t k = pending[j];
+                V[j] *= b[k];
+                if (V[j] <= 1) {
+                    X[j] = t[k] * std::pow(V[j], 1.0 / alpha[k]);
+                    accepted[j] = W[j] <= (2.0 - X[j]) / (2.0 + X[j]);
+                }
+                else {
+                    X[j] = -std::log(t[k] * (b[k] - V[j]) / alpha[k]);
+                    RealType Y = X[j] / t[k];
+                    accepted[j] = W[j] * (alpha[k] + Y - alpha[k] * Y) <= 1;
+                }
+            }
+
+            /// exact tests only for the rest
+            for (size_t j = 0; j != m; ++j) {
+                if (accepted[j])
+                    continue;
+                size_t k = pending[j];
+                if (V[j] <= 1)
+                    accepted[j] = W[j] <= std::exp(-X[j]);
+                else
+                    accepted[j] = W[j] <= std::pow(X[j] / t[k], alpha[k] - 1);
+            }
+
+            /// compaction: write accepted values and keep rejected for the next round
+            size_t rejected = 0;
+            for (size_t j = 0; j != m; ++j) {
+                if (accepted[j])
+                    outputData[start + pending[j]] = X[j];
+                else
+                    pending[rejected++] = pending[j];
+            }
+            m = rejected;
+        }
+    }
+}
+
+template < typename RealType >
+void GammaDistribution<RealType>::sampleMarsagliaTsang(const std::vector<double> &shapes, std::vector<RealType> &outputData, RandGenerator &randGenerator)
+{
+    /// Marsaglia and Tsang’s Method, processed by blocks small enough to stay in cache
+    constexpr size_t BLOCK_SIZE = 256;
+    size_t size = outputData.size();
+    bool commonShape = (shapes.size() == 1);
+    RealType d[BLOCK_SIZE], cInv[BLOCK_SIZE], squeeze[BLOCK_SIZE];
+    RealType N[BLOCK_SIZE], U[BLOCK_SIZE], V[BLOCK_SIZE];
+    size_t pending[BLOCK_SIZE];
+    bool accepted[BLOCK_SIZE];
+
+    for (size_t start = 0; start < size; start += BLOCK_SIZE) {
+        size_t m = std::min(BLOCK_SIZE, size - start);
+        for (size_t j = 0; j != m; ++j) {
+            if (commonShape && j > 0) {
+                d[j] = d[0];
+                cInv[j] = cInv[0];
+                squeeze[j] = squeeze[0];
+                continue;
+            }
+            double shape = commonShape ? shapes[0] : shapes[start + j];
+            d[j] = shape - 1.0 / 3;
+            cInv[j] = 1.0 / (3 * std::sqrt(d[j]));
+            /// squeeze 1 - 0.0331 x^4 lies below the acceptance function only for α >= 1,
+            /// otherwise its bound is set to -∞, so that only the exact test is used
+            squeeze[j] = (shape >= 1.0) ? 0.0331 : INFINITY;
+        }
+        for (size_t j = 0; j != m; ++j)
+            pending[j] = j;
+
+        size_t iter = 0;
+        while (m > 0) {
+            if (++iter > ProbabilityDistribution<RealType>::MAX_ITER_REJECTION)
+                throw std::runtime_error("Gamma distribution: sampling failed");
+            for (size_t j = 0; j != m; ++j)
+                N[j] = NormalRand<RealType>::StandardVariate(randGenerator);
+            for (size_t j = 0; j != m; ++j)
+                U[j] = UniformRand<RealType>::StandardVariate(randGenerator);
+
+            /// cubic transformation and squeeze test (branch-free, vectorizable)
+            for (size_t j = 0; j != m; ++j) {
+                size_t k = pending[j];
+                RealType v = 1 + N[j] * cInv[k];
+                v = v * v * v;
+                RealType x2 = N[j] * N[j];
+                V[j] = v;
+                accepted[j] = (v > 0) & (U[j] < 1 - squeeze[k] * x2 * x2);
+            }
+
+            /// exact test only for the elements, which didn't pass the squeeze
+            for (size_t j = 0; j != m; ++j) {
+                if (accepted[j] || V[j] <= 0)
+                    continue;
+                size_t k = pending[j];
+                accepted[j] = std::log(U[j]) < 0.5 * N[j] * N[j] + d[k] * (1.0 - V[j] + std::log(V[j]));
+            }
+
+            /// compaction: write accepted values and keep rejected for the next round
+            size_t rejected = 0;
+            for (size_t j = 0; j != m; ++j) {
+                if (accepted[j])
+                    outputData[start + pending[j]] = d[pending[j]] * V[j];
+                else
+                    pending[rejected++] = pending[j];
+            }
+            m = rejected;
+        }
+    }
+}
+
 template < typename RealType >
 RealType GammaDistribution<RealType>::StandardVariate(double shape, RandGenerator& randGenerator)
 {
@@ -235,6 +415,90 @@ RealType GammaDistribution<RealType>::Variate(double shape, double rate, RandGen
     return StandardVariate(shape, randGenerator) / rate;
 }
 
+template < typename RealType >
+void GammaDistribution<RealType>::StandardSampleParams(const std::vector<double> &shapes, std::vector<RealType> &outputData, RandGenerator &randGenerator)
+{
+    size_t size = outputData.size();
+    if (shapes.size() != size)
+        throw std::invalid_argument("Gamma distribution: number of shapes should be equal to the size of output data");
+
+    std::vector<int> regimeIds(size);
+    for (size_t i = 0; i != size; ++i) {
+        if (shapes[i] <= 0.0)
+            throw std::invalid_argument("Gamma distribution: shape should be positive, but it's equal to " + std::to_string(shapes[i]));
+        regimeIds[i] = getIdOfUsedGenerator(shapes[i]);
+    }
+    std::vector<size_t> indices;
+    std::vector<size_t> offsets = UnivariateDistribution<RealType>::groupIndicesByRegime(regimeIds, MARSAGLIA_TSANG + 1, indices);
+
+    for (size_t j = offsets[INTEGER_SHAPE]; j != offsets[INTEGER_SHAPE + 1]; ++j) {
+        size_t i = indices[j];
+        outputData[i] = variateThroughExponentialSum(std::round(shapes[i]), randGenerator);
+    }
+    for (size_t j = offsets[ONE_AND_A_HALF_SHAPE]; j != offsets[ONE_AND_A_HALF_SHAPE + 1]; ++j)
+        outputData[indices[j]] = variateForShapeOneAndAHalf(randGenerator);
+    for (size_t j = offsets[FISHMAN]; j != offsets[FISHMAN + 1]; ++j) {
+        size_t i = indices[j];
+        outputData[i] = variateFishman(shapes[i], randGenerator);
+    }
+
+    /// rejection algorithms with block kernels
+    for (GENERATOR_ID id : {SMALL_SHAPE, MARSAGLIA_TSANG}) {
+        size_t groupSize = offsets[id + 1] - offsets[id];
+        if (groupSize == 0)
+            continue;
+        std::vector<double> groupShapes(groupSize);
+        std::vector<RealType> groupData(groupSize);
+        for (size_t j = 0; j != groupSize; ++j)
+            groupShapes[j] = shapes[indices[offsets[id] + j]];
+        if (id == SMALL_SHAPE)
+            sampleBest(groupShapes, groupData, randGenerator);
+        else
+            sampleMarsagliaTsang(groupShapes, groupData, randGenerator);
+        for (size_t j = 0; j != groupSize; ++j)
+            outputData[indices[offsets[id] + j]] = groupData[j];
+    }
+}
+
+template < typename RealType >
+void GammaDistribution<RealType>::StandardSampleStrided(double shape, RealType *outputData, size_t size, size_t stride, RandGenerator &randGenerator)
+{
+    if (shape <= 0.0)
+        throw std::invalid_argument("Gamma distribution: shape should be positive, but it's equal to " + std::to_string(shape));
+    GENERATOR_ID genId = getIdOfUsedGenerator(shape);
+    if (genId != SMALL_SHAPE && genId != MARSAGLIA_TSANG) {
+        for (size_t i = 0; i != size; ++i)
+            outputData[i * stride] = StandardVariate(shape, randGenerator);
+        return;
+    }
+
+    constexpr size_t BUFFER_SIZE = 1024;
+    std::vector<RealType> buffer(std::min(size, BUFFER_SIZE));
+    for (size_t start = 0; start < size; start += BUFFER_SIZE) {
+        buffer.resize(std::min(BUFFER_SIZE, size - start));
+        if (genId == SMALL_SHAPE)
+            sampleBest({shape}, buffer, randGenerator);
+        else
+            sampleMarsagliaTsang({shape}, buffer, randGenerator);
+        for (size_t j = 0; j != buffer.size(); ++j)
+            outputData[(start + j) * stride] = buffer[j];
+    }
+}
+
+template < typename RealType >
+void GammaDistribution<RealType>::SampleParams(const std::vector<double> &shapes, const std::vector<double> &rates, std::vector<RealType> &outputData, RandGenerator &randGenerator)
+{
+    if (rates.size() != outputData.size())
+        throw std::invalid_argument("Gamma distribution: number of rates should be equal to the size of output data");
+    for (double rate : rates) {
+        if (rate <= 0.0)
+            throw std::invalid_argument("Gamma distribution: rate should be positive, but it's equal to " + std::to_string(rate));
+    }
+    StandardSampleParams(shapes, outputData, randGenerator);
+    for (size_t i = 0; i != outputData.size(); ++i)
+        outputData[i] /= rates[i];
+}
+
 template < typename RealType >
 RealType GammaDistribution<RealType>::Variate() const
 {
@@ -271,16 +535,18 @@ void GammaDistribution<RealType>::Sample(std::vector<RealType> &outputData) cons
             var = theta * variateForShapeOneAndAHalf(this->localRandGenerator);
         break;
     case SMALL_SHAPE:
+        sampleBest({this->alpha}, outputData, this->localRandGenerator);
         for (RealType &var : outputData)
-            var = theta * variateBest(this->localRandGenerator);
+            var *= theta;
         break;
     case FISHMAN:
         for (RealType &var : outputData)
             var = theta * variateFishman(this->alpha, this->localRandGenerator);
         break;
     case MARSAGLIA_TSANG:
+        sampleMarsagliaTsang({this->alpha}, outputData, this->localRandGenerator);
         for (RealType &var : outputData)
-            var = theta * variateMarsagliaTsang(this->alpha, this->localRandGenerator);
+            var *= theta;
         break;
     default:
         return;
@@ -335,131 +601,6 @@ long double GammaDistribution<RealType>::ExcessKurtosis() const
     return 6.0l / this->alpha;
 }
 
-template < typename RealType >
-RealType GammaDistribution<RealType>::initRootForSmallP(double r) const
-{
-    double root = 0;
-    double c[5];
-    c[4] = 1;
-    /// first coefficient
-    double denominator = this->alpha + 1;
-    c[3] = 1.0 / denominator;
-    /// second coefficient
-    denominator *= denominator;
-    denominator *= this->alpha + 2;
-    c[2] = 0.5 * (3 * this->alpha + 5) / denominator;
-    /// third coefficient
-    denominator *= 3 * (this->alpha + 1) * (this->alpha + 3);
-    c[1] = 8 * this->alpha + 33;
-    c[1] *= this->alpha;
-    c[1] += 31;
-    c[1] /= denominator;
-    /// fourth coefficient
-    denominator *= 8 * (this->alpha + 1) * (this->alpha + 2) * (this->alpha + 4);
-    c[0] = 125 * this->alpha + 1179;
-    c[0] *= this->alpha;
-    c[0] += 3971;
-    c[0] *= this->alpha;
-    c[0] += 5661;
-    c[0] *= this->alpha;
-    c[0] += 2888;
-    c[0] /= denominator;
-    /// now calculate root
-    for (int i = 0; i != 5; ++i) {
-        root += c[i];
-        root *= r;
-    }
-    return root;
-}
-
-template < typename RealType >
-RealType GammaDistribution<RealType>::initRootForLargeP(double logQ) const
-{
-    /// look for approximate value of x -> INFINITY
-    double x = (logQ + lgammaAlpha) / this->alpha;
-    x = -std::exp(x) / this->alpha;
-    return -alpha * RandMath::Wm1Lambert(x);
-}
-
-template < typename RealType >
-RealType GammaDistribution<RealType>::initRootForLargeShape(double p) const
-{
-    if (p == 0.5)
-        return this->alpha;
-    double x = RandMath::erfcinv(2 * p);
-    double lambda = x * x / this->alpha + 1;
-    lambda = -std::exp(-lambda);
-    lambda = (x < 0) ? -RandMath::Wm1Lambert(lambda) : -RandMath::W0Lambert(lambda);
-    return lambda * this->alpha;
-}
-
-template < typename RealType >
-RealType GammaDistribution<RealType>::initRootForLargeShape1m(double p) const
-{
-    if (p == 0.5)
-        return this->alpha;
-    double x = -RandMath::erfcinv(2 * p);
-    double lambda = x * x / this->alpha + 1;
-    lambda = -std::exp(-lambda);
-    lambda = (x < 0) ? -RandMath::Wm1Lambert(lambda) : -RandMath::W0Lambert(lambda);
-    return lambda * this->alpha;
-}
-
-template < typename RealType >
-RealType GammaDistribution<RealType>::quantileInitialGuess(double p) const
-{
-    /// Method is taken from
-    /// "Efficient and accurate algorithms
-    /// for the computation and inversion
-    /// of the incomplete gamma function ratios"
-    /// (Amparo Gil, Javier Segura and Nico M. Temme)
-    double guess = 0;
-    if (this->alpha < 10) {
-        double r = std::log(p * this->alpha) + lgammaAlpha;
-        r = std::exp(r / this->alpha);
-        /// if p -> 0
-        if (r < 0.2 * (this->alpha + 1)) {
-            guess = initRootForSmallP(r);
-        }
-        else {
-            double logQ = std::log1pl(-p);
-            /// boundary adviced in a paper
-            double maxBoundary1 = -0.5 * this->alpha - logAlpha - lgammaAlpha;
-            /// the maximum possible value to have a solution
-            double maxBoundary2 = this->alpha * (logAlpha - 1) - lgammaAlpha;
-            /// if p -> 1
-            if (logQ < std::min(maxBoundary1, maxBoundary2))
-                guess = initRootForLargeP(logQ);
-            else if (this->alpha < 1)
-                guess = r;
-            else
-                guess = initRootForLargeShape(p);
-        }
-    }
-    else
-        guess = initRootForLargeShape(p);
-    return guess / this->beta;
-}
-
-template < typename RealType >
-RealType GammaDistribution<RealType>::quantileInitialGuess1m(double p) const
-{
-    if (this->alpha < 10) {
-        double logQ = std::log(p);
-        /// boundary adviced in a paper
-        double maxBoundary1 = -0.5 * this->alpha - logAlpha - lgammaAlpha;
-        /// the maximum possible value to have a solution
-        double maxBoundary2 = this->alpha * (logAlpha - 1) - lgammaAlpha;
-        /// if p -> 0
-        if (logQ < std::min(maxBoundary1, maxBoundary2))
-            return initRootForLargeP(logQ) / this->beta;
-    }
-    else {
-        return initRootForLargeShape1m(p) / this->beta;
-    }
-    return quantileInitialGuess(1.0 - p);
-}
-
 template < typename RealType >
 double GammaDistribution<RealType>::df(RealType x) const
 {
@@ -473,7 +614,7 @@ double GammaDistribution<RealType>::df(RealType x) const
 template < typename RealType >
 double GammaDistribution<RealType>::dfDivf(RealType x) const
 {
-    return x / (this->alpha - 1 - this->beta * x);
+    return (this->alpha - 1 - this->beta * x) / x;
 }
 
 template < typename RealType >
@@ -481,7 +622,7 @@ RealType GammaDistribution<RealType>::quantileImpl(double p, RealType initValue)
 {
     if (p < 1e-5) { /// too small p
         double logP = std::log(p);
-        if (!RandMath::findRootNewtonSecondOrder<RealType>([this, logP] (double x)
+        return this->quantileBracketed([this, logP] (double x)
         {
             if (x <= 0)
                return DoubleTriplet(-INFINITY, 0, 0);
@@ -490,11 +631,9 @@ RealType GammaDistribution<RealType>::quantileImpl(double p, RealType initValue)
             double second = std::exp(logPdf - logCdf);
             double third = second * (dfDivf(x) - second);
             return DoubleTriplet(first, second, third);
-        }, initValue))
-            throw std::runtime_error("Gamma distribution: failure in numeric procedure");
-        return initValue;
+        }, initValue);
     }
-    if (!RandMath::findRootNewtonSecondOrder<RealType>([this, p] (double x)
+    return this->quantileBracketed([this, p] (double x)
     {
         if (x <= 0)
             return DoubleTriplet(-p, 0, 0);
@@ -502,15 +641,21 @@ RealType GammaDistribution<RealType>::quantileImpl(double p, RealType initValue)
         double second = f(x);
         double third = df(x);
         return DoubleTriplet(first, second, third);
-    }, initValue))
-        throw std::runtime_error("Gamma distribution: failure in numeric procedure");
-    return initValue;
+    }, initValue);
 }
 
 template < typename RealType >
 RealType GammaDistribution<RealType>::quantileImpl(double p) const
 {
-    return (this->alpha == 1.0) ? -theta * std::log1pl(-p) : quantileImpl(p, quantileInitialGuess(p));
+    if (this->alpha == 1.0)
+        return -theta * std::log1pl(-p);
+    RealType root = 0;
+    if (this->quantileSweepGuess(p, root, false))
+        root = quantileImpl(p, root);
+    else
+        root = theta * RandMath::pgammainv(this->alpha, p, logAlpha, lgammaAlpha);
+    this->setPreviousQuantile(root, p);
+    return root;
 }
 
 template < typename RealType >
@@ -518,7 +663,7 @@ RealType GammaDistribution<RealType>::quantileImpl1m(double p, RealType initValu
 {
     if (p < 1e-5) { /// too small p
         double logP = std::log(p);
-        if (!RandMath::findRootNewtonSecondOrder<RealType>([this, logP] (double x)
+        return this->quantileBracketed([this, logP] (double x)
         {
            if (x <= 0)
                return DoubleTriplet(logP, 0, 0);
@@ -527,11 +672,9 @@ RealType GammaDistribution<RealType>::quantileImpl1m(double p, RealType initValu
             double second = std::exp(logPdf - logCcdf);
             double third = second * (dfDivf(x) + second);
             return DoubleTriplet(first, second, third);
-        }, initValue))
-            throw std::runtime_error("Gamma distribution: failure in numeric procedure");
-        return initValue;
+        }, initValue);
     }
-    if (!RandMath::findRootNewtonSecondOrder<RealType>([this, p] (double x)
+    return this->quantileBracketed([this, p] (double x)
     {
         if (x <= 0)
             return DoubleTriplet(p - 1.0, 0, 0);
@@ -539,15 +682,21 @@ RealType GammaDistribution<RealType>::quantileImpl1m(double p, RealType initValu
         double second = f(x);
         double third = df(x);
         return DoubleTriplet(first, second, third);
-    }, initValue))
-        throw std::runtime_error("Gamma distribution: failure in numeric procedure");
-    return initValue;
+    }, initValue);
 }
 
 template < typename RealType >
 RealType GammaDistribution<RealType>::quantileImpl1m(double p) const
 {
-    return (this->alpha == 1.0) ? -theta * std::log(p) : quantileImpl1m(p, quantileInitialGuess1m(p));
+    if (this->alpha == 1.0)
+        return -theta * std::log(p);
+    RealType root = 0;
+    if (this->quantileSweepGuess(p, root, true))
+        root = quantileImpl1m(p, root);
+    else
+        root = theta * RandMath::qgammainv(this->alpha, p, logAlpha, lgammaAlpha);
+    this->setPreviousQuantile(root, p);
+    return root;
 }
 
 template < typename RealType >
@@ -642,9 +791,14 @@ void GammaRand<RealType>::Fit(const std::vector<RealType> &sample)
     if (!this->allElementsArePositive(sample))
         throw std::invalid_argument(this->fitErrorDescription(this->WRONG_SAMPLE, this->POSITIVITY_VIOLATION));
 
+    Fit(this->GetSampleMean(sample), this->GetSampleLogMean(sample));
+}
+
+template < typename RealType >
+void GammaRand<RealType>::Fit(long double mean, long double logMean)
+{
     /// Calculate initial guess for shape
-    double average = this->GetSampleMean(sample);
-    double s = std::log(average) - this->GetSampleLogMean(sample);
+    double s = std::log(mean) - logMean;
     double sm3 = s - 3.0, sp12 = 12.0 * s;
     double shape = sm3 * sm3 + 2 * sp12;
     shape = std::sqrt(shape);
@@ -659,7 +813,7 @@ void GammaRand<RealType>::Fit(const std::vector<RealType> &sample)
     }, shape))
         throw std::runtime_error(this->fitErrorDescription(this->UNDEFINED_ERROR, "Error in root-finding procedure"));
 
-    SetParameters(shape, shape / average);
+    SetParameters(shape, shape / mean);
 }
 
 template < typename RealType >
@@ -682,6 +836,18 @@ DoublePair GammaRand<RealType>::SourceToNatural(DoublePair sourceParameters) con
     return {shape - 1, -rate};
 }
 
+template < typename RealType >
+DoublePair GammaRand<RealType>::NaturalToSource(DoublePair theta) const
+{
+    return {theta.first + 1, -theta.second};
+}
+
+template < typename RealType >
+void GammaRand<RealType>::SetSourceParameters(DoublePair sourceParameters)
+{
+    this->SetParameters(sourceParameters.first, sourceParameters.second);
+}
+
 template < typename RealType >
 double GammaRand<RealType>::LogNormalizer(DoublePair parameters) const
 {
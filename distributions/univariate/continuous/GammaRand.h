@@ -98,10 +98,13 @@ public:
 
     double f(const RealType & x) const override;
     double logf(const RealType & x) const override;
+    void LogProbabilityDensityFunction(const std::vector<RealType> &x, std::vector<double> &y) const override;
     double F(const RealType & x) const override;
     double logF(const RealType &x) const;
     double S(const RealType & x) const override;
     double logS(const RealType & x) const;
+    void CumulativeDistributionFunction(const std::vector<RealType> &x, std::vector<double> &y) const override;
+    void SurvivalFunction(const std::vector<RealType> &x, std::vector<double> &y) const override;
     
 private:
 
@@ -165,6 +168,23 @@ private:
      * @return gamma variate, using Marsaglia-Tsang algorithm
      */
     static RealType variateMarsagliaTsang(double shape, RandGenerator& randGenerator);
+    /**
+     * @fn sampleBest
+     * block version of Best algorithm: uniform variates are drawn for the whole block,
+     * cheap squeeze tests are evaluated in one pass and only rejected elements are retried
+     * @param shapes α_i for each element of outputData or one α for all of them (α < 1)
+     * @param outputData
+     */
+    static void sampleBest(const std::vector<double> &shapes, std::vector<RealType> &outputData, RandGenerator& randGenerator);
+    /**
+     * @fn sampleMarsagliaTsang
+     * block version of Marsaglia-Tsang algorithm: normal and uniform variates are drawn for the whole block,
+     * cubic transformation and squeeze test are evaluated in one branch-free pass,
+     * accepted values are compacted and only rejected elements are retried
+     * @param shapes α_i for each element of outputData or one α for all of them (α > 1/3)
+     * @param outputData
+     */
+    static void sampleMarsagliaTsang(const std::vector<double> &shapes, std::vector<RealType> &outputData, RandGenerator& randGenerator);
     
 public:
     /**
@@ -181,6 +201,36 @@ public:
      */
     static RealType Variate(double shape, double rate, RandGenerator &randGenerator = ProbabilityDistribution<RealType>::staticRandGenerator);
 
+    /**
+     * @fn StandardSampleParams
+     * fill outputData with gamma variates with unity rate, such that i-th variate has shape α_i;
+     * elements are grouped by the generator used for their shape and each group is sampled in one pass
+     * @param shapes α_i
+     * @param outputData
+     */
+    static void StandardSampleParams(const std::vector<double> &shapes, std::vector<RealType> &outputData,
+                                     RandGenerator &randGenerator = ProbabilityDistribution<RealType>::staticRandGenerator);
+    /**
+     * @fn StandardSampleStrided
+     * fill every stride-th element of outputData with gamma variates with common shape α and unity rate;
+     * block kernels write through a buffer of fixed size, so that no memory proportional to the size is allocated
+     * @param shape α
+     * @param outputData pointer on the first element
+     * @param size number of variates
+     * @param stride distance between consecutive variates
+     */
+    static void StandardSampleStrided(double shape, RealType *outputData, size_t size, size_t stride,
+                                      RandGenerator &randGenerator = ProbabilityDistribution<RealType>::staticRandGenerator);
+    /**
+     * @fn SampleParams
+     * fill outputData with gamma variates, such that i-th variate has shape α_i and rate β_i
+     * @param shapes α_i
+     * @param rates β_i
+     * @param outputData
+     */
+    static void SampleParams(const std::vector<double> &shapes, const std::vector<double> &rates, std::vector<RealType> &outputData,
+                             RandGenerator &randGenerator = ProbabilityDistribution<RealType>::staticRandGenerator);
+
     RealType Variate() const override;
     void Sample(std::vector<RealType> &outputData) const override;
 
@@ -210,15 +260,6 @@ public:
     long double ExcessKurtosis() const override;
 
 private:
-    /// quantile auxiliary functions
-    RealType initRootForSmallP(double r) const;
-    RealType initRootForLargeP(double logQ) const;
-    RealType initRootForSmallShape(double p) const;
-    RealType initRootForLargeShape(double p) const;
-    RealType initRootForLargeShape1m(double p) const;
-    RealType quantileInitialGuess(double p) const;
-    RealType quantileInitialGuess1m(double p) const;
-
     /**
      * @fn df
      * derivative of probability density function
@@ -309,6 +350,15 @@ public:
      */
     void FitShape(const std::vector<RealType> &sample);
 
+    /**
+     * @fn Fit
+     * set shape and rate, estimated via maximum-likelihood method,
+     * using sufficient statistics instead of the whole sample
+     * @param mean sample average
+     * @param logMean sample average of ln(X)
+     */
+    void Fit(long double mean, long double logMean);
+
     /**
      * @fn Fit
      * set shape and rate, estimated via maximum-likelihood method
@@ -319,6 +369,8 @@ public:
     DoublePair SufficientStatistic(RealType x) const override;
     DoublePair SourceParameters() const override;
     DoublePair SourceToNatural(DoublePair sourceParameters) const override;
+    DoublePair NaturalToSource(DoublePair theta) const override;
+    void SetSourceParameters(DoublePair sourceParameters) override;
     double LogNormalizer(DoublePair parameters) const override;
     DoublePair LogNormalizerGradient(DoublePair parameters) const override;
     double CarrierMeasure(RealType) const override;
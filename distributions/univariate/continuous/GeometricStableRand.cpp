@@ -38,12 +38,14 @@ void GeneralGeometricStableDistribution<RealType>::SetParameters(double exponent
         distributionType = (beta == 0.0) ? CAUCHY : UNITY_EXPONENT;
     else
         distributionType = GENERAL;
+    invalidateGrid(true);
 }
 
 template < typename RealType >
 void GeneralGeometricStableDistribution<RealType>::SetLocation(double location)
 {
     mu = location;
+    invalidateGrid(false);
 }
 
 template < typename RealType >
@@ -60,6 +62,7 @@ void GeneralGeometricStableDistribution<RealType>::SetScale(double scale)
                                     + std::to_string(scale));
     gamma = scale;
     logGamma = std::log(gamma);
+    invalidateGrid(false);
 }
 
 template < typename RealType >
@@ -237,6 +240,519 @@ double GeneralGeometricStableDistribution<RealType>::pdfByCauchy(double x) const
     }, 0, 1);
 }
 
+template < typename RealType >
+void GeneralGeometricStableDistribution<RealType>::Tabulate()
+{
+    tabulated = true;
+}
+
+template < typename RealType >
+void GeneralGeometricStableDistribution<RealType>::Untabulate()
+{
+    tabulated = false;
+    invalidateGrid(true);
+}
+
+template < typename RealType >
+void GeneralGeometricStableDistribution<RealType>::BuildCaches() const
+{
+    isGridApplicable();
+    ContinuousDistribution<RealType>::BuildCaches();
+}
+
+template < typename RealType >
+void GeneralGeometricStableDistribution<RealType>::invalidateGrid(bool isStableChanged)
+{
+    gridValid = false;
+    for (int side = 0; side != 2; ++side) {
+        gridLogPdf[side].clear();
+        gridLogPdfDerivative[side].clear();
+        gridLogTail[side].clear();
+        gridLogTailDerivative[side].clear();
+    }
+    if (!isStableChanged)
+        return;
+    stableTableValid = false;
+    stablePdfTable.clear();
+    stablePdfDerivativeTable.clear();
+    stableCdfTable.clear();
+    stableCcdfTable.clear();
+    stableRightTailCoefs.clear();
+    stableLeftTailCoefs.clear();
+}
+
+template < typename RealType >
+double GeneralGeometricStableDistribution<RealType>::pdfByIntegral(double x0) const
+{
+    return RandMath::integral([this, x0] (double z)
+    {
+        if (z <= 0 || z >= 1)
+            return 0.0;
+        double logz = std::log(z);
+        double tau = 1.0 / (gamma * std::pow(-logz, alphaInv));
+        double par = tau * (x0 + mu * logz);
+        return tau * Z.f(par);
+    },
+    0, 1);
+}
+
+template < typename RealType >
+double GeneralGeometricStableDistribution<RealType>::cdfByIntegral(double x0) const
+{
+    return RandMath::integral([this, x0] (double z)
+    {
+        if (z <= 0) {
+            if (x0 != 0.0)
+                return (x0 < 0.0) ? 0.0 : 1.0;
+            if (mu == 0)
+                return Z.F(0);
+            if (distributionType == UNITY_EXPONENT)
+                return Z.F(-mu / gamma);
+            if (alpha < 1.0)
+                return Z.F(0);
+            return (mu < 0.0) ? 1.0 : 0.0;
+        }
+
+        /// weight exp(-t) / (1 - z)^2 vanishes for t → ∞
+        if (z >= 1)
+            return 0.0;
+
+        double denominator = 1.0 - z;
+        double t = z / denominator;
+        double par = x0 - mu * t;
+        par /= std::pow(t, alphaInv) * gamma;
+        double y = std::exp(-t) * Z.F(par);
+        return y / (denominator * denominator);
+    },
+    0, 1);
+}
+
+template < typename RealType >
+bool GeneralGeometricStableDistribution<RealType>::isGridApplicable() const
+{
+    if (!tabulated || (distributionType != GENERAL && distributionType != ONEHALF_EXPONENT))
+        return false;
+    if (!stableTableValid)
+        buildStableTable();
+    if (stablePdfTable.empty())
+        return false;
+    if (!gridValid) {
+        buildGrid();
+        gridAccepted = checkGrid();
+    }
+    return gridAccepted;
+}
+
+template < typename RealType >
+bool GeneralGeometricStableDistribution<RealType>::buildStableTable() const
+{
+    static constexpr double EPSILON = 1e-16;
+    static constexpr int MAX_TERMS = 60;
+    static constexpr double MAX_BOUND = 1e4;
+    static constexpr double MAX_STEP = 0.015625; ///< 2^(-6), maximal step of the table
+    static constexpr size_t MAX_SIZE = 1 << 20; ///< maximal size of FFT
+    static constexpr int POLYNOMIAL_DEGREE = 40; ///< degree of Taylor polynomial for aliasing correction
+    stableTableValid = true;
+
+    /// φ(t) = exp(-t^α (1 - iτ)) for t > 0, 1 - iτ = ρ exp(-iη)
+    double tau = beta * std::tan(M_PI_2 * alpha);
+    double logRho = 0.5 * std::log1pl(tau * tau), eta = std::atan(tau);
+
+    /// Coefficients of series f(y) ~ Σ c_k y^(-kα-1), obtained by termwise integration of exp(-ity) φ(t)
+    auto tailCoefs = [this, logRho] (double etaAdj)
+    {
+        std::vector<double> coefs(MAX_TERMS);
+        for (int k = 1; k <= MAX_TERMS; ++k) {
+            double sine = std::sin(k * (etaAdj + M_PI_2 * alpha));
+            if (std::fabs(sine) < 1e-12)
+                sine = 0.0; /// light tail for |β| = 1
+            double coef = std::exp(k * logRho + std::lgammal(k * alpha + 1) - RandMath::lfact(k)) * M_1_PI * sine;
+            coefs[k - 1] = (k & 1) ? coef : -coef;
+        }
+        return coefs;
+    };
+    std::vector<double> rightCoefs = tailCoefs(eta), leftCoefs = tailCoefs(-eta);
+
+    /// Find boundary Y, such that the series are accurate for |y| ≥ Y, and the number of terms
+    auto numberOfTerms = [this] (const std::vector<double> &coefs, double y)
+    {
+        double q = std::pow(y, -alpha), power = 1.0, sum = 0.0, previousTerm = INFINITY;
+        for (int k = 1; k <= MAX_TERMS; ++k) {
+            power *= q;
+            double term = std::fabs(coefs[k - 1]) * power;
+            if (term <= EPSILON * sum)
+                return k - 1;
+            /// asymptotic series starts to diverge
+            if (term > previousTerm && term > 0.0)
+                return -1;
+            sum += term;
+            if (term > 0.0)
+                previousTerm = term;
+        }
+        return (sum == 0.0) ? 0 : -1;
+    };
+    double bound = 12.5;
+    int rightTerms = -1, leftTerms = -1;
+    while (bound <= MAX_BOUND) {
+        rightTerms = numberOfTerms(rightCoefs, bound);
+        leftTerms = numberOfTerms(leftCoefs, bound);
+        if (rightTerms >= 0 && leftTerms >= 0)
+            break;
+        bound *= 2;
+    }
+    if (rightTerms < 0 || leftTerms < 0)
+        return false;
+
+    /// Period L = 4Y of the discrete Fourier transform, such that aliases are in the region of the tail series
+    double period = 4 * bound;
+    double maxFrequency = std::pow(40.0, 1.0 / alpha); /// |φ(T)| = exp(-40)
+    double minSize = std::max(period * maxFrequency / M_PI, period / MAX_STEP);
+    if (minSize > MAX_SIZE)
+        return false;
+    size_t size = 8;
+    while (size < minSize)
+        size <<= 1;
+    double step = period / size, frequencyStep = 2 * M_PI / period;
+
+    rightCoefs.resize(rightTerms);
+    leftCoefs.resize(leftTerms);
+    stableRightTailCoefs = rightCoefs;
+    stableLeftTailCoefs = leftCoefs;
+    stableTableBound = bound;
+    stableTableStep = step;
+
+    /// f(y_j) = (1 / 2π) Σ φ(t_k) exp(-i t_k y_j) dt, where t_k = (k - N/2) dt and y_j = (j - N/2) dy;
+    /// f and f' are obtained as real and imaginary parts of one transform
+    std::vector<std::complex<double>> a(size);
+    for (size_t k = 0; k != size; ++k) {
+        double t = (static_cast<double>(k) - 0.5 * size) * frequencyStep;
+        std::complex<double> phi = 1.0;
+        if (t != 0.0) {
+            double tPowAlpha = std::pow(std::fabs(t), alpha);
+            phi = std::exp(std::complex<double>(-tPowAlpha, tPowAlpha * tau));
+            if (t < 0)
+                phi = std::conj(phi);
+        }
+        phi *= 1.0 + t; /// φ(t) + i(-itφ(t))
+        a[k] = (k & 1) ? -phi : phi;
+    }
+    RandMath::fft(a);
+
+    /// Aliases Σ f(y + kL), k ≠ 0, are approximated by Taylor polynomial, built with the help of the tail series:
+    /// Σ_{k ≥ 1} (kL ± y)^(-s) = Σ_n (s)_n / n! (∓y)^n L^(-s-n) ζ(s + n)
+    std::vector<double> aliasCoefs(POLYNOMIAL_DEGREE + 1, 0.0);
+    double logPeriod = std::log(period);
+    for (size_t side = 0; side != 2; ++side) {
+        const std::vector<double> &coefs = (side == 0) ? rightCoefs : leftCoefs;
+        for (size_t k = 1; k <= coefs.size(); ++k) {
+            double s = k * alpha + 1, binomial = 1.0;
+            for (int n = 0; n <= POLYNOMIAL_DEGREE; ++n) {
+                if (n > 0)
+                    binomial *= (s + n - 1) / n;
+                double term = coefs[k - 1] * binomial * std::exp(-(s + n) * logPeriod) * RandMath::riemannZeta(s + n);
+                aliasCoefs[n] += (side == 0 && (n & 1)) ? -term : term;
+            }
+        }
+    }
+
+    size_t tableSize = size / 2 + 1;
+    stablePdfTable.resize(tableSize);
+    stablePdfDerivativeTable.resize(tableSize);
+    double coef = frequencyStep / (2 * M_PI);
+    for (size_t i = 0; i != tableSize; ++i) {
+        size_t j = i + size / 4;
+        double y = (static_cast<double>(j) - 0.5 * size) * step;
+        double alias = aliasCoefs[POLYNOMIAL_DEGREE], aliasDerivative = 0.0;
+        for (int n = POLYNOMIAL_DEGREE; n > 0; --n) {
+            aliasDerivative = aliasDerivative * y + n * aliasCoefs[n];
+            alias = alias * y + aliasCoefs[n - 1];
+        }
+        double sign = (j & 1) ? -coef : coef;
+        stablePdfTable[i] = std::max(sign * a[j].real() - alias, 0.0);
+        stablePdfDerivativeTable[i] = sign * a[j].imag() - aliasDerivative;
+    }
+
+    /// Cumulative distribution function and its complement are obtained by integration of Hermite polynomials
+    /// from the left and right ends respectively, so that both of them keep relative accuracy in light tails;
+    /// the mismatch with the tail series is removed by normalization of the integrals
+    double pdf, pdfDerivative, leftTail, rightTail;
+    stableTail(-bound, pdf, pdfDerivative, leftTail);
+    stableTail(bound, pdf, pdfDerivative, rightTail);
+    std::vector<double> cellIntegrals(tableSize, 0.0);
+    double mass = 0.0;
+    for (size_t i = 1; i != tableSize; ++i) {
+        double integral = 0.5 * (stablePdfTable[i - 1] + stablePdfTable[i]);
+        integral += step * (stablePdfDerivativeTable[i - 1] - stablePdfDerivativeTable[i]) / 12.0;
+        cellIntegrals[i] = step * integral;
+        mass += cellIntegrals[i];
+    }
+    double normalization = (1.0 - leftTail - rightTail) / mass;
+    stableCdfTable.resize(tableSize);
+    stableCcdfTable.resize(tableSize);
+    stableCdfTable[0] = leftTail;
+    for (size_t i = 1; i != tableSize; ++i)
+        stableCdfTable[i] = stableCdfTable[i - 1] + normalization * cellIntegrals[i];
+    stableCcdfTable[tableSize - 1] = rightTail;
+    for (size_t i = tableSize - 1; i != 0; --i)
+        stableCcdfTable[i - 1] = stableCcdfTable[i] + normalization * cellIntegrals[i];
+    return true;
+}
+
+template < typename RealType >
+void GeneralGeometricStableDistribution<RealType>::stableTail(double y, double &pdf, double &pdfDerivative, double &tail) const
+{
+    const std::vector<double> &coefs = (y > 0) ? stableRightTailCoefs : stableLeftTailCoefs;
+    double z = std::fabs(y);
+    double q = std::pow(z, -alpha), power = 1.0;
+    pdf = pdfDerivative = tail = 0.0;
+    for (size_t k = 1; k <= coefs.size(); ++k) {
+        power *= q;
+        double term = coefs[k - 1] * power;
+        double kAlpha = k * alpha;
+        pdf += term;
+        pdfDerivative += term * (kAlpha + 1);
+        tail += term / kAlpha;
+    }
+    pdf /= z;
+    pdfDerivative /= z * z;
+    if (y > 0)
+        pdfDerivative = -pdfDerivative;
+}
+
+template < typename RealType >
+void GeneralGeometricStableDistribution<RealType>::stableValues(double y, double &pdf, double &pdfDerivative, double &cdf, double &ccdf) const
+{
+    if (std::fabs(y) >= stableTableBound) {
+        double tail = 0.0;
+        stableTail(y, pdf, pdfDerivative, tail);
+        cdf = (y < 0) ? tail : 1.0 - tail;
+        ccdf = (y < 0) ? 1.0 - tail : tail;
+        return;
+    }
+    /// cubic Hermite interpolation
+    double position = (y + stableTableBound) / stableTableStep;
+    size_t i = std::min(static_cast<size_t>(position), stablePdfTable.size() - 2);
+    double t = position - i, t2 = t * t, t3 = t2 * t, t4 = t2 * t2;
+    double f0 = stablePdfTable[i], f1 = stablePdfTable[i + 1];
+    double m0 = stableTableStep * stablePdfDerivativeTable[i], m1 = stableTableStep * stablePdfDerivativeTable[i + 1];
+    pdf = (2 * t3 - 3 * t2 + 1) * f0 + (t3 - 2 * t2 + t) * m0 + (3 * t2 - 2 * t3) * f1 + (t3 - t2) * m1;
+    pdf = std::max(pdf, 0.0);
+    pdfDerivative = (6 * t2 - 6 * t) * (f0 - f1) + (3 * t2 - 4 * t + 1) * m0 + (3 * t2 - 2 * t) * m1;
+    pdfDerivative /= stableTableStep;
+    double integral = (t - t3 + 0.5 * t4) * f0 + (0.25 * t4 - 2 * t3 / 3 + 0.5 * t2) * m0;
+    integral += (t3 - 0.5 * t4) * f1 + (0.25 * t4 - t3 / 3) * m1;
+    integral *= stableTableStep;
+    cdf = std::min(std::max(stableCdfTable[i] + integral, 0.0), 1.0);
+    ccdf = std::min(std::max(stableCcdfTable[i] - integral, 0.0), 1.0);
+}
+
+template < typename RealType >
+void GeneralGeometricStableDistribution<RealType>::mixtureValues(double x0, double &pdf, double &pdfDerivative, double &tail) const
+{
+    /// integration in v = log(w), f(x) = ∫ w exp(-w) f_Z((x0 - μw) / s) / s dv, where s = γw^(1/α)
+    double r = std::fabs(x0) / gamma;
+    /// rough magnitudes of the results to keep relative accuracy
+    double pdfScale = 1.0, pdfDerivativeScale = 1.0, tailScale = 1.0;
+    if (x0 != 0.0) {
+        pdfScale = gamma * (std::min(1.0, std::pow(r, 1.0 - alpha)) + std::pow(r, alpha + 1));
+        pdfDerivativeScale = pdfScale * std::fabs(x0);
+        tailScale = std::max(1.0, std::pow(r, alpha));
+    }
+    bool isLeft = (x0 <= 0);
+
+    double logCharacteristicW = 0.0;
+    if (x0 != 0.0) {
+        logCharacteristicW = std::min(logCharacteristicW, alpha * std::log(r));
+        if (mu != 0.0)
+            logCharacteristicW = std::min(logCharacteristicW, std::log(std::fabs(x0 / mu)));
+    }
+    double vMin = logCharacteristicW - 40.0;
+    double vMax = std::log(45.0 + ((x0 * mu > 0) ? x0 / mu : 0.0));
+
+    auto integrand = [this, x0, isLeft, pdfScale, pdfDerivativeScale, tailScale] (double v, std::vector<double> &y)
+    {
+        double w = std::exp(v);
+        double weight = w * std::exp(-w);
+        double scale = gamma * std::exp(v / alpha);
+        double pdfZ, pdfDerivativeZ, cdfZ, ccdfZ;
+        stableValues((x0 - mu * w) / scale, pdfZ, pdfDerivativeZ, cdfZ, ccdfZ);
+        y[0] = weight * pdfZ / scale * pdfScale;
+        y[1] = weight * pdfDerivativeZ / (scale * scale) * pdfDerivativeScale;
+        y[2] = weight * (isLeft ? cdfZ : ccdfZ) * tailScale;
+    };
+    /// the integrand can be concentrated in a narrow band of v (e.g. for light tail of Z),
+    /// which is missed by adaptive rule on the whole interval, therefore it is split into short pieces
+    static constexpr double MAX_PIECE_LENGTH = 2.0;
+    int numberOfPieces = std::ceil((vMax - vMin) / MAX_PIECE_LENGTH);
+    std::vector<double> nodes(numberOfPieces + 1);
+    for (int k = 0; k < numberOfPieces; ++k)
+        nodes[k] = vMin + k * (vMax - vMin) / numberOfPieces;
+    nodes[numberOfPieces] = vMax;
+    /// for x - m ~ μw the argument of Z is close to 0 in the band of width γw^(1/α) / |μ| around log(w),
+    /// which gets narrow near the shift, so the pieces are refined geometrically around it
+    if (x0 * mu > 0) {
+        double vPeak = std::log(x0 / mu);
+        for (double width = gamma / std::fabs(mu) * std::exp((alphaInv - 1.0) * vPeak); width < MAX_PIECE_LENGTH; width *= 4) {
+            nodes.push_back(vPeak - width);
+            nodes.push_back(vPeak + width);
+        }
+        nodes.push_back(vPeak);
+    }
+    std::sort(nodes.begin(), nodes.end());
+    nodes.erase(std::remove_if(nodes.begin(), nodes.end(), [vMin, vMax] (double v) { return v < vMin || v > vMax; }), nodes.end());
+    std::vector<double> integrals(3, 0.0);
+    for (size_t k = 1; k < nodes.size(); ++k) {
+        std::vector<double> pieceIntegrals = RandMath::integral(integrand, nodes[k - 1], nodes[k], 3, 1e-12);
+        for (size_t i = 0; i != 3; ++i)
+            integrals[i] += pieceIntegrals[i];
+    }
+    pdf = integrals[0] / pdfScale;
+    pdfDerivative = integrals[1] / pdfDerivativeScale;
+    tail = integrals[2] / tailScale;
+}
+
+template < typename RealType >
+void GeneralGeometricStableDistribution<RealType>::buildGrid() const
+{
+    static constexpr double LOG_STEP = 0.03125;
+    static constexpr double LOG_BOUND = 18.5; /// grid covers 10^(-8) < |x - m| / γ < 10^8
+    /// maximal mismatch between the chord and the mean slope at the nodes over the step,
+    /// larger one in the tail means that the values are spoiled by the errors of integration
+    static constexpr double CHORD_TOLERANCE = 1e-2;
+    static constexpr double TAIL_LEVEL = 1e-6;
+    gridValid = true;
+    gridLogStep = LOG_STEP;
+    gridLogMin = -LOG_BOUND;
+    int size = std::ceil(2 * LOG_BOUND / LOG_STEP) + 1;
+    for (int side = 0; side != 2; ++side) {
+        gridLogPdf[side].clear();
+        gridLogPdfDerivative[side].clear();
+        gridLogTail[side].clear();
+        gridLogTailDerivative[side].clear();
+        gridTruncated[side] = false;
+        /// zero density for one of the sides
+        if (alpha < 1 && side == 0 && beta == 1 && mu >= 0)
+            continue;
+        if (alpha < 1 && side == 1 && beta == -1 && mu <= 0)
+            continue;
+        for (int k = 0; k != size; ++k) {
+            double x0 = gamma * std::exp(gridLogMin + k * gridLogStep);
+            if (side == 0)
+                x0 = -x0;
+            double pdf = 0, pdfDerivative = 0, tail = 0;
+            mixtureValues(x0, pdf, pdfDerivative, tail);
+            /// the rest of the side is calculated directly
+            if (!std::isfinite(pdf) || !std::isfinite(pdfDerivative) || !std::isfinite(tail))
+                break;
+            /// underflow of the tail, the rest of the side is extrapolated
+            if (!(pdf > 0) || !(tail > 0)) {
+                gridTruncated[side] = true;
+                break;
+            }
+            double logPdf = std::log(pdf), logPdfDerivative = x0 * pdfDerivative / pdf;
+            double logTail = std::log(tail), logTailDerivative = -std::fabs(x0) * pdf / tail;
+            if (k > 0 && tail < TAIL_LEVEL) {
+                double pdfSlope = (logPdf - gridLogPdf[side].back()) / gridLogStep;
+                double pdfMeanSlope = 0.5 * (logPdfDerivative + gridLogPdfDerivative[side].back());
+                double tailSlope = (logTail - gridLogTail[side].back()) / gridLogStep;
+                double tailMeanSlope = 0.5 * (logTailDerivative + gridLogTailDerivative[side].back());
+                if (gridLogStep * std::fabs(pdfSlope - pdfMeanSlope) > CHORD_TOLERANCE ||
+                    gridLogStep * std::fabs(tailSlope - tailMeanSlope) > CHORD_TOLERANCE) {
+                    gridTruncated[side] = true;
+                    break;
+                }
+            }
+            gridLogPdf[side].push_back(logPdf);
+            gridLogPdfDerivative[side].push_back(logPdfDerivative);
+            gridLogTail[side].push_back(logTail);
+            gridLogTailDerivative[side].push_back(logTailDerivative);
+        }
+        /// derivative of the density is integrated with cancellation for small |x - m|,
+        /// where it is replaced by the difference of the neighbouring nodes
+        std::vector<double> &logPdfs = gridLogPdf[side], &logPdfDerivatives = gridLogPdfDerivative[side];
+        size_t sideSize = logPdfs.size();
+        for (size_t k = 0; sideSize > 1 && k != sideSize; ++k) {
+            size_t left = (k > 0) ? k - 1 : 0, right = std::min(k + 1, sideSize - 1);
+            double slope = (logPdfs[right] - logPdfs[left]) / ((right - left) * gridLogStep);
+            if (gridLogStep * std::fabs(logPdfDerivatives[k] - slope) > CHORD_TOLERANCE)
+                logPdfDerivatives[k] = slope;
+        }
+    }
+}
+
+template < typename RealType >
+bool GeneralGeometricStableDistribution<RealType>::gridValues(double x0, double &logPdf, double &logTail) const
+{
+    if (x0 == 0.0)
+        return false;
+    int side = (x0 > 0) ? 1 : 0;
+    const std::vector<double> &logPdfs = gridLogPdf[side];
+    if (logPdfs.size() < 2)
+        return false;
+    double position = (std::log(std::fabs(x0) / gamma) - gridLogMin) / gridLogStep;
+    if (!(position >= 0.0))
+        return false;
+    const std::vector<double> &logPdfDerivatives = gridLogPdfDerivative[side];
+    const std::vector<double> &logTails = gridLogTail[side], &logTailDerivatives = gridLogTailDerivative[side];
+    size_t last = logPdfs.size() - 1;
+    if (position > last) {
+        if (!gridTruncated[side])
+            return false;
+        /// power-law extrapolation with the slopes at the last node
+        double distance = (position - last) * gridLogStep;
+        logPdf = logPdfs[last] + std::min(logPdfDerivatives[last], 0.0) * distance;
+        logTail = logTails[last] + logTailDerivatives[last] * distance;
+        return true;
+    }
+    size_t i = std::min(static_cast<size_t>(position), last - 1);
+    double t = position - i, t2 = t * t, t3 = t2 * t;
+    double h00 = 2 * t3 - 3 * t2 + 1, h10 = t3 - 2 * t2 + t, h01 = 3 * t2 - 2 * t3, h11 = t3 - t2;
+    logPdf = h00 * logPdfs[i] + h01 * logPdfs[i + 1];
+    logPdf += gridLogStep * (h10 * logPdfDerivatives[i] + h11 * logPdfDerivatives[i + 1]);
+    logTail = h00 * logTails[i] + h01 * logTails[i + 1];
+    logTail += gridLogStep * (h10 * logTailDerivatives[i] + h11 * logTailDerivatives[i + 1]);
+    return true;
+}
+
+template < typename RealType >
+bool GeneralGeometricStableDistribution<RealType>::checkGrid() const
+{
+    static constexpr double PDF_TOLERANCE = 1e-2;
+    static constexpr double CDF_TOLERANCE = 1e-3;
+    for (double x0 : {-gamma, -0.3 * gamma, 0.3 * gamma, gamma}) {
+        double logPdf = 0, logTail = 0;
+        /// the rest of the side is calculated directly anyway
+        if (!gridValues(x0, logPdf, logTail))
+            continue;
+        double pdf = pdfByIntegral(x0);
+        if (!(std::fabs(std::exp(logPdf) - pdf) <= PDF_TOLERANCE * pdf))
+            return false;
+        double cdf = (x0 < 0) ? std::exp(logTail) : -std::expm1(logTail);
+        if (!(std::fabs(cdf - cdfByIntegral(x0)) <= CDF_TOLERANCE))
+            return false;
+    }
+    /// direct integrals are inaccurate in light tails, hence the interpolation in the tails
+    /// is compared with the integration over mixing variable between the nodes close to the end of each side
+    for (int side = 0; side != 2; ++side) {
+        size_t size = gridLogPdf[side].size();
+        if (size < 2)
+            continue;
+        for (size_t i : {(size - 1) / 2, (3 * size - 3) / 4, size - 2}) {
+            double x0 = gamma * std::exp(gridLogMin + (i + 0.5) * gridLogStep);
+            if (side == 0)
+                x0 = -x0;
+            double logPdf = 0, logTail = 0, pdf = 0, pdfDerivative = 0, tail = 0;
+            gridValues(x0, logPdf, logTail);
+            mixtureValues(x0, pdf, pdfDerivative, tail);
+            if (!(logTail <= 0.0) || !(std::fabs(std::exp(logPdf) - pdf) <= PDF_TOLERANCE * pdf))
+                return false;
+            if (!(std::fabs(std::exp(logTail) - tail) <= PDF_TOLERANCE * tail))
+                return false;
+        }
+    }
+    return true;
+}
+
 template < typename RealType >
 double GeneralGeometricStableDistribution<RealType>::f(const RealType &x) const
 {
@@ -268,22 +784,26 @@ double GeneralGeometricStableDistribution<RealType>::f(const RealType &x) const
         }
     }
 
-    return RandMath::integral([this, x0] (double z)
-    {
-        if (z <= 0 || z >= 1)
-            return 0.0;
-        double logz = std::log(z);
-        double tau = 1.0 / (gamma * std::pow(-logz, alphaInv));
-        double par = tau * (x0 + mu * logz);
-        return tau * Z.f(par);
-    },
-    0, 1);
+    if (isGridApplicable()) {
+        double logPdf = 0, logTail = 0;
+        if (gridValues(x0, logPdf, logTail))
+            return std::exp(logPdf);
+        double pdf = 0, pdfDerivative = 0, tail = 0;
+        mixtureValues(x0, pdf, pdfDerivative, tail);
+        return pdf;
+    }
+    return pdfByIntegral(x0);
 }
 
 template < typename RealType >
 double GeneralGeometricStableDistribution<RealType>::logf(const RealType & x) const
 {
-    return (distributionType == LAPLACE || distributionType == ASYMMETRIC_LAPLACE) ? logpdfLaplace(x - m) : std::log(f(x));
+    if (distributionType == LAPLACE || distributionType == ASYMMETRIC_LAPLACE)
+        return logpdfLaplace(x - m);
+    double logPdf = 0, logTail = 0;
+    if (isGridApplicable() && gridValues(x - m, logPdf, logTail))
+        return logPdf;
+    return std::log(f(x));
 }
 
 template < typename RealType >
@@ -292,38 +812,46 @@ double GeneralGeometricStableDistribution<RealType>::F(const RealType &x) const
     double x0 = x - m;
     if (distributionType == LAPLACE || distributionType == ASYMMETRIC_LAPLACE)
         return cdfLaplace(x0);
-    return RandMath::integral([this, x0] (double z)
-    {
-        if (z <= 0) {
-            if (x0 != 0.0)
-                return (x0 < 0.0) ? 0.0 : 1.0;
-            if (mu == 0)
-                return Z.F(0);
-            if (distributionType == UNITY_EXPONENT)
-                return Z.F(-mu / gamma);
-            if (alpha < 1.0)
-                return Z.F(0);
-            return (mu < 0.0) ? 1.0 : 0.0;
+    if (isGridApplicable()) {
+        if (x0 < 0 && alpha < 1 && beta == 1 && mu >= 0)
+            return 0.0;
+        if (x0 > 0 && alpha < 1 && beta == -1 && mu <= 0)
+            return 1.0;
+        double logPdf = 0, logTail = 0, tail = 0;
+        if (gridValues(x0, logPdf, logTail))
+            tail = std::exp(std::min(logTail, 0.0));
+        else {
+            double pdf = 0, pdfDerivative = 0;
+            mixtureValues(x0, pdf, pdfDerivative, tail);
+            tail = std::min(std::max(tail, 0.0), 1.0);
         }
+        return (x0 <= 0) ? tail : 1.0 - tail;
+    }
+    return std::min(std::max(cdfByIntegral(x0), 0.0), 1.0);
+}
 
-        if (z >= 1) {
-            if (mu == 0.0)
-                return Z.F(0);
-            if (distributionType == UNITY_EXPONENT)
-                return Z.F(-mu / gamma);
-            if (alpha > 1.0)
-                return Z.F(0);
-            return (mu < 0.0) ? 1.0 : 0.0;
+template < typename RealType >
+double GeneralGeometricStableDistribution<RealType>::S(const RealType &x) const
+{
+    double x0 = x - m;
+    if (distributionType == LAPLACE || distributionType == ASYMMETRIC_LAPLACE)
+        return cdfLaplaceCompl(x0);
+    if (isGridApplicable()) {
+        if (x0 < 0 && alpha < 1 && beta == 1 && mu >= 0)
+            return 1.0;
+        if (x0 > 0 && alpha < 1 && beta == -1 && mu <= 0)
+            return 0.0;
+        double logPdf = 0, logTail = 0, tail = 0;
+        if (gridValues(x0, logPdf, logTail))
+            tail = std::exp(std::min(logTail, 0.0));
+        else {
+            double pdf = 0, pdfDerivative = 0;
+            mixtureValues(x0, pdf, pdfDerivative, tail);
+            tail = std::min(std::max(tail, 0.0), 1.0);
         }
-
-        double denominator = 1.0 - z;
-        double t = z / denominator;
-        double par = x0 - mu * t;
-        par /= std::pow(t, alphaInv) * gamma;
-        double y = std::exp(-t) * Z.F(par);
-        return y / (denominator * denominator);
-    },
-    0, 1);
+        return (x0 > 0) ? tail : 1.0 - tail;
+    }
+    return 1.0 - F(x);
 }
 
 template < typename RealType >
@@ -13,6 +13,27 @@ class RANDLIBSHARED_EXPORT GeneralGeometricStableDistribution : public Continuou
 {
     StableRand<RealType> Z{};
 
+    /// grid mode
+    bool tabulated = false; ///< true if grid mode is switched on
+    mutable bool stableTableValid = false; ///< true if table of the standard stable distribution corresponds to α and β
+    mutable bool gridValid = false; ///< true if grid of the distribution corresponds to current parameters
+    mutable bool gridAccepted = false; ///< true if grid agrees with direct integration at the probe points
+    mutable double stableTableBound = 0; ///< table of the standard stable distribution covers [-Y, Y], tail series are used beyond
+    mutable double stableTableStep = 0; ///< step of the table
+    mutable std::vector<double> stablePdfTable{}; ///< density of the standard stable distribution on the table
+    mutable std::vector<double> stablePdfDerivativeTable{}; ///< derivative of the density on the table
+    mutable std::vector<double> stableCdfTable{}; ///< cumulative distribution function on the table
+    mutable std::vector<double> stableCcdfTable{}; ///< complementary cumulative distribution function on the table
+    mutable std::vector<double> stableRightTailCoefs{}; ///< coefficients of series f(y) ~ Σ c_k y^(-kα-1) for y → ∞
+    mutable std::vector<double> stableLeftTailCoefs{}; ///< coefficients of series f(-y) ~ Σ c_k y^(-kα-1) for y → ∞
+    mutable double gridLogStep = 0; ///< step of the grid in log(|x - m| / γ)
+    mutable double gridLogMin = 0; ///< log(|x - m| / γ) at the first node of the grid
+    mutable std::vector<double> gridLogPdf[2]; ///< log(f(x)) on the grid on the left and right sides of m
+    mutable std::vector<double> gridLogPdfDerivative[2]; ///< derivative of log(f(x)) in log(|x - m|)
+    mutable std::vector<double> gridLogTail[2]; ///< log(F(x)) on the left side and log(S(x)) on the right side
+    mutable std::vector<double> gridLogTailDerivative[2]; ///< derivative of log-tail in log(|x - m|)
+    mutable bool gridTruncated[2] = {false, false}; ///< true if the side of the grid is cut where integration loses accuracy
+
 protected:
     double alpha = 2; ///< characteristic exponent α
     double alphaInv = 0.5; /// 1/α
@@ -50,6 +71,35 @@ protected:
 
     DISTRIBUTION_TYPE distributionType = LAPLACE; ///< type of distribution (Laplace by default)
 
+    /**
+     * @fn Tabulate
+     * Switch on grid mode for exponents, which don't have closed-form expressions (α ≠ 1, 2 and not Levy).
+     * Density of the standard stable distribution is recovered once by FFT inversion of its characteristic function,
+     * then pdf and cdf are integrated over the exponential mixing variable at the nodes of logarithmic grid
+     * and are interpolated afterwards. Tables are rebuilt lazily after parameters are changed
+     * and are compared with direct integration at a few points before use, exact calculations are kept
+     * if they disagree. For α < 1/3 the inversion is not feasible and exact calculations are kept as well
+     */
+    void Tabulate();
+
+    /**
+     * @fn Untabulate
+     * switch off grid mode and free the tables
+     */
+    void Untabulate();
+
+    /**
+     * @fn IsTabulated
+     * @return true if grid mode is switched on
+     */
+    inline bool IsTabulated() const { return tabulated; }
+
+    /**
+     * @fn BuildCaches
+     * build the tables of grid mode, if it's switched on, before the grid for quantiles
+     */
+    void BuildCaches() const override;
+
 public:
     inline double GetExponent() const { return alpha; }
     inline double GetSkewness() const { return beta; }
@@ -70,10 +120,102 @@ private:
     double pdfByLevy(double x) const;
     double pdfByCauchy(double x) const;
 
+    /**
+     * @fn pdfByIntegral
+     * @param x0 x - m
+     * @return f(x) by direct integration over the exponential mixing variable
+     */
+    double pdfByIntegral(double x0) const;
+
+    /**
+     * @fn cdfByIntegral
+     * @param x0 x - m
+     * @return F(x) by direct integration over the exponential mixing variable
+     */
+    double cdfByIntegral(double x0) const;
+
+    /**
+     * @fn isGridApplicable
+     * @return true if grid mode is switched on and tables can be used for current parameters
+     */
+    bool isGridApplicable() const;
+
+    /**
+     * @fn buildStableTable
+     * tabulate standard stable distribution S(α, β, 1, 0) by FFT inversion of its characteristic function
+     * φ(t) = exp(-|t|^α (1 - iβ tan(πα/2) sign(t))), aliasing from heavy tails is removed with the help of tail series
+     * @return false if FFT would be too large for current exponent
+     */
+    bool buildStableTable() const;
+
+    /**
+     * @fn stableTail
+     * calculate series expansion of the standard stable distribution for |y| ≥ Y
+     * @param y
+     * @param pdf f(y)
+     * @param pdfDerivative f'(y)
+     * @param tail F(y) for negative y or S(y) for positive y
+     */
+    void stableTail(double y, double &pdf, double &pdfDerivative, double &tail) const;
+
+    /**
+     * @fn stableValues
+     * interpolate the table of standard stable distribution
+     * @param y
+     * @param pdf f(y)
+     * @param pdfDerivative f'(y)
+     * @param cdf F(y)
+     * @param ccdf S(y)
+     */
+    void stableValues(double y, double &pdf, double &pdfDerivative, double &cdf, double &ccdf) const;
+
+    /**
+     * @fn mixtureValues
+     * integrate over the exponential mixing variable W, as X - m = μW + γW^(1/α)Z
+     * @param x0 x - m, should be non-zero
+     * @param pdf f(x)
+     * @param pdfDerivative f'(x)
+     * @param tail F(x) for x < m and S(x) for x > m
+     */
+    void mixtureValues(double x0, double &pdf, double &pdfDerivative, double &tail) const;
+
+    /**
+     * @fn buildGrid
+     * calculate log-density and log-tails on logarithmic grid on both sides of m
+     */
+    void buildGrid() const;
+
+    /**
+     * @fn gridValues
+     * @param x0 x - m
+     * @param logPdf log(f(x))
+     * @param logTail log(F(x)) for x < m or log(S(x)) for x > m
+     * @return false if x0 is out of the grid, log-values are extrapolated beyond the truncated side
+     */
+    bool gridValues(double x0, double &logPdf, double &logTail) const;
+
+    /**
+     * @fn checkGrid
+     * compare the grid with direct integration at points |x - m| = 0.3γ and γ on both sides
+     * and with integration over mixing variable between the nodes in the tails
+     * @return true if density agrees with relative tolerance 1e-2 and cdf with absolute tolerance 1e-3,
+     * density and tails agree with relative tolerance 1e-2 in the tails
+     */
+    bool checkGrid() const;
+
+protected:
+    /**
+     * @fn invalidateGrid
+     * should be called after change of the parameters
+     * @param isStableChanged true if exponent or skewness is changed
+     */
+    void invalidateGrid(bool isStableChanged);
+
 public:
     double f(const RealType & x) const override;
     double logf(const RealType & x) const override;
     double F(const RealType & x) const override;
+    double S(const RealType & x) const override;
 
 private:
     double variateForUnityExponent(double z) const;
@@ -133,6 +275,11 @@ public:
     void SetLocation(double location);
     void SetScale(double scale);
     inline double GetLocation() const { return this->mu; }
+
+    using GeneralGeometricStableDistribution<RealType>::Tabulate;
+    using GeneralGeometricStableDistribution<RealType>::Untabulate;
+    using GeneralGeometricStableDistribution<RealType>::IsTabulated;
+    using GeneralGeometricStableDistribution<RealType>::BuildCaches;
 };
 
 #endif // GEOMETRICSTABLERAND_H
@@ -1,4 +1,5 @@
 #include "IrwinHallRand.h"
+#include "NormalRand.h"
 
 template < typename RealType >
 IrwinHallRand<RealType>::IrwinHallRand(size_t number)
@@ -18,6 +19,84 @@ void IrwinHallRand<RealType>::SetNumber(int number)
     if (number <= 0)
         throw std::invalid_argument("Irwin-Hall distribution: number should be positive");
     n = number;
+    sigma = std::sqrt(n / 12.0);
+    table.reset();
+}
+
+template < typename RealType >
+double IrwinHallRand<RealType>::recurrence(double x, bool isDensity, double &logScale) const
+{
+    /// values are rescaled by 2^SCALE_EXPONENT, when they become too small
+    static constexpr int SCALE_EXPONENT = -std::numeric_limits<double>::min_exponent / 2;
+    static const double SCALE_THRESHOLD = std::ldexp(1.0, -SCALE_EXPONENT);
+    int last = std::floor(x);
+    /// v[j] = f_m(x - j) or F_m(x - j), values for j > last are equal to 0
+    std::vector<double> v(last + 2, 0.0);
+    int m = 1;
+    if (isDensity) {
+        v[last] = 1.0;
+    }
+    else {
+        std::fill(v.begin(), v.begin() + last + 1, 1.0);
+        m = 0;
+    }
+    logScale = 0.0;
+    for (++m; m <= n; ++m) {
+        double factor = 1.0 / (isDensity ? m - 1 : m);
+        double maxValue = 0.0;
+        /// values for x - j ≥ m stay equal to 1 for cdf and 0 for density
+        int first = std::max(0, static_cast<int>(std::floor(x - m)) + 1);
+        for (int j = first; j <= last; ++j) {
+            double y = x - j;
+            v[j] = (y * v[j] + (m - y) * v[j + 1]) * factor;
+            maxValue = std::max(maxValue, v[j]);
+        }
+        /// cdf values, which are not updated, are equal to 1
+        if (maxValue > 0.0 && maxValue < SCALE_THRESHOLD && (isDensity || first == 0)) {
+            for (int j = first; j <= last; ++j)
+                v[j] = std::ldexp(v[j], SCALE_EXPONENT);
+            logScale -= SCALE_EXPONENT * M_LN2;
+        }
+    }
+    return v[0];
+}
+
+template < typename RealType >
+const CFInversion<RealType> &IrwinHallRand<RealType>::getTable() const
+{
+    static constexpr double TABLE_EPSILON = 1e-13;
+    if (!table) {
+        /// P(|X - n / 2| > 20σ) < 2exp(-200 / 3) by Hoeffding's inequality
+        double center = 0.5 * n, halfWidth = 20 * sigma;
+        std::vector<const UnivariateDistribution<RealType> *> summands{this};
+        table.emplace(summands, std::max(center - halfWidth, 0.0), std::min(center + halfWidth, 1.0 * n), TABLE_EPSILON);
+    }
+    return *table;
+}
+
+template < typename RealType >
+bool IrwinHallRand<RealType>::tableValue(double x, bool isDensity, double &value) const
+{
+    static constexpr double TABLE_MIN_PROBABILITY = 1e-4;
+    if (n <= RECURRENCE_LIMIT)
+        return false;
+    const CFInversion<RealType> &cdfTable = getTable();
+    double cdf = cdfTable.F(x);
+    if (cdf < TABLE_MIN_PROBABILITY)
+        return false;
+    value = isDensity ? cdfTable.f(x) : cdf;
+    return true;
+}
+
+template < typename RealType >
+double IrwinHallRand<RealType>::leftTail(double x, bool isDensity) const
+{
+    double value = 0.0;
+    if (tableValue(x, isDensity, value))
+        return value;
+    double logScale = 0.0;
+    double y = recurrence(x, isDensity, logScale);
+    return (logScale == 0.0) ? y : y * std::exp(logScale);
 }
 
 template < typename RealType >
@@ -31,23 +110,22 @@ double IrwinHallRand<RealType>::f(const RealType & x) const
         return 1.0;
     if (n == 2)
         return (x <= 1.0) ? x : 2.0 - x;
-    /// General case
-    double sum = 0.0;
-    int last = std::floor(x);
-    for (int i = 0; i <= last; ++i) {
-        double add = (n - 1) * std::log(x - i);
-        add -= RandMath::lfact(i);
-        add -= RandMath::lfact(n - i);
-        add = std::exp(add);
-        sum += (i % 2) ? -add : add;
-    }
-    return n * sum;
+    /// General case, f(x) = f(n - x)
+    return leftTail(std::min<double>(x, n - x), true);
 }
 
 template < typename RealType >
 double IrwinHallRand<RealType>::logf(const RealType & x) const
 {
-    return std::log(f(x));
+    if (x < 0 || x > n)
+        return -INFINITY;
+    if (n <= 2)
+        return std::log(f(x));
+    double y = std::min<double>(x, n - x), value = 0.0;
+    if (tableValue(y, true, value))
+        return std::log(value);
+    double logScale = 0.0;
+    return std::log(recurrence(y, true, logScale)) + logScale;
 }
 
 template < typename RealType >
@@ -67,32 +145,44 @@ double IrwinHallRand<RealType>::F(const RealType & x) const
         double temp = 2.0 - x;
         return 1.0 - 0.5 * temp * temp;
     }
-    /// General case
-    double sum = 0.0;
-    int last = std::floor(x);
-    for (int i = 0; i <= last; ++i) {
-        double add = n * std::log(x - i);
-        add -= RandMath::lfact(i);
-        add -= RandMath::lfact(n - i);
-        add = std::exp(add);
-        sum += (i % 2) ? -add : add;
-    }
-    return sum;
+    /// General case, F(x) = S(n - x)
+    return (x <= 0.5 * n) ? leftTail(x, false) : 1.0 - leftTail(n - x, false);
+}
+
+template < typename RealType >
+double IrwinHallRand<RealType>::S(const RealType & x) const
+{
+    return F(n - x);
 }
 
 template < typename RealType >
 RealType IrwinHallRand<RealType>::Variate() const
 {
-    RealType sum = 0.0;
-    for (int i = 0; i != n; ++i)
-        sum += U.Variate();
-    return sum;
+    if (n <= SUM_LIMIT) {
+        RealType sum = 0.0;
+        for (int i = 0; i != n; ++i)
+            sum += UniformRand<RealType>::StandardVariate(this->localRandGenerator);
+        return sum;
+    }
+    if (n <= EDGEWORTH_LIMIT)
+        return getTable().Quantile(UniformRand<RealType>::StandardVariate(this->localRandGenerator));
+    /// Cornish-Fisher expansion with standardized cumulants γ_2 = -6 / (5n) and γ_4 = 48 / (7n^2),
+    /// the error is O(n^-3)
+    double z = NormalRand<RealType>::StandardVariate(this->localRandGenerator), z2 = z * z;
+    double gamma2 = -1.2 / n, gamma4 = 48.0 / (7.0 * n * n);
+    double w = z + gamma2 / 24 * z * (z2 - 3) + gamma4 / 720 * z * ((z2 - 10) * z2 + 15);
+    w -= gamma2 * gamma2 / 384 * z * ((3 * z2 - 24) * z2 + 29);
+    double x = 0.5 * n + sigma * w;
+    return std::min(std::max(x, 0.0), 1.0 * n);
 }
 
 template < typename RealType >
-void IrwinHallRand<RealType>::Reseed(unsigned long seed) const
+void IrwinHallRand<RealType>::BuildCaches() const
 {
-    U.Reseed(seed);
+    /// the table is used by density and cdf for n > RECURRENCE_LIMIT and by Variate for n > SUM_LIMIT
+    if (n > SUM_LIMIT)
+        getTable();
+    ContinuousDistribution<RealType>::BuildCaches();
 }
 
 template < typename RealType >
@@ -111,7 +201,12 @@ long double IrwinHallRand<RealType>::Variance() const
 template < typename RealType >
 std::complex<double> IrwinHallRand<RealType>::CFImpl(double t) const
 {
-    return std::pow(U.CF(t), n);
+    /// φ(t) = (sin(t / 2) / (t / 2))^n exp(int / 2)
+    double halfT = 0.5 * t, sinc = std::sin(halfT) / halfT;
+    double angle = n * halfT;
+    if (sinc < 0 && (n & 1))
+        angle += M_PI;
+    return std::polar(std::exp(n * std::log(std::fabs(sinc))), angle);
 }
 
 template < typename RealType >
@@ -2,6 +2,8 @@
 #define IRWINHALLRAND_H
 
 #include "UniformRand.h"
+#include "../CFInversion.h"
+#include <optional>
 
 /**
  * @brief The IrwinHallRand class <BR>
@@ -13,12 +15,21 @@
  *
  * Related distributions: <BR>
  * X ~ Y_1 + Y_2 + ... + Y_n, where Y_i ~ U(0,1)
+ *
+ * The alternating sum above loses all precision for n ≳ 30, therefore density and cdf are calculated
+ * by the recurrences of cardinal B-splines, which have no cancellation.
+ * For large n values in the bulk are taken from the table, obtained by inversion of characteristic function.
  */
 template < typename RealType = double >
 class RANDLIBSHARED_EXPORT IrwinHallRand : public ContinuousDistribution<RealType>
 {
+    static constexpr int SUM_LIMIT = 8; ///< maximal n, for which variates are generated by summation
+    static constexpr int RECURRENCE_LIMIT = 32; ///< maximal n, for which density and cdf are calculated by recurrences only
+    static constexpr int EDGEWORTH_LIMIT = 4096; ///< maximal n, for which variates are generated by the table
+
     int n = 1; ///< parameter of the distribution
-    UniformRand<RealType> U{};
+    double sigma = 0.288675134594813; ///< standard deviation √(n / 12)
+    mutable std::optional<CFInversion<RealType>> table{}; ///< tabulated cdf for large n, built on demand
 
 public:
     explicit IrwinHallRand(size_t number);
@@ -34,8 +45,14 @@ public:
     double f(const RealType & x) const override;
     double logf(const RealType & x) const override;
     double F(const RealType & x) const override;
+    double S(const RealType & x) const override;
     RealType Variate() const override;
-    void Reseed(unsigned long seed) const override;
+
+    /**
+     * @fn BuildCaches
+     * build the table of cdf, if it's used for current n, before the grid for quantiles
+     */
+    void BuildCaches() const override;
 
     long double Mean() const override;
     long double Variance() const override;
@@ -45,6 +62,41 @@ public:
     long double ExcessKurtosis() const override;
 
 private:
+    /**
+     * @fn recurrence
+     * f_m(y) = (y f_{m-1}(y) + (m - y) f_{m-1}(y - 1)) / (m - 1) with f_1(y) = 1 for 0 ≤ y < 1,
+     * F_m(y) = (y F_{m-1}(y) + (m - y) F_{m-1}(y - 1)) / m with F_0(y) = 1 for y ≥ 0,
+     * all terms are non-negative for 0 ≤ y ≤ m
+     * @param x argument in [0, n / 2]
+     * @param isDensity
+     * @param logScale logarithm of the scale factor, which is applied to avoid underflow
+     * @return f(x) or F(x) divided by exp(logScale)
+     */
+    double recurrence(double x, bool isDensity, double &logScale) const;
+
+    /**
+     * @fn getTable
+     * @return table of cdf on the interval n / 2 ± 20σ
+     */
+    const CFInversion<RealType> &getTable() const;
+
+    /**
+     * @fn tableValue
+     * @param x argument in [0, n / 2]
+     * @param isDensity
+     * @param value f(x) or F(x) from the table
+     * @return true if n is large and the tabulated cdf is not too small to be relatively accurate
+     */
+    bool tableValue(double x, bool isDensity, double &value) const;
+
+    /**
+     * @fn leftTail
+     * @param x argument in [0, n / 2]
+     * @param isDensity
+     * @return f(x) or F(x)
+     */
+    double leftTail(double x, bool isDensity) const;
+
     std::complex<double> CFImpl(double t) const override;
 };
 
@@ -152,6 +152,10 @@ template class AsymmetricLaplaceDistribution<float>;
 template class AsymmetricLaplaceDistribution<double>;
 template class AsymmetricLaplaceDistribution<long double>;
 
+template class ShiftedAsymmetricLaplaceDistribution<float>;
+template class ShiftedAsymmetricLaplaceDistribution<double>;
+template class ShiftedAsymmetricLaplaceDistribution<long double>;
+
 template < typename RealType >
 String AsymmetricLaplaceRand<RealType>::Name() const
 {
@@ -69,6 +69,14 @@ RealType LogNormalRand<RealType>::StandardVariate(RandGenerator &randGenerator)
     return std::exp(NormalRand<RealType>::StandardVariate(randGenerator));
 }
 
+template < typename RealType >
+void LogNormalRand<RealType>::SampleParams(const std::vector<double> &locations, const std::vector<double> &scales, std::vector<RealType> &outputData, RandGenerator &randGenerator)
+{
+    NormalRand<RealType>::SampleParams(locations, scales, outputData, randGenerator);
+    for (RealType &var : outputData)
+        var = std::exp(var);
+}
+
 template < typename RealType >
 void LogNormalRand<RealType>::Reseed(unsigned long seed) const
 {
@@ -40,6 +40,16 @@ public:
 
     RealType Variate() const override;
     static RealType StandardVariate(RandGenerator &randGenerator = ProbabilityDistribution<RealType>::staticRandGenerator);
+
+    /**
+     * @fn SampleParams
+     * fill outputData with log-normal variates, such that i-th variate has location μ_i and scale σ_i
+     * @param locations μ_i
+     * @param scales σ_i
+     * @param outputData
+     */
+    static void SampleParams(const std::vector<double> &locations, const std::vector<double> &scales, std::vector<RealType> &outputData,
+                             RandGenerator &randGenerator = ProbabilityDistribution<RealType>::staticRandGenerator);
     void Reseed(unsigned long seed) const override;
 
     long double Mean() const override;
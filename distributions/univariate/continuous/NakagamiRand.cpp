@@ -165,17 +165,16 @@ std::complex<double> NakagamiDistribution<RealType>::CFImpl(double t) const
     if (mu >= 0.5)
         return ContinuousDistribution<RealType>::CFImpl(t);
 
-    double re = this->ExpectedValue([this, t] (double x)
+    std::vector<long double> reim = this->ExpectedValues({[t] (double x)
     {
         if (x == 0.0)
             return 0.0;
         return std::cos(t * x) - 1.0;
-    }, 0, INFINITY) + 1.0;
-
-    double im = this->ExpectedValue([this, t] (double x)
+    }, [t] (double x)
     {
         return std::sin(t * x);
-    }, 0, INFINITY);
+    }}, 0, INFINITY);
+    double re = reim[0] + 1.0, im = reim[1];
 
     return std::complex<double>(re, im);
 }
@@ -63,15 +63,56 @@ double NoncentralChiSquaredRand<RealType>::logf(const RealType & x) const
     return y + 0.5 * z - M_LN2;
 }
 
+template < typename RealType >
+void NoncentralChiSquaredRand<RealType>::ProbabilityDensityFunction(const std::vector<RealType> &x, std::vector<double> &y) const
+{
+    size_t size = x.size();
+    if (size > y.size())
+        return;
+    LogProbabilityDensityFunction(x, y);
+    for (size_t i = 0; i != size; ++i) {
+        if (x[i] == 0.0)
+            y[i] = f(x[i]);
+        else
+            y[i] = std::exp(y[i]);
+    }
+}
+
+template < typename RealType >
+void NoncentralChiSquaredRand<RealType>::LogProbabilityDensityFunction(const std::vector<RealType> &x, std::vector<double> &y) const
+{
+    size_t size = x.size();
+    if (size > y.size())
+        return;
+    /// Bessel function is evaluated at once for all positive arguments
+    std::vector<size_t> indices;
+    std::vector<double> args;
+    for (size_t i = 0; i != size; ++i) {
+        if (x[i] > 0.0) {
+            indices.push_back(i);
+            args.push_back(std::sqrt(lambda * x[i]));
+        }
+        else
+            y[i] = logf(x[i]);
+    }
+    std::vector<double> logBessel(args.size());
+    double halfKm1 = halfK - 1;
+    RandMath::logBesselI(halfKm1, args, logBessel);
+    for (size_t j = 0; j != indices.size(); ++j) {
+        double xj = x[indices[j]];
+        double z = halfKm1 * (std::log(xj) - logLambda);
+        z -= xj + lambda;
+        y[indices[j]] = logBessel[j] + 0.5 * z - M_LN2;
+    }
+}
+
 template < typename RealType >
 double NoncentralChiSquaredRand<RealType>::F(const RealType &x) const
 {
     if (x <= 0.0)
         return 0.0;
     double halfX = 0.5 * x;
-    double sqrtHalfX = std::sqrt(halfX);
-    double logHalfX = std::log(halfX);
-    return RandMath::MarcumP(halfK, halfLambda, halfX, sqrtLambda / M_SQRT2, sqrtHalfX, logLambda - M_LN2, logHalfX);
+    return RandMath::MarcumP(halfK, halfLambda, halfX, std::log(halfX));
 }
 
 template < typename RealType >
@@ -80,9 +121,52 @@ double NoncentralChiSquaredRand<RealType>::S(const RealType &x) const
     if (x <= 0.0)
         return 1.0;
     double halfX = 0.5 * x;
-    double sqrtHalfX = std::sqrt(halfX);
-    double logHalfX = std::log(halfX);
-    return RandMath::MarcumQ(halfK, halfLambda, halfX, sqrtLambda / M_SQRT2, sqrtHalfX, logLambda - M_LN2, logHalfX);
+    return RandMath::MarcumQ(halfK, halfLambda, halfX, std::log(halfX));
+}
+
+template < typename RealType >
+void NoncentralChiSquaredRand<RealType>::CumulativeDistributionFunction(const std::vector<RealType> &x, std::vector<double> &y) const
+{
+    size_t size = x.size();
+    if (size > y.size())
+        return;
+    /// Marcum function is evaluated at once for all positive arguments
+    std::vector<size_t> indices;
+    std::vector<double> halfX;
+    for (size_t i = 0; i != size; ++i) {
+        if (x[i] > 0.0) {
+            indices.push_back(i);
+            halfX.push_back(0.5 * x[i]);
+        }
+        else
+            y[i] = 0.0;
+    }
+    std::vector<double> cdf(halfX.size());
+    RandMath::MarcumP(halfK, halfLambda, halfX, cdf);
+    for (size_t j = 0; j != indices.size(); ++j)
+        y[indices[j]] = cdf[j];
+}
+
+template < typename RealType >
+void NoncentralChiSquaredRand<RealType>::SurvivalFunction(const std::vector<RealType> &x, std::vector<double> &y) const
+{
+    size_t size = x.size();
+    if (size > y.size())
+        return;
+    std::vector<size_t> indices;
+    std::vector<double> halfX;
+    for (size_t i = 0; i != size; ++i) {
+        if (x[i] > 0.0) {
+            indices.push_back(i);
+            halfX.push_back(0.5 * x[i]);
+        }
+        else
+            y[i] = 1.0;
+    }
+    std::vector<double> ccdf(halfX.size());
+    RandMath::MarcumQ(halfK, halfLambda, halfX, ccdf);
+    for (size_t j = 0; j != indices.size(); ++j)
+        y[indices[j]] = ccdf[j];
 }
 
 template < typename RealType >
@@ -179,6 +263,18 @@ long double NoncentralChiSquaredRand<RealType>::ExcessKurtosis() const
     return 12 * (k + 4 * lambda) / (y * y);
 }
 
+template < typename RealType >
+RealType NoncentralChiSquaredRand<RealType>::quantileImpl(double p) const
+{
+    return 2 * RandMath::MarcumPinv(halfK, halfLambda, p);
+}
+
+template < typename RealType >
+RealType NoncentralChiSquaredRand<RealType>::quantileImpl1m(double p) const
+{
+    return 2 * RandMath::MarcumQinv(halfK, halfLambda, p);
+}
+
 template < typename RealType >
 std::complex<double> NoncentralChiSquaredRand<RealType>::CFImpl(double t) const
 {
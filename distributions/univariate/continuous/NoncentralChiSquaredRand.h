@@ -44,6 +44,10 @@ public:
     double logf(const RealType & x) const override;
     double F(const RealType & x) const override;
     double S(const RealType & x) const override;
+    void ProbabilityDensityFunction(const std::vector<RealType> &x, std::vector<double> &y) const override;
+    void LogProbabilityDensityFunction(const std::vector<RealType> &x, std::vector<double> &y) const override;
+    void CumulativeDistributionFunction(const std::vector<RealType> &x, std::vector<double> &y) const override;
+    void SurvivalFunction(const std::vector<RealType> &x, std::vector<double> &y) const override;
 
 private:
     RealType variateForDegreeEqualOne() const;
@@ -61,6 +65,9 @@ public:
     long double ExcessKurtosis() const override;
 
 private:
+    RealType quantileImpl(double p) const override;
+    RealType quantileImpl1m(double p) const override;
+
     std::complex<double> CFImpl(double t) const override;
 };
 
@@ -1,433 +1,496 @@
 #include "NoncentralTRand.h"
 #include "NormalRand.h"
-#include <functional>
 
-NoncentralTRand::NoncentralTRand(double degree, double noncentrality) :
-    T(degree)
+template < typename RealType >
+NoncentralTRand<RealType>::NoncentralTRand(double degree, double noncentrality)
 {
     SetParameters(degree, noncentrality);
 }
 
-std::string NoncentralTRand::Name() const
+template < typename RealType >
+String NoncentralTRand<RealType>::Name() const
 {
-    return "Noncentral-t(" + toStringWithPrecision(GetDegree()) + ", "
-            + toStringWithPrecision(GetNoncentrality()) + ")";
+    return "Noncentral-t(" + this->toStringWithPrecision(GetDegree()) + ", "
+            + this->toStringWithPrecision(GetNoncentrality()) + ")";
 }
 
-void NoncentralTRand::SetParameters(double degree, double noncentrality)
+template < typename RealType >
+void NoncentralTRand<RealType>::SetParameters(double degree, double noncentrality)
 {
-    nu = (degree > 0.0) ? degree : 1.0;
+    SetDegree(degree);
+    SetNoncentrality(noncentrality);
+}
+
+template < typename RealType >
+void NoncentralTRand<RealType>::SetDegree(double degree)
+{
+    if (degree <= 0.0)
+        throw std::invalid_argument("Noncentral-t distribution: degree parameter should be positive");
+    nu = degree;
+    halfNu = 0.5 * nu;
     T.SetDegree(nu);
-    sqrt1p2oNu = std::exp(0.5 * std::log1p(2.0 / nu));
+    Y.SetParameters(halfNu, halfNu);
+    lgammaHalfNu = std::lgammal(halfNu);
+    meanCoef = (nu > 1) ? std::sqrt(halfNu) * std::exp(std::lgammal(halfNu - 0.5) - lgammaHalfNu) : INFINITY;
+    /// log(B(1/2, ν / 2))
+    logBetaHalf = 0.5 * M_LNPI + lgammaHalfNu - std::lgammal(halfNu + 0.5);
+    setStartingPoint();
+}
 
+template < typename RealType >
+void NoncentralTRand<RealType>::SetNoncentrality(double noncentrality)
+{
     mu = noncentrality;
-
-    PhiMu = 0.5 * std::erfc(-M_SQRT1_2 * mu); /// φ(μ)
-    PhimMu = 0.5 * std::erfc(M_SQRT1_2 * mu); /// φ(-μ)
-
+    PhiMu = 0.5 * std::erfc(-M_SQRT1_2 * mu);
+    PhimMu = 0.5 * std::erfc(M_SQRT1_2 * mu);
     halfMuSq = 0.5 * mu * mu;
-    startingPoint = std::floor(halfMuSq);
-    logHalfMuSq = 2 * std::log(std::fabs(mu)) - M_LN2;
-    lgammaStartingPointpHalf = std::lgamma(startingPoint + 0.5);
-    lgammaStartingPointp1 = RandMath::lfact(startingPoint);
-
-    /// precalculate values for pdf/cdf calculation
-    nuCoefs.halfNu = 0.5 * nu;
-    nuCoefs.logHalfNu = std::log(nuCoefs.halfNu);
-    nuCoefs.lgammaHalfNu = std::lgamma(nuCoefs.halfNu);
-    nuCoefs.lgamma1 = std::lgamma(startingPoint + 0.5 + nuCoefs.halfNu);
-    nuCoefs.lgamma2 = std::lgamma(startingPoint + 1 + nuCoefs.halfNu);
-    nup2Coefs.halfNu = nuCoefs.halfNu + 1.0;
-    nup2Coefs.logHalfNu = std::log1p(nuCoefs.halfNu);
-    nup2Coefs.lgammaHalfNu = std::lgamma(nup2Coefs.halfNu);
-    nup2Coefs.lgamma1 = std::lgamma(startingPoint + 0.5 + nup2Coefs.halfNu);
-    nup2Coefs.lgamma2 = std::lgamma(startingPoint + 1 + nup2Coefs.halfNu);
+    setStartingPoint();
 }
 
-double NoncentralTRand::cdfSeries(const double &x, const nuStruct &degreeCoef, double noncentrality) const
+template < typename RealType >
+void NoncentralTRand<RealType>::setStartingPoint()
 {
-    if (x == 0.0)
-        return 0.0;
-    long double xSq = x * x;
-    long double y = xSq / (xSq + 2 * degreeCoef.halfNu);
-    long double logY = std::log(y), log1mY = std::log1p(-y);
-    static constexpr double M_LN2_2 = 0.5 * M_LN2;
+    startingPoint = std::floor(halfMuSq);
+    long double logWeight = (startingPoint == 0) ? -halfMuSq : startingPoint * std::log(halfMuSq) - halfMuSq;
+    pStart = std::exp(logWeight - std::lgammal(startingPoint + 1));
+    qStart = std::fabs(mu) * M_SQRT1_2 * std::exp(logWeight - std::lgammal(startingPoint + 1.5));
+    logBetaFun1 = std::lgammal(startingPoint + 0.5) + lgammaHalfNu - std::lgammal(startingPoint + 0.5 + halfNu);
+    logBetaFun2 = std::lgammal(startingPoint + 1.0) + lgammaHalfNu - std::lgammal(startingPoint + 1.0 + halfNu);
+    logPdfAtZero = -halfMuSq - 0.5 * std::log(nu) - logBetaHalf;
+}
 
-    /// go forward
-    long double sum1 = 0.0, addon = 0.0;
-    int j = startingPoint;
-    long double logBetaFun1 = lgammaStartingPointpHalf + degreeCoef.lgammaHalfNu - degreeCoef.lgamma1;
-    long double logBetaFun2 = lgammaStartingPointp1 + degreeCoef.lgammaHalfNu - degreeCoef.lgamma2;
-    long double I1 = RandMath::ibeta(y, j + 0.5, degreeCoef.halfNu, logBetaFun1, logY, log1mY);
-    long double I2 = RandMath::ibeta(y, j + 1.0, degreeCoef.halfNu, logBetaFun2, logY, log1mY);
-    long double lgammajpHalf = lgammaStartingPointpHalf, lgammajp1 = lgammaStartingPointp1;
-    long double lgammaj1 = degreeCoef.lgamma1, lgammaj2 = degreeCoef.lgamma2;
-    long double I1Temp = I1, I2Temp = I2;
-    size_t iter = 0;
-    static constexpr size_t MAX_ITER = 1e5;
-    do {
-        double jpHalf = j + 0.5;
-        int jp1 = j + 1;
-        long double logJpHalf = std::log(jpHalf), logJp1 = std::log(jp1);
-        long double temp = j * logHalfMuSq - halfMuSq;
-        long double p = temp - lgammajp1;
-        p = std::exp(p);
-        long double q = temp - logJpHalf - lgammajpHalf - M_LN2_2;
-        q = noncentrality * std::exp(q);
-        addon = p * I1 + q * I2;
-        sum1 += addon;
-        if (std::fabs(addon) < MIN_POSITIVE * std::fabs(sum1))
-            break;
-        /// shift first regularized beta function
-        long double z = jpHalf * logY + degreeCoef.halfNu * log1mY;
-        long double logBeta = lgammajpHalf + degreeCoef.lgammaHalfNu - lgammaj1;
-        z = std::exp(z - logBeta);
-        z /= jpHalf;
-        I1 -= z;
-        /// shift second regularized beta function
-        z = jp1 * logY + degreeCoef.halfNu * log1mY;
-        logBeta = lgammajp1 + degreeCoef.lgammaHalfNu - lgammaj2;
-        z = std::exp(z - logBeta);
-        z /= jp1;
-        I2 -= z;
-        /// go to the next term
-        lgammajpHalf += logJpHalf;
-        lgammajp1 += logJp1;
-        lgammaj1 += std::log(jpHalf + degreeCoef.halfNu);
-        lgammaj2 += std::log(jp1 + degreeCoef.halfNu);
-        ++j;
-    } while (++iter < MAX_ITER);
-
-    /// go backwards
-    long double sum2 = 0.0;
-    j = startingPoint;
-    I1 = I1Temp;
-    I2 = I2Temp;
-    lgammajpHalf = lgammaStartingPointpHalf;
-    long double lgammajmHalf = lgammaStartingPointpHalf;
-    long double lgammaj = lgammaStartingPointp1;
-    lgammaj1 = degreeCoef.lgamma1;
-    lgammaj2 = degreeCoef.lgamma2;
-    while (j > 0) {
-        /// move to j - 1
-        double jmHalf = j - 0.5;
-        lgammajmHalf -= std::log(jmHalf);
-        lgammaj -= std::log(j);
-        lgammaj1 -= std::log(jmHalf + degreeCoef.halfNu);
-        lgammaj2 -= std::log(j + degreeCoef.halfNu);
-        /// shift first regularized beta function
-        long double z = jmHalf * logY + degreeCoef.halfNu * log1mY;
-        long double logBeta = lgammajmHalf + degreeCoef.lgammaHalfNu - lgammaj1;
-        z = std::exp(z - logBeta);
-        z /= jmHalf;
-        I1 += z;
-        /// shift second regularized beta function
-        z = j * logY + degreeCoef.halfNu * log1mY;
-        logBeta = lgammaj + degreeCoef.lgammaHalfNu - lgammaj2;
-        z = std::exp(z - logBeta);
-        z /= j;
-        I2 += z;
-        long double temp = (j - 1) * logHalfMuSq - halfMuSq;
-        long double p = temp - lgammaj; // p and q get by relation with previous values
-        p = std::exp(p);
-        long double q = temp - lgammajpHalf - M_LN2_2;
-        q = noncentrality * std::exp(q);
-        addon = p * I1 + q * I2;
-        sum2 += addon;
-        if (std::fabs(addon) < MIN_POSITIVE * std::fabs(sum2))
-            break;
-        --j;
-        lgammajpHalf = lgammajmHalf;
-    };
-    //if (std::fabs(x) < 0.05)
-        //qDebug() << "SUM:" << x << (double)sum1 << (double)sum2 << (double)(0.5 * (sum1 + sum2));
-    return 0.5 * (sum1 + sum2);
+template < typename RealType >
+void NoncentralTRand<RealType>::betaSeriesStart(double t, bool isComplement, double &I1, double &I2) const
+{
+    double tSq = t * t;
+    double denominator = tSq + nu;
+    double logDenominator = std::log(denominator);
+    double logY = 2 * std::log(t) - logDenominator, log1mY = std::log(nu) - logDenominator;
+    double a1 = startingPoint + 0.5, a2 = startingPoint + 1.0;
+    if (isComplement) {
+        double y1m = nu / denominator;
+        I1 = RandMath::ibeta(y1m, halfNu, a1, logBetaFun1, log1mY, logY);
+        I2 = RandMath::ibeta(y1m, halfNu, a2, logBetaFun2, log1mY, logY);
+    }
+    else {
+        double y = tSq / denominator;
+        I1 = RandMath::ibeta(y, a1, halfNu, logBetaFun1, logY, log1mY);
+        I2 = RandMath::ibeta(y, a2, halfNu, logBetaFun2, logY, log1mY);
+    }
 }
 
-double NoncentralTRand::cdfComplSeries(const double &x, const NoncentralTRand::nuStruct &degreeCoef, double noncentrality) const
+template < typename RealType >
+double NoncentralTRand<RealType>::betaSeries(double t, double noncentrality, bool isComplement, double I1, double I2, bool isDensity) const
 {
-    // TODO: find bug here, sum is always around 1e-15
-    long double y = degreeCoef.halfNu / (degreeCoef.halfNu + 0.5 * x * x);
-    double logY = std::log(y), log1mY = std::log1p(-y);
-    static constexpr long double M_LN2_2 = 0.5 * M_LN2;
+    static constexpr int MAX_ITER = 100000;
+    static constexpr long double EPSILON = 1e-18;
+    /// logarithms are multiplied by large numbers, so they should be calculated more accurately
+    long double tl = t;
+    long double logDenominator = std::log(tl * tl + nu);
+    long double logY = 2 * std::log(tl) - logDenominator, log1mY = std::log(static_cast<long double>(nu)) - logDenominator;
+    long double y = std::exp(logY);
+    /// g(a) = y^a (1 - y)^b / (a B(a, b)) for a = j + 1/2 and a = j + 1 at the starting point
+    long double a1 = startingPoint + 0.5, a2 = startingPoint + 1.0;
+    long double g1Start = std::exp(a1 * logY + halfNu * log1mY - logBetaFun1) / a1;
+    long double g2Start = std::exp(a2 * logY + halfNu * log1mY - logBetaFun2) / a2;
+    long double qSigned = (noncentrality < 0) ? -qStart : qStart;
+    /// I(y, a + 1, b) = I(y, a, b) - g(a), while 1 - I(y, a, b) increases by the same value.
+    /// Derivative of I(y, a, ν / 2) by ν / 2 leads to f(t) = Σ (p_j (j + 1/2) g(j + 1/2) + q_j (j + 1) g(j + 1)) / t
+    int sign = isComplement ? 1 : -1;
+    long double sum = 0.0, magnitude = 0.0;
 
     /// go forward
-    long double sum1 = 0.0, addon = 0.0;
-    int j = startingPoint;
-    long double logBetaFun1 = lgammaStartingPointpHalf + degreeCoef.lgammaHalfNu - degreeCoef.lgamma1;
-    long double logBetaFun2 = lgammaStartingPointp1 + degreeCoef.lgammaHalfNu - degreeCoef.lgamma2;
-    long double I1 = RandMath::ibeta(y, degreeCoef.halfNu, j + 0.5, logBetaFun1, logY, log1mY);
-    long double I2 = RandMath::ibeta(y, degreeCoef.halfNu, j + 1.0, logBetaFun2, logY, log1mY);
-    long double lgammajpHalf = lgammaStartingPointpHalf, lgammajp1 = lgammaStartingPointp1;
-    long double lgammaj1 = degreeCoef.lgamma1, lgammaj2 = degreeCoef.lgamma2;
-    long double I1Temp = I1, I2Temp = I2;
-    size_t iter = 0;
-    static constexpr size_t MAX_ITER = 1e5;
-    do {
-        double jpHalf = j + 0.5;
-        int jp1 = j + 1;
-        long double logJpHalf = std::log(jpHalf), logJp1 = std::log(jp1);
-        long double temp = j * logHalfMuSq - halfMuSq;
-        long double p = temp - lgammajp1;
-        p = std::exp(p);
-        long double q = temp - logJpHalf - lgammajpHalf - M_LN2_2;
-        q = noncentrality * std::exp(q);
-        addon = p * I1 + q * I2;
-        sum1 += addon;
-        if (std::fabs(addon) < MIN_POSITIVE * std::fabs(sum1))
+    long double p = pStart, q = qSigned, g1 = g1Start, g2 = g2Start, J1 = I1, J2 = I2;
+    long double prevTerm = INFINITY;
+    for (int j = startingPoint; j != startingPoint + MAX_ITER; ++j) {
+        long double jpHalf = j + 0.5, jp1 = j + 1.0;
+        long double term = isDensity ? p * jpHalf * g1 + q * jp1 * g2 : p * J1 + q * J2;
+        sum += term;
+        term = std::fabs(term);
+        magnitude += term;
+        if (term <= EPSILON * std::fabs(sum) && term <= prevTerm)
             break;
-        /// shift first regularized beta function
-        long double z = degreeCoef.halfNu  * logY + jpHalf * log1mY;
-        long double logBeta = lgammajpHalf + degreeCoef.lgammaHalfNu - lgammaj1;
-        z = std::exp(z - logBeta);
-        z /= jpHalf;
-        I1 += z;
-        /// shift second regularized beta function
-        z = degreeCoef.halfNu * logY + jp1 * log1mY;
-        logBeta = lgammajp1 + degreeCoef.lgammaHalfNu - lgammaj2;
-        z = std::exp(z - logBeta);
-        z /= jp1;
-        I2 += z;
-        /// go to the next term
-        lgammajpHalf += logJpHalf;
-        lgammajp1 += logJp1;
-        lgammaj1 += std::log(jpHalf + degreeCoef.halfNu);
-        lgammaj2 += std::log(jp1 + degreeCoef.halfNu);
-        ++j;
-    } while (++iter < MAX_ITER);
-
-    /// go backwards
-    long double sum2 = 0.0;
-    j = startingPoint;
-    I1 = I1Temp;
-    I2 = I2Temp;
-    lgammajpHalf = lgammaStartingPointpHalf;
-    long double lgammajmHalf = lgammaStartingPointpHalf;
-    long double lgammaj = lgammaStartingPointp1;
-    lgammaj1 = degreeCoef.lgamma1;
-    lgammaj2 = degreeCoef.lgamma2;
-    while (j > 0) {
-        /// move to j - 1
-        double jmHalf = j - 0.5;
-        lgammajmHalf -= std::log(jmHalf);
-        lgammaj -= std::log(j);
-        lgammaj1 -= std::log(jmHalf + degreeCoef.halfNu);
-        lgammaj2 -= std::log(j + degreeCoef.halfNu);
-        /// shift first regularized beta function
-        long double z = degreeCoef.halfNu * logY + jmHalf * log1mY;
-        long double logBeta = lgammajmHalf + degreeCoef.lgammaHalfNu - lgammaj1;
-        z = std::exp(z - logBeta);
-        z /= jmHalf;
-        I1 -= z;
-        /// shift second regularized beta function
-        z = degreeCoef.halfNu * logY + j * log1mY;
-        logBeta = lgammaj + degreeCoef.lgammaHalfNu - lgammaj2;
-        z = std::exp(z - logBeta);
-        z /= j;
-        I2 -= z;
-        long double temp = (j - 1) * logHalfMuSq - halfMuSq;
-        long double p = temp - lgammaj;
-        p = std::exp(p);
-        long double q = temp - lgammajpHalf - M_LN2_2;
-        q = noncentrality * std::exp(q);
-        addon = p * I1 + q * I2;
-        sum2 += addon;
-        if (std::fabs(addon) < MIN_POSITIVE * std::fabs(sum2))
+        prevTerm = term;
+        J1 += sign * g1;
+        J2 += sign * g2;
+        g1 *= y * (jpHalf + halfNu) / (jpHalf + 1);
+        g2 *= y * (jp1 + halfNu) / (jp1 + 1);
+        p *= halfMuSq / jp1;
+        q *= halfMuSq / (jpHalf + 1);
+    }
+
+    /// go backward
+    p = pStart;
+    q = qSigned;
+    g1 = g1Start;
+    g2 = g2Start;
+    J1 = I1;
+    J2 = I2;
+    prevTerm = INFINITY;
+    for (int j = startingPoint - 1; j >= 0; --j) {
+        long double jpHalf = j + 0.5, jp1 = j + 1.0;
+        p *= jp1 / halfMuSq;
+        q *= (jpHalf + 1) / halfMuSq;
+        g1 *= (jpHalf + 1) / (y * (jpHalf + halfNu));
+        g2 *= (jp1 + 1) / (y * (jp1 + halfNu));
+        J1 -= sign * g1;
+        J2 -= sign * g2;
+        long double term = isDensity ? p * jpHalf * g1 + q * jp1 * g2 : p * J1 + q * J2;
+        sum += term;
+        term = std::fabs(term);
+        magnitude += term;
+        if (term <= EPSILON * std::fabs(sum) && term <= prevTerm)
             break;
-        --j;
-        lgammajpHalf = lgammajmHalf;
-    };
-    //if (std::fabs(x) < 0.05)
-        //qDebug() << "SUM:" << x << (double)sum1 << (double)sum2 << (double)(0.5 * (sum1 + sum2));
-    return 0.5 * (sum1 + sum2);
-}
+        prevTerm = term;
+    }
 
-double NoncentralTRand::logPdfAtZero() const
-{
-    double y = mu * mu + M_LN2 + nuCoefs.logHalfNu;
-    y *= -0.5;
-    y -= T.logBetaFun;
-    return y;
+    /// for negative noncentrality terms have different signs, the sum is inaccurate if it's much smaller than them
+    if (noncentrality < 0 && (isDensity || isComplement) && std::fabs(sum) < 1e-3 * magnitude)
+        return oppositeTail(t, noncentrality, isDensity);
+    if (isDensity)
+        return std::max(sum / t, 0.0l);
+    return 0.5 * sum;
 }
 
-double NoncentralTRand::pdfCommon(const double &x, double noncentrality) const
+template < typename RealType >
+double NoncentralTRand<RealType>::oppositeTail(double t, double noncentrality, bool isDensity) const
 {
-    double y = 0.0;
-    if (x >= 0.0) {
-        y = cdfSeries(x * sqrt1p2oNu, nup2Coefs, noncentrality);
-        y -= cdfSeries(x, nuCoefs, noncentrality);
+    double m = -noncentrality;
+    /// logarithm of the integrand for w = log(W), density of log(W) is 2 (ν / 2)^(ν / 2) e^(ν w - ν e^(2w) / 2) / Γ(ν / 2)
+    double logCoef = M_LN2 + halfNu * std::log(halfNu) - std::lgammal(halfNu);
+    auto logIntegrand = [this, t, m, logCoef, isDensity] (double w) -> double
+    {
+        double u = std::exp(w);
+        long double z = m + t * u;
+        double y = logCoef + nu * w - halfNu * u * u;
+        if (isDensity)
+            return y + w - 0.5 * z * z - 0.5 * M_LN2 - 0.5 * M_LNPI;
+        return y + static_cast<double>(std::log(0.5l * std::erfc(z * M_SQRT1_2)));
+    };
+    /// the integrand is log-concave, it's integrated around its maximum
+    double root = 0.0;
+    RandMath::findMin<double>([logIntegrand] (double w)
+    {
+        return -logIntegrand(w);
+    }, 0.0, root, 1e-10);
+    double logMax = logIntegrand(root);
+    if (!std::isfinite(logMax))
+        return 0.0;
+    static constexpr double LOG_EPS = 45.0;
+    double h = 1e-3;
+    double curvature = (2 * logMax - logIntegrand(root + h) - logIntegrand(root - h)) / (h * h);
+    double width = (curvature > 0.0) ? 1.0 / std::sqrt(curvature) : 1.0;
+    double lower = root - width, step = width;
+    while (logIntegrand(lower) > logMax - LOG_EPS) {
+        lower -= step;
+        step *= 1.5;
     }
-    else {
-        y = cdfComplSeries(-x * sqrt1p2oNu, nup2Coefs, -noncentrality);
-        y -= cdfComplSeries(-x, nuCoefs, -noncentrality);
+    double upper = root + width;
+    step = width;
+    while (logIntegrand(upper) > logMax - LOG_EPS) {
+        upper += step;
+        step *= 1.5;
     }
-    y *= nu / x;
-    return std::max(y, 0.0);
+    /// trapezoidal rule converges exponentially for smooth integrands, which vanish at the ends
+    auto integrand = [logIntegrand, logMax] (double w)
+    {
+        return std::exp(logIntegrand(w) - logMax);
+    };
+    int n = 16;
+    h = (upper - lower) / n;
+    double sum = 0.5 * (integrand(lower) + integrand(upper));
+    for (int i = 1; i != n; ++i)
+        sum += integrand(lower + i * h);
+    double integral = sum * h;
+    static constexpr int MAX_NODES = 1 << 14;
+    while (n < MAX_NODES) {
+        for (int i = 0; i != n; ++i)
+            sum += integrand(lower + (i + 0.5) * h);
+        n *= 2;
+        h *= 0.5;
+        double prevIntegral = integral;
+        integral = sum * h;
+        if (std::fabs(integral - prevIntegral) <= 1e-14 * integral)
+            break;
+    }
+    return std::exp(logMax + std::log(integral));
+}
+
+template < typename RealType >
+double NoncentralTRand<RealType>::tail(const RealType &x, bool isRightTail) const
+{
+    if (x == 0.0)
+        return isRightTail ? PhiMu : PhimMu;
+    /// if X ~ t'(ν, μ), then -X ~ t'(ν, -μ), hence F(x) = S(-x) and S(x) = F(-x) for noncentrality -μ
+    bool isPositive = x > 0.0;
+    double t = isPositive ? x : -x;
+    bool isComplement = (isPositive == isRightTail);
+    double I1 = 0.0, I2 = 0.0;
+    betaSeriesStart(t, isComplement, I1, I2);
+    double y = betaSeries(t, isPositive ? mu : -mu, isComplement, I1, I2, false);
+    if (!isComplement)
+        y += isPositive ? PhimMu : PhiMu;
+    return std::min(std::max(y, 0.0), 1.0);
 }
 
-double NoncentralTRand::f(const double & x) const
+template < typename RealType >
+double NoncentralTRand<RealType>::f(const RealType & x) const
 {
     if (mu == 0.0)
         return T.f(x);
-    return (x == 0.0) ? std::exp(logPdfAtZero()) : pdfCommon(x, mu);
+    if (x == 0.0)
+        return std::exp(logPdfAtZero);
+    return (x > 0.0) ? betaSeries(x, mu, false, 0.0, 0.0, true) : betaSeries(-x, -mu, false, 0.0, 0.0, true);
 }
 
-double NoncentralTRand::logf(const double & x) const
+template < typename RealType >
+double NoncentralTRand<RealType>::logf(const RealType & x) const
 {
     if (mu == 0.0)
         return T.logf(x);
     if (x == 0.0)
-        return logPdfAtZero();
-    double y = pdfCommon(x, mu);
+        return logPdfAtZero;
+    double y = f(x);
     return (y > 0.0) ? std::log(y) : -INFINITY;
 }
 
-double NoncentralTRand::F(const double & x) const
+template < typename RealType >
+double NoncentralTRand<RealType>::F(const RealType & x) const
 {
-    if (mu == 0.0)
-        return T.F(x);
-    if (x == 0.0)
-        return PhimMu;
+    return (mu == 0.0) ? T.F(x) : tail(x, false);
+}
 
-    // mu > 0
-    if (x >= 0.0)
-        return PhimMu + cdfSeries(x, nuCoefs, mu);
-    return PhimMu - cdfSeries(-x, nuCoefs, -mu);
+template < typename RealType >
+double NoncentralTRand<RealType>::S(const RealType & x) const
+{
+    return (mu == 0.0) ? T.S(x) : tail(x, true);
+}
 
-    /*double y = (x >= 0.0) ? PhimMu + cdfSeries(x, nuCoefs, mu) : cdfComplSeries(-x, nuCoefs, -mu);
-    return std::max(y, 0.0);*/
+template < typename RealType >
+void NoncentralTRand<RealType>::tailFunction(const std::vector<RealType> &x, std::vector<double> &y, bool isRightTail) const
+{
+    size_t size = x.size();
+    /// arguments are split by the type of the series: with incomplete beta functions or their complements
+    std::vector<size_t> indices[2];
+    std::vector<double> args[2];
+    for (size_t i = 0; i != size; ++i) {
+        if (x[i] == 0.0) {
+            y[i] = isRightTail ? PhiMu : PhimMu;
+            continue;
+        }
+        bool isComplement = ((x[i] > 0.0) == isRightTail);
+        double tSq = x[i] * x[i];
+        indices[isComplement].push_back(i);
+        args[isComplement].push_back(isComplement ? nu / (tSq + nu) : tSq / (tSq + nu));
+    }
+    double a1 = startingPoint + 0.5, a2 = startingPoint + 1.0;
+    for (int group = 0; group != 2; ++group) {
+        size_t groupSize = indices[group].size();
+        if (groupSize == 0)
+            continue;
+        bool isComplement = (group == 1);
+        /// incomplete beta functions at the starting point for all arguments at once
+        std::vector<double> I1(groupSize), I2(groupSize);
+        if (isComplement) {
+            RandMath::ibeta(args[group], I1, halfNu, a1, logBetaFun1);
+            RandMath::ibeta(args[group], I2, halfNu, a2, logBetaFun2);
+        }
+        else {
+            RandMath::ibeta(args[group], I1, a1, halfNu, logBetaFun1);
+            RandMath::ibeta(args[group], I2, a2, halfNu, logBetaFun2);
+        }
+        for (size_t j = 0; j != groupSize; ++j) {
+            size_t i = indices[group][j];
+            bool isPositive = x[i] > 0.0;
+            double value = betaSeries(isPositive ? x[i] : -x[i], isPositive ? mu : -mu, isComplement, I1[j], I2[j], false);
+            if (!isComplement)
+                value += isPositive ? PhimMu : PhiMu;
+            y[i] = std::min(std::max(value, 0.0), 1.0);
+        }
+    }
 }
 
-double NoncentralTRand::S(const double &x) const
+template < typename RealType >
+void NoncentralTRand<RealType>::CumulativeDistributionFunction(const std::vector<RealType> &x, std::vector<double> &y) const
 {
     if (mu == 0.0)
-        return T.S(x);
-    double y = (x >= 0.0) ? cdfComplSeries(x, nuCoefs, mu) : PhiMu + cdfSeries(-x, nuCoefs, -mu);
-    return std::max(y, 0.0);
+        return T.CumulativeDistributionFunction(x, y);
+    if (x.size() > y.size())
+        return;
+    tailFunction(x, y, false);
 }
 
-double NoncentralTRand::Variate() const
+template < typename RealType >
+void NoncentralTRand<RealType>::SurvivalFunction(const std::vector<RealType> &x, std::vector<double> &y) const
 {
-    double X = NormalRand::StandardVariate() + mu;
-    X /= T.Y.Variate();
-    return X;
+    if (mu == 0.0)
+        return T.SurvivalFunction(x, y);
+    if (x.size() > y.size())
+        return;
+    tailFunction(x, y, true);
 }
 
-void NoncentralTRand::Sample(std::vector<double> &outputData) const
+template < typename RealType >
+RealType NoncentralTRand<RealType>::Variate() const
 {
-    if (mu == 0.0)
-        return T.Sample(outputData);
-    T.Y.Sample(outputData);
-    for (double &var : outputData)
-        var = (mu + NormalRand::StandardVariate()) / var;
+    return (mu + NormalRand<RealType>::StandardVariate(this->localRandGenerator)) / std::sqrt(Y.Variate());
 }
 
-double NoncentralTRand::Mean() const
+template < typename RealType >
+void NoncentralTRand<RealType>::Sample(std::vector<RealType> &outputData) const
 {
-    if (nu <= 1)
-        return NAN;
-    if (mu == 0.0)
-        return 0.0;
-    double temp = T.Y.GetLogGammaShapeRatio();
-    temp += 0.5 * nuCoefs.logHalfNu;
-    return 2 * mu / (nu - 1) * std::exp(temp);
+    Y.Sample(outputData);
+    for (RealType &var : outputData)
+        var = (mu + NormalRand<RealType>::StandardVariate(this->localRandGenerator)) / std::sqrt(var);
+}
+
+template < typename RealType >
+void NoncentralTRand<RealType>::Reseed(unsigned long seed) const
+{
+    this->localRandGenerator.Reseed(seed);
+    Y.Reseed(seed + 1);
+}
+
+template < typename RealType >
+long double NoncentralTRand<RealType>::Mean() const
+{
+    return (nu > 1) ? mu * meanCoef : NAN;
 }
 
-double NoncentralTRand::Variance() const
+template < typename RealType >
+long double NoncentralTRand<RealType>::Variance() const
 {
     if (nu <= 2)
         return (nu > 1) ? INFINITY : NAN;
-    double mean = Mean();
-    return nu * (1.0 + mu * mu) / (nu - 2) + mean * mean; // TODO: Wikipedia lies, re-check
+    long double mean = Mean();
+    return nu * (1.0l + mu * mu) / (nu - 2) - mean * mean;
 }
 
-double NoncentralTRand::Mode() const
+template < typename RealType >
+RealType NoncentralTRand<RealType>::Mode() const
 {
     if (mu == 0.0)
         return 0.0;
-    double left = std::sqrt(nu / (nu + 2.5)); /// left boundary for mode / μ
-    double right = std::sqrt(nu / (nu + 1.0)); /// right boundary for mode / μ
-    double guess = 0.5 * mu * (left + right);
-    double root = 0;
-    RandMath::findMin([this] (double x)
+    /// mode / μ is between √(ν / (ν + 5/2)) and √(ν / (ν + 1))
+    double left = std::sqrt(nu / (nu + 2.5));
+    double right = std::sqrt(nu / (nu + 1.0));
+    RealType guess = 0.5 * mu * (left + right);
+    RealType root = 0;
+    RandMath::findMin<RealType>([this] (const RealType &x)
     {
-        return -f(x);
+        return -logf(x);
     }, guess, root);
     return root;
 }
 
-double NoncentralTRand::Skewness() const
+template < typename RealType >
+long double NoncentralTRand<RealType>::Skewness() const
 {
     if (nu <= 3)
         return NAN;
-    double mean = Mean();
-    double var = nu * (1.0 + mu * mu) / (nu - 2) + mean * mean;
-    double thirdMoment = std::lgamma(0.5 * nu - 1.5); //TODO: use hashed GetLogGammaShapeRatio
-    thirdMoment -= T.Y.GetLogGammaFunction();
-    thirdMoment += 1.5 * (nuCoefs.logHalfNu + M_LN2);
-    thirdMoment = 0.25 * std::exp(thirdMoment);
-    thirdMoment *= mu * (3.0 + mu * mu);
-    double denominator = std::pow(var, 1.5);
-    return (thirdMoment - 3 * mean * var - std::pow(mean, 3)) / denominator;  // TODO: Wikipedia lies, re-check
+    /// raw moments E[X^k] = (ν / 2)^(k / 2) Γ((ν - k) / 2) / Γ(ν / 2) E[(Z + μ)^k]
+    long double muSq = mu * mu;
+    long double mean = Mean();
+    long double secondMoment = nu * (1.0l + muSq) / (nu - 2);
+    long double thirdMoment = mu * (3.0l + muSq) * meanCoef * nu / (nu - 3);
+    long double variance = secondMoment - mean * mean;
+    long double centralMoment = thirdMoment - 3 * mean * secondMoment + 2 * mean * mean * mean;
+    return centralMoment / std::pow(variance, 1.5l);
 }
 
-double NoncentralTRand::ExcessKurtosis() const
+template < typename RealType >
+long double NoncentralTRand<RealType>::ExcessKurtosis() const
 {
     if (nu <= 4)
         return (nu > 2) ? INFINITY : NAN;
-    double fourthMoment = nu * nu / ((nu - 2) * (nu - 4));
-    fourthMoment *= (std::pow(mu, 4) + 6 * mu * mu + 3);
-    double thirdMoment = std::lgamma(0.5 * nu - 1.5); //TODO: use hashed GetLogGammaShapeRatio
-    thirdMoment -= T.Y.GetLogGammaFunction();
-    thirdMoment += 1.5 * (nuCoefs.logHalfNu + M_LN2);
-    thirdMoment = 0.25 * std::exp(thirdMoment);
-    thirdMoment *= mu * (3.0 + mu * mu);
-    double mean = Mean();
-    double kurtosis = fourthMoment - 4 * mean * thirdMoment;
-    kurtosis += 6 * mean * mean * nu * (1.0 + mu * mu) / (nu - 2);
-    kurtosis -= 3 * std::pow(mean, 4);
-    double var = Variance();
-    return kurtosis / (var * var);  // TODO: Wikipedia lies, re-check
+    long double muSq = mu * mu;
+    long double mean = Mean(), meanSq = mean * mean;
+    long double secondMoment = nu * (1.0l + muSq) / (nu - 2);
+    long double thirdMoment = mu * (3.0l + muSq) * meanCoef * nu / (nu - 3);
+    long double fourthMoment = (muSq * muSq + 6 * muSq + 3) * nu * nu / ((nu - 2) * (nu - 4));
+    long double variance = secondMoment - meanSq;
+    long double centralMoment = fourthMoment - 4 * mean * thirdMoment + 6 * meanSq * secondMoment - 3 * meanSq * meanSq;
+    return centralMoment / (variance * variance) - 3.0;
+}
+
+template < typename RealType >
+RealType NoncentralTRand<RealType>::quantileInitialGuess(double p, bool isComplement) const
+{
+    double z = -M_SQRT2 * RandMath::erfcinv(2 * p);
+    if (isComplement)
+        z = -z;
+    /// root of quadratic equation (c t - μ)^2 = z^2 (1 + s t^2)
+    double c = 1.0 - 0.25 / nu, s = 0.5 / nu;
+    double a = c * c - z * z * s;
+    double d = c * c + s * (mu * mu - z * z);
+    if (a > 0.0 && d >= 0.0) {
+        double root = (c * mu + z * std::sqrt(d)) / a;
+        if (std::isfinite(root))
+            return root;
+    }
+    return mu + (isComplement ? T.Quantile1m(p) : T.Quantile(p));
 }
 
-double NoncentralTRand::quantileImpl(double p) const
+template < typename RealType >
+RealType NoncentralTRand<RealType>::quantileImpl(double p, RealType initValue) const
 {
-    if (p > 1e-5)
-        return ContinuousDistribution::quantileImpl(p);
-    /// we need to be cautious with small values of p
-    /// initial guess is obtained by inverse error function approximation
-    double guess = -2 * std::erfc(2 * p);
-    guess += mu;
-    guess /= 1 - 0.25 * nu;
-    double logP = std::log(p);
-    if (RandMath::findRoot([this, logP] (double x)
+    if (p < 1e-5) { /// too small p
+        double logP = std::log(p);
+        return this->quantileBracketed([this, logP] (const RealType &x)
+        {
+            double cdf = tail(x, false);
+            return DoubleTriplet(std::log(cdf) - logP, f(x) / cdf, 0.0);
+        }, initValue);
+    }
+    return this->quantileBracketed([this, p] (const RealType &x)
     {
-        double logCdf = std::log(F(x)), logPdf = logf(x);
-        double first = logCdf - logP;
-        double second = std::exp(logPdf - logCdf);
-        return DoublePair(first, second);
-    }, guess))
-        return guess;
-    return NAN;
+        return DoubleTriplet(tail(x, false) - p, f(x), 0.0);
+    }, initValue);
 }
 
-double NoncentralTRand::quantileImpl1m(double p) const
+template < typename RealType >
+RealType NoncentralTRand<RealType>::quantileImpl(double p) const
 {
-    if (p > 1e-5)
-        return ContinuousDistribution::quantileImpl1m(p);
-    /// we need to be cautious with small values of p
-    /// initial guess is obtained by inverse error function approximation
-    double guess = 2 * std::erfc(2 * p);
-    guess += mu;
-    guess /= 1 - 0.25 * nu;
-    double logP = std::log(p);
-    if (RandMath::findRoot([this, logP] (double x)
+    if (mu == 0.0)
+        return T.Quantile(p);
+    RealType root = 0;
+    if (!this->quantileSweepGuess(p, root, false))
+        root = quantileInitialGuess(p, false);
+    root = quantileImpl(p, root);
+    this->setPreviousQuantile(root, p);
+    return root;
+}
+
+template < typename RealType >
+RealType NoncentralTRand<RealType>::quantileImpl1m(double p, RealType initValue) const
+{
+    if (p < 1e-5) { /// too small p
+        double logP = std::log(p);
+        return this->quantileBracketed([this, logP] (const RealType &x)
+        {
+            double ccdf = tail(x, true);
+            return DoubleTriplet(logP - std::log(ccdf), f(x) / ccdf, 0.0);
+        }, initValue);
+    }
+    return this->quantileBracketed([this, p] (const RealType &x)
     {
-        double logCcdf = std::log(S(x)), logPdf = logf(x);
-        double first = logP - logCcdf;
-        double second = std::exp(logPdf - logCcdf);
-        return DoublePair(first, second);
-    }, guess))
-        return guess;
-    return NAN;
+        return DoubleTriplet(p - tail(x, true), f(x), 0.0);
+    }, initValue);
 }
+
+template < typename RealType >
+RealType NoncentralTRand<RealType>::quantileImpl1m(double p) const
+{
+    if (mu == 0.0)
+        return T.Quantile1m(p);
+    RealType root = 0;
+    if (!this->quantileSweepGuess(p, root, true))
+        root = quantileInitialGuess(p, true);
+    root = quantileImpl1m(p, root);
+    this->setPreviousQuantile(root, p);
+    return root;
+}
+
+template class NoncentralTRand<float>;
+template class NoncentralTRand<double>;
+template class NoncentralTRand<long double>;
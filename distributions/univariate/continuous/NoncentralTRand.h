@@ -3,82 +3,152 @@
 
 #include "ContinuousDistribution.h"
 #include "StudentTRand.h"
+#include "GammaRand.h"
 
 /**
  * @brief The NoncentralTRand class <BR>
- * Notation: Noncentral-t(ν, μ)
+ * Noncentral Student's t-distribution
+ *
+ * Notation: X ~ t'(ν, μ)
+ *
+ * Related distributions: <BR>
+ * If X ~ t'(ν, 0), then X ~ t(ν) <BR>
+ * X = (Z + μ) / √(V / ν), where Z ~ Normal(0, 1) and V ~ χ^2(ν) <BR>
+ * If X ~ t'(ν, μ), then -X ~ t'(ν, -μ)
  */
-class RANDLIBSHARED_EXPORT NoncentralTRand : public ContinuousDistribution
+template < typename RealType = double >
+class RANDLIBSHARED_EXPORT NoncentralTRand : public ContinuousDistribution<RealType>
 {
-    double nu, mu;
-    long double PhiMu, PhimMu;
-    double sqrt1p2oNu;
-    /// starting point at most weight
-    int startingPoint;
-    double logHalfMuSq, halfMuSq;
-    double lgammaStartingPointpHalf, lgammaStartingPointp1;
-
-    struct nuStruct {
-        /// 0.5 ν
-        double halfNu;
-        double logHalfNu, lgammaHalfNu;
-        double lgamma1, lgamma2;
-    } nuCoefs, nup2Coefs;
-
-    StudentTRand T;
+    double nu = 1; ///< degree ν
+    double mu = 0; ///< noncentrality μ
+    double halfNu = 0.5; ///< ν / 2
+    double halfMuSq = 0; ///< μ^2 / 2, mean of Poisson weights
+    double PhiMu = 0.5; ///< Φ(μ)
+    double PhimMu = 0.5; ///< Φ(-μ)
+    int startingPoint = 0; ///< index of the largest Poisson weight
+    long double pStart = 1; ///< Poisson weight e^(-μ^2 / 2) (μ^2 / 2)^j / j! for j at the starting point
+    long double qStart = 0; ///< |μ| e^(-μ^2 / 2) (μ^2 / 2)^j / (√2 Γ(j + 3/2)) for j at the starting point
+    double logBetaFun1 = M_LNPI; ///< log(B(j + 1/2, ν / 2)) for j at the starting point
+    double logBetaFun2 = M_LN2; ///< log(B(j + 1, ν / 2)) for j at the starting point
+    double lgammaHalfNu = 0.5 * M_LNPI; ///< log(Γ(ν / 2))
+    double logBetaHalf = M_LNPI; ///< log(B(1/2, ν / 2))
+    double logPdfAtZero = -M_LNPI; ///< log(f(0))
+    double meanCoef = INFINITY; ///< √(ν / 2) Γ((ν - 1) / 2) / Γ(ν / 2)
+
+    StudentTRand<RealType> T{};
+    GammaRand<RealType> Y{}; ///< χ^2(ν) / ν
 
 public:
     explicit NoncentralTRand(double degree = 1, double noncentrality = 0);
 
-    std::string Name() const override;
+    String Name() const override;
     SUPPORT_TYPE SupportType() const override { return INFINITE_T; }
-    double MinValue() const override { return -INFINITY; }
-    double MaxValue() const override { return INFINITY; }
+    RealType MinValue() const override { return -INFINITY; }
+    RealType MaxValue() const override { return INFINITY; }
 
     void SetParameters(double degree, double noncentrality);
+    void SetDegree(double degree);
     /**
-     * @fn GetDegree
-     * @return degree ν
+     * @fn SetNoncentrality
+     * set noncentrality, keeping precalculated values for the degree,
+     * which makes sweeps over noncentrality (e.g. in power analysis) cheaper
+     * @param noncentrality μ
      */
+    void SetNoncentrality(double noncentrality);
     inline double GetDegree() const { return nu; }
-    /**
-     * @fn GetNoncentrality
-     * @return noncentrality μ
-     */
     inline double GetNoncentrality() const { return mu; }
 
 private:
-    double cdfSeries(const double &x, const nuStruct &degreeCoef, double noncentrality) const;
-    double cdfComplSeries(const double &x, const nuStruct &degreeCoef, double noncentrality) const;
     /**
-     * @fn logPdfAtZero
-     * @return log(f(0))
+     * @fn setStartingPoint
+     * precalculate Poisson weights and beta functions at the largest weight
      */
-    double logPdfAtZero() const;
+    void setStartingPoint();
+
     /**
-     * @fn pdfCommon
+     * @fn betaSeriesStart
+     * @param t positive argument
+     * @param isComplement
+     * @param I1 I(y, j + 1/2, ν / 2) or 1 - I(y, j + 1/2, ν / 2) in output, where y = t^2 / (t^2 + ν)
+     * and j is the starting point
+     * @param I2 I(y, j + 1, ν / 2) or 1 - I(y, j + 1, ν / 2) in output
+     */
+    void betaSeriesStart(double t, bool isComplement, double &I1, double &I2) const;
+
+    /**
+     * @fn betaSeries
+     * Sum up 0.5 Σ (p_j I(y, j + 1/2, ν / 2) + q_j I(y, j + 1, ν / 2)) or the density f(t),
+     * going forward and backward from the starting point.
+     * Incomplete beta functions and their derivatives are obtained by the recurrence
+     * I(y, a + 1, b) = I(y, a, b) - y^a (1 - y)^b / (a B(a, b)), so that there are no special functions inside of the loop
+     * @param t positive argument
+     * @param noncentrality μ or -μ
+     * @param isComplement if true, 1 - I(y, a, ν / 2) is used in the sum
+     * @param I1 the first incomplete beta function at the starting point (see betaSeriesStart)
+     * @param I2 the second incomplete beta function at the starting point
+     * @param isDensity if true, density f(t) is returned and incomplete beta functions are not used
+     * @return the sum or the density for the given noncentrality
+     */
+    double betaSeries(double t, double noncentrality, bool isComplement, double I1, double I2, bool isDensity) const;
+
+    /**
+     * @fn oppositeTail
+     * In the tail, which is opposite to the sign of noncentrality, terms of the series have different signs.
+     * If the series loses accuracy, then P(X > t) = E[Φ(-m - t W)] or f(t) = E[W φ(m + t W)],
+     * where m = -μ > 0, W = √(V / ν) and V ~ χ^2(ν), is integrated numerically in logarithmic scale of W
+     * @param t positive argument
+     * @param noncentrality negative μ
+     * @param isDensity
+     * @return P(X > t) or f(t)
+     */
+    double oppositeTail(double t, double noncentrality, bool isDensity) const;
+
+    /**
+     * @fn tail
+     * @param x
+     * @param isRightTail
+     * @return F(x) or S(x)
+     */
+    double tail(const RealType &x, bool isRightTail) const;
+
+    /**
+     * @fn tailFunction
+     * fill y with F(x) or S(x), incomplete beta functions at the starting point are calculated at once for all arguments
      * @param x
-     * @param noncentrality
-     * @return pdf for x ≠ 0
+     * @param y
+     * @param isRightTail
      */
-    double pdfCommon(const double & x, double noncentrality) const;
+    void tailFunction(const std::vector<RealType> &x, std::vector<double> &y, bool isRightTail) const;
+
 public:
-    double f(const double & x) const override;
-    double logf(const double & x) const override;
-    double F(const double & x) const override;
-    double S(const double & x) const override;
-    double Variate() const override;
-    void Sample(std::vector<double> &outputData) const override;
-
-    double Mean() const override;
-    double Variance() const override;
-    double Mode() const override;
-    double Skewness() const override;
-    double ExcessKurtosis() const override;
+    double f(const RealType & x) const override;
+    double logf(const RealType & x) const override;
+    double F(const RealType & x) const override;
+    double S(const RealType & x) const override;
+    void CumulativeDistributionFunction(const std::vector<RealType> &x, std::vector<double> &y) const override;
+    void SurvivalFunction(const std::vector<RealType> &x, std::vector<double> &y) const override;
+    RealType Variate() const override;
+    void Sample(std::vector<RealType> &outputData) const override;
+    void Reseed(unsigned long seed) const override;
+
+    long double Mean() const override;
+    long double Variance() const override;
+    RealType Mode() const override;
+    long double Skewness() const override;
+    long double ExcessKurtosis() const override;
 
 private:
-    double quantileImpl(double p) const override;
-    double quantileImpl1m(double p) const override;
+    /**
+     * @fn quantileInitialGuess
+     * @param p
+     * @param isComplement
+     * @return root of Φ((t (1 - 1 / (4ν)) - μ) / √(1 + t^2 / (2ν))) = p (or 1 - p)
+     */
+    RealType quantileInitialGuess(double p, bool isComplement) const;
+    RealType quantileImpl(double p, RealType initValue) const override;
+    RealType quantileImpl(double p) const override;
+    RealType quantileImpl1m(double p, RealType initValue) const override;
+    RealType quantileImpl1m(double p) const override;
 };
 
 #endif // NONCENTRALTRAND_H
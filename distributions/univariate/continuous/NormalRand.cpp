@@ -55,6 +55,20 @@ DoublePair NormalRand<RealType>::SourceToNatural(DoublePair sourceParameters) co
     return {mean / scaleSq, -0.5 / scaleSq};
 }
 
+template < typename RealType >
+DoublePair NormalRand<RealType>::NaturalToSource(DoublePair theta) const
+{
+    double scaleSq = -0.5 / theta.second;
+    return {theta.first * scaleSq, scaleSq};
+}
+
+template < typename RealType >
+void NormalRand<RealType>::SetSourceParameters(DoublePair sourceParameters)
+{
+    SetVariance(sourceParameters.second);
+    this->SetLocation(sourceParameters.first);
+}
+
 template < typename RealType >
 double NormalRand<RealType>::LogNormalizer(DoublePair theta) const
 {
@@ -91,6 +105,17 @@ double NormalRand<RealType>::logf(const RealType &x) const
     return this->logpdfNormal(x);
 }
 
+template < typename RealType >
+void NormalRand<RealType>::LogProbabilityDensityFunction(const std::vector<RealType> &x, std::vector<double> &y) const
+{
+    /// the same formula as logpdfNormal without calls per element, so that the loop is vectorized
+    double mu = this->mu, coef = 0.5 / this->gamma, pdfCoef = this->pdfCoef;
+    for (size_t i = 0; i != x.size(); ++i) {
+        double z = (x[i] - mu) * coef;
+        y[i] = -(z * z + pdfCoef);
+    }
+}
+
 template < typename RealType >
 double NormalRand<RealType>::F(const RealType & x) const
 {
@@ -153,6 +178,23 @@ void NormalRand<RealType>::Sample(std::vector<RealType> &outputData) const
         var = this->Variate();
 }
 
+template < typename RealType >
+void NormalRand<RealType>::SampleParams(const std::vector<double> &locations, const std::vector<double> &scales, std::vector<RealType> &outputData, RandGenerator &randGenerator)
+{
+    size_t size = outputData.size();
+    if (locations.size() != size || scales.size() != size)
+        throw std::invalid_argument("Normal distribution: number of parameters should be equal to the size of output data");
+    for (double scale : scales) {
+        if (scale <= 0.0)
+            throw std::invalid_argument("Normal distribution: scale should be positive, but it's equal to " + std::to_string(scale));
+    }
+    for (RealType &var : outputData)
+        var = StandardVariate(randGenerator);
+    /// Shift and scale in a separate pass
+    for (size_t i = 0; i != size; ++i)
+        outputData[i] = locations[i] + scales[i] * outputData[i];
+}
+
 template < typename RealType >
 std::complex<double> NormalRand<RealType>::CFImpl(double t) const
 {
@@ -86,18 +86,31 @@ public:
     DoublePair SufficientStatistic(RealType x) const override;
     DoublePair SourceParameters() const override;
     DoublePair SourceToNatural(DoublePair sourceParameters) const override;
+    DoublePair NaturalToSource(DoublePair theta) const override;
+    void SetSourceParameters(DoublePair sourceParameters) override;
     double LogNormalizer(DoublePair theta) const override;
     DoublePair LogNormalizerGradient(DoublePair theta) const override;
     double CarrierMeasure(RealType) const override;
 
     double f(const RealType &x) const override;
     double logf(const RealType &x) const override;
+    void LogProbabilityDensityFunction(const std::vector<RealType> &x, std::vector<double> &y) const override;
     double F(const RealType & x) const override;
     double S(const RealType & x) const override;
     RealType Variate() const override;
     static RealType StandardVariate(RandGenerator &randGenerator = ProbabilityDistribution<RealType>::staticRandGenerator);
     void Sample(std::vector<RealType> &outputData) const override;
 
+    /**
+     * @fn SampleParams
+     * fill outputData with normal variates, such that i-th variate has location μ_i and scale σ_i
+     * @param locations μ_i
+     * @param scales σ_i
+     * @param outputData
+     */
+    static void SampleParams(const std::vector<double> &locations, const std::vector<double> &scales, std::vector<RealType> &outputData,
+                             RandGenerator &randGenerator = ProbabilityDistribution<RealType>::staticRandGenerator);
+
 private:
     RealType quantileImpl(double p) const override;
     RealType quantileImpl1m(double p) const override;
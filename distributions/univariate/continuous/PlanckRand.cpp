@@ -77,29 +77,71 @@ double PlanckRand<RealType>::logf(const RealType &x) const
     return y - RandMath::logexpm1l(b * x);
 }
 
+template < typename RealType >
+double PlanckRand<RealType>::lowerSeries(const RealType & x) const
+{
+    /// F(x) = g(a + 1) / b^(a + 1) * int_0^y t^a / (exp(t) - 1) dt, where y = bx,
+    /// and we expand t / (exp(t) - 1) = sum_n B_n t^n / n!, which converges for y < 2π
+    double y = b * x;
+    double sum = 1.0 / a - 0.5 * y / (a + 1);
+    double yDiv2PiSq = 0.5 * y / M_PI;
+    yDiv2PiSq *= yDiv2PiSq;
+    double yPow = 2.0;
+    for (int j = 1; j != 64; ++j) {
+        yPow *= -yDiv2PiSq;
+        double addon = -yPow * RandMath::riemannZeta(2 * j) / (2 * j + a);
+        sum += addon;
+        if (std::fabs(addon) <= MIN_POSITIVE * sum)
+            break;
+    }
+    return std::exp(pdfCoef + a * std::log(x)) * sum / b;
+}
+
+template < typename RealType >
+double PlanckRand<RealType>::upperSeries(const RealType & x) const
+{
+    /// S(x) = 1 / ζ(a + 1) * sum_k k^(-a-1) Q(a + 1, kbx)
+    double y = b * x;
+    double ap1 = a + 1;
+    double roundA = std::round(a);
+    if (a == roundA && a < 32) {
+        /// for integer shape the sum is expressed through polylogarithms:
+        /// S(x) = 1 / ζ(a + 1) * sum_{m=0}^{a} y^m / m! * Li_{a+1-m}(exp(-y))
+        double expmY = std::exp(-y);
+        double sum = 0.0, yPowDivFact = 1.0;
+        int aInt = roundA;
+        for (int m = 0; m <= aInt; ++m) {
+            sum += yPowDivFact * RandMath::polylog(ap1 - m, expmY);
+            yPowDivFact *= y / (m + 1);
+        }
+        return sum / Z.GetZetaFunction();
+    }
+    double logAp1 = std::log(ap1), lgammaAp1 = G.GetLogGammaShape();
+    double sum = 0.0;
+    for (int k = 1; k != 1000; ++k) {
+        double addon = RandMath::qgamma(ap1, k * y, logAp1, lgammaAp1);
+        addon *= std::exp(-ap1 * std::log(k));
+        sum += addon;
+        if (addon <= MIN_POSITIVE * sum)
+            break;
+    }
+    return sum / Z.GetZetaFunction();
+}
+
 template < typename RealType >
 double PlanckRand<RealType>::F(const RealType &x) const
 {
     if (x <= 0)
         return 0.0;
+    return (b * x <= 2.0) ? lowerSeries(x) : 1.0 - upperSeries(x);
+}
 
-    if (a >= 1) {
-        return RandMath::integral([this] (double t)
-        {
-            return f(t);
-        },
-        0, x);
-    }
-
-    /// split F(x) by two integrals
-    double aux = pdfCoef + a * std::log(x);
-    double integral1 = std::exp(aux) / (b * a);
-    double integral2 = RandMath::integral([this] (double t)
-    {
-        return h(t);
-    },
-    0, x);
-    return integral1 + integral2;
+template < typename RealType >
+double PlanckRand<RealType>::S(const RealType &x) const
+{
+    if (x <= 0)
+        return 1.0;
+    return (b * x <= 2.0) ? 1.0 - lowerSeries(x) : upperSeries(x);
 }
 
 template < typename RealType >
@@ -116,12 +158,11 @@ void PlanckRand<RealType>::Sample(std::vector<RealType> &outputData) const
         var /= Z.Variate();
 }
 
-#if HAVE_MATH_SPECIAL_FUNCTIONS
 template < typename RealType >
 long double PlanckRand<RealType>::Mean() const
 {
     double y = (a + 1) / b;
-    y *= std::riemann_zetal(a + 2);
+    y *= RandMath::riemannZeta(a + 2);
     return y / Z.GetZetaFunction();
 }
 
@@ -130,23 +171,11 @@ long double PlanckRand<RealType>::SecondMoment() const
 {
     long double secondMoment = (a + 1) * (a + 2);
     secondMoment /= (b * b);
-    secondMoment *= std::riemann_zetal(a + 3);
+    secondMoment *= RandMath::riemannZeta(a + 3);
     secondMoment /= Z.GetZetaFunction();
     return secondMoment;
 }
-#else
-template<typename RealType>
-long double PlanckRand<RealType>::Mean() const
-{
-    throw std::runtime_error("RandLib compiler does not support math special functions");
-}
 
-template<typename RealType>
-long double PlanckRand<RealType>::SecondMoment() const
-{
-    throw std::runtime_error("RandLib compiler does not support math special functions");
-}
-#endif
 template < typename RealType >
 long double PlanckRand<RealType>::Variance() const
 {
@@ -164,23 +193,16 @@ RealType PlanckRand<RealType>::Mode() const
     return (y + a) / b;
 }
 
-#if HAVE_MATH_SPECIAL_FUNCTIONS
 template < typename RealType >
 long double PlanckRand<RealType>::ThirdMoment() const
 {
     long double thirdMoment = (a + 3) * (a + 2) * (a + 1);
     thirdMoment /= (b * b * b);
-    thirdMoment *= std::riemann_zetal(a + 4);
+    thirdMoment *= RandMath::riemannZeta(a + 4);
     thirdMoment /= Z.GetZetaFunction();
     return thirdMoment;
 }
-#else
-template<typename RealType>
-long double PlanckRand<RealType>::ThirdMoment() const
-{
-    throw std::runtime_error("RandLib compiler does not support math special functions");
-}
-#endif
+
 template < typename RealType >
 long double PlanckRand<RealType>::Skewness() const
 {
@@ -194,24 +216,16 @@ long double PlanckRand<RealType>::Skewness() const
     return numerator / denominator;
 }
 
-#if HAVE_MATH_SPECIAL_FUNCTIONS
 template < typename RealType >
 long double PlanckRand<RealType>::FourthMoment() const
 {
     long double fourthMoment = (a + 4) * (a + 3) * (a + 2) * (a + 1);
     long double bSq = b * b;
     fourthMoment /= (bSq * bSq);
-    fourthMoment *= std::riemann_zetal(a + 5);
+    fourthMoment *= RandMath::riemannZeta(a + 5);
     fourthMoment /= Z.GetZetaFunction();
     return fourthMoment;
 }
-#else
-template<typename RealType>
-long double PlanckRand<RealType>::FourthMoment() const
-{
-    throw std::runtime_error("RandLib compiler does not support math special functions");
-}
-#endif
 
 template < typename RealType >
 long double PlanckRand<RealType>::ExcessKurtosis() const
@@ -46,10 +46,26 @@ private:
      */
     double h(double t) const;
 
+    /**
+     * @fn lowerSeries
+     * @param x
+     * @return F(x), calculated by Bernoulli series, converges for bx < 2π
+     */
+    double lowerSeries(const RealType & x) const;
+
+    /**
+     * @fn upperSeries
+     * @param x
+     * @return S(x), calculated by series of incomplete gamma functions or polylogarithms,
+     * converges fast for large bx
+     */
+    double upperSeries(const RealType & x) const;
+
 public:
     double f(const RealType & x) const override;
     double logf(const RealType & x) const override;
     double F(const RealType & x) const override;
+    double S(const RealType & x) const override;
     RealType Variate() const override;
     void Sample(std::vector<RealType> &outputData) const override;
 
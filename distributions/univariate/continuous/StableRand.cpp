@@ -1082,7 +1082,7 @@ std::complex<double> StableDistribution<RealType>::CFImpl(double t) const
         x = beta * M_2_PI * std::log(t);
         break;
     default:
-        x = -zeta;
+        x = zeta;
     }
     double re = std::pow(gamma * t, alpha);
     std::complex<double> psi = std::complex<double>(re, re * x - mu * t);
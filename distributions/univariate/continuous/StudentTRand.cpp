@@ -140,6 +140,54 @@ double StudentTRand<RealType>::S(const RealType & x) const
     return (x0 > 0.0) ? y : 1.0 - y;
 }
 
+template < typename RealType >
+void StudentTRand<RealType>::tailProbability(const std::vector<RealType> &x, std::vector<double> &t, std::vector<double> &y) const
+{
+    size_t size = x.size();
+    std::vector<double> z(size);
+    for (size_t i = 0; i != size; ++i) {
+        t[i] = (x[i] - mu) / sigma;
+        z[i] = nu / (t[i] * t[i] + nu);
+    }
+    RandMath::ibeta(z, y, 0.5 * nu, 0.5, logBetaFun);
+    for (size_t i = 0; i != size; ++i)
+        y[i] *= 0.5;
+}
+
+template < typename RealType >
+void StudentTRand<RealType>::CumulativeDistributionFunction(const std::vector<RealType> &x, std::vector<double> &y) const
+{
+    /// closed forms for ν = 1, 2, 3
+    if (nu == 1 || nu == 2 || nu == 3)
+        return ContinuousDistribution<RealType>::CumulativeDistributionFunction(x, y);
+    size_t size = x.size();
+    if (size > y.size())
+        return;
+    std::vector<double> t(size);
+    tailProbability(x, t, y);
+    for (size_t i = 0; i != size; ++i) {
+        if (t[i] > 0.0)
+            y[i] = 1.0 - y[i];
+    }
+}
+
+template < typename RealType >
+void StudentTRand<RealType>::SurvivalFunction(const std::vector<RealType> &x, std::vector<double> &y) const
+{
+    /// closed forms for ν = 1, 2, 3
+    if (nu == 1 || nu == 2 || nu == 3)
+        return ContinuousDistribution<RealType>::SurvivalFunction(x, y);
+    size_t size = x.size();
+    if (size > y.size())
+        return;
+    std::vector<double> t(size);
+    tailProbability(x, t, y);
+    for (size_t i = 0; i != size; ++i) {
+        if (t[i] < 0.0)
+            y[i] = 1.0 - y[i];
+    }
+}
+
 template < typename RealType >
 RealType StudentTRand<RealType>::Variate() const
 {
@@ -162,6 +210,46 @@ void StudentTRand<RealType>::Sample(std::vector<RealType> &outputData) const
     }
 }
 
+template < typename RealType >
+void StudentTRand<RealType>::SampleParams(const std::vector<double> &degrees, const std::vector<double> &locations, const std::vector<double> &scales,
+                                          std::vector<RealType> &outputData, RandGenerator &randGenerator)
+{
+    size_t size = outputData.size();
+    if (degrees.size() != size || locations.size() != size || scales.size() != size)
+        throw std::invalid_argument("Student-t distribution: number of parameters should be equal to the size of output data");
+
+    /// Regime 0: Cauchy (ν = 1), regime 1: N / sqrt(χ^2_ν / ν)
+    std::vector<int> regimeIds(size);
+    for (size_t i = 0; i != size; ++i) {
+        if (degrees[i] <= 0.0)
+            throw std::invalid_argument("Student-t distribution: degree parameter should be positive, but it's equal to " + std::to_string(degrees[i]));
+        if (scales[i] <= 0.0)
+            throw std::invalid_argument("Student-t distribution: scale should be positive, but it's equal to " + std::to_string(scales[i]));
+        regimeIds[i] = (degrees[i] == 1) ? 0 : 1;
+    }
+    std::vector<size_t> indices;
+    std::vector<size_t> offsets = UnivariateDistribution<RealType>::groupIndicesByRegime(regimeIds, 2, indices);
+
+    for (size_t j = offsets[0]; j != offsets[1]; ++j)
+        outputData[indices[j]] = CauchyRand<RealType>::StandardVariate(randGenerator);
+
+    size_t groupSize = offsets[2] - offsets[1];
+    if (groupSize > 0) {
+        std::vector<double> halfDegrees(groupSize);
+        for (size_t j = 0; j != groupSize; ++j)
+            halfDegrees[j] = 0.5 * degrees[indices[offsets[1] + j]];
+        std::vector<RealType> G(groupSize);
+        GammaDistribution<RealType>::StandardSampleParams(halfDegrees, G, randGenerator);
+        for (size_t j = 0; j != groupSize; ++j) {
+            RealType N = NormalRand<RealType>::StandardVariate(randGenerator);
+            outputData[indices[offsets[1] + j]] = N * std::sqrt(halfDegrees[j] / G[j]);
+        }
+    }
+
+    for (size_t i = 0; i != size; ++i)
+        outputData[i] = locations[i] + scales[i] * outputData[i];
+}
+
 template < typename RealType >
 void StudentTRand<RealType>::Reseed(unsigned long seed) const
 {
@@ -197,6 +285,25 @@ std::complex<double> StudentTRand<RealType>::CFImpl(double t) const
     return std::exp(y) * cf;
 }
 
+template < typename RealType >
+double StudentTRand<RealType>::tailQuantile(double p) const
+{
+    /// P(X > t) = I(ν / (ν + t^2), ν / 2, 1 / 2) / 2
+    double q = 2 * p;
+    if (q < 0.5) {
+        double x = RandMath::ibetainv(q, 0.5 * nu, 0.5, logBetaFun);
+        if (x == 0.0) {
+            /// x is too small to be represented, so we use asymptotic formula for its logarithm
+            double logX = 2 * (std::log(0.5 * q * nu) + logBetaFun) / nu;
+            return std::sqrt(nu) * std::exp(-0.5 * logX);
+        }
+        return std::sqrt(nu * (1.0 - x) / x);
+    }
+    /// for t -> 0 we solve for t^2 / (ν + t^2) to avoid cancellation
+    double y = RandMath::ibetacinv(q, 0.5, 0.5 * nu, logBetaFun);
+    return std::sqrt(nu * y / (1.0 - y));
+}
+
 template < typename RealType >
 RealType StudentTRand<RealType>::quantileImpl(double p) const
 {
@@ -212,7 +319,13 @@ RealType StudentTRand<RealType>::quantileImpl(double p) const
         double beta = std::cos(std::acos(alpha) / 3.0) / alpha - 1;
         return mu + sigma * 2 * RandMath::sign(temp) * std::sqrt(beta);
     }
-    return ContinuousDistribution<RealType>::quantileImpl(p);
+    RealType root = 0;
+    if (this->quantileSweepGuess(p, root, false))
+        root = ContinuousDistribution<RealType>::quantileImpl(p, root);
+    else
+        root = (p < 0.5) ? mu - sigma * tailQuantile(p) : mu + sigma * tailQuantile(1.0 - p);
+    this->setPreviousQuantile(root, p);
+    return root;
 }
 
 template < typename RealType >
@@ -230,7 +343,13 @@ RealType StudentTRand<RealType>::quantileImpl1m(double p) const
         double beta = std::cos(std::acos(alpha) / 3.0) / alpha - 1;
         return mu + sigma * 2 * RandMath::sign(temp) * std::sqrt(beta);
     }
-    return ContinuousDistribution<RealType>::quantileImpl1m(p);
+    RealType root = 0;
+    if (this->quantileSweepGuess(p, root, true))
+        root = ContinuousDistribution<RealType>::quantileImpl1m(p, root);
+    else
+        root = (p < 0.5) ? mu + sigma * tailQuantile(p) : mu - sigma * tailQuantile(1.0 - p);
+    this->setPreviousQuantile(root, p);
+    return root;
 }
 
 template < typename RealType >
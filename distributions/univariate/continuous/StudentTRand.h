@@ -42,8 +42,22 @@ public:
     double logf(const RealType & x) const override;
     double F(const RealType & x) const override;
     double S(const RealType & x) const override;
+    void CumulativeDistributionFunction(const std::vector<RealType> &x, std::vector<double> &y) const override;
+    void SurvivalFunction(const std::vector<RealType> &x, std::vector<double> &y) const override;
     RealType Variate() const override;
     void Sample(std::vector<RealType> &outputData) const override;
+
+    /**
+     * @fn SampleParams
+     * fill outputData with Student's t variates, such that i-th variate has degree ν_i, location μ_i and scale σ_i;
+     * elements with ν_i = 1 are sampled as Cauchy, the rest through one batched gamma pass
+     * @param degrees ν_i
+     * @param locations μ_i
+     * @param scales σ_i
+     * @param outputData
+     */
+    static void SampleParams(const std::vector<double> &degrees, const std::vector<double> &locations, const std::vector<double> &scales,
+                             std::vector<RealType> &outputData, RandGenerator &randGenerator = ProbabilityDistribution<RealType>::staticRandGenerator);
     void Reseed(unsigned long seed) const override;
 
     long double Mean() const override;
@@ -54,6 +68,21 @@ public:
     long double ExcessKurtosis() const override;
 
 private:
+    /**
+     * @fn tailProbability
+     * fill y with 0.5 * I(ν / (ν + t^2), ν / 2, 1 / 2) = P(X > |t|) for standard Student-t distribution
+     * @param x input vector
+     * @param t output vector of standardized x
+     * @param y
+     */
+    void tailProbability(const std::vector<RealType> &x, std::vector<double> &t, std::vector<double> &y) const;
+
+    /**
+     * @fn tailQuantile
+     * @param p
+     * @return such t > 0 that P(X > t) = p for standard Student-t distribution and p <= 0.5
+     */
+    double tailQuantile(double p) const;
     RealType quantileImpl(double p) const override;
     RealType quantileImpl1m(double p) const override;
     std::complex<double> CFImpl(double t) const override;
@@ -0,0 +1,317 @@
+#include "TransformedDensityRejection.h"
+#include "ContinuousDistribution.h"
+#include "UniformRand.h"
+#include "ExponentialRand.h"
+
+template < typename RealType >
+double TransformedDensityRejection<RealType>::logfDerivative(const ContinuousDistribution<RealType> &distribution, double x) const
+{
+    double derivative = distribution.logfDerivative(x);
+    if (!std::isnan(derivative))
+        return derivative;
+    /// central difference or one-sided difference of the second order near the boundaries
+    double minVal = distribution.MinValue(), maxVal = distribution.MaxValue();
+    double h = derivativeStep;
+    double logfx = distribution.logf(x);
+    if (x - h > minVal && x + h < maxVal) {
+        double logfLeft = distribution.logf(x - h), logfRight = distribution.logf(x + h);
+        if (std::isfinite(logfLeft) && std::isfinite(logfRight))
+            return 0.5 * (logfRight - logfLeft) / h;
+    }
+    if (x + 2 * h < maxVal) {
+        double logf1 = distribution.logf(x + h), logf2 = distribution.logf(x + 2 * h);
+        if (std::isfinite(logf1) && std::isfinite(logf2))
+            return 0.5 * (4 * logf1 - logf2 - 3 * logfx) / h;
+    }
+    if (x - 2 * h > minVal) {
+        double logf1 = distribution.logf(x - h), logf2 = distribution.logf(x - 2 * h);
+        if (std::isfinite(logf1) && std::isfinite(logf2))
+            return 0.5 * (3 * logfx - 4 * logf1 + logf2) / h;
+    }
+    return NAN;
+}
+
+template < typename RealType >
+double TransformedDensityRejection<RealType>::exponentialIntegral(double left, double right, double x, double logfx, double slope) const
+{
+    if (!(right > left))
+        return 0.0;
+    double logHeight = logfx - logfScale;
+    if (slope == 0.0)
+        return std::exp(logHeight) * (right - left);
+    if (slope > 0.0) {
+        if (std::isinf(right))
+            return INFINITY;
+        double top = std::exp(logHeight + slope * (right - x));
+        return std::isinf(left) ? top / slope : -top * std::expm1(-slope * (right - left)) / slope;
+    }
+    if (std::isinf(left))
+        return INFINITY;
+    double top = std::exp(logHeight + slope * (left - x));
+    return std::isinf(right) ? -top / slope : top * std::expm1(slope * (right - left)) / slope;
+}
+
+template < typename RealType >
+double TransformedDensityRejection<RealType>::squeezeIntegral(size_t index) const
+{
+    const Segment &segment = segments[index];
+    double area = 0.0;
+    if (index > 0) {
+        const Segment &previous = segments[index - 1];
+        double slope = (segment.logf - previous.logf) / (segment.x - previous.x);
+        area += exponentialIntegral(segment.left, segment.x, segment.x, segment.logf, slope);
+    }
+    if (index + 1 < segments.size()) {
+        const Segment &next = segments[index + 1];
+        double slope = (next.logf - segment.logf) / (next.x - segment.x);
+        area += exponentialIntegral(segment.x, segment.right, segment.x, segment.logf, slope);
+    }
+    return area;
+}
+
+template < typename RealType >
+double TransformedDensityRejection<RealType>::squeeze(size_t index, double x) const
+{
+    const Segment &segment = segments[index];
+    if (x >= segment.x) {
+        if (index + 1 == segments.size())
+            return -INFINITY;
+        const Segment &next = segments[index + 1];
+        return segment.logf + (x - segment.x) * (next.logf - segment.logf) / (next.x - segment.x);
+    }
+    if (index == 0)
+        return -INFINITY;
+    const Segment &previous = segments[index - 1];
+    return segment.logf + (x - segment.x) * (segment.logf - previous.logf) / (segment.x - previous.x);
+}
+
+template < typename RealType >
+bool TransformedDensityRejection<RealType>::findInitialPoints(const ContinuousDistribution<RealType> &distribution, double mode, std::vector<double> &points)
+{
+    double logfMode = distribution.logf(mode);
+    if (!std::isfinite(logfMode))
+        return false;
+    points.assign(1, mode);
+    derivativeStep = 0;
+    /// on each side look for the point, where log-density drops by 0.5 to 8 from the mode
+    static constexpr int MAX_ITER = 256;
+    double minVal = distribution.MinValue(), maxVal = distribution.MaxValue();
+    double step = 1e-3 * std::max(std::fabs(mode), 1.0);
+    for (double direction : {-1.0, 1.0}) {
+        double bound = (direction < 0) ? minVal : maxVal;
+        if (mode == bound)
+            continue;
+        bool isFound = false;
+        for (int iter = 0; iter < MAX_ITER && !isFound; ++iter) {
+            double x = mode + direction * step;
+            if (!(x > minVal && x < maxVal)) {
+                step = 0.5 * std::fabs(bound - mode);
+                continue;
+            }
+            double drop = logfMode - distribution.logf(x);
+            if (!(drop < 8.0))
+                step *= 0.5;
+            else if (drop < 0.5 && 2 * step < std::fabs(bound - mode))
+                step *= 2;
+            else {
+                points.push_back(x);
+                isFound = true;
+            }
+        }
+        if (!isFound && std::isinf(bound))
+            return false;
+        if (isFound && (derivativeStep == 0 || step < derivativeStep))
+            derivativeStep = step;
+    }
+    if (derivativeStep == 0)
+        derivativeStep = step;
+    derivativeStep *= 1e-5;
+    std::sort(points.begin(), points.end());
+    return true;
+}
+
+template < typename RealType >
+bool TransformedDensityRejection<RealType>::buildHull(const ContinuousDistribution<RealType> &distribution, const std::vector<double> &points)
+{
+    segments.clear();
+    for (double x : points) {
+        double logfx = distribution.logf(x);
+        double slope = logfDerivative(distribution, x);
+        /// points with zero density or infinite derivative near the boundaries are skipped
+        if (std::isfinite(logfx) && std::isfinite(slope))
+            segments.push_back({0, 0, x, logfx, slope});
+    }
+    if (segments.empty())
+        return false;
+
+    /// tangents should be above the density at neighbouring points and slopes should decrease
+    logfScale = segments[0].logf;
+    for (size_t i = 1; i < segments.size(); ++i) {
+        Segment &previous = segments[i - 1], &current = segments[i];
+        logfScale = std::max(logfScale, current.logf);
+        double tolerance = 1e-7 * (1.0 + std::fabs(previous.logf) + std::fabs(current.logf));
+        double dx = current.x - previous.x;
+        if (previous.logf + previous.slope * dx < current.logf - tolerance ||
+            current.logf - current.slope * dx < previous.logf - tolerance ||
+            current.slope > previous.slope + tolerance * (1.0 + std::fabs(previous.slope)))
+            return false;
+        /// intersection of tangents
+        double z = 0.5 * (previous.x + current.x);
+        double slopeDiff = previous.slope - current.slope;
+        if (slopeDiff > 0.0) {
+            double zCandidate = (current.logf - previous.logf + previous.slope * previous.x - current.slope * current.x) / slopeDiff;
+            if (zCandidate >= previous.x && zCandidate <= current.x)
+                z = zCandidate;
+        }
+        previous.right = z;
+        current.left = z;
+    }
+    segments.front().left = distribution.MinValue();
+    segments.back().right = distribution.MaxValue();
+
+    size_t n = segments.size();
+    cumulativeAreas.resize(n);
+    hullArea = 0.0;
+    squeezeArea = 0.0;
+    for (size_t i = 0; i != n; ++i) {
+        const Segment &segment = segments[i];
+        hullArea += exponentialIntegral(segment.left, segment.right, segment.x, segment.logf, segment.slope);
+        squeezeArea += squeezeIntegral(i);
+        cumulativeAreas[i] = hullArea;
+    }
+    if (!std::isfinite(hullArea) || hullArea <= 0.0)
+        return false;
+
+    guideTable.resize(n);
+    size_t index = 0;
+    for (size_t k = 0; k != n; ++k) {
+        double area = hullArea * k / n;
+        while (index + 1 < n && cumulativeAreas[index] <= area)
+            ++index;
+        guideTable[k] = index;
+    }
+    return true;
+}
+
+template < typename RealType >
+bool TransformedDensityRejection<RealType>::Setup(const ContinuousDistribution<RealType> &distribution, double maxRatio, size_t maxPoints)
+{
+    isLogConcave = false;
+    double minVal = distribution.MinValue(), maxVal = distribution.MaxValue();
+    double mode = std::min(std::max(static_cast<double>(distribution.Mode()), minVal), maxVal);
+    std::vector<double> points;
+    bool isValid = findInitialPoints(distribution, mode, points) && buildHull(distribution, points);
+    while (isValid && hullArea > maxRatio * squeezeArea && segments.size() < maxPoints) {
+        /// areas between hull and squeeze on intervals between construction points, including tails
+        size_t n = segments.size();
+        std::vector<double> gaps(n + 1, 0.0);
+        for (size_t i = 0; i != n; ++i) {
+            const Segment &segment = segments[i];
+            double gap = exponentialIntegral(segment.left, segment.x, segment.x, segment.logf, segment.slope);
+            if (i > 0) {
+                const Segment &previous = segments[i - 1];
+                gap -= exponentialIntegral(segment.left, segment.x, segment.x, segment.logf, (segment.logf - previous.logf) / (segment.x - previous.x));
+            }
+            gaps[i] += gap;
+            gap = exponentialIntegral(segment.x, segment.right, segment.x, segment.logf, segment.slope);
+            if (i + 1 < n) {
+                const Segment &next = segments[i + 1];
+                gap -= exponentialIntegral(segment.x, segment.right, segment.x, segment.logf, (next.logf - segment.logf) / (next.x - segment.x));
+            }
+            gaps[i + 1] += gap;
+        }
+        double averageGap = (hullArea - squeezeArea) / (n + 1);
+
+        /// split intervals with gap above average at the intersections of tangents
+        points.clear();
+        for (const Segment &segment : segments)
+            points.push_back(segment.x);
+        for (size_t j = 0; j <= n && points.size() < maxPoints; ++j) {
+            if (!(gaps[j] >= averageGap && gaps[j] > 0.0))
+                continue;
+            double x = NAN;
+            if (j == 0) {
+                const Segment &first = segments.front();
+                x = std::isfinite(minVal) ? 0.5 * (minVal + first.x) : first.x - 1.0 / first.slope;
+            }
+            else if (j == n) {
+                const Segment &last = segments.back();
+                x = std::isfinite(maxVal) ? 0.5 * (last.x + maxVal) : last.x - 1.0 / last.slope;
+            }
+            else {
+                x = segments[j - 1].right;
+            }
+            if (x > minVal && x < maxVal && x != segments[std::min(j, n - 1)].x && (j == 0 || x != segments[j - 1].x))
+                points.push_back(x);
+        }
+        if (points.size() == n)
+            break;
+        std::sort(points.begin(), points.end());
+        isValid = buildHull(distribution, points);
+    }
+    isLogConcave = isValid;
+    isBuilt = true;
+
+    /// density at the mode and at the farthest point from it is remembered
+    probes[0] = mode;
+    probes[1] = mode;
+    if (isValid) {
+        double left = segments.front().x, right = segments.back().x;
+        probes[1] = (mode - left > right - mode) ? left : right;
+    }
+    for (int i = 0; i != 2; ++i)
+        probeLogf[i] = distribution.logf(probes[i]);
+    return isLogConcave;
+}
+
+template < typename RealType >
+bool TransformedDensityRejection<RealType>::IsBuiltFor(const ContinuousDistribution<RealType> &distribution) const
+{
+    if (!isBuilt)
+        return false;
+    for (int i = 0; i != 2; ++i) {
+        double logfx = distribution.logf(probes[i]);
+        if (logfx != probeLogf[i] && !(std::isnan(logfx) && std::isnan(probeLogf[i])))
+            return false;
+    }
+    return true;
+}
+
+template < typename RealType >
+RealType TransformedDensityRejection<RealType>::Variate(const ContinuousDistribution<RealType> &distribution, RandGenerator &randGenerator) const
+{
+    size_t n = segments.size();
+    size_t iter = 0;
+    do {
+        /// choose segment with probability proportional to its area
+        double area = hullArea * UniformRand<double>::StandardVariate(randGenerator);
+        size_t index = guideTable[std::min(static_cast<size_t>(area / hullArea * n), n - 1)];
+        while (index + 1 < n && cumulativeAreas[index] < area)
+            ++index;
+        const Segment &segment = segments[index];
+
+        /// inversion of exponential density within the segment
+        double U = UniformRand<double>::StandardVariate(randGenerator);
+        double left = segment.left, right = segment.right, slope = segment.slope;
+        double x = 0.0;
+        if (slope == 0.0)
+            x = left + U * (right - left);
+        else if (slope > 0.0)
+            x = std::isinf(left) ? right + std::log(U) / slope : right + std::log1p((1.0 - U) * std::expm1(-slope * (right - left))) / slope;
+        else
+            x = std::isinf(right) ? left + std::log(U) / slope : left + std::log1p((1.0 - U) * std::expm1(slope * (right - left))) / slope;
+        x = std::min(std::max(x, left), right);
+
+        /// accept by squeeze or by density
+        double logHull = segment.logf + segment.slope * (x - segment.x);
+        double level = logHull - ExponentialRand<double>::StandardVariate(randGenerator);
+        if (level <= squeeze(index, x) || level <= distribution.logf(x))
+            return x;
+    } while (++iter <= MAX_ITER_REJECTION);
+    throw std::runtime_error("Transformed density rejection: sampling failed");
+}
+
+
+template class TransformedDensityRejection<float>;
+template class TransformedDensityRejection<double>;
+template class TransformedDensityRejection<long double>;
@@ -0,0 +1,152 @@
+#ifndef TRANSFORMEDDENSITYREJECTION_H
+#define TRANSFORMEDDENSITYREJECTION_H
+
+#include "../../ProbabilityDistribution.h"
+
+template < typename RealType >
+class ContinuousDistribution;
+
+/**
+ * @brief The TransformedDensityRejection class <BR>
+ * Transformed density rejection with logarithmic transformation for log-concave densities
+ *
+ * Hull is piecewise exponential and consists of tangents to log(f) at the construction points,
+ * squeeze consists of chords between them. Construction points are added by derandomized adaptive rejection:
+ * each interval with area between hull and squeeze above the average is split at the intersection of tangents,
+ * until the ratio of areas under hull and under squeeze is small enough.
+ * Therefore, most variates are accepted without evaluation of the density.
+ * The hull stores no reference to the distribution and remains valid for its copies.
+ */
+template < typename RealType = double >
+class RANDLIBSHARED_EXPORT TransformedDensityRejection
+{
+    /**
+     * @brief The Segment struct
+     * part of the hull, which is built on the tangent at the construction point
+     */
+    struct Segment
+    {
+        double left; ///< left boundary
+        double right; ///< right boundary
+        double x; ///< construction point
+        double logf; ///< log(f(x))
+        double slope; ///< derivative of log(f(x))
+    };
+
+    static constexpr size_t MAX_ITER_REJECTION = 1000;
+
+    std::vector<Segment> segments{};
+    std::vector<double> cumulativeAreas{}; ///< cumulative areas under the hull, scaled by 1 / max(f)
+    std::vector<size_t> guideTable{}; ///< first segment with cumulative area above k / n
+    double logfScale = 0; ///< maximum of log(f) at construction points
+    double hullArea = 0; ///< area under the hull, scaled by 1 / max(f)
+    double squeezeArea = 0; ///< area under the squeeze, scaled by 1 / max(f)
+    double derivativeStep = 0; ///< step for numerical derivative of log(f)
+    bool isBuilt = false; ///< true if setup was done
+    bool isLogConcave = false;
+    RealType probes[2] = {0, 0}; ///< points, where density is compared to detect change of parameters
+    double probeLogf[2] = {NAN, NAN}; ///< log(f) at probes
+
+public:
+    TransformedDensityRejection() {}
+
+    /**
+     * @fn Setup
+     * build the hull for the distribution
+     * @param distribution
+     * @param maxRatio desired upper bound of the ratio between areas under hull and squeeze
+     * @param maxPoints maximal number of construction points
+     * @return true if the density is found to be log-concave and the hull is built
+     */
+    bool Setup(const ContinuousDistribution<RealType> &distribution, double maxRatio = 1.01, size_t maxPoints = 128);
+
+    /**
+     * @fn IsBuiltFor
+     * @param distribution
+     * @return true if the setup was done for current parameters of the distribution,
+     * which is checked by the density at two points
+     */
+    bool IsBuiltFor(const ContinuousDistribution<RealType> &distribution) const;
+
+    /**
+     * @fn IsLogConcave
+     * @return true if the last setup succeeded
+     */
+    inline bool IsLogConcave() const { return isLogConcave; }
+    /**
+     * @fn GetNumberOfPoints
+     * @return number of construction points
+     */
+    inline size_t GetNumberOfPoints() const { return segments.size(); }
+    /**
+     * @fn GetRejectionConstant
+     * @return ratio between areas under hull and squeeze,
+     * which bounds the expected number of iterations from above
+     */
+    inline double GetRejectionConstant() const { return hullArea / squeezeArea; }
+
+    /**
+     * @fn Variate
+     * @param distribution should be the one the hull is built for
+     * @param randGenerator
+     * @return random variate
+     */
+    RealType Variate(const ContinuousDistribution<RealType> &distribution, RandGenerator &randGenerator) const;
+
+private:
+    /**
+     * @fn logfDerivative
+     * @param distribution
+     * @param x
+     * @return derivative of log(f), evaluated numerically if the distribution doesn't provide it
+     */
+    double logfDerivative(const ContinuousDistribution<RealType> &distribution, double x) const;
+
+    /**
+     * @fn exponentialIntegral
+     * @param left
+     * @param right
+     * @param x
+     * @param logfx
+     * @param slope
+     * @return ∫ exp(logfx + slope * (t - x) - logfScale) dt over [left, right]
+     */
+    double exponentialIntegral(double left, double right, double x, double logfx, double slope) const;
+
+    /**
+     * @fn squeezeIntegral
+     * @param index of the segment
+     * @return area under the squeeze within the segment
+     */
+    double squeezeIntegral(size_t index) const;
+
+    /**
+     * @fn squeeze
+     * @param index of the segment, which contains x
+     * @param x
+     * @return logarithm of the squeeze or -inf if x is beyond extreme construction points
+     */
+    double squeeze(size_t index, double x) const;
+
+    /**
+     * @fn findInitialPoints
+     * find points on both sides of the mode, where log(f) is lower by 0.5 to 8,
+     * and choose the step of numerical differentiation accordingly
+     * @param distribution
+     * @param mode
+     * @param points
+     * @return true if the points are found for infinite boundaries
+     */
+    bool findInitialPoints(const ContinuousDistribution<RealType> &distribution, double mode, std::vector<double> &points);
+
+    /**
+     * @fn buildHull
+     * calculate intersections of tangents and areas under hull and squeeze
+     * @param distribution
+     * @param points sorted construction points
+     * @return false if tangents don't form a bounded hull above the density
+     */
+    bool buildHull(const ContinuousDistribution<RealType> &distribution, const std::vector<double> &points);
+};
+
+#endif // TRANSFORMEDDENSITYREJECTION_H
@@ -41,6 +41,20 @@ double UniformRand<RealType>::S(const RealType & x) const
     return (x > this->b) ? 0.0 : this->bmaInv * (this->b - x);
 }
 
+template < typename RealType >
+void UniformRand<RealType>::CumulativeDistributionFunction(const std::vector<RealType> &x, std::vector<double> &y) const
+{
+    /// closed form is cheaper than incomplete beta function
+    ContinuousDistribution<RealType>::CumulativeDistributionFunction(x, y);
+}
+
+template < typename RealType >
+void UniformRand<RealType>::SurvivalFunction(const std::vector<RealType> &x, std::vector<double> &y) const
+{
+    /// closed form is cheaper than incomplete beta function
+    ContinuousDistribution<RealType>::SurvivalFunction(x, y);
+}
+
 template < typename RealType >
 RealType UniformRand<RealType>::Variate() const
 {
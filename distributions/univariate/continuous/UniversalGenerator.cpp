@@ -0,0 +1,296 @@
+#include "UniversalGenerator.h"
+#include "ContinuousDistribution.h"
+#include "UniformRand.h"
+
+template < typename RealType >
+double UniversalGenerator<RealType>::bulkScale(const ContinuousDistribution<RealType> &distribution, double mode) const
+{
+    double fallback = std::max(std::fabs(mode), 1.0);
+    double logfMode = distribution.logf(mode);
+    if (!std::isfinite(logfMode))
+        return fallback;
+    /// on each side look for the point, where log-density drops by log(2) to 4 from the mode
+    static constexpr int MAX_ITER = 256;
+    double minVal = distribution.MinValue(), maxVal = distribution.MaxValue();
+    double scale = 0.0;
+    for (double direction : {-1.0, 1.0}) {
+        double distance = (direction < 0) ? mode - minVal : maxVal - mode;
+        if (!(distance > 0))
+            continue;
+        double step = std::min(1e-3 * fallback, 0.5 * distance);
+        for (int iter = 0; iter != MAX_ITER; ++iter) {
+            double drop = logfMode - distribution.logf(mode + direction * step);
+            if (!(drop < 4.0))
+                step *= 0.5;
+            else if (drop < M_LN2 && 2 * step < distance)
+                step *= 2;
+            else
+                break;
+        }
+        scale = std::max(scale, step);
+    }
+    return (scale > 0 && std::isfinite(scale)) ? scale : fallback;
+}
+
+template < typename RealType >
+bool UniversalGenerator<RealType>::setupRatioOfUniforms(const ContinuousDistribution<RealType> &distribution, double mode, double scale)
+{
+    double logfMode = distribution.logf(mode);
+    if (!std::isfinite(logfMode))
+        return false;
+    center = mode;
+    double logUMax = 0.5 * logfMode;
+    double logV[2] = {-INFINITY, -INFINITY};
+    double minVal = distribution.MinValue(), maxVal = distribution.MaxValue();
+
+    /// maximize log(t) + log(f(m ± t)) / 2 on geometric grid t = s * 2^(k/4), which is scanned
+    /// in both directions from k = 0 until the function decreases substantially or levels off, and refine by golden section
+    static constexpr int GRID_MIN = -64, GRID_MAX = 256, PATIENCE = 8;
+    for (int side = 0; side != 2; ++side) {
+        double direction = side ? 1.0 : -1.0;
+        double distance = side ? maxVal - mode : mode - minVal;
+        if (!(distance > 0))
+            continue;
+        auto logV2 = [&distribution, mode, direction] (double logT) {
+            return logT + 0.5 * distribution.logf(mode + direction * std::exp(logT));
+        };
+        std::vector<double> logTs, values;
+        bool isLeveled = false;
+        for (int step : {1, -1}) {
+            std::vector<double> scanLogTs, scanValues;
+            double maxValue = -INFINITY;
+            int decreaseCount = 0;
+            for (int k = (step > 0) ? 0 : -1; k >= GRID_MIN && k <= GRID_MAX; k += step) {
+                double t = scale * std::exp2(0.25 * k);
+                if (step < 0 && t >= distance)
+                    continue;
+                bool isLast = (t >= distance);
+                if (isLast)
+                    t = distance * (1.0 - 1e-9);
+                double logfx = distribution.logf(mode + direction * t);
+                if (logfx == INFINITY)
+                    return false;
+                logUMax = std::max(logUMax, 0.5 * logfx);
+                double value = std::log(t) + 0.5 * logfx;
+                scanLogTs.push_back(std::log(t));
+                scanValues.push_back(value);
+                decreaseCount = (value < maxValue) ? decreaseCount + 1 : 0;
+                maxValue = std::max(maxValue, value);
+                size_t size = scanValues.size();
+                if (step > 0 && size > PATIENCE && value - scanValues[size - 1 - PATIENCE] < 1e-6 && decreaseCount == 0)
+                    isLeveled = true;
+                bool isDecreased = decreaseCount >= 4 * PATIENCE || (decreaseCount >= PATIENCE && value < maxValue - 2);
+                if (isLast || isDecreased || isLeveled)
+                    break;
+            }
+            if (step > 0) {
+                logTs = scanLogTs;
+                values = scanValues;
+            }
+            else {
+                logTs.insert(logTs.begin(), scanLogTs.rbegin(), scanLogTs.rend());
+                values.insert(values.begin(), scanValues.rbegin(), scanValues.rend());
+            }
+        }
+        size_t size = values.size();
+        size_t best = std::max_element(values.begin(), values.end()) - values.begin();
+        if (!std::isfinite(values[best]))
+            continue;
+        if (best + 1 == size) {
+            /// supremum at infinity is finite only if the function levels off
+            if (std::isinf(distance) && !isLeveled)
+                return false;
+            logV[side] = values[best];
+            continue;
+        }
+        /// golden section
+        double a = logTs[best > 0 ? best - 1 : 0], b = logTs[best + 1];
+        static constexpr double GOLDEN = 0.6180339887498949;
+        double c = b - GOLDEN * (b - a), d = a + GOLDEN * (b - a);
+        double fc = logV2(c), fd = logV2(d);
+        for (int iter = 0; iter != 64; ++iter) {
+            if (fc > fd) {
+                b = d; d = c; fd = fc;
+                c = b - GOLDEN * (b - a);
+                fc = logV2(c);
+            }
+            else {
+                a = c; c = d; fc = fd;
+                d = a + GOLDEN * (b - a);
+                fd = logV2(d);
+            }
+        }
+        logV[side] = std::max(values[best], std::max(fc, fd));
+    }
+
+    /// small margin covers error of maximization
+    static constexpr double SAFETY = 1.01;
+    uMax = SAFETY * std::exp(logUMax);
+    vMin = -SAFETY * std::exp(logV[0]);
+    vMax = SAFETY * std::exp(logV[1]);
+    return std::isfinite(uMax) && std::isfinite(vMax - vMin) && GetAcceptanceRate() >= MIN_ACCEPTANCE_RATE;
+}
+
+template < typename RealType >
+void UniversalGenerator<RealType>::setupNumericalInversion(const ContinuousDistribution<RealType> &distribution)
+{
+    tableQuantiles.clear();
+    tableCdf.clear();
+    for (size_t i = 1; i <= TABLE_SIZE; ++i) {
+        double x = distribution.Quantile(static_cast<double>(i) / (TABLE_SIZE + 1));
+        double cdf = distribution.F(x);
+        if (!std::isfinite(x) || (!tableCdf.empty() && (cdf <= tableCdf.back() || x <= tableQuantiles.back())))
+            continue;
+        tableQuantiles.push_back(x);
+        tableCdf.push_back(cdf);
+    }
+}
+
+template < typename RealType >
+void UniversalGenerator<RealType>::Setup(const ContinuousDistribution<RealType> &distribution)
+{
+    double minVal = distribution.MinValue(), maxVal = distribution.MaxValue();
+    double mode = std::min(std::max(static_cast<double>(distribution.Mode()), minVal), maxVal);
+    double scale = bulkScale(distribution, mode);
+
+    probes[0] = mode;
+    probes[1] = (mode + scale < maxVal) ? mode + scale : ((mode - scale > minVal) ? mode - scale : mode);
+    for (int i = 0; i != 2; ++i)
+        probeLogf[i] = distribution.logf(probes[i]);
+    isBuilt = true;
+
+    if (densityRejection.Setup(distribution))
+        id = TRANSFORMED_DENSITY_REJECTION;
+    else if (setupRatioOfUniforms(distribution, mode, scale))
+        id = RATIO_OF_UNIFORMS;
+    else {
+        setupNumericalInversion(distribution);
+        id = NUMERICAL_INVERSION;
+    }
+}
+
+template < typename RealType >
+bool UniversalGenerator<RealType>::IsBuiltFor(const ContinuousDistribution<RealType> &distribution) const
+{
+    if (!isBuilt)
+        return false;
+    for (int i = 0; i != 2; ++i) {
+        double logfx = distribution.logf(probes[i]);
+        if (logfx != probeLogf[i] && !(std::isnan(logfx) && std::isnan(probeLogf[i])))
+            return false;
+    }
+    return true;
+}
+
+template < typename RealType >
+double UniversalGenerator<RealType>::GetAcceptanceRate() const
+{
+    switch (id) {
+    case TRANSFORMED_DENSITY_REJECTION:
+        return 1.0 / densityRejection.GetRejectionConstant();
+    case RATIO_OF_UNIFORMS:
+        /// area of the acceptance region is 1/2
+        return 0.5 / (uMax * (vMax - vMin));
+    default:
+        return 1.0;
+    }
+}
+
+template < typename RealType >
+RealType UniversalGenerator<RealType>::variateRatioOfUniforms(const ContinuousDistribution<RealType> &distribution, RandGenerator &randGenerator) const
+{
+    double minVal = distribution.MinValue(), maxVal = distribution.MaxValue();
+    size_t iter = 0;
+    do {
+        double u = uMax * UniformRand<double>::StandardVariate(randGenerator);
+        double v = vMin + (vMax - vMin) * UniformRand<double>::StandardVariate(randGenerator);
+        double x = center + v / u;
+        if (x >= minVal && x <= maxVal && 2 * std::log(u) <= distribution.logf(x))
+            return x;
+    } while (++iter <= MAX_ITER_REJECTION);
+    throw std::runtime_error("Ratio-of-uniforms method: sampling failed");
+}
+
+template < typename RealType >
+RealType UniversalGenerator<RealType>::variateNumericalInversion(const ContinuousDistribution<RealType> &distribution, RandGenerator &randGenerator) const
+{
+    double U = UniformRand<double>::StandardVariate(randGenerator);
+    size_t n = tableQuantiles.size();
+    if (n == 0)
+        return distribution.Quantile(U);
+
+    /// bracket from the table of starting points
+    size_t index = std::min(static_cast<size_t>(U * (TABLE_SIZE + 1)), n);
+    while (index > 0 && tableCdf[index - 1] > U)
+        --index;
+    while (index < n && tableCdf[index] <= U)
+        ++index;
+    double lower = (index > 0) ? tableQuantiles[index - 1] : distribution.MinValue();
+    double upper = (index < n) ? tableQuantiles[index] : distribution.MaxValue();
+    double x = 0.0;
+    if (index > 0 && index < n) {
+        double weight = (U - tableCdf[index - 1]) / (tableCdf[index] - tableCdf[index - 1]);
+        x = lower + weight * (upper - lower);
+    }
+    else {
+        /// extend the bracket into the tail geometrically
+        double width = (n > 1) ? tableQuantiles[n - 1] - tableQuantiles[0] : 1.0;
+        for (int iter = 0; iter < 2048 && std::isinf(lower); ++iter, width *= 2) {
+            double y = upper - width;
+            if (distribution.F(y) <= U)
+                lower = y;
+            else
+                upper = y;
+        }
+        for (int iter = 0; iter < 2048 && std::isinf(upper); ++iter, width *= 2) {
+            double y = lower + width;
+            if (distribution.F(y) > U)
+                upper = y;
+            else
+                lower = y;
+        }
+        if (!std::isfinite(lower) || !std::isfinite(upper))
+            return distribution.Quantile(U);
+        x = (index == 0) ? upper : lower;
+    }
+
+    /// safeguarded Newton's method, cdf is replaced by survival function in the right half
+    bool isComplement = U > 0.5;
+    double p = isComplement ? 1.0 - U : U;
+    double tolerance = 1e-12 * p;
+    static constexpr int MAX_ITER = 100;
+    for (int iter = 0; iter != MAX_ITER; ++iter) {
+        double gap = isComplement ? p - distribution.S(x) : distribution.F(x) - p;
+        if (std::fabs(gap) <= tolerance)
+            break;
+        if (gap < 0)
+            lower = x;
+        else
+            upper = x;
+        double next = x - gap / distribution.f(x);
+        if (!(next > lower && next < upper))
+            next = 0.5 * (lower + upper);
+        if (std::fabs(next - x) <= 4 * MIN_POSITIVE + 4e-16 * std::fabs(x))
+            return next;
+        x = next;
+    }
+    return x;
+}
+
+template < typename RealType >
+RealType UniversalGenerator<RealType>::Variate(const ContinuousDistribution<RealType> &distribution, RandGenerator &randGenerator) const
+{
+    switch (id) {
+    case TRANSFORMED_DENSITY_REJECTION:
+        return densityRejection.Variate(distribution, randGenerator);
+    case RATIO_OF_UNIFORMS:
+        return variateRatioOfUniforms(distribution, randGenerator);
+    default:
+        return variateNumericalInversion(distribution, randGenerator);
+    }
+}
+
+
+template class UniversalGenerator<float>;
+template class UniversalGenerator<double>;
+template class UniversalGenerator<long double>;
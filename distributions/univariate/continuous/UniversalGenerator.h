@@ -0,0 +1,139 @@
+#ifndef UNIVERSALGENERATOR_H
+#define UNIVERSALGENERATOR_H
+
+#include "TransformedDensityRejection.h"
+
+/**
+ * @brief The UniversalGenerator class <BR>
+ * Automatic choice of generator for continuous distribution, which needs only its density and cdf
+ *
+ * Transformed density rejection is used for log-concave density.
+ * Otherwise, ratio-of-uniforms method is used if the bounding rectangle,
+ * calculated by maximization of sqrt(f(x)) and |x - m| sqrt(f(x)) around the mode m, is finite and tight enough.
+ * Otherwise, numerical inversion (NINV of Hörmann and Leydold) is used,
+ * which starts Newton's method from the cached table of quantiles
+ */
+template < typename RealType = double >
+class RANDLIBSHARED_EXPORT UniversalGenerator
+{
+public:
+    enum GENERATOR_ID {
+        TRANSFORMED_DENSITY_REJECTION, ///< log-concave density
+        RATIO_OF_UNIFORMS, ///< density with tails not heavier than x^(-2)
+        NUMERICAL_INVERSION ///< any density
+    };
+
+private:
+    static constexpr size_t MAX_ITER_REJECTION = 1000;
+    static constexpr double MIN_ACCEPTANCE_RATE = 0.2; ///< for ratio-of-uniforms method
+    static constexpr size_t TABLE_SIZE = 64; ///< number of starting points for numerical inversion
+
+    TransformedDensityRejection<RealType> densityRejection{};
+    GENERATOR_ID id = NUMERICAL_INVERSION;
+    bool isBuilt = false; ///< true if setup was done
+
+    double center = 0; ///< m
+    double uMax = 0; ///< max(sqrt(f(x)))
+    double vMin = 0; ///< min((x - m) sqrt(f(x)))
+    double vMax = 0; ///< max((x - m) sqrt(f(x)))
+
+    std::vector<double> tableQuantiles{}; ///< x_i, such that F(x_i) ≈ i / (TABLE_SIZE + 1)
+    std::vector<double> tableCdf{}; ///< F(x_i)
+
+    RealType probes[2] = {0, 0}; ///< points, where density is compared to detect change of parameters
+    double probeLogf[2] = {NAN, NAN}; ///< log(f) at probes
+
+public:
+    UniversalGenerator() {}
+
+    /**
+     * @fn Setup
+     * choose generator for the distribution and calculate its constants
+     * @param distribution
+     */
+    void Setup(const ContinuousDistribution<RealType> &distribution);
+
+    /**
+     * @fn IsBuilt
+     * @return true if the setup was done and not invalidated since then
+     */
+    inline bool IsBuilt() const { return isBuilt; }
+
+    /**
+     * @fn Invalidate
+     * drop the setup, so that the next variate repeats it
+     */
+    inline void Invalidate() { isBuilt = false; }
+
+    /**
+     * @fn IsBuiltFor
+     * @param distribution
+     * @return true if the setup was done for current parameters of the distribution,
+     * which is checked by the density at two points
+     */
+    bool IsBuiltFor(const ContinuousDistribution<RealType> &distribution) const;
+
+    /**
+     * @fn GetIdOfUsedGenerator
+     * @return method chosen by the last setup
+     */
+    inline GENERATOR_ID GetIdOfUsedGenerator() const { return id; }
+
+    /**
+     * @fn GetAcceptanceRate
+     * @return expected fraction of accepted candidates for rejection methods and 1 for inversion
+     */
+    double GetAcceptanceRate() const;
+
+    /**
+     * @fn Variate
+     * @param distribution should be the one the generator is built for
+     * @param randGenerator
+     * @return random variate
+     */
+    RealType Variate(const ContinuousDistribution<RealType> &distribution, RandGenerator &randGenerator) const;
+
+private:
+    /**
+     * @fn bulkScale
+     * @param distribution
+     * @param mode
+     * @return distance from the mode, where the density halves, found by doubling and halving of the step,
+     * or max(|mode|, 1) if the density at the mode is not finite
+     */
+    double bulkScale(const ContinuousDistribution<RealType> &distribution, double mode) const;
+
+    /**
+     * @fn setupRatioOfUniforms
+     * @param distribution
+     * @param mode
+     * @param scale width of the bulk of distribution
+     * @return true if the bounding rectangle is finite and acceptance rate is not too small
+     */
+    bool setupRatioOfUniforms(const ContinuousDistribution<RealType> &distribution, double mode, double scale);
+
+    /**
+     * @fn setupNumericalInversion
+     * tabulate quantiles for starting points
+     * @param distribution
+     */
+    void setupNumericalInversion(const ContinuousDistribution<RealType> &distribution);
+
+    /**
+     * @fn variateRatioOfUniforms
+     * @param distribution
+     * @param randGenerator
+     * @return random variate by ratio-of-uniforms method
+     */
+    RealType variateRatioOfUniforms(const ContinuousDistribution<RealType> &distribution, RandGenerator &randGenerator) const;
+
+    /**
+     * @fn variateNumericalInversion
+     * @param distribution
+     * @param randGenerator
+     * @return random variate by numerical inversion
+     */
+    RealType variateNumericalInversion(const ContinuousDistribution<RealType> &distribution, RandGenerator &randGenerator) const;
+};
+
+#endif // UNIVERSALGENERATOR_H
@@ -72,6 +72,23 @@ RealType WeibullRand<RealType>::Variate() const
     return lambda * std::pow(ExponentialRand<RealType>::StandardVariate(this->localRandGenerator), kInv);
 }
 
+template < typename RealType >
+void WeibullRand<RealType>::SampleParams(const std::vector<double> &scales, const std::vector<double> &shapes, std::vector<RealType> &outputData, RandGenerator &randGenerator)
+{
+    size_t size = outputData.size();
+    if (scales.size() != size || shapes.size() != size)
+        throw std::invalid_argument("Weibull distribution: number of parameters should be equal to the size of output data");
+    for (size_t i = 0; i != size; ++i) {
+        if (scales[i] <= 0.0 || shapes[i] <= 0.0)
+            throw std::invalid_argument("Weibull distribution: scale and shape should be positive, but they're equal to "
+                                        + std::to_string(scales[i]) + " and " + std::to_string(shapes[i]));
+    }
+    for (RealType &var : outputData)
+        var = ExponentialRand<RealType>::StandardVariate(randGenerator);
+    for (size_t i = 0; i != size; ++i)
+        outputData[i] = scales[i] * std::pow(outputData[i], 1.0 / shapes[i]);
+}
+
 template < typename RealType >
 long double WeibullRand<RealType>::Mean() const
 {
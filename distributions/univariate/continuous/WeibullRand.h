@@ -36,6 +36,16 @@ public:
     double S(const RealType & x) const override;
     RealType Variate() const override;
 
+    /**
+     * @fn SampleParams
+     * fill outputData with Weibull variates, such that i-th variate has scale λ_i and shape k_i
+     * @param scales λ_i
+     * @param shapes k_i
+     * @param outputData
+     */
+    static void SampleParams(const std::vector<double> &scales, const std::vector<double> &shapes, std::vector<RealType> &outputData,
+                             RandGenerator &randGenerator = ProbabilityDistribution<RealType>::staticRandGenerator);
+
     long double Mean() const override;
     long double Variance() const override;
     RealType Median() const override;
@@ -28,6 +28,7 @@ void BetaBinomialRand<IntType>::SetParameters(IntType number, double shape1, dou
     pmfCoef = RandMath::lfact(n);
     pmfCoef -= std::lgammal(B.GetAlpha() + B.GetBeta() + n);
     pmfCoef -= B.GetLogBetaFunction();
+    this->updateTable();
 }
 
 template< typename IntType >
@@ -55,6 +56,8 @@ double BetaBinomialRand<IntType>::F(const IntType & k) const
         return 0.0;
     if (k >= n)
         return 1.0;
+    if (this->isInTable(k))
+        return this->tabulatedF(k);
     double sum = 0.0;
     int i = 0;
     do {
@@ -63,6 +66,23 @@ double BetaBinomialRand<IntType>::F(const IntType & k) const
     return sum;
 }
 
+template< typename IntType >
+double BetaBinomialRand<IntType>::S(const IntType & k) const
+{
+    if (k < 0)
+        return 1.0;
+    if (k >= n)
+        return 0.0;
+    if (this->isInTable(k))
+        return this->tabulatedS(k);
+    double sum = 0.0;
+    int i = n;
+    do {
+        sum += P(i);
+    } while (--i > k);
+    return sum;
+}
+
 template< typename IntType >
 IntType BetaBinomialRand<IntType>::VariateUniform() const
 {
@@ -79,13 +99,19 @@ IntType BetaBinomialRand<IntType>::VariateBeta() const
 template< typename IntType >
 IntType BetaBinomialRand<IntType>::Variate() const
 {
+    if (this->IsTabulated())
+        return this->tabulatedVariate();
     return (B.GetAlpha() == 1 && B.GetBeta() == 1) ? VariateUniform() : VariateBeta();
 }
 
 template< typename IntType >
 void BetaBinomialRand<IntType>::Sample(std::vector<IntType> &outputData) const
 {
-    if (B.GetAlpha() == 1 && B.GetBeta() == 1) {
+    if (this->IsTabulated()) {
+        for (IntType & var : outputData)
+            var = this->tabulatedVariate();
+    }
+    else if (B.GetAlpha() == 1 && B.GetBeta() == 1) {
         for (IntType & var : outputData)
             var = VariateUniform();
     }
@@ -33,9 +33,13 @@ public:
     inline double GetAlpha() const { return B.GetAlpha(); }
     inline double GetBeta() const { return B.GetBeta(); }
 
+    using DiscreteDistribution<IntType>::Tabulate;
+    using DiscreteDistribution<IntType>::Untabulate;
+
     double P(const IntType & k) const override;
     double logP(const IntType & k) const override;
     double F(const IntType & k) const override;
+    double S(const IntType & k) const override;
 
 private:
     IntType VariateUniform() const;
@@ -111,6 +111,18 @@ double BinomialDistribution<IntType>::SourceToNatural(double sourceParameters) c
     return std::log(sourceParameters) - std::log1p(-sourceParameters);
 }
 
+template< typename IntType >
+double BinomialDistribution<IntType>::NaturalToSource(double theta) const
+{
+    return 1.0 / (1.0 + std::exp(-theta));
+}
+
+template< typename IntType >
+void BinomialDistribution<IntType>::SetSourceParameters(double probability)
+{
+    SetParameters(this->n, probability);
+}
+
 template< typename IntType >
 double BinomialDistribution<IntType>::NaturalParameters() const
 {
@@ -313,6 +325,94 @@ IntType BinomialDistribution<IntType>::variateBernoulliSum(IntType number, doubl
     return var;
 }
 
+template< typename IntType >
+IntType BinomialDistribution<IntType>::variateTransformedRejection(IntType number, double probability, RandGenerator &randGenerator)
+{
+    /// W. Hörmann, The generation of binomial random variates (1993)
+    /// Stirling-formula correction log(k!) - (k + 0.5)log(k + 1) + k + 1 - 0.5log(2π)
+    static constexpr double fcTable[10] = {
+        0.08106146679532726, 0.04134069595540929, 0.02767792568499834,
+        0.02079067210376509, 0.01664469118982119, 0.01387612882307075,
+        0.01189670994589177, 0.01041126526197209, 0.009255462182712733,
+        0.008330563433362871
+    };
+    auto fc = [] (double k) {
+        if (k < 10)
+            return fcTable[static_cast<int>(k)];
+        double kp1Inv = 1.0 / (k + 1), kp1InvSq = kp1Inv * kp1Inv;
+        return (1.0 / 12 - (1.0 / 360 - kp1InvSq / 1260) * kp1InvSq) * kp1Inv;
+    };
+
+    double n = number, p = probability, q = 1.0 - p;
+    double m = std::floor((n + 1) * p);
+    double r = p / q, nr = (n + 1) * r;
+    double npq = n * p * q, sqrtnpq = std::sqrt(npq);
+    double b = 1.15 + 2.53 * sqrtnpq;
+    double a = -0.0873 + 0.0248 * b + 0.01 * p;
+    double c = n * p + 0.5;
+    double alpha = (2.83 + 5.1 / b) * sqrtnpq;
+    double vr = 0.92 - 4.2 / b;
+    double urvr = 0.86 * vr;
+
+    size_t iter = 0;
+    do {
+        double V = UniformRand<double>::StandardVariate(randGenerator);
+        double U = 0;
+        if (V <= urvr) {
+            /// immediate acceptance in the central part
+            U = V / vr - 0.43;
+            return std::floor((2 * a / (0.5 - std::fabs(U)) + b) * U + c);
+        }
+        if (V >= vr) {
+            U = UniformRand<double>::StandardVariate(randGenerator) - 0.5;
+        }
+        else {
+            U = V / vr - 0.93;
+            U = ((U > 0) ? 0.5 : -0.5) - U;
+            V = UniformRand<double>::StandardVariate(randGenerator) * vr;
+        }
+
+        double us = 0.5 - std::fabs(U);
+        double k = std::floor((2 * a / us + b) * U + c);
+        if (k < 0 || k > n)
+            continue;
+        V *= alpha / (a / (us * us) + b);
+        double km = std::fabs(k - m);
+        if (km <= 15) {
+            /// recursive evaluation of f(k)
+            double f = 1.0;
+            if (m < k) {
+                for (double i = m + 1; i <= k; ++i)
+                    f *= nr / i - r;
+            }
+            else if (m > k) {
+                for (double i = k + 1; i <= m; ++i)
+                    V *= nr / i - r;
+            }
+            if (V <= f)
+                return k;
+            continue;
+        }
+
+        /// squeeze acceptance and rejection
+        V = std::log(V);
+        double rho = (km / npq) * (((km / 3 + 0.625) * km + 1.0 / 6) / npq + 0.5);
+        double t = -0.5 * km * km / npq;
+        if (V < t - rho)
+            return k;
+        if (V > t + rho)
+            continue;
+
+        /// final acceptance test
+        double nm = n - m + 1;
+        double h = (m + 0.5) * std::log((m + 1) / (r * nm)) + fc(m) + fc(n - m);
+        double nk = n - k + 1;
+        if (V <= h + (n + 1) * std::log(nm / nk) + (k + 0.5) * std::log(nk * r / (k + 1)) - fc(k) - fc(n - k))
+            return k;
+    } while (++iter <= ProbabilityDistribution<IntType>::MAX_ITER_REJECTION);
+    throw std::runtime_error("Binomial distribution: sampling failed");
+}
+
 template< typename IntType >
 IntType BinomialDistribution<IntType>::Variate() const
 {
@@ -356,9 +456,10 @@ IntType BinomialDistribution<IntType>::Variate(IntType number, double probabilit
 
     if (number < 10)
         return variateBernoulliSum(number, probability, randGenerator);
-    if (probability < 0.5)
-        return variateWaiting(number, probability, randGenerator);
-    return number - variateWaiting(number, 1.0 - probability, randGenerator);
+    double minpq = std::min(probability, 1.0 - probability);
+    IntType var = (number * minpq < 10) ? variateWaiting(number, minpq, randGenerator)
+                                        : variateTransformedRejection(number, minpq, randGenerator);
+    return (probability <= 0.5) ? var : number - var;
 }
 
 template< typename IntType >
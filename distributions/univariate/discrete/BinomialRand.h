@@ -67,6 +67,8 @@ public:
     double SufficientStatistic(IntType x) const override;
     double SourceParameters() const override;
     double SourceToNatural(double sourceParameters) const override;
+    double NaturalToSource(double theta) const override;
+    void SetSourceParameters(double probability) override;
     double NaturalParameters() const override;
     double LogNormalizer(double theta) const override;
     double LogNormalizerGradient(double theta) const override;
@@ -115,6 +117,15 @@ private:
     IntType variateWaiting(IntType number) const;
     static IntType variateWaiting(IntType number, double probability, RandGenerator &randGenerator);
     static IntType variateBernoulliSum(IntType number, double probability, RandGenerator &randGenerator);
+    /**
+     * @fn variateTransformedRejection
+     * BTRD algorithm of Hörmann (transformed rejection with decomposition),
+     * requires no precalculated constants and is fast for any large n * p
+     * @param number n
+     * @param probability p ≤ 0.5, such that n * p ≥ 10
+     * @return binomial variate
+     */
+    static IntType variateTransformedRejection(IntType number, double probability, RandGenerator &randGenerator);
 
 public:
     IntType Variate() const override;
@@ -26,6 +26,8 @@ void CategoricalRand<IntType>::SetProbabilities(std::vector<double> &&probabilit
     }
 
     K = prob.size();
+    this->updateTable();
+    this->invalidateMoments();
 }
 
 template < typename IntType >
@@ -47,6 +49,8 @@ double CategoricalRand<IntType>::F(const IntType & k) const
         return 0.0;
     if (k >= K)
         return 1.0;
+    if (this->isInTable(k))
+        return this->tabulatedF(k);
     if (2 * k <= K) {
         double sum = 0.0;
         for (int i = 0; i <= k; ++i)
@@ -59,6 +63,18 @@ double CategoricalRand<IntType>::F(const IntType & k) const
     return sum;
 }
 
+template < typename IntType >
+double CategoricalRand<IntType>::S(const IntType & k) const
+{
+    if (k < 0)
+        return 1.0;
+    if (k >= K)
+        return 0.0;
+    if (this->isInTable(k))
+        return this->tabulatedS(k);
+    return 1.0 - F(k);
+}
+
 template < typename IntType >
 IntType CategoricalRand<IntType>::Variate() const
 {
@@ -97,6 +113,9 @@ IntType CategoricalRand<IntType>::Mode() const
 template < typename IntType >
 IntType CategoricalRand<IntType>::quantileImpl(double p) const
 {
+    IntType k = 0;
+    if (this->tabulatedQuantile(p, k))
+        return k;
     double sum = 0.0;
     for (IntType i = 0; i != K; ++i) {
         sum += prob[i];
@@ -109,6 +128,9 @@ IntType CategoricalRand<IntType>::quantileImpl(double p) const
 template < typename IntType >
 IntType CategoricalRand<IntType>::quantileImpl1m(double p) const
 {
+    IntType k = 0;
+    if (this->tabulatedQuantile1m(p, k))
+        return k;
     double sum = 0;
     for (IntType i = K - 1; i >= 0; --i) {
         sum += prob[i];
@@ -1,5 +1,6 @@
 #include "DiscreteDistribution.h"
 #include "../continuous/GammaRand.h"
+#include "../continuous/UniformRand.h"
 
 template < typename IntType >
 void DiscreteDistribution<IntType>::ProbabilityMassFunction(const std::vector<IntType> &x, std::vector<double> &y) const
@@ -39,6 +40,131 @@ IntType DiscreteDistribution<IntType>::Mode() const
     return x;
 }
 
+template < typename IntType >
+void DiscreteDistribution<IntType>::Tabulate(size_t maxSize)
+{
+    if (!this->isLeftBounded())
+        throw std::invalid_argument("Discrete distribution: tabulated mode is supported only for support bounded from the left");
+    if (maxSize == 0)
+        throw std::invalid_argument("Discrete distribution: size of table should be positive");
+    tabulated = true;
+    maxTableSize = maxSize;
+    updateTable();
+}
+
+template < typename IntType >
+void DiscreteDistribution<IntType>::Untabulate()
+{
+    tabulated = false;
+    cdfTable.clear();
+    cdfTable.shrink_to_fit();
+    sfTable.clear();
+    sfTable.shrink_to_fit();
+    guideTable.clear();
+    guideTable.shrink_to_fit();
+}
+
+template < typename IntType >
+void DiscreteDistribution<IntType>::updateTable()
+{
+    if (!tabulated)
+        return;
+    /// clear tables first, so that F, S and P don't use them
+    cdfTable.clear();
+    sfTable.clear();
+    guideTable.clear();
+
+    IntType minValue = this->MinValue(), maxValue = this->MaxValue();
+    std::vector<double> prob;
+    double cdf = 0.0;
+    IntType k = minValue;
+    bool isComplete = false;
+    while (prob.size() < maxTableSize) {
+        double pk = this->P(k);
+        prob.push_back(pk);
+        cdf += pk;
+        if (k == maxValue) {
+            isComplete = true;
+            break;
+        }
+        /// truncate the table if the tail is negligible
+        if (1.0 - cdf < MIN_POSITIVE || (pk < MIN_POSITIVE && cdf > 0.5))
+            break;
+        ++k;
+    }
+
+    size_t size = prob.size();
+    std::vector<double> cdfValues(size), sfValues(size);
+    double sum = 0.0;
+    for (size_t i = 0; i != size; ++i) {
+        sum += prob[i];
+        cdfValues[i] = std::min(sum, 1.0);
+    }
+    sum = isComplete ? 0.0 : this->S(minValue + size - 1);
+    for (size_t i = size; i-- != 0;) {
+        sfValues[i] = std::min(sum, 1.0);
+        sum += prob[i];
+    }
+    if (isComplete)
+        cdfValues[size - 1] = 1.0;
+
+    /// Chen-Asau guide table
+    std::vector<size_t> guideValues(size);
+    size_t j = 0;
+    for (size_t i = 0; i != size; ++i) {
+        double level = static_cast<double>(i) / size;
+        while (j < size - 1 && cdfValues[j] < level)
+            ++j;
+        guideValues[i] = j;
+    }
+
+    tableMinValue = minValue;
+    cdfTable = std::move(cdfValues);
+    sfTable = std::move(sfValues);
+    guideTable = std::move(guideValues);
+}
+
+template < typename IntType >
+bool DiscreteDistribution<IntType>::isInTable(const IntType & k) const
+{
+    return k >= tableMinValue && static_cast<size_t>(k - tableMinValue) < cdfTable.size();
+}
+
+template < typename IntType >
+bool DiscreteDistribution<IntType>::tabulatedQuantile(double p, IntType & quantile) const
+{
+    if (cdfTable.empty() || p > cdfTable.back())
+        return false;
+    size_t size = cdfTable.size();
+    size_t i = std::min(static_cast<size_t>(p * size), size - 1);
+    size_t j = guideTable[i];
+    while (cdfTable[j] < p)
+        ++j;
+    quantile = tableMinValue + j;
+    return true;
+}
+
+template < typename IntType >
+bool DiscreteDistribution<IntType>::tabulatedQuantile1m(double p, IntType & quantile) const
+{
+    if (sfTable.empty() || p < sfTable.back())
+        return false;
+    auto it = std::partition_point(sfTable.begin(), sfTable.end(), [p] (double sf) { return sf > p; });
+    quantile = tableMinValue + (it - sfTable.begin());
+    return true;
+}
+
+template < typename IntType >
+IntType DiscreteDistribution<IntType>::tabulatedVariate() const
+{
+    double U = UniformRand<double>::StandardVariate(this->localRandGenerator);
+    IntType k = 0;
+    if (tabulatedQuantile(U, k))
+        return k;
+    /// variate is in the truncated tail
+    return this->quantileImpl(U);
+}
+
 template < typename IntType >
 IntType DiscreteDistribution<IntType>::quantileImpl(double p, IntType initValue) const
 {
@@ -63,6 +189,12 @@ IntType DiscreteDistribution<IntType>::quantileImpl(double p, IntType initValue)
 template < typename IntType >
 IntType DiscreteDistribution<IntType>::quantileImpl(double p) const
 {
+    if (!cdfTable.empty()) {
+        IntType k = 0;
+        if (tabulatedQuantile(p, k))
+            return k;
+        return this->quantileImpl(p, tableMinValue + cdfTable.size() - 1);
+    }
     /// We use quantile from sample as an initial guess
     static constexpr int SAMPLE_SIZE = 128;
     static std::vector<IntType> sample(SAMPLE_SIZE);
@@ -98,6 +230,12 @@ IntType DiscreteDistribution<IntType>::quantileImpl1m(double p, IntType initValu
 template < typename IntType >
 IntType DiscreteDistribution<IntType>::quantileImpl1m(double p) const
 {
+    if (!sfTable.empty()) {
+        IntType k = 0;
+        if (tabulatedQuantile1m(p, k))
+            return k;
+        return this->quantileImpl1m(p, tableMinValue + sfTable.size() - 1);
+    }
     /// We use quantile from sample as an initial guess
     static constexpr int SAMPLE_SIZE = 128;
     static std::vector<IntType> sample(SAMPLE_SIZE);
@@ -109,6 +247,82 @@ IntType DiscreteDistribution<IntType>::quantileImpl1m(double p) const
     return this->quantileImpl1m(p, sample[index]);
 }
 
+template < typename IntType >
+void DiscreteDistribution<IntType>::quantileSweepImpl(const std::vector<double> &p, std::vector<IntType> &y, bool isComplement) const
+{
+    int size = std::min(p.size(), y.size());
+    if (!cdfTable.empty()) {
+        for (int i = 0; i != size; ++i)
+            y[i] = isComplement ? this->Quantile1m(p[i]) : this->Quantile(p[i]);
+        return;
+    }
+    /// quantile is the smallest k, such that F(k) >= q (or S(k) <= q), k is the quantile of the last probability in (0, 1),
+    /// the walk goes to the right if probabilities of the left tail increase
+    bool isIncreasing = (p[size - 1] >= p[0]) != isComplement;
+    IntType minVal = this->MinValue(), maxVal = this->MaxValue();
+    /// difference, which doesn't overflow for supports, unbounded from both sides
+    using UnsignedType = std::make_unsigned_t<IntType>;
+    static constexpr UnsignedType MAX_STEP = std::numeric_limits<UnsignedType>::max() / 4;
+    auto distance = [] (IntType a, IntType b) {
+        return static_cast<UnsignedType>(b) - static_cast<UnsignedType>(a);
+    };
+    bool isKnown = false;
+    IntType k = 0;
+    double edge = 0; ///< F(k) (S(k)) if the walk goes to the right and F(k - 1) (S(k - 1)) otherwise
+    for (int i = 0; i != size; ++i) {
+        double q = p[i];
+        if (q <= 0.0 || q >= 1.0) {
+            y[i] = isComplement ? this->Quantile1m(q) : this->Quantile(q);
+            continue;
+        }
+        auto isAbove = [this, q, isComplement] (IntType j) {
+            return isComplement ? this->S(j) <= q : this->F(j) >= q;
+        };
+        IntType root = k;
+        if (!isKnown)
+            root = isComplement ? this->Quantile1m(q) : this->Quantile(q);
+        else if (isIncreasing ? !(isComplement ? edge <= q : edge >= q) : (k != minVal && (isComplement ? edge <= q : edge >= q))) {
+            /// gallop from the previous root and bisect, since steps by one are too slow for heavy tails:
+            /// isAbove(lower) is false and isAbove(upper) is true
+            IntType lower = isIncreasing ? k : k - 1, upper = lower;
+            bool isFound = false;
+            for (UnsignedType step = 1; !isFound; step = (step > MAX_STEP) ? step : 2 * step) {
+                if (isIncreasing) {
+                    lower = upper;
+                    upper = (distance(lower, maxVal) <= step) ? maxVal : lower + step;
+                    isFound = (upper == maxVal) || isAbove(upper);
+                }
+                else {
+                    upper = lower;
+                    lower = (distance(minVal, upper) <= step) ? minVal : upper - step;
+                    isFound = !isAbove(lower);
+                    if (!isFound && lower == minVal) {
+                        upper = lower;
+                        break;
+                    }
+                }
+            }
+            while (distance(lower, upper) > 1) {
+                IntType middle = lower + static_cast<IntType>(distance(lower, upper) / 2);
+                if (isAbove(middle))
+                    upper = middle;
+                else
+                    lower = middle;
+            }
+            root = upper;
+        }
+        if (!isKnown || root != k) {
+            k = root;
+            if (isIncreasing)
+                edge = isComplement ? this->S(k) : this->F(k);
+            else
+                edge = (k == minVal) ? (isComplement ? 1.0 : 0.0) : (isComplement ? this->S(k - 1) : this->F(k - 1));
+            isKnown = true;
+        }
+        y[i] = k;
+    }
+}
+
 template < typename IntType >
 long double DiscreteDistribution<IntType>::ExpectedValue(const std::function<double (IntType)> &funPtr, IntType minPoint, IntType maxPoint) const
 {
@@ -136,6 +350,42 @@ long double DiscreteDistribution<IntType>::ExpectedValue(const std::function<dou
     return sum;
 }
 
+template < typename IntType >
+std::vector<long double> DiscreteDistribution<IntType>::ExpectedValues(const std::vector<std::function<double (IntType)>> &funPtrs, IntType minPoint, IntType maxPoint) const
+{
+    SUPPORT_TYPE suppType = this->SupportType();
+    IntType k = minPoint, upperBoundary = maxPoint;
+    if (suppType == FINITE_T || suppType == RIGHTSEMIFINITE_T) {
+        k = std::max(k, this->MinValue());
+    }
+    if (suppType == FINITE_T || suppType == LEFTSEMIFINITE_T) {
+        upperBoundary = std::min(upperBoundary, this->MaxValue());
+    }
+
+    size_t size = funPtrs.size();
+    std::vector<long double> sums(size, 0.0);
+    if (size == 0)
+        return sums;
+    std::vector<double> addons(size);
+    do {
+        bool isZero = true;
+        for (size_t i = 0; i != size; ++i) {
+            addons[i] = funPtrs[i](k);
+            isZero = isZero && (addons[i] == 0.0);
+        }
+        if (!isZero) {
+            /// probability is calculated once for all of the functions
+            double prob = this->P(k);
+            if (prob < MIN_POSITIVE)
+                return sums;
+            for (size_t i = 0; i != size; ++i)
+                sums[i] += addons[i] * prob;
+        }
+        ++k;
+    } while (k <= upperBoundary);
+    return sums;
+}
+
 template < typename IntType >
 double DiscreteDistribution<IntType>::Hazard(const IntType &x) const
 {
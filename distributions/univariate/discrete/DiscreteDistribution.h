@@ -13,6 +13,13 @@ class RANDLIBSHARED_EXPORT DiscreteDistribution : virtual public UnivariateDistr
 {
     static_assert(std::is_integral_v<IntType> && std::is_signed_v<IntType>, "Discrete distribution supports only signed integral types");
 
+    bool tabulated = false; ///< true if tabulated mode is switched on
+    size_t maxTableSize = 0; ///< maximal number of tabulated values
+    IntType tableMinValue = 0; ///< value, which corresponds to the first element of tables
+    std::vector<double> cdfTable{}; ///< F(k) for k = tableMinValue, tableMinValue + 1, ...
+    std::vector<double> sfTable{}; ///< S(k) for k = tableMinValue, tableMinValue + 1, ...
+    std::vector<size_t> guideTable{}; ///< Chen-Asau guide table: i-th element is the smallest index j such that cdfTable[j] >= i / size
+
 protected:
     DiscreteDistribution() {}
     virtual ~DiscreteDistribution() {}
@@ -38,7 +45,7 @@ public:
      * @param x
      * @param y
      */
-    void ProbabilityMassFunction(const std::vector<IntType> &x, std::vector<double> &y) const;
+    virtual void ProbabilityMassFunction(const std::vector<IntType> &x, std::vector<double> &y) const;
 
     /**
      * @fn LogProbabilityMassFunction
@@ -46,16 +53,101 @@ public:
      * @param x
      * @param y
      */
-    void LogProbabilityMassFunction(const std::vector<IntType> &x, std::vector<double> &y) const;
+    virtual void LogProbabilityMassFunction(const std::vector<IntType> &x, std::vector<double> &y) const;
 
     IntType Mode() const override;
 
+    /**
+     * @fn IsTabulated
+     * @return true if tabulated mode is switched on
+     */
+    inline bool IsTabulated() const { return tabulated; }
+
 protected:
+    /**
+     * @fn Tabulate
+     * Switch on tabulated mode: cumulative probabilities are calculated once and stored,
+     * so that F and S are calculated in O(1) time and variates are generated
+     * by guide table inversion (Chen-Asau) in O(1) expected time.
+     * For large or unbounded support tables are truncated at maxSize values
+     * or when tail probability becomes negligible.
+     * Tables are rebuilt each time parameters are changed, therefore it is exposed
+     * only by distributions, whose setters call updateTable().
+     * Supported by distributions with support bounded from the left
+     * @param maxSize maximal number of tabulated values
+     */
+    void Tabulate(size_t maxSize = 1 << 20);
+
+    /**
+     * @fn Untabulate
+     * switch off tabulated mode and free the tables
+     */
+    void Untabulate();
+
+    /**
+     * @fn updateTable
+     * rebuild tables if tabulated mode is switched on, should be called after parameters are changed
+     */
+    void updateTable();
+
+    /**
+     * @fn isInTable
+     * @param k
+     * @return true if F(k) and S(k) are tabulated
+     */
+    bool isInTable(const IntType & k) const;
+
+    /**
+     * @fn tabulatedF
+     * @param k value, for which isInTable(k) is true
+     * @return F(k) from the table
+     */
+    inline double tabulatedF(const IntType & k) const { return cdfTable[k - tableMinValue]; }
+
+    /**
+     * @fn tabulatedS
+     * @param k value, for which isInTable(k) is true
+     * @return S(k) from the table
+     */
+    inline double tabulatedS(const IntType & k) const { return sfTable[k - tableMinValue]; }
+
+    /**
+     * @fn tabulatedQuantile
+     * @param p
+     * @param quantile such minimal k that F(k) >= p
+     * @return true if quantile is in the table
+     */
+    bool tabulatedQuantile(double p, IntType & quantile) const;
+
+    /**
+     * @fn tabulatedQuantile1m
+     * @param p
+     * @param quantile such minimal k that S(k) <= p
+     * @return true if quantile is in the table
+     */
+    bool tabulatedQuantile1m(double p, IntType & quantile) const;
+
+    /**
+     * @fn tabulatedVariate
+     * @return random variate, generated by guide table inversion
+     */
+    IntType tabulatedVariate() const;
+
     IntType quantileImpl(double p, IntType initValue) const override;
     IntType quantileImpl(double p) const override;
     IntType quantileImpl1m(double p, IntType initValue) const override;
     IntType quantileImpl1m(double p) const override;
+
+    /**
+     * @fn quantileSweepImpl
+     * fill y with quantiles of monotone sequence p by a single walk through the cdf
+     * @param p
+     * @param y
+     * @param isComplement true if p are probabilities of the right tail
+     */
+    void quantileSweepImpl(const std::vector<double> &p, std::vector<IntType> &y, bool isComplement) const override;
     long double ExpectedValue(const std::function<double (IntType)> &funPtr, IntType minPoint, IntType maxPoint) const override;
+    std::vector<long double> ExpectedValues(const std::vector<std::function<double (IntType)>> &funPtrs, IntType minPoint, IntType maxPoint) const override;
 
 public:
     /**
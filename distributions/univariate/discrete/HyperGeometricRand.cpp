@@ -34,6 +34,7 @@ void HyperGeometricRand<IntType>::SetParameters(IntType totalSize, IntType draws
     pmfCoef += RandMath::lfact(N - n);
     pmfCoef += RandMath::lfact(n);
     pmfCoef -= RandMath::lfact(N);
+    this->updateTable();
 }
 
 template < typename IntType >
@@ -62,6 +63,8 @@ double HyperGeometricRand<IntType>::F(const IntType & k) const
     IntType maxVal = MaxValue();
     if (k >= maxVal)
         return 1.0;
+    if (this->isInTable(k))
+        return this->tabulatedF(k);
     if (k <= 0.5 * maxVal) {
         /// sum P(X = i) going forward until k
         double sum = 0;
@@ -76,9 +79,23 @@ double HyperGeometricRand<IntType>::F(const IntType & k) const
     return sum;
 }
 
+template < typename IntType >
+double HyperGeometricRand<IntType>::S(const IntType & k) const
+{
+    if (k < MinValue())
+        return 1.0;
+    if (k >= MaxValue())
+        return 0.0;
+    if (this->isInTable(k))
+        return this->tabulatedS(k);
+    return 1.0 - F(k);
+}
+
 template < typename IntType >
 IntType HyperGeometricRand<IntType>::Variate() const
 {
+    if (this->IsTabulated())
+        return this->tabulatedVariate();
     double p = p0;
     IntType sum = 0;
     for (int i = 1; i <= n; ++i)
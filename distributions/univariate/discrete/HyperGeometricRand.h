@@ -32,9 +32,13 @@ public:
     inline IntType GetDrawsNum() { return n; }
     inline IntType GetSuccessesNum() { return K; }
 
+    using DiscreteDistribution<IntType>::Tabulate;
+    using DiscreteDistribution<IntType>::Untabulate;
+
     double P(const IntType & k) const override;
     double logP(const IntType & k) const override;
     double F(const IntType & k) const override;
+    double S(const IntType & k) const override;
     IntType Variate() const override;
 
     long double Mean() const override;
@@ -21,6 +21,8 @@ void LogarithmicRand<IntType>::SetProbability(double probability)
     p = probability;
     logProb = std::log(p);
     log1mProb = std::log1pl(-p);
+    this->updateTable();
+    this->invalidateMoments();
 }
 
 template < typename IntType >
@@ -38,7 +40,7 @@ double LogarithmicRand<IntType>::logP(const IntType & k) const
 template < typename IntType >
 double LogarithmicRand<IntType>::betaFun(IntType a) const
 {
-    double denom = a + 1;
+    double denom = a + 2;
     double sum = p * p / (a + 2) + p / (a + 1) + 1.0 / a;
     double add = 1;
     int i = 3;
@@ -53,18 +55,28 @@ double LogarithmicRand<IntType>::betaFun(IntType a) const
 template < typename IntType >
 double LogarithmicRand<IntType>::F(const IntType & k) const
 {
-    return (k < 1) ? 0.0 : 1 + betaFun(k + 1) / log1mProb;
+    if (k < 1)
+        return 0.0;
+    if (this->isInTable(k))
+        return this->tabulatedF(k);
+    return 1 + betaFun(k + 1) / log1mProb;
 }
 
 template < typename IntType >
 double LogarithmicRand<IntType>::S(const IntType & k) const
 {
-    return (k < 1) ? 1.0 : -betaFun(k + 1) / log1mProb;
+    if (k < 1)
+        return 1.0;
+    if (this->isInTable(k))
+        return this->tabulatedS(k);
+    return -betaFun(k + 1) / log1mProb;
 }
 
 template < typename IntType >
 IntType LogarithmicRand<IntType>::Variate() const
 {
+    if (this->IsTabulated())
+        return this->tabulatedVariate();
     /// Kemp's second accelerated generator
     /// p. 548, "Non-Uniform Random Variate Generation" by Luc Devroye
     float V = UniformRand<float>::StandardVariate(this->localRandGenerator);
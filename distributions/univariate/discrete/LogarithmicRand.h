@@ -27,6 +27,9 @@ public:
     void SetProbability(double probability);
     inline double GetProbability() const { return p; }
 
+    using DiscreteDistribution<IntType>::Tabulate;
+    using DiscreteDistribution<IntType>::Untabulate;
+
     double P(const IntType & k) const override;
     double logP(const IntType & k) const override;
 private:
@@ -34,6 +34,8 @@ void NegativeHyperGeometricRand<IntType>::SetParameters(IntType totalSize, IntTy
     pmfCoef -= RandMath::lfact(m - 1);
     pmfCoef -= RandMath::lfact(M - m);
     pmfCoef -= RandMath::lfact(N);
+    this->updateTable();
+    this->invalidateMoments();
 }
 
 template < typename IntType >
@@ -63,6 +65,8 @@ double NegativeHyperGeometricRand<IntType>::F(const IntType &k) const
     IntType maxVal = MaxValue();
     if (k >= maxVal)
         return 1.0;
+    if (this->isInTable(k))
+        return this->tabulatedF(k);
     if (k <= 0.5 * maxVal) {
         /// sum P(X = i) going forward until k
         double sum = 0;
@@ -77,9 +81,23 @@ double NegativeHyperGeometricRand<IntType>::F(const IntType &k) const
     return sum;
 }
 
+template < typename IntType >
+double NegativeHyperGeometricRand<IntType>::S(const IntType & k) const
+{
+    if (k < MinValue())
+        return 1.0;
+    if (k >= MaxValue())
+        return 0.0;
+    if (this->isInTable(k))
+        return this->tabulatedS(k);
+    return 1.0 - F(k);
+}
+
 template < typename IntType >
 IntType NegativeHyperGeometricRand<IntType>::Variate() const
 {
+    if (this->IsTabulated())
+        return this->tabulatedVariate();
     double p = p0;
     IntType successesNum = 0;
     IntType num = 0;
@@ -31,9 +31,13 @@ public:
     inline IntType GetTotalSuccessesNum() { return M; }
     inline IntType GetLimitSuccessesNum() { return m; }
 
+    using DiscreteDistribution<IntType>::Tabulate;
+    using DiscreteDistribution<IntType>::Untabulate;
+
     double P(const IntType & k) const override;
     double logP(const IntType & k) const override;
     double F(const IntType & k) const override;
+    double S(const IntType & k) const override;
     IntType Variate() const override;
 
     long double Mean() const override;
@@ -73,6 +73,18 @@ double PoissonRand<IntType>::SourceToNatural(double sourceParameters) const
     return std::log(sourceParameters);
 }
 
+template < typename IntType >
+double PoissonRand<IntType>::NaturalToSource(double theta) const
+{
+    return std::exp(theta);
+}
+
+template < typename IntType >
+void PoissonRand<IntType>::SetSourceParameters(double rate)
+{
+    SetRate(rate);
+}
+
 template < typename IntType >
 double PoissonRand<IntType>::NaturalParameters() const
 {
@@ -118,6 +130,34 @@ double PoissonRand<IntType>::logP(const IntType & k) const
     return y - RandMath::lfact(k);
 }
 
+template < typename IntType >
+void PoissonRand<IntType>::LogProbabilityMassFunction(const std::vector<IntType> &x, std::vector<double> &y) const
+{
+    /// log(k!) is cached for small values, which are repeated in the most of samples
+    static constexpr IntType CACHE_SIZE = 256;
+    std::array<double, CACHE_SIZE> lfactCache;
+    IntType cached = 0;
+    for (size_t i = 0; i != x.size(); ++i) {
+        IntType k = x[i];
+        if (k < 0) {
+            y[i] = -INFINITY;
+            continue;
+        }
+        double lfact = 0;
+        if (k < CACHE_SIZE) {
+            while (cached <= k) {
+                lfactCache[cached] = RandMath::lfact(cached);
+                ++cached;
+            }
+            lfact = lfactCache[k];
+        }
+        else {
+            lfact = RandMath::lfact(k);
+        }
+        y[i] = k * logLambda - lambda - lfact;
+    }
+}
+
 template < typename IntType >
 double PoissonRand<IntType>::F(const IntType & k) const
 {
@@ -44,6 +44,8 @@ public:
     double SufficientStatistic(IntType x) const override;
     double SourceParameters() const override;
     double SourceToNatural(double sourceParameters) const override;
+    double NaturalToSource(double theta) const override;
+    void SetSourceParameters(double rate) override;
     double NaturalParameters() const override;
     double LogNormalizer(double theta) const override;
     double LogNormalizerGradient(double theta) const override;
@@ -52,6 +54,7 @@ public:
     double EntropyAdjusted() const override;
 
     double logP(const IntType &k) const override;
+    void LogProbabilityMassFunction(const std::vector<IntType> &x, std::vector<double> &y) const override;
     double F(const IntType & k) const override;
     double S(const IntType & k) const override;
 
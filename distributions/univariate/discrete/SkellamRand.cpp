@@ -48,13 +48,13 @@ double SkellamRand<IntType>::logP(const IntType & k) const
 template < typename IntType >
 double SkellamRand<IntType>::F(const IntType & k) const
 {
-    return (k < 0) ? RandMath::MarcumP(-k, mu1, mu2, sqrtMu1, sqrtMu2, logMu1, logMu2) : RandMath::MarcumQ(k + 1, mu2, mu1, sqrtMu2, sqrtMu1, logMu2, logMu1);
+    return (k < 0) ? RandMath::MarcumP(-k, mu1, mu2, logMu2) : RandMath::MarcumQ(k + 1, mu2, mu1, logMu1);
 }
 
 template < typename IntType >
 double SkellamRand<IntType>::S(const IntType & k) const
 {
-    return (k < 0) ? RandMath::MarcumQ(-k, mu1, mu2, sqrtMu1, sqrtMu2, logMu1, logMu2) : RandMath::MarcumP(k + 1, mu2, mu1, sqrtMu2, sqrtMu1, logMu2, logMu1);
+    return (k < 0) ? RandMath::MarcumQ(-k, mu1, mu2, logMu2) : RandMath::MarcumP(k + 1, mu2, mu1, logMu1);
 }
 
 template < typename IntType >
@@ -14,7 +14,6 @@ String ZetaRand<IntType>::Name() const
     return "Zeta(" + this->toStringWithPrecision(GetExponent()) + ")";
 }
 
-#if HAVE_MATH_SPECIAL_FUNCTIONS
 template < typename IntType >
 void ZetaRand<IntType>::SetExponent(double exponent)
 {
@@ -22,18 +21,10 @@ void ZetaRand<IntType>::SetExponent(double exponent)
         throw std::invalid_argument("Zeta distribution: exponent should be greater than 1, but it's equal to " + std::to_string(exponent));
     s = exponent;
     sm1 = s - 1.0;
-    zetaS = std::riemann_zetal(s);
+    zetaS = RandMath::riemannZeta(s);
     logZetaS = std::log(zetaS);
     b = -std::expm1l(-sm1 * M_LN2);
 }
-#else
-template<typename IntType>
-void ZetaRand<IntType>::SetExponent(double exponent)
-{
-    throw std::runtime_error("RandLib compiler does not support math special functions");
-}
-
-#endif
 
 template < typename IntType >
 double ZetaRand<IntType>::logP(const IntType & k) const
@@ -47,6 +38,13 @@ double ZetaRand<IntType>::F(const IntType & k) const
     return (k < 1) ? 0.0 : RandMath::harmonicNumber(s, k) / zetaS;
 }
 
+template < typename IntType >
+double ZetaRand<IntType>::S(const IntType & k) const
+{
+    /// P(X > k) = ζ(s, k + 1) / ζ(s)
+    return (k < 1) ? 1.0 : RandMath::hurwitzZeta(s, k + 1.0) / zetaS;
+}
+
 template < typename IntType >
 IntType ZetaRand<IntType>::Variate() const
 {
@@ -73,35 +71,21 @@ IntType ZetaRand<IntType>::Variate() const
     throw std::runtime_error("Zeta distribution: sampling failed");
 }
 
-#if HAVE_MATH_SPECIAL_FUNCTIONS
 template < typename IntType >
 long double ZetaRand<IntType>::Mean() const
 {
-    return (s > 2) ? std::riemann_zetal(sm1) / zetaS : INFINITY;
+    return (s > 2) ? RandMath::riemannZeta(sm1) / zetaS : INFINITY;
 }
 
-
 template < typename IntType >
 long double ZetaRand<IntType>::Variance() const
 {
     if (s <= 3)
         return INFINITY;
     double y = Mean();
-    double z = std::riemann_zetal(s - 2) / zetaS;
+    double z = RandMath::riemannZeta(s - 2) / zetaS;
     return z - y * y;
 }
-#else
-template<typename IntType>
-long double ZetaRand<IntType>::Mean() const
-{
-    throw std::runtime_error("RandLib compiler does not support math special functions");
-}
-template<typename IntType>
-long double ZetaRand<IntType>::Variance() const
-{
-    throw std::runtime_error("RandLib compiler does not support math special functions");
-}
-#endif
 
 template < typename IntType >
 IntType ZetaRand<IntType>::Mode() const
@@ -109,15 +93,14 @@ IntType ZetaRand<IntType>::Mode() const
     return 1;
 }
 
-#if HAVE_MATH_SPECIAL_FUNCTIONS
 template < typename IntType >
 long double ZetaRand<IntType>::Skewness() const
 {
     if (s <= 4)
         return INFINITY;
-    long double z1 = std::riemann_zetal(sm1), z1Sq = z1 * z1;
-    long double z2 = std::riemann_zetal(s - 2);
-    long double z3 = std::riemann_zetal(s - 3);
+    long double z1 = RandMath::riemannZeta(sm1), z1Sq = z1 * z1;
+    long double z2 = RandMath::riemannZeta(s - 2);
+    long double z3 = RandMath::riemannZeta(s - 3);
     long double z = zetaS, zSq = z * z;
     long double logskew = zSq * z3;
     logskew -= 3 * z2 * z1 * z;
@@ -127,13 +110,7 @@ long double ZetaRand<IntType>::Skewness() const
     logskew -= 2 * logZetaS;
     return std::exp(logskew);
 }
-#else
-template<typename IntType>
-long double ZetaRand<IntType>::Skewness() const
-{
-    throw std::runtime_error("RandLib compiler does not support math special functions");
-}
-#endif
+
 template < typename IntType >
 long double ZetaRand<IntType>::ExcessKurtosis() const
 {
@@ -150,19 +127,43 @@ long double ZetaRand<IntType>::ExcessKurtosis() const
     return numerator / denominator - 3.0;
 }
 
-#if HAVE_MATH_SPECIAL_FUNCTIONS
 template < typename IntType >
 long double ZetaRand<IntType>::Moment(int n) const
 {
-    return (s > n + 1) ? std::riemann_zetal(s - n) / zetaS : INFINITY;
+    return (s > n + 1) ? RandMath::riemannZeta(s - n) / zetaS : INFINITY;
 }
-#else
-template<typename IntType>
-long double ZetaRand<IntType>::Moment(int n) const
+
+template < typename IntType >
+IntType ZetaRand<IntType>::quantileGuess(double q) const
 {
-    throw std::runtime_error("RandLib compiler does not support math special functions");
+    /// P(X > k) = ζ(s, k + 1) / ζ(s) ~ (k + 0.5)^(1 - s) / ((s - 1) ζ(s))
+    double logK = -std::log(sm1 * zetaS * q) / sm1;
+    double k = std::exp(logK) - 0.5;
+    if (k < 1.0)
+        return 1;
+    return (k < this->MaxValue()) ? (IntType)k : this->MaxValue();
 }
-#endif
+
+template < typename IntType >
+IntType ZetaRand<IntType>::quantileImpl(double p) const
+{
+    IntType guess = quantileGuess(1.0 - p);
+    /// quantile can't be represented by IntType
+    if (guess == this->MaxValue())
+        return guess;
+    return DiscreteDistribution<IntType>::quantileImpl(p, guess);
+}
+
+template < typename IntType >
+IntType ZetaRand<IntType>::quantileImpl1m(double p) const
+{
+    IntType guess = quantileGuess(p);
+    /// quantile can't be represented by IntType
+    if (guess == this->MaxValue())
+        return guess;
+    return DiscreteDistribution<IntType>::quantileImpl1m(p, guess);
+}
+
 template class ZetaRand<int>;
 template class ZetaRand<long int>;
 template class ZetaRand<long long int>;
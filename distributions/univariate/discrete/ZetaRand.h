@@ -33,6 +33,7 @@ public:
 
     double logP(const IntType & k) const override;
     double F(const IntType & k) const override;
+    double S(const IntType & k) const override;
     IntType Variate() const override;
 
     long double Mean() const override;
@@ -46,6 +47,17 @@ public:
 
     inline long double GetZetaFunction() const { return zetaS; }
     inline long double GetLogZetaFunction() const { return logZetaS; }
+
+private:
+    /**
+     * @fn quantileGuess
+     * @param q
+     * @return initial guess for such k that P(X > k) = q, based on asymptotic of Hurwitz zeta function
+     */
+    IntType quantileGuess(double q) const;
+
+    IntType quantileImpl(double p) const override;
+    IntType quantileImpl1m(double p) const override;
 };
 
 #endif // ZETARAND_H
@@ -28,17 +28,35 @@ void ZipfRand<IntType>::SetParameters(double exponent, IntType number)
 
     invHarmonicNumber = 1.0 / RandMath::harmonicNumber(s, n);
 
-    // WARNING: we calculate pow here and in invHarmonic number
-    hashedVarNum = n > tableSize ? tableSize : n;
-    table[0] = 1.0;
-    for (int i = 1; i < hashedVarNum - 1; ++i)
-        table[i] = table[i - 1] + std::pow(i + 1, -s);
-    if (hashedVarNum == n)
-        table[hashedVarNum - 1] = 1.0 / invHarmonicNumber;
-    else
-        table[hashedVarNum - 1] = table[hashedVarNum - 2] + std::pow(hashedVarNum, -s);
-    for (int i = 0; i < hashedVarNum; ++i)
-        table[i] *= invHarmonicNumber;
+    hIntegralX1 = hIntegral(1.5) - 1.0;
+    hIntegralN = hIntegral(n + 0.5);
+    squeeze = 2.0 - hIntegralInverse(hIntegral(2.5) - h(2));
+    this->updateTable();
+}
+
+template < typename IntType >
+double ZipfRand<IntType>::h(double x) const
+{
+    return std::exp(-s * std::log(x));
+}
+
+template < typename IntType >
+double ZipfRand<IntType>::hIntegral(double x) const
+{
+    /// (x^{1-s} - 1) / (1 - s) = log(x) * (exp(y) - 1) / y, where y = (1 - s) * log(x)
+    double logX = std::log(x);
+    double y = (1.0 - s) * logX;
+    return (std::fabs(y) > 1e-8) ? logX * std::expm1(y) / y : logX * (1.0 + 0.5 * y);
+}
+
+template < typename IntType >
+double ZipfRand<IntType>::hIntegralInverse(double x) const
+{
+    /// (1 + (1 - s) * x)^{1 / (1 - s)} = exp(x * log(1 + t) / t), where t = (1 - s) * x
+    double t = x * (1.0 - s);
+    if (t < -1.0)
+        t = -1.0;
+    return std::exp((std::fabs(t) > 1e-8) ? x * std::log1p(t) / t : x * (1.0 - 0.5 * t));
 }
 
 template < typename IntType >
@@ -60,28 +78,77 @@ double ZipfRand<IntType>::F(const IntType & k) const
         return 0.0;
     if (k >= n)
         return 1.0;
+    if (this->isInTable(k))
+        return this->tabulatedF(k);
     return RandMath::harmonicNumber(s, k) * invHarmonicNumber;
 }
 
+template < typename IntType >
+double ZipfRand<IntType>::S(const IntType & k) const
+{
+    if (k < 1.0)
+        return 1.0;
+    if (k >= n)
+        return 0.0;
+    if (this->isInTable(k))
+        return this->tabulatedS(k);
+    /// sum_{i=k+1}^{n} i^{-s} is evaluated as a finite sum, since ζ(s, k + 1) - ζ(s, n + 1) cancels for k close to n
+    return RandMath::zetaPartialSum(s, k + 1, n) * invHarmonicNumber;
+}
+
 template < typename IntType >
 IntType ZipfRand<IntType>::Variate() const
 {
-    double U = UniformRand<double>::StandardVariate(this->localRandGenerator);
-    int k = 1;
-    /// if we didn't manage to hash values for such U
-    if (U > table[hashedVarNum - 1]) {
-        k = hashedVarNum;
-        double sum = table[hashedVarNum - 1];
-        do {
-            ++k;
-            sum += std::pow(k, -s) * invHarmonicNumber;
-        } while (sum < U);
-    }
-    else {
-        while (k <= hashedVarNum && table[k - 1] < U)
-            ++k;
-    }
-    return k;
+    if (this->IsTabulated())
+        return this->tabulatedVariate();
+    /// Rejection-inversion method of Hörmann and Derflinger,
+    /// which requires O(1) setup and O(1) expected time
+    /// regardless of the value of n
+    size_t iter = 0;
+    do {
+        double U = UniformRand<double>::StandardVariate(this->localRandGenerator);
+        double u = hIntegralN + U * (hIntegralX1 - hIntegralN);
+        double x = hIntegralInverse(u);
+        double kDouble = std::round(x);
+        if (kDouble < 1.0)
+            kDouble = 1.0;
+        else if (kDouble > n)
+            kDouble = n;
+        if (kDouble - x <= squeeze || u >= hIntegral(kDouble + 0.5) - h(kDouble))
+            return kDouble;
+    } while (++iter <= ProbabilityDistribution<IntType>::MAX_ITER_REJECTION);
+    throw std::runtime_error("Zipf distribution: sampling failed");
+}
+
+template < typename IntType >
+IntType ZipfRand<IntType>::quantileGuess(double q) const
+{
+    /// sum_{i=k+1}^{n} i^{-s} = ζ(s, k + 1) - ζ(s, n + 1),
+    /// where ζ(s, k + 1) ~ (k + 0.5)^(1 - s) / (s - 1)
+    double tail = q / invHarmonicNumber + RandMath::hurwitzZeta(s, n + 1.0);
+    double sm1 = s - 1.0;
+    double k = std::exp(-std::log(sm1 * tail) / sm1) - 0.5;
+    if (k < 1.0)
+        return 1;
+    return (k < n) ? (IntType)k : n;
+}
+
+template < typename IntType >
+IntType ZipfRand<IntType>::quantileImpl(double p) const
+{
+    IntType k = 0;
+    if (this->tabulatedQuantile(p, k))
+        return k;
+    return DiscreteDistribution<IntType>::quantileImpl(p, quantileGuess(1.0 - p));
+}
+
+template < typename IntType >
+IntType ZipfRand<IntType>::quantileImpl1m(double p) const
+{
+    IntType k = 0;
+    if (this->tabulatedQuantile1m(p, k))
+        return k;
+    return DiscreteDistribution<IntType>::quantileImpl1m(p, quantileGuess(p));
 }
 
 template < typename IntType >
@@ -109,7 +176,7 @@ template < typename IntType >
 std::complex<double> ZipfRand<IntType>::CFImpl(double t) const
 {
     std::complex<double> sum(0.0, 0.0);
-    for (int i = 1; i <= n; ++i)
+    for (IntType i = 1; i <= n; ++i)
     {
         std::complex<double> addon(-s * std::log(i), i * t);
         sum += std::exp(addon);
@@ -17,9 +17,10 @@ class RANDLIBSHARED_EXPORT ZipfRand : public DiscreteDistribution<IntType>
     IntType n = 1; ///< number
     double invHarmonicNumber = 1; /// 1 / H(s, n)
 
-    static constexpr int tableSize = 16;
-    int hashedVarNum = 1;
-    double table[tableSize];
+    /// constants for rejection-inversion sampling
+    double hIntegralX1 = 0; ///< H(1.5) - 1
+    double hIntegralN = 0; ///< H(n + 0.5)
+    double squeeze = 0; ///< 2 - H^{-1}(H(2.5) - h(2))
 
 public:
     ZipfRand(double exponent = 2.0, IntType number = 1);
@@ -33,9 +34,13 @@ public:
     inline double GetExponent() const { return s; }
     inline IntType GetNumber() const { return n; }
 
+    using DiscreteDistribution<IntType>::Tabulate;
+    using DiscreteDistribution<IntType>::Untabulate;
+
     double P(const IntType & k) const override;
     double logP(const IntType & k) const override;
     double F(const IntType & k) const override;
+    double S(const IntType & k) const override;
     IntType Variate() const override;
 
     long double Mean() const override;
@@ -45,6 +50,37 @@ public:
     long double ExcessKurtosis() const override;
 
 private:
+    /**
+     * @fn h
+     * @param x
+     * @return x^{-s}
+     */
+    double h(double x) const;
+
+    /**
+     * @fn hIntegral
+     * @param x
+     * @return H(x) = (x^{1-s} - 1) / (1 - s), antiderivative of h
+     */
+    double hIntegral(double x) const;
+
+    /**
+     * @fn hIntegralInverse
+     * @param x
+     * @return H^{-1}(x)
+     */
+    double hIntegralInverse(double x) const;
+
+    /**
+     * @fn quantileGuess
+     * @param q
+     * @return initial guess for such k that P(X > k) = q, based on asymptotic of Hurwitz zeta function
+     */
+    IntType quantileGuess(double q) const;
+
+    IntType quantileImpl(double p) const override;
+    IntType quantileImpl1m(double p) const override;
+
     std::complex<double> CFImpl(double t) const override;
 };
 
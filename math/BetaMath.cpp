@@ -1,4 +1,5 @@
 #include "BetaMath.h"
+#include "NumericMath.h"
 
 namespace RandMath {
 
@@ -7,8 +8,9 @@ long double logBeta(long double a, long double b)
 {
     if (a <= 0 || b <= 0)
         throw std::invalid_argument("Parameters (a, b) of beta function should be both positive");
-    double beta = std::betal(a, b);
-    if (std::isfinite(beta))
+    /// beta function underflows for large parameters, then logarithms of gamma functions are used
+    long double beta = std::betal(a, b);
+    if (std::isfinite(beta) && beta > 0)
         return std::log(beta);
     double apb = a + b;
     int roundA = std::round(a), roundB = std::round(b);
@@ -169,4 +171,476 @@ double ibeta(double x, double a, double b)
     return ibeta(x, a, b, logBetaFun, logX, log1mX);
 }
 
+/**
+ * @fn ibetaPowerSeries1
+ * power series #1 of I(x, a, b) for a batch of arguments
+ * @param x
+ * @param logX log(x)
+ * @param log1mX log(1-x)
+ * @param a
+ * @param b
+ * @param logBetaFun log(B(a, b))
+ * @param y output vector
+ */
+void ibetaPowerSeries1(const std::vector<double> &x, const std::vector<double> &logX, const std::vector<double> &log1mX,
+                       double a, double b, double logBetaFun, std::vector<double> &y)
+{
+    size_t size = x.size();
+    std::vector<double> u(size), addon(size, 1.0), sum(size, 0.0);
+    for (size_t i = 0; i < size; ++i) {
+        /// avoid underflow
+        u[i] = (x[i] > 1e-5) ? -x[i] / (1.0 - x[i]) : -std::exp(logX[i] - log1mX[i]);
+    }
+    /// all series are summed up at once, converged ones are dropped from the active set
+    std::vector<size_t> active(size);
+    std::iota(active.begin(), active.end(), 0);
+    for (int n = 1; !active.empty(); ++n) {
+        double coef = (n - b) / (a + n);
+        size_t activeSize = 0;
+        for (size_t i : active) {
+            addon[i] *= coef * u[i];
+            sum[i] += addon[i];
+            if (std::fabs(addon[i]) > MIN_POSITIVE * std::fabs(sum[i]))
+                active[activeSize++] = i;
+        }
+        active.resize(activeSize);
+    }
+    for (size_t i = 0; i < size; ++i) {
+        double logY = a * logX[i] + (b - 1) * log1mX[i] - logBetaFun + std::log1p(sum[i]);
+        y[i] = std::exp(logY) / a;
+    }
+}
+
+/**
+ * @fn ibetaContinuedFraction1
+ * equivalent continued fraction #1 of I(x, a, b) for a batch of arguments
+ * @param x
+ * @param logX log(x)
+ * @param log1mX log(1-x)
+ * @param a
+ * @param b
+ * @param number amount of terms
+ * @param logBetaFun log(B(a, b))
+ * @param y output vector
+ */
+void ibetaContinuedFraction1(const std::vector<double> &x, const std::vector<double> &logX, const std::vector<double> &log1mX,
+                             double a, double b, int number, double logBetaFun, std::vector<double> &y)
+{
+    size_t size = x.size();
+    std::vector<double> u(size), frac(size, 0.0);
+    for (size_t i = 0; i < size; ++i) {
+        /// avoid underflow
+        u[i] = (x[i] > 1e-5) ? x[i] / (1.0 - x[i]) : std::exp(logX[i] - log1mX[i]);
+    }
+    for (int n = number; n > 1; --n) {
+        double coef = (b - n + 1) / (a + n - 1);
+        for (size_t i = 0; i < size; ++i) {
+            double cn = coef * u[i];
+            frac[i] = cn / (1 + cn - frac[i]);
+        }
+    }
+    double c1 = b / a;
+    for (size_t i = 0; i < size; ++i) {
+        double F = c1 / (1 + c1 - frac[i]);
+        double logY = a * logX[i] + (b - 1) * log1mX[i] - logBetaFun;
+        y[i] = std::exp(logY) / b * F / (1.0 - F);
+    }
+}
+
+/**
+ * @fn ibetaPowerSeries2
+ * power series #2 of I(x, a, b) for a batch of arguments
+ * @param x
+ * @param logX log(x)
+ * @param log1mX log(1-x)
+ * @param a
+ * @param b
+ * @param logBetaFun log(B(a, b))
+ * @param y output vector
+ */
+void ibetaPowerSeries2(const std::vector<double> &x, const std::vector<double> &logX, const std::vector<double> &log1mX,
+                       double a, double b, double logBetaFun, std::vector<double> &y)
+{
+    size_t size = x.size();
+    std::vector<double> addon(size, 1.0), sum(size, 0.0);
+    /// all series are summed up at once, converged ones are dropped from the active set
+    std::vector<size_t> active(size);
+    std::iota(active.begin(), active.end(), 0);
+    for (int n = 0; !active.empty(); ++n) {
+        double coef = (n + a + b) / (a + n + 1);
+        size_t activeSize = 0;
+        for (size_t i : active) {
+            addon[i] *= coef * x[i];
+            sum[i] += addon[i];
+            if (std::fabs(addon[i]) > MIN_POSITIVE * std::fabs(sum[i]))
+                active[activeSize++] = i;
+        }
+        active.resize(activeSize);
+    }
+    for (size_t i = 0; i < size; ++i) {
+        double logY = a * logX[i] + b * log1mX[i] - logBetaFun + std::log1p(sum[i]);
+        y[i] = std::exp(logY) / a;
+    }
+}
+
+/**
+ * @fn ibetaContinuedFraction2
+ * equivalent continued fraction #2 of I(x, a, b) for a batch of arguments
+ * @param x
+ * @param logX log(x)
+ * @param log1mX log(1-x)
+ * @param a
+ * @param b
+ * @param number amount of terms
+ * @param logBetaFun log(B(a, b))
+ * @param y output vector
+ */
+void ibetaContinuedFraction2(const std::vector<double> &x, const std::vector<double> &logX, const std::vector<double> &log1mX,
+                             double a, double b, int number, double logBetaFun, std::vector<double> &y)
+{
+    size_t size = x.size();
+    std::vector<double> frac(size, 0.0);
+    for (int n = number; n > 1; --n) {
+        double coef = (a + b + n - 2) / (a + n - 1);
+        for (size_t i = 0; i < size; ++i) {
+            double cn = coef * x[i];
+            frac[i] = cn / (1 + cn - frac[i]);
+        }
+    }
+    double c1 = (a + b - 1) / a;
+    for (size_t i = 0; i < size; ++i) {
+        double F = c1 / (1 + c1 - frac[i]);
+        double logY = a * logX[i] + b * log1mX[i] - logBetaFun;
+        y[i] = std::exp(logY) / (a + b - 1) * F / (1.0 - F);
+    }
+}
+
+/**
+ * @fn ibetaBelowMean
+ * Calculate I(x, a, b) for a batch of arguments, which don't exceed the mean a / (a + b)
+ * @param x
+ * @param logX log(x)
+ * @param log1mX log(1-x)
+ * @param a
+ * @param b
+ * @param logBetaFun log(B(a, b))
+ * @param y output vector
+ */
+void ibetaBelowMean(const std::vector<double> &x, const std::vector<double> &logX, const std::vector<double> &log1mX,
+                    double a, double b, double logBetaFun, std::vector<double> &y)
+{
+    /// split arguments by the same threshold 0.45, as for a single one
+    std::vector<size_t> indices[2];
+    std::vector<double> args[2], logArgs[2], log1mArgs[2];
+    for (size_t i = 0; i != x.size(); ++i) {
+        int regime = (x[i] < 0.45) ? 0 : 1;
+        indices[regime].push_back(i);
+        args[regime].push_back(x[i]);
+        logArgs[regime].push_back(logX[i]);
+        log1mArgs[regime].push_back(log1mX[i]);
+    }
+    double number = std::floor(b);
+    for (int regime = 0; regime != 2; ++regime) {
+        size_t size = indices[regime].size();
+        if (size == 0)
+            continue;
+        std::vector<double> res(size), residue(size, 0.0);
+        if (regime == 0) {
+            if (b < 1)
+                ibetaPowerSeries1(args[0], logArgs[0], log1mArgs[0], a, b, logBetaFun, res);
+            else {
+                ibetaContinuedFraction1(args[0], logArgs[0], log1mArgs[0], a, b, number, logBetaFun, res);
+                double apn = a + number, bmn = b - number;
+                if (b != number)
+                    ibetaPowerSeries1(args[0], logArgs[0], log1mArgs[0], apn, bmn, logBeta(apn, bmn), residue);
+            }
+        }
+        else {
+            if (b < 1)
+                ibetaPowerSeries2(args[1], logArgs[1], log1mArgs[1], a, b, logBetaFun, res);
+            else {
+                ibetaContinuedFraction2(args[1], logArgs[1], log1mArgs[1], a, b, number, logBetaFun, res);
+                double apn = a + number;
+                ibetaPowerSeries2(args[1], logArgs[1], log1mArgs[1], apn, b, logBeta(apn, b), residue);
+            }
+        }
+        for (size_t i = 0; i != size; ++i)
+            y[indices[regime][i]] = res[i] + residue[i];
+    }
+}
+
+/**
+ * @fn incompleteBeta
+ * Calculate I(x, a, b) or 1 - I(x, a, b) for a batch of arguments
+ * @param x
+ * @param y output vector
+ * @param a
+ * @param b
+ * @param logBetaFun log(B(a, b))
+ * @param isLower true if I(x, a, b) should be returned, 1 - I(x, a, b) otherwise
+ */
+void incompleteBeta(const std::vector<double> &x, std::vector<double> &y, double a, double b, double logBetaFun, bool isLower)
+{
+    if (a <= 0 || b <= 0)
+        throw std::invalid_argument("Parameters (a, b) of incomplete beta function should be both positive, but they're equal to "
+                                    + std::to_string(a) + " and " + std::to_string(b) + " respectively");
+    size_t size = x.size();
+    if (size > y.size())
+        return;
+    /// group 0 contains arguments of I(x, a, b), group 1 - of I(1 - x, b, a),
+    /// and the flag shows if the result should be complemented
+    std::vector<size_t> indices[2];
+    std::vector<double> args[2], logArgs[2], log1mArgs[2];
+    std::vector<bool> isComplement[2];
+    double mean = a / (a + b);
+    for (size_t i = 0; i != size; ++i) {
+        double xi = x[i];
+        if (xi < 0.0 || xi > 1.0)
+            throw std::invalid_argument("Argument x of incomplete beta function should be in interval [0, 1], but it's equal to "
+                                        + std::to_string(xi));
+        if (xi == 0.0 || xi == 1.0) {
+            y[i] = ((xi == 1.0) == isLower) ? 1.0 : 0.0;
+            continue;
+        }
+        double logX = std::log(xi), log1mX = std::log1p(-xi);
+        if (b == 1.0) {
+            y[i] = isLower ? std::exp(a * logX) : -std::expm1(a * logX);
+            continue;
+        }
+        if (a == 1.0) {
+            y[i] = isLower ? -std::expm1(b * log1mX) : std::exp(b * log1mX);
+            continue;
+        }
+        /// If x is greater than mean of Beta distribution,
+        /// convergence of complementary distribution function is faster
+        if (xi > mean) {
+            indices[1].push_back(i);
+            args[1].push_back(1.0 - xi);
+            logArgs[1].push_back(log1mX);
+            log1mArgs[1].push_back(logX);
+            isComplement[1].push_back(isLower);
+        }
+        else {
+            indices[0].push_back(i);
+            args[0].push_back(xi);
+            logArgs[0].push_back(logX);
+            log1mArgs[0].push_back(log1mX);
+            isComplement[0].push_back(!isLower);
+        }
+    }
+    for (int group = 0; group != 2; ++group) {
+        size_t groupSize = indices[group].size();
+        if (groupSize == 0)
+            continue;
+        std::vector<double> res(groupSize);
+        if (group == 0)
+            ibetaBelowMean(args[0], logArgs[0], log1mArgs[0], a, b, logBetaFun, res);
+        else
+            ibetaBelowMean(args[1], logArgs[1], log1mArgs[1], b, a, logBetaFun, res);
+        for (size_t i = 0; i != groupSize; ++i)
+            y[indices[group][i]] = isComplement[group][i] ? 1.0 - res[i] : res[i];
+    }
+}
+
+void ibeta(const std::vector<double> &x, std::vector<double> &y, double a, double b, double logBetaFun)
+{
+    incompleteBeta(x, y, a, b, logBetaFun, true);
+}
+
+void ibeta(const std::vector<double> &x, std::vector<double> &y, double a, double b)
+{
+    incompleteBeta(x, y, a, b, logBeta(a, b), true);
+}
+
+void ibetac(const std::vector<double> &x, std::vector<double> &y, double a, double b, double logBetaFun)
+{
+    incompleteBeta(x, y, a, b, logBetaFun, false);
+}
+
+void ibetac(const std::vector<double> &x, std::vector<double> &y, double a, double b)
+{
+    incompleteBeta(x, y, a, b, logBeta(a, b), false);
+}
+
+/**
+ * @fn ibetainvInitialValue
+ * @param p probability of the left tail, p <= 0.5
+ * @param a
+ * @param b
+ * @param logBetaFun log(B(a, b))
+ * @return initial value of inverse of I(x, a, b)
+ */
+double ibetainvInitialValue(double p, double a, double b, double logBetaFun)
+{
+    /// Method is taken from algorithm AS 109
+    /// "Inverse of the incomplete beta function ratio"
+    /// (G.W. Cran, K.J. Martin and G.E. Thomas)
+    double r = std::sqrt(-2 * std::log(p));
+    double y = r - (2.30753 + 0.27061 * r) / (1.0 + (0.99229 + 0.04481 * r) * r);
+    double x = NAN;
+    if (a > 1 && b > 1) {
+        r = (y * y - 3.0) / 6.0;
+        double s = 1.0 / (a + a - 1.0);
+        double t = 1.0 / (b + b - 1.0);
+        double h = 2.0 / (s + t);
+        double w = y * std::sqrt(h + r) / h - (t - s) * (r + 5.0 / 6.0 - 2.0 / (3.0 * h));
+        x = a / (a + b * std::exp(w + w));
+    }
+    else {
+        r = b + b;
+        double t = 1.0 / (9.0 * b);
+        t = r * std::pow(1.0 - t - y * std::sqrt(t), 3);
+        if (t > 0.0) {
+            t = (4.0 * a + r - 2.0) / t;
+            x = (t > 1.0) ? 1.0 - 2.0 / (t + 1.0) : std::exp((std::log(p * a) + logBetaFun) / a);
+        }
+        else {
+            x = 1.0 - std::exp((std::log1pl(-p) + std::log(b) + logBetaFun) / b);
+        }
+    }
+    /// the approximation is crude in the far tail,
+    /// where I(x, a, b) ~ x^a / (a B(a, b))
+    double xSmall = std::exp((std::log(p * a) + logBetaFun) / a);
+    if (!(x > 0.0 && x < 1.0) || xSmall < 1e-3)
+        x = xSmall;
+    return (x >= 0.0 && x < 1.0) ? x : a / (a + b);
+}
+
+/**
+ * @fn ibetainvRaw
+ * @param p probability of the tail
+ * @param a
+ * @param b
+ * @param logBetaFun log(B(a, b))
+ * @param isUpper true if p = 1 - I(x, a, b), false if p = I(x, a, b)
+ * @return such x that I(x, a, b) = p or 1 - I(x, a, b) = p
+ */
+double ibetainvRaw(double p, double a, double b, double logBetaFun, bool isUpper)
+{
+    /// the equation is solved for z = x or z = 1 - x, whichever is below 1/2,
+    /// since roots close to 0 can't be represented as 1 - z;
+    /// I(x, a, b) = 1 - I(1 - x, b, a), so that reflection swaps parameters and tails
+    double tailAtHalf = isUpper ? ibeta(0.5, b, a, logBetaFun, -M_LN2, -M_LN2) : ibeta(0.5, a, b, logBetaFun, -M_LN2, -M_LN2);
+    bool isReflected = isUpper ? (p < tailAtHalf) : (p > tailAtHalf);
+    if (isReflected) {
+        std::swap(a, b);
+        isUpper = !isUpper;
+    }
+
+    /// initial value, where I(z, a, b) ~ z^a / (a B(a, b)) is used for small roots
+    double pLower = isUpper ? 1.0 - p : p;
+    double logZSmall = (std::log(pLower * a) + logBetaFun) / a;
+    /// the root is too close to the boundary to be represented
+    if (logZSmall < std::log(std::numeric_limits<double>::denorm_min()))
+        return isReflected ? 1.0 : 0.0;
+    double root = (pLower <= 0.5) ? ibetainvInitialValue(pLower, a, b, logBetaFun)
+                                  : 1.0 - ibetainvInitialValue(isUpper ? p : 1.0 - p, b, a, logBetaFun);
+    if (!(root > 0.0 && root < 0.5))
+        root = std::min(std::exp(logZSmall), 0.5);
+
+    /// Halley's method for increasing function,
+    /// for small p we use logarithmic scale
+    bool isLogScale = p < 1e-5;
+    double logP = std::log(p);
+    auto fun = [a, b, p, logP, logBetaFun, isUpper, isLogScale] (double x)
+    {
+        if (x <= 0.0 || x >= 1.0) {
+            bool isLeft = x <= 0.0;
+            double tail = (isLeft != isUpper) ? 0.0 : 1.0;
+            if (isLogScale)
+                return DoubleTriplet(isUpper ? logP - std::log(tail) : std::log(tail) - logP, 0, 0);
+            return DoubleTriplet(isUpper ? p - tail : tail - p, 0, 0);
+        }
+        double logX = std::log(x), log1mX = std::log1pl(-x);
+        double logPdf = (a - 1) * logX + (b - 1) * log1mX - logBetaFun;
+        double dLogPdf = (a - 1) / x - (b - 1) / (1.0 - x);
+        /// 1 - x is rounded to 1 for small x, hence the upper tail is evaluated in 1 - x only above the mean
+        bool isComplement = isUpper && x < a / (a + b);
+        double tail = (isUpper && !isComplement) ? ibeta(1.0 - x, b, a, logBetaFun, log1mX, logX) : ibeta(x, a, b, logBetaFun, logX, log1mX);
+        if (isComplement)
+            tail = 1.0 - tail;
+        if (isLogScale) {
+            double logTail = std::log(tail);
+            double first = isUpper ? logP - logTail : logTail - logP;
+            /// residual is below accuracy of incomplete beta function
+            if (std::fabs(first) <= 1e-13)
+                first = 0.0;
+            double second = std::exp(logPdf - logTail);
+            double third = second * (isUpper ? dLogPdf + second : dLogPdf - second);
+            return DoubleTriplet(first, second, third);
+        }
+        double first = isUpper ? p - tail : tail - p;
+        if (std::fabs(first) <= 1e-13 * p)
+            first = 0.0;
+        double second = std::exp(logPdf);
+        return DoubleTriplet(first, second, second * dLogPdf);
+    };
+    /// tail behaves like a power of z for small roots, therefore the root is located in logarithmic variable
+    /// and then refined in z
+    auto logFun = [fun] (double logZ)
+    {
+        double z = std::exp(logZ);
+        auto [first, second, third] = fun(z);
+        return DoubleTriplet(first, second * z, (third * z + second) * z);
+    };
+    double logRoot = std::log(root);
+    if (!findRootNewtonBracketed<double>(logFun, std::log(std::numeric_limits<double>::denorm_min()), -M_LN2, logRoot, 1e-15))
+        throw std::runtime_error("Inverse of incomplete beta function: failure in numeric procedure");
+    root = std::exp(logRoot);
+    double refinedRoot = root;
+    if (findRootNewtonBracketed<double>(fun, 0.0, 0.5, refinedRoot, 1e-15))
+        root = refinedRoot;
+
+    /// the root is verified, since the incomplete beta function can fail for extreme parameters:
+    /// residual should be small or change its sign at the neighbouring representable numbers
+    static constexpr double MAX_RESIDUAL = 1e-8;
+    double residual = std::get<0>(fun(root));
+    bool isRoot = std::fabs(residual) <= (isLogScale ? MAX_RESIDUAL : MAX_RESIDUAL * p);
+    if (!isRoot && std::isfinite(residual)) {
+        double residualLeft = std::get<0>(fun(std::nextafter(root, 0.0)));
+        double residualRight = std::get<0>(fun(std::nextafter(root, 1.0)));
+        isRoot = residualLeft <= 0.0 && residualRight >= 0.0;
+    }
+    if (!isRoot)
+        throw std::runtime_error("Inverse of incomplete beta function: residual " + std::to_string(residual)
+                                 + " is too large for parameters " + std::to_string(a) + " and " + std::to_string(b));
+    return isReflected ? 1.0 - root : root;
+}
+
+double ibetainv(double p, double a, double b, double logBetaFun)
+{
+    if (a <= 0 || b <= 0 || p < 0.0 || p > 1.0)
+        throw std::invalid_argument("Parameters (a, b) of inverse incomplete beta function should be both positive and probability p should be in interval [0, 1]");
+    if (p == 0.0 || p == 1.0)
+        return p;
+    if (b == 1.0)
+        return std::exp(std::log(p) / a);
+    if (a == 1.0)
+        return -std::expm1l(std::log1pl(-p) / b);
+    return (p <= 0.5) ? ibetainvRaw(p, a, b, logBetaFun, false) : ibetainvRaw(1.0 - p, a, b, logBetaFun, true);
+}
+
+double ibetainv(double p, double a, double b)
+{
+    return ibetainv(p, a, b, logBeta(a, b));
+}
+
+double ibetacinv(double q, double a, double b, double logBetaFun)
+{
+    if (a <= 0 || b <= 0 || q < 0.0 || q > 1.0)
+        throw std::invalid_argument("Parameters (a, b) of inverse incomplete beta function should be both positive and probability q should be in interval [0, 1]");
+    if (q == 0.0 || q == 1.0)
+        return 1.0 - q;
+    if (b == 1.0)
+        return std::exp(std::log1pl(-q) / a);
+    if (a == 1.0)
+        return -std::expm1l(std::log(q) / b);
+    return (q <= 0.5) ? ibetainvRaw(q, a, b, logBetaFun, true) : ibetainvRaw(1.0 - q, a, b, logBetaFun, false);
+}
+
+double ibetacinv(double q, double a, double b)
+{
+    return ibetacinv(q, a, b, logBeta(a, b));
+}
+
 }
@@ -40,6 +40,92 @@ double ibeta(double x, double a, double b, double logBetaFun, double logX, doubl
  */
 double ibeta(double x, double a, double b);
 
+/**
+ * @fn ibeta
+ * Fast calculation of regularized beta function for a batch of arguments, using precalculated value of log(B(a, b)).
+ * Arguments are grouped by the regime of evaluation and each group is processed at once
+ * @param x input vector
+ * @param y output vector: y = I(x, a, b)
+ * @param a
+ * @param b
+ * @param logBetaFun log(B(a, b))
+ */
+void ibeta(const std::vector<double> &x, std::vector<double> &y, double a, double b, double logBetaFun);
+
+/**
+ * @fn ibeta
+ * Calculate regularized beta function for a batch of arguments
+ * @param x input vector
+ * @param y output vector: y = I(x, a, b)
+ * @param a
+ * @param b
+ */
+void ibeta(const std::vector<double> &x, std::vector<double> &y, double a, double b);
+
+/**
+ * @fn ibetac
+ * Fast calculation of complementary regularized beta function for a batch of arguments,
+ * using precalculated value of log(B(a, b))
+ * @param x input vector
+ * @param y output vector: y = 1 - I(x, a, b)
+ * @param a
+ * @param b
+ * @param logBetaFun log(B(a, b))
+ */
+void ibetac(const std::vector<double> &x, std::vector<double> &y, double a, double b, double logBetaFun);
+
+/**
+ * @fn ibetac
+ * Calculate complementary regularized beta function for a batch of arguments
+ * @param x input vector
+ * @param y output vector: y = 1 - I(x, a, b)
+ * @param a
+ * @param b
+ */
+void ibetac(const std::vector<double> &x, std::vector<double> &y, double a, double b);
+
+/**
+ * @fn ibetainv
+ * Calculate inverse of regularized beta function, using precalculated value of log(B(a, b))
+ * @param p
+ * @param a
+ * @param b
+ * @param logBetaFun log(B(a, b))
+ * @return such x that I(x, a, b) = p
+ */
+double ibetainv(double p, double a, double b, double logBetaFun);
+
+/**
+ * @fn ibetainv
+ * Calculate inverse of regularized beta function
+ * @param p
+ * @param a
+ * @param b
+ * @return such x that I(x, a, b) = p
+ */
+double ibetainv(double p, double a, double b);
+
+/**
+ * @fn ibetacinv
+ * Calculate inverse of complementary regularized beta function, using precalculated value of log(B(a, b))
+ * @param q
+ * @param a
+ * @param b
+ * @param logBetaFun log(B(a, b))
+ * @return such x that 1 - I(x, a, b) = q
+ */
+double ibetacinv(double q, double a, double b, double logBetaFun);
+
+/**
+ * @fn ibetacinv
+ * Calculate inverse of complementary regularized beta function
+ * @param q
+ * @param a
+ * @param b
+ * @return such x that 1 - I(x, a, b) = q
+ */
+double ibetacinv(double q, double a, double b);
+
 }
 
 #endif // BETAMATH
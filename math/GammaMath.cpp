@@ -1,4 +1,5 @@
 #include "GammaMath.h"
+#include "NumericMath.h"
 
 namespace RandMath
 {
@@ -523,16 +524,22 @@ double incompleteGammaUniformExpansion(double a, double x, double logX, double l
     double lambda = x / a;
     double logLambda = logX - logA;
     double aux = x - a - a * logLambda;
+    /// η = sign(λ - 1) sqrt(2(λ - 1 - log(λ))) is negative for x < a,
+    /// Q(a, x) = erfc(η sqrt(a/2)) / 2 + R and P(a, x) = erfc(-η sqrt(a/2)) / 2 - R
     double eta = 0.0, base = 0.5;
     if (aux > 0.0) { /// otherwise, x ~ a and aux ~ 0.0
         eta = std::sqrt(2 * (lambda - 1.0 - logLambda));
-        base = 0.5 * std::erfc(std::sqrt(aux));
+        double erfcArg = std::sqrt(aux);
+        if (x < a) {
+            eta = -eta;
+            erfcArg = -erfcArg;
+        }
+        base = 0.5 * std::erfc(isP ? -erfcArg : erfcArg);
     }
     long double sum = 0.0l;
     double betanp2 = d[N], betanp1 = d[N - 1];
     for (int n = N - 2; n >= 0; --n) {
-        double beta = (n + 2) * betanp2 / a;
-        beta += (x < a && (n & 1)) ? -d[n] : d[n];
+        double beta = (n + 2) * betanp2 / a + d[n];
         sum += beta * std::pow(eta, n);
         betanp2 = betanp1;
         betanp1 = beta;
@@ -576,7 +583,7 @@ double lpgamma(double a, double x, double logA, double lgammaA)
 {
     parametersVerification(a, x);
     if (x == 0.0)
-        return 0.0;
+        return -INFINITY;
     if (a == 1.0)
         return RandMath::log1mexp(-x);
     double logX = std::log(x);
@@ -588,7 +595,7 @@ double lpgamma(double a, double x, double logX)
 {
     parametersVerification(a, x);
     if (x == 0.0)
-        return 0.0;
+        return -INFINITY;
     if (a == 1.0)
         return RandMath::log1mexp(-x);
     REGULARISED_GAMMA_METHOD_ID mId = getRegularizedGammaMethodId(a, x, logX);
@@ -599,7 +606,7 @@ double lpgamma(double a, double x)
 {
     parametersVerification(a, x);
     if (x == 0.0)
-        return 0.0;
+        return -INFINITY;
     if (a == 1.0)
         return RandMath::log1mexp(-x);
     double logX = std::log(x);
@@ -621,7 +628,7 @@ double pgamma(double a, double x, double logA, double lgammaA)
 {
     parametersVerification(a, x);
     if (x == 0.0)
-        return 1.0;
+        return 0.0;
     if (a == 1.0)
         return -std::expm1l(-x);
     double logX = std::log(x);
@@ -633,7 +640,7 @@ double pgamma(double a, double x, double logX)
 {
     parametersVerification(a, x);
     if (x == 0.0)
-        return 1.0;
+        return 0.0;
     if (a == 1.0)
         return -std::expm1l(-x);
     REGULARISED_GAMMA_METHOD_ID mId = getRegularizedGammaMethodId(a, x, logX);
@@ -644,7 +651,7 @@ double pgamma(double a, double x)
 {
     parametersVerification(a, x);
     if (x == 0.0)
-        return 1.0;
+        return 0.0;
     if (a == 1.0)
         return -std::expm1l(-x);
     double logX = std::log(x);
@@ -669,6 +676,12 @@ double qtGammaExpansionAux(double a, double logX, double logA, double lgammaA)
     return y;
 }
 
+/**
+ * @fn MAX_CONTINUED_FRACTION_TERMS
+ * maximum amount of terms in continued fraction for Q(a, x)
+ */
+constexpr int MAX_CONTINUED_FRACTION_TERMS = 1000;
+
 double lqgammaRaw(double a, double x, double logX, double logA, double lgammaA, REGULARISED_GAMMA_METHOD_ID mId)
 {
     if (mId == QT)
@@ -679,10 +692,9 @@ double lqgammaRaw(double a, double x, double logX, double logA, double lgammaA,
     if (mId == CF)
     {
         /// Continued fraction
-        int k0 = std::min(40.0 / (x - 1) + 5.0, 60.0);
         long double sum = 0.0;
         double rhok = 0.0, tk = 1.0;
-        for (int k = 1; k <= k0; ++k) {
+        for (int k = 1; k <= MAX_CONTINUED_FRACTION_TERMS && std::fabs(tk) > MIN_POSITIVE * std::fabs(sum); ++k) {
             /// Calculate a(k)
             double ak = k * (a - k);
             double temp = x + 2 * k - a;
@@ -709,7 +721,7 @@ double lqgamma(double a, double x, double logA, double lgammaA)
 {
     parametersVerification(a, x);
     if (x == 0.0)
-        return -INFINITY;
+        return 0.0;
     if (a == 1.0)
         return -x;
     double logX = std::log(x);
@@ -721,7 +733,7 @@ double lqgamma(double a, double x, double logX)
 {
     parametersVerification(a, x);
     if (x == 0.0)
-        return -INFINITY;
+        return 0.0;
     if (a == 1.0)
         return -x;
     REGULARISED_GAMMA_METHOD_ID mId = getRegularizedGammaMethodId(a, x, logX);
@@ -732,7 +744,7 @@ double lqgamma(double a, double x)
 {
     parametersVerification(a, x);
     if (x == 0.0)
-        return -INFINITY;
+        return 0.0;
     if (a == 1.0)
         return -x;
     double logX = std::log(x);
@@ -756,7 +768,7 @@ double qgamma(double a, double x, double logA, double lgammaA)
 {
     parametersVerification(a, x);
     if (x == 0.0)
-        return 0.0;
+        return 1.0;
     if (a == 1.0)
         return std::exp(-x);
     double logX = std::log(x);
@@ -768,7 +780,7 @@ double qgamma(double a, double x, double logX)
 {
     parametersVerification(a, x);
     if (x == 0.0)
-        return 0.0;
+        return 1.0;
     if (a == 1.0)
         return std::exp(-x);
     REGULARISED_GAMMA_METHOD_ID mId = getRegularizedGammaMethodId(a, x, logX);
@@ -779,7 +791,7 @@ double qgamma(double a, double x)
 {
     parametersVerification(a, x);
     if (x == 0.0)
-        return 0.0;
+        return 1.0;
     if (a == 1.0)
         return std::exp(-x);
     double logX = std::log(x);
@@ -788,4 +800,470 @@ double qgamma(double a, double x)
 }
 
 
+/**
+ * @fn incompleteGammaTaylorP
+ * Taylor expansion of P(a, x) for a batch of arguments
+ * @param a
+ * @param x
+ * @param logX log(x)
+ * @param logA log(a)
+ * @param lgammaA log(Γ(a))
+ * @param isP true if P(a, x) should be returned, Q(a, x) otherwise
+ * @param y output vector
+ */
+void incompleteGammaTaylorP(double a, const std::vector<double> &x, const std::vector<double> &logX, double logA, double lgammaA, bool isP, std::vector<double> &y)
+{
+    size_t size = x.size();
+    /// the amount of terms is chosen for the largest argument
+    double maxX = *std::max_element(x.begin(), x.end());
+    int n0 = 70.0 * maxX / a + 7;
+    /// coefficients 1 / ((a + 1)(a + 2)...(a + n))
+    std::vector<double> coefs(n0 + 1);
+    coefs[0] = 1.0;
+    for (int n = 1; n <= n0; ++n)
+        coefs[n] = coefs[n - 1] / (a + n);
+    /// Horner's scheme, evaluated for all arguments at once
+    std::vector<double> sum(size, coefs[n0]);
+    for (int n = n0 - 1; n >= 0; --n) {
+        double coef = coefs[n];
+        for (size_t i = 0; i < size; ++i)
+            sum[i] = sum[i] * x[i] + coef;
+    }
+    double lgammaAp1 = logA + lgammaA;
+    for (size_t i = 0; i < size; ++i) {
+        double logP = a * logX[i] - x[i] + std::log(sum[i]) - lgammaAp1;
+        y[i] = isP ? std::exp(logP) : -std::expm1(logP);
+    }
+}
+
+/**
+ * @fn incompleteGammaTaylorQ
+ * Taylor expansion of Q(a, x) for a batch of arguments
+ * @param a
+ * @param x
+ * @param logX log(x)
+ * @param logA log(a)
+ * @param lgammaA log(Γ(a))
+ * @param isP true if P(a, x) should be returned, Q(a, x) otherwise
+ * @param y output vector
+ */
+void incompleteGammaTaylorQ(double a, const std::vector<double> &x, const std::vector<double> &logX, double logA, double lgammaA, bool isP, std::vector<double> &y)
+{
+    static constexpr int N = 19;
+    size_t size = x.size();
+    /// coefficients (-1)^n a / (n! (a + n))
+    double coefs[N + 1];
+    coefs[0] = 0.0;
+    double factorial = 1.0;
+    for (int n = 1; n <= N; ++n) {
+        factorial *= n;
+        coefs[n] = a / (factorial * (a + n));
+        if (n & 1)
+            coefs[n] = -coefs[n];
+    }
+    std::vector<double> sum(size, coefs[N]);
+    for (int n = N - 1; n >= 0; --n) {
+        double coef = coefs[n];
+        for (size_t i = 0; i < size; ++i)
+            sum[i] = sum[i] * x[i] + coef;
+    }
+    double logGammaAp1 = logA + lgammaA;
+    for (size_t i = 0; i < size; ++i) {
+        double logP = std::log1p(sum[i]) + a * logX[i] - logGammaAp1;
+        y[i] = isP ? std::exp(logP) : -std::expm1(logP);
+    }
+}
+
+/**
+ * @fn incompleteGammaContinuedFraction
+ * continued fraction for Q(a, x) for a batch of arguments
+ * @param a
+ * @param x
+ * @param logX log(x)
+ * @param lgammaA log(Γ(a))
+ * @param isP true if P(a, x) should be returned, Q(a, x) otherwise
+ * @param y output vector
+ */
+void incompleteGammaContinuedFraction(double a, const std::vector<double> &x, const std::vector<double> &logX, double lgammaA, bool isP, std::vector<double> &y)
+{
+    size_t size = x.size();
+    std::vector<double> sum(size, 0.0), rhok(size, 0.0), tk(size, 1.0);
+    /// all fractions are evaluated at once, until the slowest one converges
+    bool isConverged = false;
+    for (int k = 1; k <= MAX_CONTINUED_FRACTION_TERMS && !isConverged; ++k) {
+        double kamk = k * (a - k);
+        double shift = 2 * k - a;
+        for (size_t i = 0; i < size; ++i) {
+            double temp = x[i] + shift;
+            double ak = kamk / (temp * temp - 1);
+            double rho = (rhok[i] + 1) * ak;
+            rhok[i] = -rho / (1 + rho);
+            tk[i] *= rhok[i];
+            sum[i] += tk[i];
+        }
+        isConverged = true;
+        for (size_t i = 0; i < size && isConverged; ++i)
+            isConverged = std::fabs(tk[i]) <= MIN_POSITIVE * std::fabs(sum[i]);
+    }
+    for (size_t i = 0; i < size; ++i) {
+        double logQ = std::log1p(sum[i]) + a * logX[i] - x[i] - lgammaA - std::log1p(x[i] - a);
+        y[i] = isP ? -std::expm1(logQ) : std::exp(logQ);
+    }
+}
+
+/**
+ * @fn incompleteGammaUniformExpansion
+ * uniform asymptotic expansion for a batch of arguments
+ * @param a
+ * @param x
+ * @param logX log(x)
+ * @param logA log(a)
+ * @param isP true if P(a, x) should be calculated directly, Q(a, x) otherwise
+ * @param y output vector
+ */
+void incompleteGammaUniformExpansion(double a, const std::vector<double> &x, const std::vector<double> &logX, double logA, bool isP, std::vector<double> &y)
+{
+    static constexpr long double d[] = {-0.33333333333333333333l, 0.08333333333333333333l, -0.01481481481481481481l, 0.00115740740740740741l,
+                                         0.00035273368606701940l, -0.000178755144032922l, 0.0000391926317852244l, -0.00000218544851067999l,
+                                        -0.00000185406221071516l, 0.829671134095309e-6l, -0.176659527368261e-6l, 0.670785354340150e-8l,
+                                         0.102618097842403e-7l, -0.438203601845335e-8l, 0.914769958223678e-9l, -0.255141939949460e-10l,
+                                        -0.583077213255043e-10l, 0.243619480206674e-10l, -0.502766928011417e-11l, 0.110043920319559e-12l,
+                                         0.337176326240099e-12l, -0.139238872241816e-12l, 0.285348938070474e-13l, -0.513911183424242e-15l,
+                                        -0.197522882943494428e-16l, 0.809952115670456133e-17};
+    static constexpr int N = 25;
+    /// coefficients of the series don't depend on x
+    double beta[N - 1];
+    double betaNp2 = d[N], betaNp1 = d[N - 1];
+    for (int n = N - 2; n >= 0; --n) {
+        beta[n] = (n + 2) * betaNp2 / a + d[n];
+        betaNp2 = betaNp1;
+        betaNp1 = beta[n];
+    }
+    double factor = a / (a + betaNp2);
+    size_t size = x.size();
+    std::vector<double> eta(size), base(size), aux(size);
+    for (size_t i = 0; i < size; ++i) {
+        double lambda = x[i] / a;
+        double logLambda = logX[i] - logA;
+        aux[i] = x[i] - a - a * logLambda;
+        eta[i] = 0.0;
+        base[i] = 0.5;
+        if (aux[i] > 0.0) { /// otherwise, x ~ a and aux ~ 0.0
+            /// η is negative for x < a
+            eta[i] = std::sqrt(2 * (lambda - 1.0 - logLambda));
+            double erfcArg = std::sqrt(aux[i]);
+            if (x[i] < a) {
+                eta[i] = -eta[i];
+                erfcArg = -erfcArg;
+            }
+            base[i] = 0.5 * std::erfc(isP ? -erfcArg : erfcArg);
+        }
+    }
+    std::vector<double> sum(size, 0.0);
+    for (int n = N - 2; n >= 0; --n) {
+        for (size_t i = 0; i < size; ++i)
+            sum[i] = sum[i] * eta[i] + beta[n];
+    }
+    double logCoef = 0.5 * (M_LN2 + M_LNPI + logA);
+    for (size_t i = 0; i < size; ++i) {
+        double z = std::exp(-aux[i] - logCoef) * sum[i] * factor;
+        y[i] = base[i] + (isP ? -z : z);
+    }
+}
+
+/**
+ * @fn incompleteGamma
+ * Calculate regularized incomplete gamma function for a batch of arguments,
+ * grouping them by the method of calculation
+ * @param a
+ * @param x input vector
+ * @param y output vector
+ * @param logA log(a)
+ * @param lgammaA log(Γ(a))
+ * @param isP true if P(a, x) should be calculated, Q(a, x) otherwise
+ */
+void incompleteGamma(double a, const std::vector<double> &x, std::vector<double> &y, double logA, double lgammaA, bool isP)
+{
+    size_t size = x.size();
+    if (size > y.size())
+        return;
+    std::vector<size_t> indices[UNDEFINED];
+    std::vector<double> args[UNDEFINED], logArgs[UNDEFINED];
+    for (size_t i = 0; i != size; ++i) {
+        double xi = x[i];
+        parametersVerification(a, xi);
+        if (xi == 0.0)
+            y[i] = isP ? 0.0 : 1.0;
+        else if (xi == INFINITY)
+            y[i] = isP ? 1.0 : 0.0;
+        else if (a == 1.0)
+            y[i] = isP ? -std::expm1(-xi) : std::exp(-xi);
+        else {
+            double logX = std::log(xi);
+            REGULARISED_GAMMA_METHOD_ID mId = getRegularizedGammaMethodId(a, xi, logX);
+            indices[mId].push_back(i);
+            args[mId].push_back(xi);
+            logArgs[mId].push_back(logX);
+        }
+    }
+    for (int mId = PT; mId != UNDEFINED; ++mId) {
+        if (indices[mId].empty())
+            continue;
+        std::vector<double> res(indices[mId].size());
+        if (mId == PT)
+            incompleteGammaTaylorP(a, args[mId], logArgs[mId], logA, lgammaA, isP, res);
+        else if (mId == QT)
+            incompleteGammaTaylorQ(a, args[mId], logArgs[mId], logA, lgammaA, isP, res);
+        else if (mId == CF)
+            incompleteGammaContinuedFraction(a, args[mId], logArgs[mId], lgammaA, isP, res);
+        else {
+            /// uniform expansion gives P for PUA and Q for QUA directly
+            bool isDirect = (mId == PUA) == isP;
+            incompleteGammaUniformExpansion(a, args[mId], logArgs[mId], logA, mId == PUA, res);
+            if (!isDirect) {
+                for (double &value : res)
+                    value = 1.0 - value;
+            }
+        }
+        for (size_t j = 0; j != res.size(); ++j)
+            y[indices[mId][j]] = res[j];
+    }
+}
+
+void pgamma(double a, const std::vector<double> &x, std::vector<double> &y, double logA, double lgammaA)
+{
+    incompleteGamma(a, x, y, logA, lgammaA, true);
+}
+
+void pgamma(double a, const std::vector<double> &x, std::vector<double> &y)
+{
+    incompleteGamma(a, x, y, std::log(a), std::lgammal(a), true);
+}
+
+void qgamma(double a, const std::vector<double> &x, std::vector<double> &y, double logA, double lgammaA)
+{
+    incompleteGamma(a, x, y, logA, lgammaA, false);
+}
+
+void qgamma(double a, const std::vector<double> &x, std::vector<double> &y)
+{
+    incompleteGamma(a, x, y, std::log(a), std::lgammal(a), false);
+}
+
+/**
+ * @fn initRootForSmallP
+ * @param a
+ * @param r (p Γ(a + 1))^(1/a)
+ * @return initial value of inverse of P(a, x) for p -> 0
+ */
+double initRootForSmallP(double a, double r)
+{
+    double root = 0;
+    double c[5];
+    c[4] = 1;
+    /// first coefficient
+    double denominator = a + 1;
+    c[3] = 1.0 / denominator;
+    /// second coefficient
+    denominator *= denominator;
+    denominator *= a + 2;
+    c[2] = 0.5 * (3 * a + 5) / denominator;
+    /// third coefficient
+    denominator *= 3 * (a + 1) * (a + 3);
+    c[1] = 8 * a + 33;
+    c[1] *= a;
+    c[1] += 31;
+    c[1] /= denominator;
+    /// fourth coefficient
+    denominator *= 8 * (a + 1) * (a + 2) * (a + 4);
+    c[0] = 125 * a + 1179;
+    c[0] *= a;
+    c[0] += 3971;
+    c[0] *= a;
+    c[0] += 5661;
+    c[0] *= a;
+    c[0] += 2888;
+    c[0] /= denominator;
+    /// now calculate root
+    for (int i = 0; i != 5; ++i) {
+        root += c[i];
+        root *= r;
+    }
+    return root;
+}
+
+/**
+ * @fn initRootForSmallQ
+ * @param a
+ * @param logQ log(q)
+ * @param lgammaA log(Γ(a))
+ * @return initial value of inverse of Q(a, x) for q -> 0
+ */
+double initRootForSmallQ(double a, double logQ, double lgammaA)
+{
+    double x = (logQ + lgammaA) / a;
+    x = -std::exp(x) / a;
+    return -a * Wm1Lambert(x);
+}
+
+/**
+ * @fn initRootForLargeShape
+ * @param a
+ * @param z erfcinv(2p) for P(a, x) = p or -erfcinv(2q) for Q(a, x) = q
+ * @return initial value of inverse of P(a, x) for large a
+ */
+double initRootForLargeShape(double a, double z)
+{
+    if (z == 0.0)
+        return a;
+    double lambda = z * z / a + 1;
+    lambda = -std::exp(-lambda);
+    lambda = (z < 0) ? -Wm1Lambert(lambda) : -W0Lambert(lambda);
+    return lambda * a;
+}
+
+/**
+ * @fn pgammainvInitialValue
+ * @param a
+ * @param p
+ * @param logA log(a)
+ * @param lgammaA log(Γ(a))
+ * @return initial value of inverse of P(a, x)
+ */
+double pgammainvInitialValue(double a, double p, double logA, double lgammaA)
+{
+    /// Method is taken from
+    /// "Efficient and accurate algorithms
+    /// for the computation and inversion
+    /// of the incomplete gamma function ratios"
+    /// (Amparo Gil, Javier Segura and Nico M. Temme)
+    if (a >= 10)
+        return initRootForLargeShape(a, erfcinv(2 * p));
+    double r = std::log(p * a) + lgammaA;
+    r = std::exp(r / a);
+    /// if p -> 0
+    if (r < 0.2 * (a + 1))
+        return initRootForSmallP(a, r);
+    double logQ = std::log1pl(-p);
+    /// boundary adviced in a paper
+    double maxBoundary1 = -0.5 * a - logA - lgammaA;
+    /// the maximum possible value to have a solution
+    double maxBoundary2 = a * (logA - 1) - lgammaA;
+    /// if p -> 1
+    if (logQ < std::min(maxBoundary1, maxBoundary2))
+        return initRootForSmallQ(a, logQ, lgammaA);
+    return (a < 1) ? r : initRootForLargeShape(a, erfcinv(2 * p));
+}
+
+/**
+ * @fn qgammainvInitialValue
+ * @param a
+ * @param q
+ * @param logA log(a)
+ * @param lgammaA log(Γ(a))
+ * @return initial value of inverse of Q(a, x)
+ */
+double qgammainvInitialValue(double a, double q, double logA, double lgammaA)
+{
+    if (a >= 10)
+        return initRootForLargeShape(a, -erfcinv(2 * q));
+    double logQ = std::log(q);
+    /// boundary adviced in a paper
+    double maxBoundary1 = -0.5 * a - logA - lgammaA;
+    /// the maximum possible value to have a solution
+    double maxBoundary2 = a * (logA - 1) - lgammaA;
+    /// if q -> 0
+    if (logQ < std::min(maxBoundary1, maxBoundary2))
+        return initRootForSmallQ(a, logQ, lgammaA);
+    return pgammainvInitialValue(a, 1.0 - q, logA, lgammaA);
+}
+
+/**
+ * @fn gammainvRaw
+ * @param a
+ * @param p probability of the tail, p <= 0.5
+ * @param logA log(a)
+ * @param lgammaA log(Γ(a))
+ * @param isUpper true if p = Q(a, x), false if p = P(a, x)
+ * @return such x that P(a, x) = p or Q(a, x) = p
+ */
+double gammainvRaw(double a, double p, double logA, double lgammaA, bool isUpper)
+{
+    double root = isUpper ? qgammainvInitialValue(a, p, logA, lgammaA) : pgammainvInitialValue(a, p, logA, lgammaA);
+    /// the root is too small to be represented
+    if (root == 0.0)
+        return 0.0;
+    /// Halley's method for increasing function,
+    /// for small p we use logarithmic scale
+    bool isLogScale = p < 1e-5;
+    double logP = std::log(p);
+    auto fun = [a, p, logP, logA, lgammaA, isUpper, isLogScale] (double x)
+    {
+        if (x <= 0.0) {
+            if (isLogScale)
+                return DoubleTriplet(isUpper ? logP : -INFINITY, 0, 0);
+            return DoubleTriplet(isUpper ? p - 1.0 : -p, 0, 0);
+        }
+        double logX = std::log(x);
+        double logPdf = (a - 1) * logX - x - lgammaA;
+        double dLogPdf = (a - 1) / x - 1.0;
+        if (isLogScale) {
+            double logTail = isUpper ? lqgamma(a, x, logA, lgammaA) : lpgamma(a, x, logA, lgammaA);
+            double first = isUpper ? logP - logTail : logTail - logP;
+            /// residual is below accuracy of incomplete gamma function
+            if (std::fabs(first) <= 1e-14)
+                first = 0.0;
+            double second = std::exp(logPdf - logTail);
+            double third = second * (isUpper ? dLogPdf + second : dLogPdf - second);
+            return DoubleTriplet(first, second, third);
+        }
+        double first = isUpper ? p - qgamma(a, x, logA, lgammaA) : pgamma(a, x, logA, lgammaA) - p;
+        if (std::fabs(first) <= 1e-14 * p)
+            first = 0.0;
+        double second = std::exp(logPdf);
+        return DoubleTriplet(first, second, second * dLogPdf);
+    };
+    if (!(root > 0.0) || !std::isfinite(root))
+        root = a;
+    if (!findRootNewtonBracketed<double>(fun, 0.0, INFINITY, root, 1e-15))
+        throw std::runtime_error("Inverse of incomplete gamma function: failure in numeric procedure");
+    return root;
+}
+
+double pgammainv(double a, double p, double logA, double lgammaA)
+{
+    if (a <= 0.0 || p < 0.0 || p > 1.0)
+        throw std::invalid_argument("Parameter a of inverse incomplete gamma function should be positive and probability p should be in interval [0, 1]");
+    if (p == 0.0)
+        return 0.0;
+    if (p == 1.0)
+        return INFINITY;
+    if (a == 1.0)
+        return -std::log1pl(-p);
+    return (p <= 0.5) ? gammainvRaw(a, p, logA, lgammaA, false) : gammainvRaw(a, 1.0 - p, logA, lgammaA, true);
+}
+
+double pgammainv(double a, double p)
+{
+    return pgammainv(a, p, std::log(a), std::lgammal(a));
+}
+
+double qgammainv(double a, double q, double logA, double lgammaA)
+{
+    if (a <= 0.0 || q < 0.0 || q > 1.0)
+        throw std::invalid_argument("Parameter a of inverse incomplete gamma function should be positive and probability q should be in interval [0, 1]");
+    if (q == 0.0)
+        return INFINITY;
+    if (q == 1.0)
+        return 0.0;
+    if (a == 1.0)
+        return -std::log(q);
+    return (q <= 0.5) ? gammainvRaw(a, q, logA, lgammaA, true) : gammainvRaw(a, 1.0 - q, logA, lgammaA, false);
+}
+
+double qgammainv(double a, double q)
+{
+    return qgammainv(a, q, std::log(a), std::lgammal(a));
+}
+
 }
@@ -198,6 +198,90 @@ double qgamma(double a, double x, double logX);
  * @return Q(a, x)
  */
 double qgamma(double a, double x);
+
+/**
+ * @fn pgamma
+ * Calculate lower regularized incomplete gamma function for a batch of arguments,
+ * accelerated by using precalculated value of log(a) and log(Γ(a))
+ * @param a non-negative parameter
+ * @param x input vector of non-negative arguments
+ * @param y output vector: y = P(a, x)
+ * @param logA log(a)
+ * @param lgammaA log(Γ(a))
+ */
+void pgamma(double a, const std::vector<double> &x, std::vector<double> &y, double logA, double lgammaA);
+
+/**
+ * @fn pgamma
+ * Calculate lower regularized incomplete gamma function for a batch of arguments
+ * @param a non-negative parameter
+ * @param x input vector of non-negative arguments
+ * @param y output vector: y = P(a, x)
+ */
+void pgamma(double a, const std::vector<double> &x, std::vector<double> &y);
+
+/**
+ * @fn qgamma
+ * Calculate upper regularized incomplete gamma function for a batch of arguments,
+ * accelerated by using precalculated value of log(a) and log(Γ(a))
+ * @param a non-negative parameter
+ * @param x input vector of non-negative arguments
+ * @param y output vector: y = Q(a, x)
+ * @param logA log(a)
+ * @param lgammaA log(Γ(a))
+ */
+void qgamma(double a, const std::vector<double> &x, std::vector<double> &y, double logA, double lgammaA);
+
+/**
+ * @fn qgamma
+ * Calculate upper regularized incomplete gamma function for a batch of arguments
+ * @param a non-negative parameter
+ * @param x input vector of non-negative arguments
+ * @param y output vector: y = Q(a, x)
+ */
+void qgamma(double a, const std::vector<double> &x, std::vector<double> &y);
+
+/**
+ * @fn pgammainv
+ * Calculate inverse of lower regularized incomplete gamma function,
+ * accelerated by using precalculated value of log(a) and log(Γ(a))
+ * @param a positive parameter
+ * @param p probability
+ * @param logA log(a)
+ * @param lgammaA log(Γ(a))
+ * @return such x that P(a, x) = p
+ */
+double pgammainv(double a, double p, double logA, double lgammaA);
+
+/**
+ * @fn pgammainv
+ * Calculate inverse of lower regularized incomplete gamma function
+ * @param a positive parameter
+ * @param p probability
+ * @return such x that P(a, x) = p
+ */
+double pgammainv(double a, double p);
+
+/**
+ * @fn qgammainv
+ * Calculate inverse of upper regularized incomplete gamma function,
+ * accelerated by using precalculated value of log(a) and log(Γ(a))
+ * @param a positive parameter
+ * @param q probability
+ * @param logA log(a)
+ * @param lgammaA log(Γ(a))
+ * @return such x that Q(a, x) = q
+ */
+double qgammainv(double a, double q, double logA, double lgammaA);
+
+/**
+ * @fn qgammainv
+ * Calculate inverse of upper regularized incomplete gamma function
+ * @param a positive parameter
+ * @param q probability
+ * @return such x that Q(a, x) = q
+ */
+double qgammainv(double a, double q);
 }
 
 #endif // GAMMAMATH
@@ -47,6 +47,109 @@ double integral(const std::function<double (double)> &funPtr, double a, double b
     return adaptiveSimpsonsAux(funPtr, a, b, epsilon, S, fa, fb, fc, maxRecursionDepth);
 }
 
+/**
+ * @fn adaptiveSimpsonsAux
+ * auxiliary function for calculation of several integrals on the same nodes
+ * @param funPtr
+ * @param a lower boundary
+ * @param b upper boundary
+ * @param epsilon
+ * @param S Simpson's estimates on [a, b]
+ * @param fa
+ * @param fb
+ * @param fc
+ * @param bottom
+ * @param result sum of the integrals on [a, b] is added to it
+ */
+void adaptiveSimpsonsAux(const std::function<void (double, std::vector<double> &)> &funPtr, double a, double b, double epsilon,
+                         const std::vector<double> &S, const std::vector<double> &fa, const std::vector<double> &fb,
+                         const std::vector<double> &fc, int bottom, std::vector<double> &result)
+{
+    size_t size = S.size();
+    double c = .5 * (a + b), h = (b - a) / 12.0;
+    double d = .5 * (a + c), e = .5 * (c + b);
+    std::vector<double> fd(size), fe(size);
+    funPtr(d, fd);
+    funPtr(e, fe);
+    std::vector<double> Sleft(size), Sright(size);
+    bool isConverged = true;
+    for (size_t i = 0; i != size; ++i) {
+        Sleft[i] = h * (fa[i] + 4 * fd[i] + fc[i]);
+        Sright[i] = h * (fc[i] + 4 * fe[i] + fb[i]);
+        if (std::fabs(Sleft[i] + Sright[i] - S[i]) > 15.0 * epsilon)
+            isConverged = false;
+    }
+    if (bottom <= 0 || isConverged) {
+        for (size_t i = 0; i != size; ++i) {
+            double S2 = Sleft[i] + Sright[i];
+            result[i] += S2 + (S2 - S[i]) / 15.0;
+        }
+        return;
+    }
+    epsilon *= .5;
+    --bottom;
+    adaptiveSimpsonsAux(funPtr, a, c, epsilon, Sleft, fa, fc, fd, bottom, result);
+    adaptiveSimpsonsAux(funPtr, c, b, epsilon, Sright, fc, fb, fe, bottom, result);
+}
+
+std::vector<double> integral(const std::function<void (double, std::vector<double> &)> &funPtr, double a, double b, size_t size,
+                             double epsilon, int maxRecursionDepth)
+{
+    std::vector<double> result(size, 0.0);
+    if (a == b)
+        return result;
+    if (a > b) {
+        result = integral(funPtr, b, a, size, epsilon, maxRecursionDepth);
+        for (double & var : result)
+            var = -var;
+        return result;
+    }
+    double c = .5 * (a + b), h = (b - a) / 6.0;
+    std::vector<double> fa(size), fb(size), fc(size), S(size);
+    funPtr(a, fa);
+    funPtr(b, fb);
+    funPtr(c, fc);
+    for (size_t i = 0; i != size; ++i)
+        S[i] = h * (fa[i] + 4 * fc[i] + fb[i]);
+    adaptiveSimpsonsAux(funPtr, a, b, epsilon, S, fa, fb, fc, maxRecursionDepth, result);
+    return result;
+}
+
+void fft(std::vector<std::complex<double>> &a, bool inverse)
+{
+    size_t size = a.size();
+    if (size < 2)
+        return;
+    if ((size & (size - 1)) != 0)
+        throw std::invalid_argument("Fast Fourier transform: size should be power of 2, but it's equal to "
+                                    + std::to_string(size));
+    /// bit-reversal permutation
+    for (size_t i = 1, j = 0; i != size; ++i) {
+        size_t bit = size >> 1;
+        for (; j & bit; bit >>= 1)
+            j ^= bit;
+        j ^= bit;
+        if (i < j)
+            std::swap(a[i], a[j]);
+    }
+    /// twiddle factors are calculated directly, as recurrence accumulates rounding errors for large sizes
+    size_t halfSize = size >> 1;
+    std::vector<std::complex<double>> twiddles(halfSize);
+    double angle = (inverse ? 2.0 : -2.0) * M_PI / size;
+    for (size_t k = 0; k != halfSize; ++k)
+        twiddles[k] = std::complex<double>(std::cos(angle * k), std::sin(angle * k));
+    for (size_t length = 2; length <= size; length <<= 1) {
+        size_t halfLength = length >> 1, stride = size / length;
+        for (size_t i = 0; i < size; i += length) {
+            for (size_t j = 0; j != halfLength; ++j) {
+                std::complex<double> u = a[i + j], v = a[i + j + halfLength] * twiddles[j * stride];
+                a[i + j] = u + v;
+                a[i + j + halfLength] = u - v;
+            }
+        }
+    }
+}
+
 bool findRootNewtonFirstOrder2d(const std::function<DoublePair (DoublePair)> &funPtr,
                                 const std::function<std::tuple<DoublePair, DoublePair> (DoublePair)> &gradPtr,
                                 DoublePair &root, long double funTol, long double stepTol)
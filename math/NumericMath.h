@@ -20,6 +20,30 @@ namespace RandMath
 double integral(const std::function<double (double)> &funPtr, double a, double b,
                             double epsilon = 1e-11, int maxRecursionDepth = 11);
 
+/**
+ * @fn integral
+ * Adaptive Simpson's rule for several integrands at once:
+ * they share the nodes, and the interval is split until all of them converge
+ * @param funPtr fills the vector of integrands at given point
+ * @param a lower boundary
+ * @param b upper boundary
+ * @param size number of integrands
+ * @param epsilon tolerance for each of the integrands
+ * @param maxRecursionDepth how deep should the algorithm go
+ * @return integrals
+ */
+std::vector<double> integral(const std::function<void (double, std::vector<double> &)> &funPtr, double a, double b, size_t size,
+                             double epsilon = 1e-11, int maxRecursionDepth = 11);
+
+/**
+ * @fn fft
+ * In-place radix-2 fast Fourier transform:
+ * a_j := Σ a_k exp(-2πijk / N) or Σ a_k exp(2πijk / N) for inverse transform (without normalization)
+ * @param a vector, which size N should be power of 2
+ * @param inverse
+ */
+void fft(std::vector<std::complex<double>> &a, bool inverse = false);
+
 /**
  * @fn findRootNewtonSecondOrder
  * Newton's root-finding procedure,
@@ -235,6 +259,99 @@ bool findRootNewtonFirstOrder(const std::function<double (RealType)> &funPtr, Re
     return true;
 }
 
+/**
+ * @fn findRootNewtonBracketed
+ * Safeguarded Newton's root-finding procedure
+ * for nondecreasing function on interval [a, b], containing the root.
+ * Halley's correction is used if second derivative is known,
+ * bisection - if the step leaves the interval or makes no progress.
+ * Boundaries can be infinite, then the interval is expanded geometrically
+ * @param funPtr mapping x |-> (f(x), f'(x), f''(x)), f''(x) should be 0 if unknown
+ * @param a lower boundary, f(a) <= 0
+ * @param b upper boundary, f(b) >= 0
+ * @param root starting point in input and such x that f(x) = 0 in output
+ * @param epsilon relative tolerance
+ * @return true if success, false otherwise
+ */
+template<typename RealType>
+bool findRootNewtonBracketed(const std::function<DoubleTriplet (RealType)> &funPtr, RealType a, RealType b, RealType & root, long double epsilon = 1e-12)
+{
+    /// Sanity check
+    epsilon = std::max<long double>(epsilon, std::numeric_limits<RealType>::epsilon());
+    static constexpr int MAX_ITER = 200;
+    static constexpr double MAX_STEP = 10;
+    if (!(root >= a && root <= b)) {
+        if (std::isfinite(a))
+            root = std::isfinite(b) ? 0.5 * (a + b) : a;
+        else
+            root = std::isfinite(b) ? b : 0.0;
+    }
+    double step = b - a, oldStep = step;
+    double oldF = INFINITY;
+    for (int iter = 0; iter != MAX_ITER; ++iter) {
+        auto [f, fx, fxx] = funPtr(root);
+        if (f == 0.0)
+            return true;
+        if (f < 0)
+            a = root;
+        else if (f > 0)
+            b = root;
+        else
+            return false; /// nan
+        double newtonStep = f / fx;
+        if (fxx != 0.0 && std::isfinite(fxx)) {
+            /// Halley's correction, applied only if it is moderate
+            double denominator = 1.0 - 0.5 * newtonStep * fxx / fx;
+            if (denominator > 0.5 && denominator < 2.0)
+                newtonStep /= denominator;
+        }
+        RealType newRoot = root - newtonStep;
+        double tol = epsilon * std::fabs(root) + std::numeric_limits<RealType>::min();
+        /// Newton's step is negligible, further iterations are dominated by rounding errors of f
+        if (std::fabs(newtonStep) <= tol) {
+            if (newRoot >= a && newRoot <= b)
+                root = newRoot;
+            return true;
+        }
+        if (b - a <= tol) {
+            if (newRoot > a && newRoot < b)
+                root = newRoot;
+            return true;
+        }
+        /// step is bounded if the interval is infinite
+        double maxStep = MAX_STEP * (std::fabs(root) + 1.0);
+        bool isBounded = std::isfinite(a) && std::isfinite(b);
+        /// Newton's step is accepted if it either shrinks fast enough or halves the residual
+        bool isProgressing = std::fabs(2 * newtonStep) <= std::fabs(oldStep) || std::fabs(f) <= 0.5 * std::fabs(oldF);
+        oldF = f;
+        if (fx > 0 && newRoot > a && newRoot < b && isProgressing &&
+            (isBounded || std::fabs(newtonStep) <= maxStep)) {
+            oldStep = step;
+            step = newtonStep;
+        }
+        else if (isBounded) {
+            /// bisection
+            oldStep = step;
+            step = 0.5 * (b - a);
+            newRoot = a + step;
+        }
+        else {
+            /// expansion of the interval
+            oldStep = step;
+            step = std::isfinite(b) ? maxStep : -maxStep;
+            newRoot = root - step;
+        }
+        if (!std::isfinite(newRoot))
+            return false;
+        if (std::fabs(newRoot - root) <= tol || newRoot <= a || newRoot >= b) {
+            root = newRoot;
+            return true;
+        }
+        root = newRoot;
+    }
+    return false;
+}
+
 /**
  * @fn parabolicMinimum
  * @param a < b < c
@@ -47,6 +47,44 @@ double log2mexp(double x)
     return std::log1pl(-std::expm1l(x));
 }
 
+/// Chebyshev coefficients of inverse erf for |1 - p| < 5e-16
+static constexpr int erfinvMuSize = 26;
+static constexpr long double erfinvMu[erfinvMuSize] = {.9885750640661893136460358l, .0108577051845994776160281l, -.0017511651027627952594825l, .0000211969932065633437984l,
+                                                       .0000156648714042435087911l, -.05190416869103124261e-5l, -.00371357897426717780e-5l, .00012174308662357429e-5l,
+                                                      -.00001768115526613442e-5l, -.119372182556161e-10l, .003802505358299e-10l, -.000660188322362e-10l, -.000087917055170e-10l,
+                                                      -.3506869329e-15l, -.0697221497e-15l, -.0109567941e-15l, -.0011536390e-15l, -.0000263938e-15l, .05341e-20l, -.22610e-20l,
+                                                       .09552e-20l, -.05250e-20l, .02487e-20l, -.01134e-20l, .00420e-20l};
+
+/// Chebyshev coefficients of inverse erf for 5e-16 < |1 - p| < 0.025
+static constexpr int erfinvDeltaSize = 38;
+static constexpr long double erfinvDelta[erfinvDeltaSize] = {.9566797090204925274526373l, -.0231070043090649036999908l, -.0043742360975084077333218l, -.0005765034226511854809364l,
+                                                            -.0000109610223070923931242l, .0000251085470246442787982l, .0000105623360679477511955l, .27544123300306391503e-5l,
+                                                             .04324844983283380689e-5l, -.00205303366552086916e-5l, -.00438915366654316784e-5l, -.00176840095080881795e-5l,
+                                                            -.00039912890280463420e-5l, -.00001869324124559212e-5l, .00002729227396746077e-5l, .00001328172131565497e-5l,
+                                                             .318342484482286e-10l, .016700607751926e-10l, -.020364649611537e-10l, -.009648468127965e-10l, -.002195672778128e-10l,
+                                                            -.000095689813014e-10l, .000137032572230e-10l, .000062538505417e-10l, .000014584615266e-10l, .1078123993e-15l,
+                                                            -.0709229988e-15l, -.0391411775e-15l, -.0111659209e-15l, -.0015770366e-15l, .0002853149e-15l, .0002716662e-15l,
+                                                             .0000176835e-15l, .09828e-20l, .20464e-20l, .08020e-20l, .01650e-20l};
+
+/// Chebyshev coefficients of inverse erf for 0.8 < p < 0.975
+static constexpr int erfinvLambdaSize = 27;
+static constexpr long double erfinvLambda[erfinvLambdaSize] = {.9121588034175537733059200l, -.0162662818676636958546661l, .0004335564729494453650589l, .0002144385700744592065205l,
+                                                               .26257510757648130176e-5l, -.30210910501037969912e-5l, -.00124060618367572157e-5l, .00624066092999917380e-5l,
+                                                              -.00005401247900957858e-5l, -.00014232078975315910e-5l, .343840281955305e-10l, .335848703900138e-10l, -.014584288516512e-10l,
+                                                              -.008102174258833e-10l, .000525324085874e-10l, .000197115408612e-10l, -.000017494333828e-10l, -.4800596619e-15l, .0557302987e-15l,
+                                                               .0116326054e-15l, -.0017262489e-15l, -.0002784973e-15l, .0000524481e-15l, .65270e-20l, -.15707e-20l, -.01475e-20l, .00450e-20l};
+
+/// Chebyshev coefficients of inverse erf for 0 < p < 0.8
+static constexpr int erfinvXiSize = 39;
+static constexpr long double erfinvXi[erfinvXiSize] = {.9928853766189408231495800l, .1204675161431044864647846l, .0160781993420999447267039l, .0026867044371623158279591l,
+                                                       .0004996347302357262947170l, .0000988982185991204409911l, .0000203918127639944337340l, .43272716177354218758e-5l,
+                                                       .09380814128593406758e-5l, .02067347208683427411e-5l, .00461596991054300078e-5l, .00104166797027146217e-5l,
+                                                       .00023715009995921222e-5l, .00005439284068471390e-5l, .00001255489864097987e-5l, .291381803663201e-10l,
+                                                       .067949421808797e-10l, .015912343331569e-10l, .003740250585245e-10l, .000882087762421e-10l, .000208650897725e-10l,
+                                                       .000049488041039e-10l, .000011766394740e-10l, .2803855725e-15l, .0669506638e-15l, .0160165495e-15l, .0038382583e-15l,
+                                                       .0009212851e-15l, .0002214615e-15l, .0000533091e-15l, .0000128488e-15l, .31006e-20l, .07491e-20l, .01812e-20l,
+                                                       .00439e-20l, .00106e-20l, .00026e-20l, .00006e-20l, .00002e-20l};
+
 double erfinvChebyshevSeries(double x, long double t, const long double *array, int size)
 {
     /// We approximate inverse erf via Chebyshev polynomials
@@ -66,57 +104,27 @@ double erfinvAux1(double beta)
 {
     /// |1 - p| < 5e-16
     static constexpr long double D5 = -9.199992358830151031278420l, D6 = 2.794990820124599493768426l;
-    static constexpr int muSize = 26;
-    static constexpr long double mu[muSize] = {.9885750640661893136460358l, .0108577051845994776160281l, -.0017511651027627952594825l, .0000211969932065633437984l,
-                                               .0000156648714042435087911l, -.05190416869103124261e-5l, -.00371357897426717780e-5l, .00012174308662357429e-5l,
-                                              -.00001768115526613442e-5l, -.119372182556161e-10l, .003802505358299e-10l, -.000660188322362e-10l, -.000087917055170e-10l,
-                                              -.3506869329e-15l, -.0697221497e-15l, -.0109567941e-15l, -.0011536390e-15l, -.0000263938e-15l, .05341e-20l, -.22610e-20l,
-                                               .09552e-20l, -.05250e-20l, .02487e-20l, -.01134e-20l, .00420e-20l};
-    return erfinvChebyshevSeries(beta, D5 / std::sqrt(beta) + D6, mu, muSize);
+    return erfinvChebyshevSeries(beta, D5 / std::sqrt(beta) + D6, erfinvMu, erfinvMuSize);
 }
 
 double erfinvAux2(double beta)
 {
     /// 5e-16 < |1 - p| < 0.025
     static constexpr long double D3 = -0.5594576313298323225436913l, D4 = 2.287915716263357638965891l;
-    static constexpr int deltaSize = 38;
-    static constexpr long double delta[deltaSize] = {.9566797090204925274526373l, -.0231070043090649036999908l, -.0043742360975084077333218l, -.0005765034226511854809364l,
-                                                    -.0000109610223070923931242l, .0000251085470246442787982l, .0000105623360679477511955l, .27544123300306391503e-5l,
-                                                     .04324844983283380689e-5l, -.00205303366552086916e-5l, -.00438915366654316784e-5l, -.00176840095080881795e-5l,
-                                                    -.00039912890280463420e-5l, -.00001869324124559212e-5l, .00002729227396746077e-5l, .00001328172131565497e-5l,
-                                                     .318342484482286e-10l, .016700607751926e-10l, -.020364649611537e-10l, -.009648468127965e-10l, -.002195672778128e-10l,
-                                                    -.000095689813014e-10l, .000137032572230e-10l, .000062538505417e-10l, .000014584615266e-10l, .1078123993e-15l,
-                                                    -.0709229988e-15l, -.0391411775e-15l, -.0111659209e-15l, -.0015770366e-15l, .0002853149e-15l, .0002716662e-15l,
-                                                     .0000176835e-15l, .09828e-20l, .20464e-20l, .08020e-20l, .01650e-20l};
-    return erfinvChebyshevSeries(beta, D3 * beta + D4, delta, deltaSize);
+    return erfinvChebyshevSeries(beta, D3 * beta + D4, erfinvDelta, erfinvDeltaSize);
 }
 
 double erfinvAux3(double beta)
 {
     /// 0.8 < p < 0.975
     static constexpr long double D1 = -1.548813042373261659512742l, D2 = 2.565490123147816151928163l;
-    static constexpr int lambdaSize = 27;
-    static constexpr long double lambda[lambdaSize] = {.9121588034175537733059200l, -.0162662818676636958546661l, .0004335564729494453650589l, .0002144385700744592065205l,
-                                                       .26257510757648130176e-5l, -.30210910501037969912e-5l, -.00124060618367572157e-5l, .00624066092999917380e-5l,
-                                                      -.00005401247900957858e-5l, -.00014232078975315910e-5l, .343840281955305e-10l, .335848703900138e-10l, -.014584288516512e-10l,
-                                                      -.008102174258833e-10l, .000525324085874e-10l, .000197115408612e-10l, -.000017494333828e-10l, -.4800596619e-15l, .0557302987e-15l,
-                                                       .0116326054e-15l, -.0017262489e-15l, -.0002784973e-15l, .0000524481e-15l, .65270e-20l, -.15707e-20l, -.01475e-20l, .00450e-20l};
-    return erfinvChebyshevSeries(beta, D1 * beta + D2, lambda, lambdaSize);
+    return erfinvChebyshevSeries(beta, D1 * beta + D2, erfinvLambda, erfinvLambdaSize);
 }
 
 double erfinvAux4(double p)
 {
     /// 0 < p < 0.8
-    static constexpr int xiSize = 39;
-    static constexpr long double xi[xiSize] = {.9928853766189408231495800l, .1204675161431044864647846l, .0160781993420999447267039l, .0026867044371623158279591l,
-                                               .0004996347302357262947170l, .0000988982185991204409911l, .0000203918127639944337340l, .43272716177354218758e-5l,
-                                               .09380814128593406758e-5l, .02067347208683427411e-5l, .00461596991054300078e-5l, .00104166797027146217e-5l,
-                                               .00023715009995921222e-5l, .00005439284068471390e-5l, .00001255489864097987e-5l, .291381803663201e-10l,
-                                               .067949421808797e-10l, .015912343331569e-10l, .003740250585245e-10l, .000882087762421e-10l, .000208650897725e-10l,
-                                               .000049488041039e-10l, .000011766394740e-10l, .2803855725e-15l, .0669506638e-15l, .0160165495e-15l, .0038382583e-15l,
-                                               .0009212851e-15l, .0002214615e-15l, .0000533091e-15l, .0000128488e-15l, .31006e-20l, .07491e-20l, .01812e-20l,
-                                               .00439e-20l, .00106e-20l, .00026e-20l, .00006e-20l, .00002e-20l};
-    return erfinvChebyshevSeries(p, p * p / 0.32 - 1.0, xi, xiSize);
+    return erfinvChebyshevSeries(p, p * p / 0.32 - 1.0, erfinvXi, erfinvXiSize);
 }
 
 double erfinv(double p)
@@ -157,6 +165,129 @@ double erfcinv(double p)
     return (p > 5e-16) ? erfinvAux2(beta) : erfinvAux1(beta);
 }
 
+/**
+ * @fn erfinvChebyshevSeries
+ * Chebyshev series of inverse erf for a batch of arguments
+ * @param x
+ * @param t arguments of Chebyshev polynomials
+ * @param array coefficients
+ * @param size amount of coefficients
+ * @param y output vector
+ */
+void erfinvChebyshevSeries(const std::vector<double> &x, const std::vector<long double> &t, const long double *array, int size, std::vector<double> &y)
+{
+    size_t n = x.size();
+    std::vector<long double> Tn(t), Tnm1(n, 1.0), sum(n, 0.0);
+    for (int i = 1; i != size; ++i) {
+        long double coef = array[i];
+        for (size_t j = 0; j != n; ++j) {
+            sum[j] += coef * Tn[j];
+            /// calculate next Chebyshev polynomial
+            double temp = Tn[j];
+            Tn[j] *= 2 * t[j];
+            Tn[j] -= Tnm1[j];
+            Tnm1[j] = temp;
+        }
+    }
+    for (size_t j = 0; j != n; ++j)
+        y[j] = x[j] * (array[0] + sum[j]);
+}
+
+/**
+ * @fn inverseErrorFunction
+ * Calculate erfinv(p) or erfcinv(p) for a batch of arguments,
+ * grouping them by the Chebyshev series, which should be used
+ * @param p
+ * @param y output vector
+ * @param isComplement true if erfcinv(p) should be returned, erfinv(p) otherwise
+ */
+void inverseErrorFunction(const std::vector<double> &p, std::vector<double> &y, bool isComplement)
+{
+    static constexpr long double D1 = -1.548813042373261659512742l, D2 = 2.565490123147816151928163l;
+    static constexpr long double D3 = -0.5594576313298323225436913l, D4 = 2.287915716263357638965891l;
+    static constexpr long double D5 = -9.199992358830151031278420l, D6 = 2.794990820124599493768426l;
+    static constexpr int numberOfSeries = 4;
+    static constexpr const long double *coefs[numberOfSeries] = {erfinvMu, erfinvDelta, erfinvLambda, erfinvXi};
+    static constexpr int sizes[numberOfSeries] = {erfinvMuSize, erfinvDeltaSize, erfinvLambdaSize, erfinvXiSize};
+    size_t size = p.size();
+    if (size > y.size())
+        return;
+    std::vector<size_t> indices[numberOfSeries];
+    std::vector<double> args[numberOfSeries], signs[numberOfSeries];
+    std::vector<long double> chebyshevArgs[numberOfSeries];
+    for (size_t i = 0; i != size; ++i) {
+        double pi = p[i], sign = 1.0;
+        if (!isComplement) {
+            if (pi < 0.0) {
+                pi = -pi;
+                sign = -1.0;
+            }
+            if (pi > 1.0)
+                throw std::invalid_argument("Argument p should be in interval [-1, 1]");
+            if (pi == 1.0 || pi == 0.0) {
+                y[i] = (pi == 0.0) ? 0.0 : sign * INFINITY;
+                continue;
+            }
+        }
+        else {
+            if (pi < 0.0 || pi > 2.0)
+                throw std::invalid_argument("Argument p should be in interval [0, 2]");
+            if (pi > 1.0) {
+                pi = 2.0 - pi;
+                sign = -1.0;
+            }
+            if (pi == 0.0 || pi == 1.0) {
+                y[i] = (pi == 1.0) ? 0.0 : sign * INFINITY;
+                continue;
+            }
+        }
+        /// series #3 is used in the center, the rest of them - for the tails
+        bool isCenter = isComplement ? pi > 0.2 : pi < 0.8;
+        if (isCenter) {
+            double x = isComplement ? 1.0 - pi : pi;
+            indices[3].push_back(i);
+            args[3].push_back(x);
+            chebyshevArgs[3].push_back(x * x / 0.32 - 1.0);
+            signs[3].push_back(sign);
+            continue;
+        }
+        double beta = 0, q = 0;
+        if (isComplement) {
+            beta = std::sqrt(-std::log(2 * pi - pi * pi));
+            q = pi;
+        }
+        else {
+            beta = std::sqrt(-std::log1pl(-pi * pi));
+            q = 1.0 - pi;
+        }
+        int series = (q > 0.0025) ? 2 : ((q > 5e-16) ? 1 : 0);
+        long double t = (series == 2) ? D1 * beta + D2 : ((series == 1) ? D3 * beta + D4 : D5 / std::sqrt(beta) + D6);
+        indices[series].push_back(i);
+        args[series].push_back(beta);
+        chebyshevArgs[series].push_back(t);
+        signs[series].push_back(sign);
+    }
+    for (int series = 0; series != numberOfSeries; ++series) {
+        size_t seriesSize = indices[series].size();
+        if (seriesSize == 0)
+            continue;
+        std::vector<double> res(seriesSize);
+        erfinvChebyshevSeries(args[series], chebyshevArgs[series], coefs[series], sizes[series], res);
+        for (size_t i = 0; i != seriesSize; ++i)
+            y[indices[series][i]] = signs[series][i] * res[i];
+    }
+}
+
+void erfinv(const std::vector<double> &p, std::vector<double> &y)
+{
+    inverseErrorFunction(p, y, false);
+}
+
+void erfcinv(const std::vector<double> &p, std::vector<double> &y)
+{
+    inverseErrorFunction(p, y, true);
+}
+
 double xexpxsqerfc(double x)
 {
     static constexpr int MAX_X = 10;
@@ -177,20 +308,6 @@ double xexpxsqerfc(double x)
     return (1.0 + sum) / M_SQRTPI;
 }
 
-double harmonicNumber(double exponent, int number)
-{
-    if (number < 1)
-        return 0;
-    if (exponent == 1)
-        return M_EULER + digamma(number + 1);
-    if (exponent == 2)
-        return M_PI_SQ / 6.0 - trigamma(number + 1);
-    double res = 1.0;
-    for (int i = 2; i <= number; ++i)
-        res += std::pow(i, -exponent);
-    return res;
-}
-
 #if HAVE_MATH_SPECIAL_FUNCTIONS
 long double logBesselI(double nu, double x)
 {
@@ -215,12 +332,12 @@ long double logBesselI(double nu, double x)
     if (std::fabs(nu) == 0.5) {
         /// log(sinh(x)) or log(cosh(x))
         long double y = x - 0.5 * (M_LN2 + M_LNPI + std::log(x));
-        y += (nu > 0) ? RandMath::softplus(-2 * x) : RandMath::log1mexp(-2 * x);
+        y += (nu > 0) ? RandMath::log1mexp(-2 * x) : RandMath::softplus(-2 * x);
         return y;
     }
 
     if (nu < 0) {
-        /// I(ν, x) = I(−ν, x) - 2 / π sin(πν) K(ν, x)
+        /// I(ν, x) = I(−ν, x) + 2 / π sin(−πν) K(−ν, x)
         long double besseli = std::cyl_bessel_il(-nu, x);
         long double sinPiNu = -std::sin(M_PI * nu);
         long double y = 0;
@@ -228,7 +345,7 @@ long double logBesselI(double nu, double x)
             y = besseli;
         else {
             long double besselk = std::cyl_bessel_kl(-nu, x);
-            y = besseli - M_2_PI * sinPiNu * besselk;
+            y = besseli + M_2_PI * sinPiNu * besselk;
         }
         return (y <= 0) ? -INFINITY : std::log(y);
     }
@@ -255,6 +372,158 @@ long double logBesselK(double nu, double x)
 
     return std::log(besselk);
 }
+
+/**
+ * @fn besselHankelCoefficients
+ * @param nu
+ * @param minX the smallest argument, for which asymptotic expansion is used
+ * @return coefficients a_k(ν) = (4ν^2 - 1)(4ν^2 - 9)...(4ν^2 - (2k-1)^2) / (k! 8^k)
+ * of Hankel asymptotic expansion, truncated when a_k(ν) / minX^k becomes negligible
+ */
+std::vector<double> besselHankelCoefficients(double nu, double minX)
+{
+    static constexpr int MAX_TERMS = 100;
+    double mu = 4 * nu * nu;
+    std::vector<double> coefs = {1.0};
+    double term = 1.0;
+    for (int k = 1; k != MAX_TERMS; ++k) {
+        double oddSq = 2 * k - 1;
+        oddSq *= oddSq;
+        double coef = coefs.back() * (mu - oddSq) / (8 * k);
+        double nextTerm = term * (mu - oddSq) / (8 * k * minX);
+        /// stop if the terms become negligible or start to grow
+        if (coef == 0.0 || std::fabs(nextTerm) < MIN_POSITIVE || std::fabs(nextTerm) > std::fabs(term))
+            break;
+        term = nextTerm;
+        coefs.push_back(coef);
+    }
+    return coefs;
+}
+
+/**
+ * @fn logBesselAsymptotic
+ * Hankel asymptotic expansion of log(I_ν(x)) or log(K_ν(x)) for a batch of large arguments
+ * @param nu
+ * @param x
+ * @param y output vector
+ * @param isFirstKind true if log(I_ν(x)) should be returned, log(K_ν(x)) otherwise
+ */
+void logBesselAsymptotic(double nu, const std::vector<double> &x, std::vector<double> &y, bool isFirstKind)
+{
+    size_t size = x.size();
+    double minX = *std::min_element(x.begin(), x.end());
+    std::vector<double> coefs = besselHankelCoefficients(nu, minX);
+    /// Horner's scheme in 1/x, evaluated for all arguments at once
+    std::vector<double> w(size), sum(size, coefs.back());
+    for (size_t i = 0; i != size; ++i)
+        w[i] = isFirstKind ? -1.0 / x[i] : 1.0 / x[i];
+    for (int k = coefs.size() - 2; k >= 0; --k) {
+        double coef = coefs[k];
+        for (size_t i = 0; i != size; ++i)
+            sum[i] = sum[i] * w[i] + coef;
+    }
+    for (size_t i = 0; i != size; ++i) {
+        double logX = std::log(x[i]);
+        y[i] = isFirstKind ? x[i] - 0.5 * (M_LN2 + M_LNPI + logX) : 0.5 * (M_LNPI - M_LN2 - logX) - x[i];
+        y[i] += std::log(sum[i]);
+    }
+}
+
+/**
+ * @fn logBesselIPowerSeries
+ * power series of log(I_ν(x)) for a batch of arguments, ν > -1
+ * @param nu
+ * @param x
+ * @param y output vector
+ */
+void logBesselIPowerSeries(double nu, const std::vector<double> &x, std::vector<double> &y)
+{
+    size_t size = x.size();
+    std::vector<double> z(size), addon(size, 1.0), sum(size, 1.0);
+    for (size_t i = 0; i != size; ++i)
+        z[i] = 0.25 * x[i] * x[i];
+    /// all series are summed up at once, converged ones are dropped from the active set
+    std::vector<size_t> active(size);
+    std::iota(active.begin(), active.end(), 0);
+    for (int k = 1; !active.empty(); ++k) {
+        double coef = 1.0 / (k * (k + nu));
+        size_t activeSize = 0;
+        for (size_t i : active) {
+            addon[i] *= coef * z[i];
+            sum[i] += addon[i];
+            if (addon[i] > MIN_POSITIVE * sum[i])
+                active[activeSize++] = i;
+        }
+        active.resize(activeSize);
+    }
+    double lgammaNup1 = std::lgammal(nu + 1);
+    for (size_t i = 0; i != size; ++i)
+        y[i] = nu * std::log(0.5 * x[i]) - lgammaNup1 + std::log(sum[i]);
+}
+
+/**
+ * @fn logBessel
+ * Calculate log(I_ν(x)) or log(K_ν(x)) for a batch of arguments,
+ * grouping them by the method of evaluation
+ * @param nu
+ * @param x
+ * @param y output vector
+ * @param isFirstKind true if log(I_ν(x)) should be returned, log(K_ν(x)) otherwise
+ */
+void logBessel(double nu, const std::vector<double> &x, std::vector<double> &y, bool isFirstKind)
+{
+    /// power series is used for x <= SERIES_MAX_X, asymptotic expansion - for x > ASYMPTOTIC_MIN_X and x > ν^2
+    static constexpr double SERIES_MAX_X = 30.0, ASYMPTOTIC_MIN_X = 30.0;
+    size_t size = x.size();
+    if (size > y.size())
+        return;
+    if (!isFirstKind && nu < 0.0) {
+        /// K(-ν, x) = -K(ν, x) < 0
+        std::fill(y.begin(), y.begin() + size, NAN);
+        return;
+    }
+    std::vector<size_t> seriesIndices, asymptoticIndices;
+    std::vector<double> seriesArgs, asymptoticArgs;
+    bool isSeriesApplicable = isFirstKind && nu > -1;
+    double asymptoticMinX = std::max(ASYMPTOTIC_MIN_X, nu * nu);
+    for (size_t i = 0; i != size; ++i) {
+        double xi = x[i];
+        if (xi > asymptoticMinX) {
+            asymptoticIndices.push_back(i);
+            asymptoticArgs.push_back(xi);
+        }
+        else if (isSeriesApplicable && xi > 0 && xi <= SERIES_MAX_X) {
+            seriesIndices.push_back(i);
+            seriesArgs.push_back(xi);
+        }
+        else {
+            /// special values and the rest of arguments
+            y[i] = isFirstKind ? logBesselI(nu, xi) : logBesselK(nu, xi);
+        }
+    }
+    if (!seriesIndices.empty()) {
+        std::vector<double> res(seriesIndices.size());
+        logBesselIPowerSeries(nu, seriesArgs, res);
+        for (size_t i = 0; i != res.size(); ++i)
+            y[seriesIndices[i]] = res[i];
+    }
+    if (!asymptoticIndices.empty()) {
+        std::vector<double> res(asymptoticIndices.size());
+        logBesselAsymptotic(nu, asymptoticArgs, res, isFirstKind);
+        for (size_t i = 0; i != res.size(); ++i)
+            y[asymptoticIndices[i]] = res[i];
+    }
+}
+
+void logBesselI(double nu, const std::vector<double> &x, std::vector<double> &y)
+{
+    logBessel(nu, x, y, true);
+}
+
+void logBesselK(double nu, const std::vector<double> &x, std::vector<double> &y)
+{
+    logBessel(nu, x, y, false);
+}
 #else
 long double logBesselI(double nu, double x)
 {
@@ -264,6 +533,14 @@ long double logBesselK(double nu, double x)
 {
     throw std::runtime_error("RandLib compiler does not support math special functions");
 }
+void logBesselI(double, const std::vector<double> &, std::vector<double> &)
+{
+    throw std::runtime_error("RandLib compiler does not support math special functions");
+}
+void logBesselK(double, const std::vector<double> &, std::vector<double> &)
+{
+    throw std::runtime_error("RandLib compiler does not support math special functions");
+}
 
 #endif
 /**
@@ -319,248 +596,412 @@ double Wm1Lambert(double x, double epsilon)
 }
 
 /**
- * @fn MarcumPSeries
+ * @fn marcumPoissonBounds
+ * Poisson weights e^(-x) x^n / n! outside of [nMin, nMax] sum up to less than 1e-18
+ * (Bernstein inequality for the tails of Poisson distribution)
+ * @param x
+ * @param nMin
+ * @param nMax
+ */
+void marcumPoissonBounds(double x, int &nMin, int &nMax)
+{
+    static constexpr double LOG_EPS = 42.0; ///< -log(1e-18) rounded up
+    double leftWidth = std::sqrt(2 * LOG_EPS * x);
+    double rightWidth = LOG_EPS / 3 + std::sqrt(LOG_EPS * LOG_EPS / 9 + 2 * LOG_EPS * x);
+    nMin = std::max(std::floor(x - leftWidth), 0.0);
+    nMax = std::ceil(x + rightWidth);
+}
+
+/**
+ * @fn marcumTruncatedIndex
+ * For small x y, terms w_n P(μ + n, y) decay much faster than Poisson weights,
+ * as they are bounded by e^(-x) (x y)^n y^μ / (n! Γ(μ + n + 1))
  * @param mu
  * @param x
  * @param y
- * @param logX log(x)
- * @param logY log(y)
- * @return series expansion for Marcum-P function
+ * @param nMax right bound of Poisson weights
+ * @return index, after which the rest of the terms for P_μ(x, y) are negligible
  */
-double MarcumPSeries(double mu, double x, double y, double logX, double logY)
-{
-    /// ~log(2πε) for ε = 1e-16
-    static constexpr double ln2piEps = -35.0;
-    double lgammamu = std::lgammal(mu);
-    double C = lgammamu - ln2piEps + mu;
-
-    /// solving equation f(n) = 0
-    /// to find first negleted term
-    double root = std::max(0.5 * (mu * mu + 4 * x * y - mu), 1.0);
-    double logXY = logX + logY;
-    if (!RandMath::findRootNewtonSecondOrder<double>([C, mu, logXY] (double n)
-    {
-        double npmu = n + mu;
-        double logn = std::log(n), lognpmu = std::log(npmu);
-        double first = logn - 2 - logXY;
-        first *= n;
-        first += npmu * lognpmu;
-        first -= C;
-        double second = logn + lognpmu - logXY;
-        double third = 1.0 / n + 1.0 / npmu;
-        return DoubleTriplet(first, second, third);
-    }, root))
-        /// unexpected return
-        throw std::runtime_error("Marcum P function: failure in numerical procedure");
-
-    /// series expansion
-    double sum = 0.0;
-    /// sanity check
-    int n0 = std::max(std::ceil(root), 5.0);
-    double mpn0 = mu + n0;
-    double P = pgamma(mpn0, y, logY);
-    double diffP = (mpn0 - 1) * logY - y - std::lgammal(mpn0);
-    diffP = std::exp(diffP);
-    for (int n = n0; n > 0; --n) {
-        double term = n * logX - x - lfact(n);
-        double mupnm1 = mu + n - 1;
-        term = std::exp(term) * P;
-        sum += term;
-        if (n % 5 == 0) {
-            /// every 5 iterations we recalculate P and diffP
-            /// in order to achieve enough accuracy
-            P = pgamma(mupnm1, y, logY);
-            diffP = (mupnm1 - 1) * logY - y - std::lgammal(mupnm1);
-            diffP = std::exp(diffP);
-        }
-        else {
-            /// otherwise we use recurrent relations
-            P += diffP;
-            diffP *= mupnm1 / y;
-        }
+int marcumTruncatedIndex(double mu, double x, double y, int nMax)
+{
+    /// ratio of the bound and the first term is at most e^y
+    double threshold = 1e-18 * std::exp(-std::min(y, 500.0));
+    double xy = x * y, relative = 1.0;
+    for (int n = 0; n != nMax; ++n) {
+        relative *= xy / ((n + 1) * (mu + n + 1));
+        if (relative > 1.0)
+            relative = 1.0;
+        else if (relative < threshold)
+            return n + 1;
     }
-    /// add the last 0-term
-    double lastTerm = lpgamma(mu, y, logY) - x;
-    lastTerm = std::exp(lastTerm);
-    sum += lastTerm;
-    return sum;
+    return nMax;
 }
 
 /**
- * @fn MarcumPAsymptoticForLargeXY
+ * @fn MARCUM_EPSILON
+ * relative accuracy of the series for Marcum functions
+ */
+constexpr double MARCUM_EPSILON = 1e-17;
+
+/**
+ * @fn MARCUM_RESCALE
+ * the sum of the series is rescaled, when it or the next addend exceeds this value
+ */
+constexpr double MARCUM_RESCALE = 1e250;
+
+/**
+ * @fn marcumPoissonSeries
+ * Calculate P_μ(x, y) = e^(-x) Σ x^n / n! P(μ + n, y), if y < x + μ,
+ * or Q_μ(x, y) = e^(-x) Σ x^n / n! Q(μ + n, y) otherwise.
+ * Only one incomplete gamma function is evaluated,
+ * the rest of them come from the recurrence, which adds positive terms only:
+ * P is summed up backward from the right tail of Poisson weights and Q - forward from the left one
  * @param mu
  * @param x
  * @param y
- * @param sqrtX √x
- * @param sqrtY √y
- * @return asymptotic expansion for Marcum-P function for large x*y
+ * @param logY log(y)
+ * @param density derivative of P_μ(x, y) by y in output
+ * @return P_μ(x, y), if y < x + μ, and Q_μ(x, y) otherwise
  */
-double MarcumPAsymptoticForLargeXY(double mu, double x, double y, double sqrtX, double sqrtY)
-{
-    double xi = 2 * sqrtX * sqrtY;
-    double sigma = (y + x) / xi - 1;
-    double sigmaXi = sigma * xi;
-    double rho = sqrtY / sqrtX;
-    double aux = std::erfc(sqrtX - sqrtY);
-    double Phi = (sigma == 0) ? 0.0 : sign(x - y) * std::sqrt(M_PI / sigma) * aux;
-    double Psi0 = aux / std::sqrt(rho);
-    double logXi = M_LN2 + 0.5 * std::log(x * y);
-    /// sanity check
-    int n0 = std::max(std::ceil(sigmaXi), 7.0);
-    double sum = 0.0;
-    double A1 = 1.0, A2 = 1.0;
-    for (int n = 1; n <= n0; ++n) {
-        /// change φ
-        double nmHalf = n - 0.5;
-        Phi *= -sigma;
-        double temp = -sigmaXi - nmHalf * logXi;
-        Phi += std::exp(temp);
-        Phi /= nmHalf;
-        /// calculate A(μ-1) and A(μ)
-        double coef1 = (nmHalf - mu) * (nmHalf + mu);
-        double coef2 = (nmHalf - mu + 1) * (nmHalf + mu - 1);
-        double denom = -2 * n;
-        A1 *= coef1 / denom;
-        A2 *= coef2 / denom;
-        /// compute term ψ and add it to the sum
-        double Psi = Phi * (A2 - A1 / rho);
-        sum += (n & 1) ? Psi : -Psi;
+double marcumPoissonSeries(double mu, double x, double y, double logY, double &density)
+{
+    int nMin = 0, nMax = 0;
+    marcumPoissonBounds(x, nMin, nMax);
+    bool isP = y < x + mu;
+    int n = isP ? marcumTruncatedIndex(mu, x, y, nMax) : nMin;
+    double a = mu + n;
+    /// logarithms are multiplied by large numbers, so they should be calculated more accurately
+    long double logXl = std::log(static_cast<long double>(x)), logYl = std::log(static_cast<long double>(y));
+    long double logW = n * logXl - x - std::lgammal(n + 1);
+    /// u is the current term w_n P(μ + n, y) or w_n Q(μ + n, y),
+    /// v is w_n y^(μ + n) e^(-y) / Γ(μ + n + 1) (w_(n-1) for P)
+    double logU = logW + (isP ? lpgamma(a, y, logY) : lqgamma(a, y, logY));
+    double logV = isP ? logW + std::log(n / x) + (a - 1) * logYl - y - std::lgammal(a)
+                      : logW + a * logYl - y - std::lgammal(a + 1);
+    double scale = std::max(logU, logV);
+    double u = std::exp(logU - scale), v = std::exp(logV - scale);
+    double sum = u, dens = 0.0;
+    if (isP) {
+        for (--n; n >= 0; --n) {
+            double prevU = u;
+            u = u * (n + 1) / x + v;
+            sum += u;
+            dens += v * (mu + n) / y;
+            v *= n * (mu + n) / (x * y);
+            if (n <= x && u < MARCUM_EPSILON * sum && u <= prevU)
+                break;
+            if (sum > MARCUM_RESCALE || v > MARCUM_RESCALE) {
+                u /= MARCUM_RESCALE;
+                v /= MARCUM_RESCALE;
+                sum /= MARCUM_RESCALE;
+                dens /= MARCUM_RESCALE;
+                scale += std::log(MARCUM_RESCALE);
+            }
+        }
     }
-    sum /= M_SQRT2PI;
-    sum += Psi0;
-    sum *= 0.5 * std::pow(rho, mu);
-    return sum;
+    else {
+        dens = v * a / y;
+        for (;; ++n) {
+            double prevU = u;
+            double ratio = x / (n + 1);
+            u = ratio * (u + v);
+            sum += u;
+            dens += v * ratio;
+            v *= ratio * y / (mu + n + 1);
+            if (n + 1 > x && u < MARCUM_EPSILON * sum && u <= prevU)
+                break;
+            if (sum > MARCUM_RESCALE || v > MARCUM_RESCALE) {
+                u /= MARCUM_RESCALE;
+                v /= MARCUM_RESCALE;
+                sum /= MARCUM_RESCALE;
+                dens /= MARCUM_RESCALE;
+                scale += std::log(MARCUM_RESCALE);
+            }
+        }
+    }
+    density = std::exp(scale + std::log(dens));
+    return std::exp(scale + std::log(sum));
 }
 
 /**
- * @fn MarcumPForMuSmallerThanOne
+ * @fn marcumSpecialValue
  * @param mu
  * @param x
  * @param y
- * @return
+ * @param lower P_μ(x, y) in output for special values of parameters
+ * @param upper Q_μ(x, y) in output, calculated separately to avoid cancellation
+ * @return true if parameters have special values
  */
-double MarcumPForMuSmallerThanOne(double mu, double x, double y, double logX, double logY)
-{
-    // TODO: check Krishnamoorthy paper for alternative representation
+bool marcumSpecialValue(double mu, double x, double y, double &lower, double &upper)
+{
+    if (mu <= 0.0 || x < 0.0)
+        throw std::invalid_argument("Marcum function: parameter μ should be positive and x should be non-negative, but they're equal to "
+                                    + std::to_string(mu) + " and " + std::to_string(x) + " respectively");
+    if (y <= 0.0) {
+        lower = 0.0;
+        upper = 1.0;
+        return true;
+    }
+    if (y == INFINITY) {
+        lower = 1.0;
+        upper = 0.0;
+        return true;
+    }
+    if (x == 0.0) {
+        lower = pgamma(mu, y);
+        upper = qgamma(mu, y);
+        return true;
+    }
+    return false;
+}
 
-    /// in this case we use numerical integration,
-    /// however we have singularity point at 0,
-    /// so we get rid of it by subtracting the function
-    /// which has the same behaviour at this point
-    double aux = x + mu * M_LN2 + std::lgammal(mu);
-    double log2x = M_LN2 + logX;
-    double I = (M_LN2 + logY) * mu - aux;
-    I = std::exp(I) / mu;
+double MarcumP(double mu, double x, double y, double logY)
+{
+    double value = 0.0, upper = 0.0, density = 0.0;
+    if (marcumSpecialValue(mu, x, y, value, upper))
+        return value;
+    value = marcumPoissonSeries(mu, x, y, logY, density);
+    return (y < x + mu) ? value : 1.0 - value;
+}
 
-    double mum1 = mu - 1.0;
-    I += RandMath::integral([x, log2x, mum1, aux] (double t)
-    {
-        if (t <= 0)
-            return 0.0;
-        /// Calculate log of leveling factor
-        double log2T = std::log(2 * t);
-        double exponent = mum1 * log2T;
-        exponent -= aux;
-
-        /// Calculate log(2f(t))
-        double logBessel = RandMath::logBesselI(mum1, 2 * std::sqrt(x * t));
-        double z = mum1 * (log2T - log2x);
-        double log2F = 0.5 * z - t - x + logBessel;
-
-        /// Return difference f(t) - factor
-        return std::exp(log2F) - 2 * std::exp(exponent);
-    }, 0, y);
-    return I;
-}
-
-double MarcumQIntegrand(double theta, double xi, double sqrt1pXiSq, double mu, double y)
-{
-    double sinTheta = std::sin(theta);
-    double theta_sinTheta = theta / sinTheta;
-    double rho = std::hypot(theta_sinTheta, xi);
-    double theta_sinThetapRho = theta_sinTheta + rho;
-    double r = 0.5 * theta_sinThetapRho / y;
-    double cosTheta = std::cos(theta);
-    double psi = cosTheta * rho - sqrt1pXiSq;
-    double frac = theta_sinThetapRho / (1.0 + sqrt1pXiSq);
-    psi -= std::log(frac);
-    double numerator = (sinTheta - theta * cosTheta) / (sinTheta * rho);
-    numerator += cosTheta - r;
-    numerator *= r;
-    double denominator = r * r - 2.0 * r * cosTheta + 1.0;
-    double f = numerator / denominator;
-    return std::exp(mu * psi) * f;
-}
-
-double MarcumQIntergralRepresentation(double mu, double x, double y, double sqrtX, double sqrtY)
-{
-    double xi = 2.0 * sqrtX * sqrtY / mu;
-    double sqrt1pXiSq = std::sqrt(1.0 + xi * xi);
-    double yPrime = y / mu;
-    double s0 = 0.5 * (1.0 + sqrt1pXiSq) / yPrime;
-    double phi = x / s0 + y * s0 - std::log(s0) * mu;
-    std::function<double (double)> integrandPtr = std::bind(&MarcumQIntegrand, std::placeholders::_1, xi, sqrt1pXiSq, mu, yPrime);
-    double integral = RandMath::integral(integrandPtr, -M_PI, M_PI);
-    return 0.5 * std::exp(-x - y + phi) / M_PI * integral;
-}
-
-double MarcumP(double mu, double x, double y, double sqrtX, double sqrtY, double logX, double logY)
-{
-    /* 1 - ok
-     * 2 - ok
-     * 3 - no
-     * 4 - no
-     * 5 - not yet
-     * */
-    if (x < 0.0 || y <= 0.0)
-        return 0.0;
+double MarcumP(double mu, double x, double y)
+{
+    double value = 0.0, upper = 0.0;
+    if (marcumSpecialValue(mu, x, y, value, upper))
+        return value;
+    return MarcumP(mu, x, y, std::log(y));
+}
 
-    if (x < 30)
-        return MarcumPSeries(mu, x, y, logX, logY);
+double MarcumQ(double mu, double x, double y, double logY)
+{
+    double lower = 0.0, value = 0.0, density = 0.0;
+    if (marcumSpecialValue(mu, x, y, lower, value))
+        return value;
+    value = marcumPoissonSeries(mu, x, y, logY, density);
+    return (y < x + mu) ? 1.0 - value : value;
+}
 
-    double xi = 2 * sqrtX * sqrtY;
-    if (xi > 30 && mu * mu < 2 * xi)
-        return MarcumPAsymptoticForLargeXY(mu, x, y, sqrtX, sqrtY);
+double MarcumQ(double mu, double x, double y)
+{
+    double lower = 0.0, value = 0.0;
+    if (marcumSpecialValue(mu, x, y, lower, value))
+        return value;
+    return MarcumQ(mu, x, y, std::log(y));
+}
 
-    double temp = std::sqrt(4 * x + 2 * mu);
-    double f1 = x + mu - temp, f2 = x + mu + temp;
-    if (y > f1 && y < f2)
-        // IF mu > 135
-        return 1.0 - MarcumQIntergralRepresentation(mu, x, y, sqrtX, sqrtY);
+/**
+ * @fn marcumPoissonSeries
+ * Calculate P_μ(x, y) or Q_μ(x, y) for a batch of arguments y, such that y < x + μ for P or y >= x + μ for Q.
+ * All series start from the same index and share Poisson weights and the coefficients of recurrence,
+ * converged ones are dropped from the active set
+ * @param mu
+ * @param x
+ * @param y
+ * @param isP true if P_μ(x, y) should be calculated, Q_μ(x, y) otherwise
+ * @param output
+ */
+void marcumPoissonSeries(double mu, double x, const std::vector<double> &y, bool isP, std::vector<double> &output)
+{
+    size_t size = y.size();
+    int nMin = 0, nMax = 0;
+    marcumPoissonBounds(x, nMin, nMax);
+    /// the bound of the terms increases with y
+    int n = isP ? marcumTruncatedIndex(mu, x, *std::max_element(y.begin(), y.end()), nMax) : nMin;
+    double a = mu + n;
+    /// logarithms are multiplied by large numbers, so they should be calculated more accurately
+    long double logW = n * std::log(static_cast<long double>(x)) - x - std::lgammal(n + 1);
+    long double lgammaAl = std::lgammal(a);
+    double logA = std::log(a), lgammaA = lgammaAl;
+    /// the first terms of the series for all arguments at once
+    std::vector<double> tail(size);
+    if (isP)
+        pgamma(a, y, tail, logA, lgammaA);
+    else
+        qgamma(a, y, tail, logA, lgammaA);
+    std::vector<double> u(size), v(size), sum(size), scale(size), invY(size);
+    long double logVCoef = isP ? logW + std::log(n / x) - lgammaAl : logW - lgammaAl - logA;
+    for (size_t i = 0; i != size; ++i) {
+        long double logY = std::log(static_cast<long double>(y[i]));
+        double logTail = (tail[i] > 0.0) ? std::log(tail[i]) : (isP ? lpgamma(a, y[i], logA, lgammaA) : lqgamma(a, y[i], logA, lgammaA));
+        double logU = logW + logTail;
+        double logV = logVCoef + (isP ? a - 1 : a) * logY - y[i];
+        scale[i] = std::max(logU, logV);
+        u[i] = std::exp(logU - scale[i]);
+        v[i] = std::exp(logV - scale[i]);
+        sum[i] = u[i];
+        invY[i] = 1.0 / y[i];
+    }
+    std::vector<size_t> active(size);
+    std::iota(active.begin(), active.end(), 0);
+    while (!active.empty()) {
+        /// coefficients of the recurrence are shared by all arguments
+        double uCoef = 0, vCoef = 0;
+        bool isTail = false;
+        if (isP) {
+            if (--n < 0)
+                break;
+            uCoef = (n + 1) / x;
+            vCoef = n * (mu + n) / x;
+            isTail = n <= x;
+        }
+        else {
+            uCoef = x / (n + 1);
+            vCoef = uCoef / (mu + n + 1);
+            isTail = ++n > x;
+        }
+        size_t activeSize = 0;
+        for (size_t i : active) {
+            double prevU = u[i];
+            u[i] = isP ? u[i] * uCoef + v[i] : uCoef * (u[i] + v[i]);
+            sum[i] += u[i];
+            v[i] *= isP ? vCoef * invY[i] : vCoef * y[i];
+            if (sum[i] > MARCUM_RESCALE || v[i] > MARCUM_RESCALE) {
+                u[i] /= MARCUM_RESCALE;
+                v[i] /= MARCUM_RESCALE;
+                sum[i] /= MARCUM_RESCALE;
+                scale[i] += std::log(MARCUM_RESCALE);
+            }
+            if (!isTail || u[i] >= MARCUM_EPSILON * sum[i] || u[i] > prevU)
+                active[activeSize++] = i;
+        }
+        active.resize(activeSize);
+    }
+    for (size_t i = 0; i != size; ++i)
+        output[i] = std::exp(scale[i] + std::log(sum[i]));
+}
 
-    // TODO: implement the rest techniques
+/**
+ * @fn marcumFunction
+ * Calculate P_μ(x, y) or Q_μ(x, y) for a batch of arguments y
+ * @param mu
+ * @param x
+ * @param y
+ * @param output
+ * @param isP true if P_μ(x, y) should be returned, Q_μ(x, y) otherwise
+ */
+void marcumFunction(double mu, double x, const std::vector<double> &y, std::vector<double> &output, bool isP)
+{
+    size_t size = y.size();
+    if (size > output.size())
+        return;
+    /// arguments are split by the function, which is summed up: P for y < x + μ and Q otherwise
+    std::vector<size_t> indices[2];
+    std::vector<double> args[2];
+    for (size_t i = 0; i != size; ++i) {
+        double lower = 0.0, upper = 0.0;
+        if (marcumSpecialValue(mu, x, y[i], lower, upper)) {
+            output[i] = isP ? lower : upper;
+            continue;
+        }
+        int group = (y[i] < x + mu) ? 0 : 1;
+        indices[group].push_back(i);
+        args[group].push_back(y[i]);
+    }
+    for (int group = 0; group != 2; ++group) {
+        size_t groupSize = indices[group].size();
+        if (groupSize == 0)
+            continue;
+        std::vector<double> res(groupSize);
+        bool isGroupP = (group == 0);
+        marcumPoissonSeries(mu, x, args[group], isGroupP, res);
+        for (size_t i = 0; i != groupSize; ++i)
+            output[indices[group][i]] = (isGroupP == isP) ? res[i] : 1.0 - res[i];
+    }
+}
 
-    double mum1 = mu - 1;
-    return RandMath::integral([mum1, logX, x](double t) {
-        if (t < 0.0)
-            return 0.0;
-        if (t == 0.0)
-            return (mum1 == 0) ? 0.5 * std::exp(-x) : 0.0;
-        double logBesseli = RandMath::logBesselI(mum1, 2 * std::sqrt(x * t));
-        double z = 0.5 * mum1 * (std::log(t) - logX);
-        double h = t + x;
-        return std::exp(logBesseli + z - h);
-    }, 0, y);
+void MarcumP(double mu, double x, const std::vector<double> &y, std::vector<double> &output)
+{
+    marcumFunction(mu, x, y, output, true);
 }
 
-double MarcumP(double mu, double x, double y)
+void MarcumQ(double mu, double x, const std::vector<double> &y, std::vector<double> &output)
 {
-    double sqrtX = std::sqrt(x), sqrtY = std::sqrt(y);
-    double logX = std::log(x), logY = std::log(y);
-    return MarcumP(mu, x, y, sqrtX, sqrtY, logX, logY);
+    marcumFunction(mu, x, y, output, false);
 }
 
-double MarcumQ(double mu, double x, double y, double sqrtX, double sqrtY, double logX, double logY)
+/**
+ * @fn MarcumInverse
+ * @param mu
+ * @param x
+ * @param p probability of the tail, p <= 0.5
+ * @param isUpper true if p = Q_μ(x, y), false if p = P_μ(x, y)
+ * @return such y that P_μ(x, y) = p or Q_μ(x, y) = p
+ */
+double MarcumInverse(double mu, double x, double p, bool isUpper)
+{
+    /// initial value from Patnaik's approximation of noncentral chi-squared distribution by scaled gamma distribution
+    double mupx = mu + x, mup2x = mu + 2 * x;
+    double shape = mupx * mupx / mup2x, c = mup2x / mupx;
+    double root = c * (isUpper ? qgammainv(shape, p) : pgammainv(shape, p));
+    if (!isUpper) {
+        /// for small y, P_μ(x, y) ~ e^(-x) y^μ / Γ(μ + 1)
+        double rootSmall = std::exp((std::log(p) + x + std::lgammal(mu + 1)) / mu);
+        if (rootSmall < 1e-3) {
+            /// the root is too small to be represented
+            if (rootSmall == 0.0)
+                return 0.0;
+            root = rootSmall;
+        }
+    }
+    if (!(root > 0.0) || !std::isfinite(root))
+        root = mupx;
+    /// Newton's method for increasing function,
+    /// for small p we use logarithmic scale
+    bool isLogScale = p < 1e-5;
+    double logP = std::log(p);
+    auto fun = [mu, x, p, logP, isUpper, isLogScale] (double y)
+    {
+        if (y <= 0.0) {
+            if (isLogScale)
+                return DoubleTriplet(isUpper ? logP : -INFINITY, 0, 0);
+            return DoubleTriplet(isUpper ? p - 1.0 : -p, 0, 0);
+        }
+        double density = 0.0;
+        double value = marcumPoissonSeries(mu, x, y, std::log(y), density);
+        /// the series returns the smaller of P and Q
+        bool isSeriesP = y < x + mu;
+        double tail = (isSeriesP != isUpper) ? value : 1.0 - value;
+        if (isLogScale) {
+            double logTail = std::log(tail);
+            double first = isUpper ? logP - logTail : logTail - logP;
+            if (std::fabs(first) <= 1e-14)
+                first = 0.0;
+            return DoubleTriplet(first, density / tail, 0);
+        }
+        double first = isUpper ? p - tail : tail - p;
+        if (std::fabs(first) <= 1e-14 * p)
+            first = 0.0;
+        return DoubleTriplet(first, density, 0);
+    };
+    if (!findRootNewtonBracketed<double>(fun, 0.0, INFINITY, root, 1e-15))
+        throw std::runtime_error("Inverse of Marcum function: failure in numeric procedure");
+    return root;
+}
+
+double MarcumPinv(double mu, double x, double p)
 {
-    // TODO: implement and use, when mu + x > y
-    return 1.0 - MarcumP(mu, x, y, sqrtX, sqrtY, logX, logY);
+    if (mu <= 0.0 || x < 0.0 || p < 0.0 || p > 1.0)
+        throw std::invalid_argument("Inverse of Marcum function: parameter μ should be positive, x should be non-negative and probability p should be in [0, 1]");
+    if (p == 0.0)
+        return 0.0;
+    if (p == 1.0)
+        return INFINITY;
+    if (x == 0.0)
+        return pgammainv(mu, p);
+    return (p <= 0.5) ? MarcumInverse(mu, x, p, false) : MarcumInverse(mu, x, 1.0 - p, true);
 }
 
-double MarcumQ(double mu, double x, double y)
+double MarcumQinv(double mu, double x, double q)
 {
-    double sqrtX = std::sqrt(x), sqrtY = std::sqrt(y);
-    double logX = std::log(x), logY = std::log(y);
-    return MarcumQ(mu, x, y, sqrtX, sqrtY, logX, logY);
+    if (mu <= 0.0 || x < 0.0 || q < 0.0 || q > 1.0)
+        throw std::invalid_argument("Inverse of Marcum function: parameter μ should be positive, x should be non-negative and probability q should be in [0, 1]");
+    if (q == 0.0)
+        return INFINITY;
+    if (q == 1.0)
+        return 0.0;
+    if (x == 0.0)
+        return qgammainv(mu, q);
+    return (q <= 0.5) ? MarcumInverse(mu, x, q, true) : MarcumInverse(mu, x, 1.0 - q, false);
 }
 
 }
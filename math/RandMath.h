@@ -8,10 +8,12 @@
 #include <utility>
 #include <algorithm>
 #include <numeric>
+#include <limits>
 
 #include "Constants.h"
 #include "GammaMath.h"
 #include "BetaMath.h"
+#include "ZetaMath.h"
 
 namespace RandMath
 {
@@ -92,6 +94,24 @@ double erfinv(double p);
  */
 double erfcinv(double p);
 
+/**
+ * @fn erfinv
+ * Calculate inverse error function for a batch of arguments,
+ * grouping them by the Chebyshev series, which should be used
+ * @param p input vector
+ * @param y output vector: y = erfinv(p)
+ */
+void erfinv(const std::vector<double> &p, std::vector<double> &y);
+
+/**
+ * @fn erfcinv
+ * Calculate inverse complementary error function for a batch of arguments,
+ * grouping them by the Chebyshev series, which should be used
+ * @param p input vector
+ * @param y output vector: y = erfcinv(p)
+ */
+void erfcinv(const std::vector<double> &p, std::vector<double> &y);
+
 /**
  * @brief xexpxsqerfc
  * @param x
@@ -99,14 +119,6 @@ double erfcinv(double p);
  */
 double xexpxsqerfc(double x);
 
-/**
- * @fn harmonicNumber
- * @param exponent
- * @param number
- * @return sum_{i=1}^{number} i^{-exponent}
- */
-double harmonicNumber(double exponent, int number);
-
 /**
  * @fn logBesselI
  * Calculates logarithm of modified Bessel function of the 1st kind
@@ -125,6 +137,26 @@ long double logBesselI(double nu, double x);
  */
 long double logBesselK(double nu, double x);
 
+/**
+ * @fn logBesselI
+ * Calculates logarithm of modified Bessel function of the 1st kind for a batch of arguments,
+ * using power series for small x and Hankel asymptotic expansion for large x
+ * @param nu
+ * @param x input vector
+ * @param y output vector: y = log(I_ν(x))
+ */
+void logBesselI(double nu, const std::vector<double> &x, std::vector<double> &y);
+
+/**
+ * @fn logBesselK
+ * Calculates logarithm of modified Bessel function of the 2nd kind for a batch of arguments,
+ * using Hankel asymptotic expansion for large x
+ * @param nu
+ * @param x input vector
+ * @param y output vector: y = log(K_ν(x))
+ */
+void logBesselK(double nu, const std::vector<double> &x, std::vector<double> &y);
+
 /**
  * @fn W0Lambert
  * @param x
@@ -146,13 +178,10 @@ double Wm1Lambert(double x, double epsilon = 1e-11);
  * @param mu
  * @param x
  * @param y
- * @param sqrtX √x
- * @param sqrtY √y
- * @param logX log(x)
  * @param logY log(y)
  * @return 1 - Marcum Q-function
  */
-double MarcumP(double mu, double x, double y, double sqrtX, double sqrtY, double logX, double logY);
+double MarcumP(double mu, double x, double y, double logY);
 
 /**
  * @fn MarcumP
@@ -168,13 +197,10 @@ double MarcumP(double mu, double x, double y);
  * @param mu
  * @param x
  * @param y
- * @param sqrtX √x
- * @param sqrtY √y
- * @param logX log(x)
  * @param logY log(y)
  * @return Marcum Q-function
  */
-double MarcumQ(double mu, double x, double y, double sqrtX, double sqrtY, double logX, double logY);
+double MarcumQ(double mu, double x, double y, double logY);
 
 /**
  * @fn MarcumQ
@@ -184,6 +210,46 @@ double MarcumQ(double mu, double x, double y, double sqrtX, double sqrtY, double
  * @return Marcum Q-function
  */
 double MarcumQ(double mu, double x, double y);
+
+/**
+ * @fn MarcumP
+ * Calculate 1 - Marcum Q-function for a batch of arguments y,
+ * sharing Poisson weights and recurrences between them
+ * @param mu
+ * @param x
+ * @param y input vector
+ * @param output output vector: output = 1 - Q_μ(x, y)
+ */
+void MarcumP(double mu, double x, const std::vector<double> &y, std::vector<double> &output);
+
+/**
+ * @fn MarcumQ
+ * Calculate Marcum Q-function for a batch of arguments y,
+ * sharing Poisson weights and recurrences between them
+ * @param mu
+ * @param x
+ * @param y input vector
+ * @param output output vector: output = Q_μ(x, y)
+ */
+void MarcumQ(double mu, double x, const std::vector<double> &y, std::vector<double> &output);
+
+/**
+ * @fn MarcumPinv
+ * @param mu
+ * @param x
+ * @param p
+ * @return such y that 1 - Q_μ(x, y) = p
+ */
+double MarcumPinv(double mu, double x, double p);
+
+/**
+ * @fn MarcumQinv
+ * @param mu
+ * @param x
+ * @param q
+ * @return such y that Q_μ(x, y) = q
+ */
+double MarcumQinv(double mu, double x, double q);
 }
 
 #endif // RANDMATH_H
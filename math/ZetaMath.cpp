@@ -0,0 +1,227 @@
+#include "ZetaMath.h"
+
+namespace RandMath
+{
+
+/**
+ * @fn BERNOULLI_COEFS B_{2j} / (2j)! for j from 1 to 8
+ */
+constexpr double BERNOULLI_COEFS[] =
+{
+    1.0 / 12.0,
+    -1.0 / 720.0,
+    1.0 / 30240.0,
+    -1.0 / 1209600.0,
+    1.0 / 47900160.0,
+    -691.0 / 1307674368000.0,
+    1.0 / 74724249600.0,
+    -3617.0 / 10670622842880000.0
+};
+
+/**
+ * @fn eulerMaclaurinCorrection
+ * @param s exponent
+ * @param a starting point of summation
+ * @param logA log(a)
+ * @return sum_{k=0}^{∞} (a + k)^{-s} - a^{1-s} / (s - 1)
+ * for a large enough to use Euler-Maclaurin formula
+ */
+double eulerMaclaurinCorrection(double s, double a, double logA)
+{
+    double fa = std::exp(-s * logA);
+    double sum = 0.5 * fa;
+    /// -f^{(2j-1)}(a) = s(s+1)...(s+2j-2) a^{-s-2j+1}
+    double coef = s, der = fa / a, invASq = 1.0 / (a * a);
+    for (int j = 0; j != 8; ++j) {
+        double addon = BERNOULLI_COEFS[j] * coef * der;
+        sum += addon;
+        if (std::fabs(addon) < MIN_POSITIVE * std::fabs(sum))
+            break;
+        double shift = s + 2 * j + 1;
+        coef *= shift * (shift + 1);
+        der *= invASq;
+    }
+    return sum;
+}
+
+/**
+ * @fn EULER_MACLAURIN_SHIFT
+ * minimal starting point for Euler-Maclaurin formula,
+ * smaller terms are summed directly
+ */
+constexpr int EULER_MACLAURIN_SHIFT = 12;
+
+double hurwitzZeta(double s, double q)
+{
+    if (q <= 0.0)
+        return NAN;
+    if (s == 1.0)
+        return INFINITY;
+    double sum = 0.0;
+    int directTerms = (q < EULER_MACLAURIN_SHIFT) ? EULER_MACLAURIN_SHIFT - std::floor(q) : 0;
+    for (int k = 0; k < directTerms; ++k)
+        sum += std::exp(-s * std::log(q + k));
+    double a = q + directTerms;
+    double logA = std::log(a);
+    sum += a * std::exp(-s * logA) / (s - 1.0);
+    return sum + eulerMaclaurinCorrection(s, a, logA);
+}
+
+double riemannZeta(double s)
+{
+    if (s == 1.0)
+        return INFINITY;
+    if (s == 0.0)
+        return -0.5;
+    if (s > 0.0)
+        return hurwitzZeta(s, 1.0);
+    /// reflection formula:
+    /// ζ(s) = 2^s π^(s-1) sin(πs/2) Γ(1-s) ζ(1-s)
+    double sinus = std::sin(M_PI_2 * s);
+    double roundS = std::round(0.5 * s);
+    if (roundS == 0.5 * s)
+        return 0.0; /// trivial zeros
+    double y = s * M_LN2 + (s - 1) * M_LNPI + std::lgammal(1.0 - s) + std::log(std::fabs(sinus));
+    y = std::exp(y) * hurwitzZeta(1.0 - s, 1.0);
+    return (sinus > 0) ? y : -y;
+}
+
+double harmonicNumber(double exponent, long long number)
+{
+    if (number < 1)
+        return 0;
+    if (exponent == 1)
+        return M_EULER + digamma(number + 1);
+    if (exponent == 2)
+        return M_PI_SQ / 6.0 - trigamma(number + 1);
+    return zetaPartialSum(exponent, 1, number);
+}
+
+/**
+ * @fn DIRECT_SUMMATION_MAX_TERMS
+ * maximal number of terms in partial sum of zeta series, which are summed directly
+ */
+constexpr long long DIRECT_SUMMATION_MAX_TERMS = 64;
+
+double zetaPartialSum(double exponent, long long from, long long to)
+{
+    if (from < 1)
+        return NAN;
+    if (to < from)
+        return 0.0;
+    /// for few terms we use direct summation, starting from the smallest ones
+    if (to - from < DIRECT_SUMMATION_MAX_TERMS) {
+        double res = 0.0;
+        for (long long i = to; i >= from; --i)
+            res += std::exp(-exponent * std::log(i));
+        return res;
+    }
+    /// otherwise we sum first terms directly
+    /// and use Euler-Maclaurin formula for the rest of them:
+    /// sum_{i=m}^{n} f(i) = int_m^n f(x) dx + (f(m) + f(n)) / 2 +
+    /// + sum_{j=1}^{p} B_{2j} / (2j)! * (f^{(2j-1)}(n) - f^{(2j-1)}(m))
+    double res = 0.0;
+    long long first = std::max<long long>(from, EULER_MACLAURIN_SHIFT);
+    for (long long i = from; i < first; ++i)
+        res += std::exp(-exponent * std::log(i));
+    double m = first, N = to;
+    double logm = std::log(m), logN = std::log(N);
+    double fm = std::exp(-exponent * logm), fN = std::exp(-exponent * logN);
+    /// integral of x^{-s} from m to n, rewritten to avoid cancellation for s close to 1
+    /// and for n close to m
+    double logRatio = std::log1p((N - m) / m);
+    double oneMinusExp = 1.0 - exponent;
+    double integral = m * fm;
+    integral *= (oneMinusExp == 0.0) ? logRatio : std::expm1(oneMinusExp * logRatio) / oneMinusExp;
+    res += integral + 0.5 * (fm + fN);
+    /// f^{(2j-1)}(x) = -s(s+1)...(s+2j-2) x^{-s-2j+1}
+    double coef = -exponent;
+    double derm = fm / m, derN = fN / N;
+    double invmSq = 1.0 / (m * m), invNSq = 1.0 / (N * N);
+    for (int j = 0; j != 8; ++j) {
+        res += BERNOULLI_COEFS[j] * coef * (derN - derm);
+        double shift = exponent + 2 * j + 1;
+        coef *= shift * (shift + 1);
+        derm *= invmSq;
+        derN *= invNSq;
+    }
+    return res;
+}
+
+/**
+ * @fn polylogSeries
+ * @param s
+ * @param x
+ * @return Li_s(x) by power series, should be used for |x| <= 0.5
+ */
+double polylogSeries(double s, double x)
+{
+    double sum = x, xPow = x;
+    int k = 1;
+    do {
+        xPow *= x;
+        double addon = xPow * std::exp(-s * std::log(++k));
+        sum += addon;
+        if (std::fabs(addon) <= MIN_POSITIVE * std::fabs(sum))
+            break;
+    } while (k < 1000);
+    return sum;
+}
+
+/**
+ * @fn polylogLogSeries
+ * @param s
+ * @param mu log(x)
+ * @return Li_s(x) by expansion in powers of μ = log(x), should be used for x in (0.5, 1)
+ */
+double polylogLogSeries(double s, double mu)
+{
+    double roundS = std::round(s);
+    bool sIsPositiveInt = (s == roundS && s >= 1);
+    int n = roundS;
+    double sum = 0.0;
+    if (sIsPositiveInt) {
+        /// Li_n(e^μ) = μ^(n-1) / (n-1)! * (H_{n-1} - log(-μ)) + sum_{k ≠ n-1} ζ(n - k) μ^k / k!
+        double harmonic = harmonicNumber(1, n - 1);
+        sum = std::pow(mu, n - 1) / factorial(n - 1) * (harmonic - std::log(-mu));
+    }
+    else {
+        /// Li_s(e^μ) = Γ(1 - s) (-μ)^(s-1) + sum_k ζ(s - k) μ^k / k!
+        double gammaCoef = std::tgamma(1.0 - s);
+        sum = gammaCoef * std::exp((s - 1) * std::log(-mu));
+    }
+    double muPowDivFact = 1.0;
+    for (int k = 0; k != 64; ++k) {
+        if (!sIsPositiveInt || k != n - 1) {
+            double addon = riemannZeta(s - k) * muPowDivFact;
+            sum += addon;
+            if (k > n && addon != 0.0 && std::fabs(addon) <= MIN_POSITIVE * std::fabs(sum))
+                break;
+        }
+        muPowDivFact *= mu / (k + 1);
+    }
+    return sum;
+}
+
+double polylog(double s, double x)
+{
+    if (x == 0.0)
+        return 0.0;
+    if (x == 1.0)
+        return (s > 1.0) ? riemannZeta(s) : INFINITY;
+    if (x > 1.0 || x < -1.0)
+        return NAN;
+    if (x == -1.0) /// Dirichlet eta function
+        return (s == 1.0) ? -M_LN2 : std::expm1((1.0 - s) * M_LN2) * riemannZeta(s);
+    if (std::fabs(x) <= 0.5)
+        return polylogSeries(s, x);
+    if (x < 0.0) {
+        /// duplication formula:
+        /// Li_s(x) = 2^(1-s) Li_s(x^2) - Li_s(-x)
+        double y = std::exp((1.0 - s) * M_LN2) * polylog(s, x * x);
+        return y - polylog(s, -x);
+    }
+    return polylogLogSeries(s, std::log(x));
+}
+
+}
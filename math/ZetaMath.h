@@ -0,0 +1,65 @@
+#ifndef ZETAMATH
+#define ZETAMATH
+
+#include "RandMath.h"
+
+/// Zeta-related functions
+
+namespace RandMath
+{
+
+/**
+ * @fn riemannZeta
+ * Calculate Riemann zeta function
+ * by Euler-Maclaurin formula for s > 0
+ * and by reflection formula for s < 0
+ * @param s real parameter, not equal to 1
+ * @return ζ(s)
+ */
+double riemannZeta(double s);
+
+/**
+ * @fn hurwitzZeta
+ * Calculate Hurwitz zeta function by Euler-Maclaurin formula
+ * @param s real parameter, not equal to 1
+ * @param q positive parameter
+ * @return ζ(s, q) = sum_{k=0}^{∞} (q + k)^{-s}
+ */
+double hurwitzZeta(double s, double q);
+
+/**
+ * @fn harmonicNumber
+ * Calculate partial sum of zeta series,
+ * in O(1) time for large number via Euler-Maclaurin formula
+ * @param exponent
+ * @param number
+ * @return sum_{i=1}^{number} i^{-exponent}
+ */
+double harmonicNumber(double exponent, long long number);
+
+/**
+ * @fn zetaPartialSum
+ * Calculate finite sum of zeta series directly for few terms
+ * and via Euler-Maclaurin formula otherwise,
+ * without cancellation of two infinite tails
+ * @param exponent
+ * @param from first index, positive
+ * @param to last index
+ * @return sum_{i=from}^{to} i^{-exponent}
+ */
+double zetaPartialSum(double exponent, long long from, long long to);
+
+/**
+ * @fn polylog
+ * Calculate polylogarithm by its power series for |x| <= 0.5,
+ * by expansion in powers of log(x) for x in (0.5, 1)
+ * and by duplication formula for x in [-1, -0.5)
+ * @param s real parameter
+ * @param x parameter in [-1, 1]
+ * @return Li_s(x) = sum_{k=1}^{∞} x^k / k^s
+ */
+double polylog(double s, double x);
+
+}
+
+#endif // ZETAMATH